@@ -37,6 +37,9 @@
 
 #include "OpenEXR/ImathMath.h"
 
+#include "IECore/FastFloat.h"
+#include "IECore/ApproximateDataConversion.h"
+
 namespace IECore
 {
 
@@ -62,6 +65,41 @@ T AlexaLogcToLinearDataConversion<F, T>::operator()( F f ) const
 	}
 }
 
+namespace Detail
+{
+
+struct AlexaLogcToLinearApproximation
+{
+	float operator()( float f ) const
+	{
+		const float kCut = 0.010591f;
+		const float kA = 5.555556f;
+		const float kB = 0.052272f;
+		const float kD = 0.385537f;
+		const float kE = 5.367655f;
+		const float kF = 0.092809f;
+		// 10^( x / kC ) == 2^( x * log2( 10 ) / kC ), with the constant
+		// folded to avoid an extra rounding error in the exponent.
+		const float log2TenOverKC = 13.4387641f;
+		return f <= kE*kCut+kF ? (f - kF) / kE : ( fastFloatExp2( (f-kD) * log2TenOverKC ) - kB ) / kA;
+	}
+
+	bool valid( float f ) const
+	{
+		// false for infinities and NaNs, and for values large
+		// enough to take fastFloatExp2() out of range.
+		return f >= -1e30f && f <= 9.0f;
+	}
+};
+
+} // namespace Detail
+
+template<typename F, typename T>
+void AlexaLogcToLinearDataConversion<F, T>::operator()( const F *from, T *to, size_t n ) const
+{
+	approximateDataConversion( *this, Detail::AlexaLogcToLinearApproximation(), from, to, n );
+}
+
 template<typename F, typename T>
 typename AlexaLogcToLinearDataConversion<F, T>::InverseType AlexaLogcToLinearDataConversion<F, T>::inverse() const
 {
@@ -0,0 +1,148 @@
+//////////////////////////////////////////////////////////////////////////
+//
+//  Copyright (c) 2013, Image Engine Design Inc. All rights reserved.
+//
+//  Redistribution and use in source and binary forms, with or without
+//  modification, are permitted provided that the following conditions are
+//  met:
+//
+//     * Redistributions of source code must retain the above copyright
+//       notice, this list of conditions and the following disclaimer.
+//
+//     * Redistributions in binary form must reproduce the above copyright
+//       notice, this list of conditions and the following disclaimer in the
+//       documentation and/or other materials provided with the distribution.
+//
+//     * Neither the name of Image Engine Design nor the names of any
+//       other contributors to this software may be used to endorse or
+//       promote products derived from this software without specific prior
+//       written permission.
+//
+//  THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS
+//  IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO,
+//  THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR
+//  PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER OR
+//  CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+//  EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+//  PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR
+//  PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF
+//  LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING
+//  NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+//  SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+//
+//////////////////////////////////////////////////////////////////////////
+
+#ifndef IECORE_ALIGNEDALLOCATOR_H
+#define IECORE_ALIGNEDALLOCATOR_H
+
+#include <cstddef>
+#include <vector>
+
+#include "boost/shared_ptr.hpp"
+#include "boost/static_assert.hpp"
+
+namespace IECore
+{
+
+namespace Detail
+{
+
+struct AlignedAllocatorAdoption;
+
+} // namespace Detail
+
+/// An STL compatible allocator which aligns storage to Alignment bytes, so that
+/// it may be used directly by vectorised code. It differs from std::allocator in
+/// two further ways :
+///
+/// - Elements constructed without a value are default-initialised rather than
+///   value-initialised. Resizing a container of builtin types therefore leaves
+///   the new elements uninitialised, rather than clearing memory which is about
+///   to be overwritten anyway.
+/// - An allocator may be constructed to adopt an existing buffer, which is then
+///   returned by the first allocation of the same size. Constructing a vector
+///   of that size with the allocator takes ownership of the data without copying
+///   it.
+///
+/// Both rely on a standard library which constructs elements via
+/// std::allocator_traits, as required by C++11. Older libraries will still
+/// value-initialise elements, overwriting any adopted data.
+///
+/// All AlignedAllocators with the same Alignment compare equal, as memory from
+/// any of them may be deallocated by any other.
+/// \ingroup utilityGroup
+template<typename T, size_t Alignment = 64>
+class AlignedAllocator
+{
+
+	public :
+
+		typedef T value_type;
+		typedef T *pointer;
+		typedef const T *const_pointer;
+		typedef T &reference;
+		typedef const T &const_reference;
+		typedef size_t size_type;
+		typedef std::ptrdiff_t difference_type;
+
+		template<typename U>
+		struct rebind
+		{
+			typedef AlignedAllocator<U, Alignment> other;
+		};
+
+		AlignedAllocator();
+		/// Constructs an allocator which adopts the buffer, returning it from the
+		/// first call to allocate( size ). The buffer must have been allocated by
+		/// an AlignedAllocator with the same Alignment, and ownership passes to
+		/// the allocator and its copies. If it is never allocated, it is
+		/// deallocated when the last copy of the allocator is destroyed.
+		AlignedAllocator( pointer buffer, size_type size );
+		template<typename U>
+		AlignedAllocator( const AlignedAllocator<U, Alignment> &other );
+
+		pointer address( reference r ) const;
+		const_pointer address( const_reference r ) const;
+		size_type max_size() const;
+
+		/// Throws std::bad_alloc on failure.
+		pointer allocate( size_type n, const void *hint = 0 );
+		void deallocate( pointer p, size_type n );
+
+		/// Default-initialises the element at p.
+		template<typename U>
+		void construct( U *p );
+		void construct( pointer p, const_reference value );
+		void destroy( pointer p );
+
+		template<typename U>
+		bool operator == ( const AlignedAllocator<U, Alignment> &other ) const;
+		template<typename U>
+		bool operator != ( const AlignedAllocator<U, Alignment> &other ) const;
+
+	private :
+
+		BOOST_STATIC_ASSERT( ( Alignment & ( Alignment - 1 ) ) == 0 && Alignment >= sizeof( void * ) );
+
+		template<typename U, size_t A>
+		friend class AlignedAllocator;
+
+		// Shared between copies of an allocator, so that an
+		// adopted buffer is only ever returned once.
+		boost::shared_ptr<Detail::AlignedAllocatorAdoption> m_adoption;
+
+};
+
+/// A std::vector using AlignedAllocator, for buffers which are resized and
+/// then immediately overwritten.
+template<typename T, size_t Alignment = 64>
+struct AlignedVector
+{
+	typedef std::vector<T, AlignedAllocator<T, Alignment> > Type;
+};
+
+} // namespace IECore
+
+#include "IECore/AlignedAllocator.inl"
+
+#endif // IECORE_ALIGNEDALLOCATOR_H
@@ -0,0 +1,169 @@
+//////////////////////////////////////////////////////////////////////////
+//
+//  Copyright (c) 2013, Image Engine Design Inc. All rights reserved.
+//
+//  Redistribution and use in source and binary forms, with or without
+//  modification, are permitted provided that the following conditions are
+//  met:
+//
+//     * Redistributions of source code must retain the above copyright
+//       notice, this list of conditions and the following disclaimer.
+//
+//     * Redistributions in binary form must reproduce the above copyright
+//       notice, this list of conditions and the following disclaimer in the
+//       documentation and/or other materials provided with the distribution.
+//
+//     * Neither the name of Image Engine Design nor the names of any
+//       other contributors to this software may be used to endorse or
+//       promote products derived from this software without specific prior
+//       written permission.
+//
+//  THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS
+//  IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO,
+//  THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR
+//  PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER OR
+//  CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+//  EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+//  PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR
+//  PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF
+//  LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING
+//  NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+//  SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+//
+//////////////////////////////////////////////////////////////////////////
+
+#ifndef IECORE_ALIGNEDALLOCATOR_INL
+#define IECORE_ALIGNEDALLOCATOR_INL
+
+#include <new>
+#include <limits>
+#include <cstdlib>
+#include <algorithm>
+
+namespace IECore
+{
+
+namespace Detail
+{
+
+struct AlignedAllocatorAdoption
+{
+
+	AlignedAllocatorAdoption( void *b, size_t s )
+		:	buffer( b ), bytes( s )
+	{
+	}
+
+	~AlignedAllocatorAdoption()
+	{
+		free( buffer );
+	}
+
+	void *buffer;
+	size_t bytes;
+
+};
+
+} // namespace Detail
+
+template<typename T, size_t Alignment>
+AlignedAllocator<T, Alignment>::AlignedAllocator()
+{
+}
+
+template<typename T, size_t Alignment>
+AlignedAllocator<T, Alignment>::AlignedAllocator( pointer buffer, size_type size )
+	:	m_adoption( new Detail::AlignedAllocatorAdoption( buffer, size * sizeof( T ) ) )
+{
+}
+
+template<typename T, size_t Alignment>
+template<typename U>
+AlignedAllocator<T, Alignment>::AlignedAllocator( const AlignedAllocator<U, Alignment> &other )
+	:	m_adoption( other.m_adoption )
+{
+}
+
+template<typename T, size_t Alignment>
+typename AlignedAllocator<T, Alignment>::pointer AlignedAllocator<T, Alignment>::address( reference r ) const
+{
+	return &r;
+}
+
+template<typename T, size_t Alignment>
+typename AlignedAllocator<T, Alignment>::const_pointer AlignedAllocator<T, Alignment>::address( const_reference r ) const
+{
+	return &r;
+}
+
+template<typename T, size_t Alignment>
+typename AlignedAllocator<T, Alignment>::size_type AlignedAllocator<T, Alignment>::max_size() const
+{
+	return std::numeric_limits<size_type>::max() / sizeof( T );
+}
+
+template<typename T, size_t Alignment>
+typename AlignedAllocator<T, Alignment>::pointer AlignedAllocator<T, Alignment>::allocate( size_type n, const void *hint )
+{
+	if( m_adoption && m_adoption->buffer && m_adoption->bytes == n * sizeof( T ) )
+	{
+		void *result = m_adoption->buffer;
+		m_adoption->buffer = 0;
+		return static_cast<pointer>( result );
+	}
+
+	if( n > max_size() )
+	{
+		throw std::bad_alloc();
+	}
+
+	void *result = 0;
+	if( posix_memalign( &result, Alignment, std::max<size_t>( n * sizeof( T ), 1 ) ) != 0 )
+	{
+		throw std::bad_alloc();
+	}
+	return static_cast<pointer>( result );
+}
+
+template<typename T, size_t Alignment>
+void AlignedAllocator<T, Alignment>::deallocate( pointer p, size_type n )
+{
+	free( p );
+}
+
+template<typename T, size_t Alignment>
+template<typename U>
+void AlignedAllocator<T, Alignment>::construct( U *p )
+{
+	new( static_cast<void *>( p ) ) U;
+}
+
+template<typename T, size_t Alignment>
+void AlignedAllocator<T, Alignment>::construct( pointer p, const_reference value )
+{
+	new( static_cast<void *>( p ) ) T( value );
+}
+
+template<typename T, size_t Alignment>
+void AlignedAllocator<T, Alignment>::destroy( pointer p )
+{
+	p->~T();
+}
+
+template<typename T, size_t Alignment>
+template<typename U>
+bool AlignedAllocator<T, Alignment>::operator == ( const AlignedAllocator<U, Alignment> &other ) const
+{
+	return true;
+}
+
+template<typename T, size_t Alignment>
+template<typename U>
+bool AlignedAllocator<T, Alignment>::operator != ( const AlignedAllocator<U, Alignment> &other ) const
+{
+	return false;
+}
+
+} // namespace IECore
+
+#endif // IECORE_ALIGNEDALLOCATOR_INL
@@ -0,0 +1,63 @@
+//////////////////////////////////////////////////////////////////////////
+//
+//  Copyright (c) 2013, Image Engine Design Inc. All rights reserved.
+//
+//  Redistribution and use in source and binary forms, with or without
+//  modification, are permitted provided that the following conditions are
+//  met:
+//
+//     * Redistributions of source code must retain the above copyright
+//       notice, this list of conditions and the following disclaimer.
+//
+//     * Redistributions in binary form must reproduce the above copyright
+//       notice, this list of conditions and the following disclaimer in the
+//       documentation and/or other materials provided with the distribution.
+//
+//     * Neither the name of Image Engine Design nor the names of any
+//       other contributors to this software may be used to endorse or
+//       promote products derived from this software without specific prior
+//       written permission.
+//
+//  THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS
+//  IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO,
+//  THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR
+//  PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER OR
+//  CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+//  EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+//  PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR
+//  PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF
+//  LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING
+//  NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+//  SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+//
+//////////////////////////////////////////////////////////////////////////
+
+#ifndef IECORE_APPROXIMATEDATACONVERSION_H
+#define IECORE_APPROXIMATEDATACONVERSION_H
+
+#include <cstddef>
+
+namespace IECore
+{
+
+/// Implements the array form of a DataConversion using a vectorisable approximation.
+/// For float input, the Approximation is applied to all values in a single loop with
+/// no calls, and any values it can't handle accurately are then recomputed using the
+/// exact scalar conversion. Input of any other type is converted with the scalar
+/// conversion throughout, so that double precision data isn't degraded to the
+/// precision of the approximation. The Approximation class must provide the following
+/// methods :
+///
+/// float operator()( float f ) const;
+/// bool valid( float f ) const; // Returns false for values which need the exact conversion.
+template<typename Conversion, typename Approximation>
+void approximateDataConversion(
+	const Conversion &conversion, const Approximation &approximation,
+	const typename Conversion::FromType *from, typename Conversion::ToType *to, size_t n
+);
+
+} // namespace IECore
+
+#include "IECore/ApproximateDataConversion.inl"
+
+#endif // IECORE_APPROXIMATEDATACONVERSION_H
@@ -0,0 +1,107 @@
+//////////////////////////////////////////////////////////////////////////
+//
+//  Copyright (c) 2013, Image Engine Design Inc. All rights reserved.
+//
+//  Redistribution and use in source and binary forms, with or without
+//  modification, are permitted provided that the following conditions are
+//  met:
+//
+//     * Redistributions of source code must retain the above copyright
+//       notice, this list of conditions and the following disclaimer.
+//
+//     * Redistributions in binary form must reproduce the above copyright
+//       notice, this list of conditions and the following disclaimer in the
+//       documentation and/or other materials provided with the distribution.
+//
+//     * Neither the name of Image Engine Design nor the names of any
+//       other contributors to this software may be used to endorse or
+//       promote products derived from this software without specific prior
+//       written permission.
+//
+//  THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS
+//  IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO,
+//  THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR
+//  PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER OR
+//  CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+//  EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+//  PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR
+//  PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF
+//  LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING
+//  NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+//  SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+//
+//////////////////////////////////////////////////////////////////////////
+
+#ifndef IECORE_APPROXIMATEDATACONVERSION_INL
+#define IECORE_APPROXIMATEDATACONVERSION_INL
+
+#include <algorithm>
+
+namespace IECore
+{
+
+namespace Detail
+{
+
+template<typename Conversion, typename Approximation, typename F>
+struct ApproximateDataConversion
+{
+	static void apply( const Conversion &conversion, const Approximation &approximation, const F *from, typename Conversion::ToType *to, size_t n )
+	{
+		for( size_t i = 0; i < n; i++ )
+		{
+			to[i] = conversion( from[i] );
+		}
+	}
+};
+
+template<typename Conversion, typename Approximation>
+struct ApproximateDataConversion<Conversion, Approximation, float>
+{
+	static void apply( const Conversion &conversion, const Approximation &approximation, const float *from, typename Conversion::ToType *to, size_t n )
+	{
+		typedef typename Conversion::ToType T;
+
+		const size_t chunkSize = 256;
+		float chunk[chunkSize];
+		while( n )
+		{
+			// we take a copy of the input, because we may be converting
+			// in place, and need the original values for the second pass.
+			const size_t size = std::min( n, chunkSize );
+			std::copy( from, from + size, chunk );
+
+			for( size_t i = 0; i < size; i++ )
+			{
+				to[i] = T( approximation( chunk[i] ) );
+			}
+
+			for( size_t i = 0; i < size; i++ )
+			{
+				if( !approximation.valid( chunk[i] ) )
+				{
+					to[i] = conversion( chunk[i] );
+				}
+			}
+
+			from += size;
+			to += size;
+			n -= size;
+		}
+	}
+};
+
+} // namespace Detail
+
+template<typename Conversion, typename Approximation>
+void approximateDataConversion(
+	const Conversion &conversion, const Approximation &approximation,
+	const typename Conversion::FromType *from, typename Conversion::ToType *to, size_t n
+)
+{
+	Detail::ApproximateDataConversion<Conversion, Approximation, typename Conversion::FromType>::apply( conversion, approximation, from, to, n );
+}
+
+} // namespace IECore
+
+#endif // IECORE_APPROXIMATEDATACONVERSION_INL
@@ -75,6 +75,15 @@ class BoundedKDTree
 		/// making queries.
 		void init( BoundIterator first, BoundIterator last, int maxLeafSize=4 );
 
+		/// Recomputes the bounds of the tree nodes, for use after the bounds
+		/// passed to init() have been modified in place. This is much quicker
+		/// than calling init() again, as the structure of the tree is kept, but
+		/// queries become less efficient as the bounds move further from where
+		/// they were when the tree was built.
+		/// \threading This can't be called while other threads are
+		/// making queries.
+		void update();
+
 		/// Populates the passed vector of iterators with the bounds which intersect "b". Returns the number of bounds found.
 		/// \threading May be called by multiple concurrent threads provided they each use a different vector for the result.
 		/// \todo There should be a form where nearNeighbours is an output iterator, to allow any container to be filled.
@@ -261,6 +261,16 @@ void BoundedKDTree<BoundIterator>::init( BoundIterator first, BoundIterator last
 	bound( rootIndex() );
 }
 
+template<class BoundIterator>
+void BoundedKDTree<BoundIterator>::update()
+{
+	for( typename NodeVector::iterator it = m_nodes.begin(); it != m_nodes.end(); it++ )
+	{
+		BoxTraits<Bound>::makeEmpty( it->bound() );
+	}
+	bound( rootIndex() );
+}
+
 template<class BoundIterator>
 typename BoundedKDTree<BoundIterator>::NodeIndex BoundedKDTree<BoundIterator>::numNodes() const
 {
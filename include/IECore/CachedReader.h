@@ -35,7 +35,10 @@
 #ifndef IE_CORE_CACHEDREADER_H
 #define IE_CORE_CACHEDREADER_H
 
+#include <vector>
+
 #include "boost/shared_ptr.hpp"
+#include "boost/thread/future.hpp"
 
 #include "IECore/Export.h"
 #include "IECore/ObjectPool.h"
@@ -91,6 +94,31 @@ class IECORE_API CachedReader : public RefCounted
 		/// concurrent threads.
 		ConstObjectPtr read( const std::string &file );
 
+		/// The result of an asynchronous read. Calling get() waits for the
+		/// load to complete, and either returns the object or rethrows the
+		/// exception thrown while loading it.
+		typedef boost::shared_future<ConstObjectPtr> Future;
+
+		/// Queues the given file to be loaded on a background I/O thread and
+		/// returns immediately. Concurrent requests for the same file are coalesced
+		/// into a single load, and files which are already cached are returned
+		/// without queueing anything.
+		/// \threading It is safe to call this method from multiple
+		/// concurrent threads.
+		Future readAsync( const std::string &file );
+
+		/// Queues the given files to be loaded on background I/O threads, so that
+		/// subsequent calls to read() or readAsync() find them already cached or in
+		/// flight. Queueing stops having any effect once the objects loaded for
+		/// this call would fill the ObjectPool, as loading more would only evict
+		/// the earlier ones before they were used. Any errors are reported when
+		/// the file is read explicitly.
+		void prefetch( const std::vector<std::string> &files );
+
+		/// Blocks until all the loads queued by readAsync() and prefetch() have
+		/// completed.
+		void waitForPendingReads();
+
 		/// Frees all memory used by the cache.
 		void clear();
 		/// Clears the cache for the given file.
@@ -45,7 +45,8 @@ namespace IECore
 /// The ColorTransformOp defines a base class for Ops which
 /// transform the colors of a Primitive. By default the "Cs" or "R",
 /// "G", and "B" channels are transformed but this can be changed
-/// using the appropriate parameters.
+/// using the appropriate parameters. Colors are transformed in spans
+/// of contiguous elements, using multiple threads.
 /// \ingroup imageProcessingGroup
 class IECORE_API ColorTransformOp : public PrimitiveOp
 {
@@ -82,6 +83,13 @@ class IECORE_API ColorTransformOp : public PrimitiveOp
 		/// Called once per color element (pixel for ImagePrimitives).
 		/// Must be implemented by subclasses to transform color in place.
 		virtual void transform( Imath::Color3f &color ) const = 0;
+		/// Called to transform a span of n contiguous color elements in place, with the
+		/// red, green and blue components held in separate arrays. The default implementation
+		/// calls transform() for each element in turn, but subclasses may override it to
+		/// process the whole span in tighter loops which the compiler is better able to
+		/// vectorise. Spans are processed concurrently by multiple threads, so this and
+		/// transform() must be threadsafe.
+		virtual void transformSpan( float *r, float *g, float *b, size_t n ) const;
 		/// Called once per operation, after all calls to transform() have been made - even if
 		// /transform() throws an exception. This is an opportunity to perform any cleanup necessary.
 		virtual void end();
@@ -98,6 +106,11 @@ class IECORE_API ColorTransformOp : public PrimitiveOp
 		void transformSeparate( Primitive * primitive, const CompoundObject * operands, T * r, T * g, T * b );
 		template <typename T>
 		void transformInterleaved( Primitive * primitive, const CompoundObject * operands, T * colors );
+		template <typename T>
+		void transformSpans( const CompoundObject * operands, T *r, T *g, T *b, size_t stride, size_t n, const T *alpha );
+
+		template<typename T>
+		class TransformSpans;
 
 		StringParameterPtr m_colorPrimVarParameter;
 		StringParameterPtr m_redPrimVarParameter;
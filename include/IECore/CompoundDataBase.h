@@ -38,12 +38,16 @@
 #include <map>
 
 #include "IECore/TypedData.h"
+#include "IECore/FlatMap.h"
 
 namespace IECore
 {
 
-/// The type of Data held by the CompoundData typedef.
-typedef std::map< InternedString, DataPtr > CompoundDataMap;
+/// The type of Data held by the CompoundData typedef. This is a FlatMap
+/// rather than a std::map, as CompoundData typically holds only a handful
+/// of members and is copied, hashed and compared far more often than it
+/// is modified.
+typedef FlatMap< InternedString, DataPtr > CompoundDataMap;
 /// A subclass of Data which stores a map of other named Data
 /// objects - a CompoundDataMap. This is accessible as usual
 /// via the readable() and writable() member functions. Generally you
@@ -37,6 +37,7 @@
 
 #include "IECore/Export.h"
 #include "IECore/Object.h"
+#include "IECore/FlatMap.h"
 
 namespace IECore
 {
@@ -52,7 +53,9 @@ class IECORE_API CompoundObject : public Object
 
 		IE_CORE_DECLAREOBJECT( CompoundObject, Object );
 
-		typedef std::map<InternedString, ObjectPtr> ObjectMap;
+		/// A FlatMap rather than a std::map - see the FlatMap
+		/// documentation for the differences between the two.
+		typedef FlatMap<InternedString, ObjectPtr> ObjectMap;
 
 		/// Gives const access to the member object map.
 		const ObjectMap &members() const;
@@ -59,6 +59,9 @@ class IECORE_API CompressSmoothSkinningDataOp : public ModifyOp
 
 	private :
 
+		struct CountWeights;
+		struct CompressPoints;
+
 		FloatParameterPtr m_thresholdParameter;
 
 };
@@ -39,6 +39,7 @@
 
 #include "IECore/LRUCache.h"
 #include "IECore/ObjectPool.h"
+#include "IECore/DiskObjectCache.h"
 
 namespace IECore
 {
@@ -46,6 +47,9 @@ namespace IECore
 /// LRUCache for generic computation that results on Object derived classes. It uses ObjectPool for the storage and retrieval of 
 /// the computation results, and internally it only holds a map of computationHash to objectHash. The get functions will return the resulting 
 /// Object, which should be copied prior to modification. The retrieve function will only query the cache and not force computation.
+/// An optional DiskObjectCache may be supplied as a persistent second level store, in which case results are also written to disk
+/// indexed by their computation hash, and are loaded from there in preference to recomputing them. This allows expensive results
+/// to be shared between processes.
 template< typename T >
 class ComputationCache : public RefCounted
 {
@@ -62,14 +66,17 @@ class ComputationCache : public RefCounted
 		/// \param hashFn Functor that should compute a unique hash from the templated parameters identifying the computation result.
 		/// \param maxResults Limits the number of computation results this cache will hold.
 		/// \param objectPool Allows overriding the ObjectPool instance to be used for holding the resulting computed objects.
-		ComputationCache( ComputeFn computeFn, HashFn hashFn, size_t maxResults = 10000, ObjectPoolPtr objectPool = ObjectPool::defaultObjectPool() );
+		/// \param diskCache Optional persistent store consulted before calling the compute function.
+		ComputationCache( ComputeFn computeFn, HashFn hashFn, size_t maxResults = 10000, ObjectPoolPtr objectPool = ObjectPool::defaultObjectPool(), DiskObjectCachePtr diskCache = 0 );
 
 		virtual ~ComputationCache();
 
-		/// Removes all the stored computation information from the cache.
+		/// Removes all the stored computation information from the cache. Results held
+		/// in the DiskObjectCache are left intact, since they may be shared by other processes.
 		void clear();
 
-		/// Removes stored information about a specific computation result.
+		/// Removes stored information about a specific computation result, including
+		/// any copy held in the DiskObjectCache.
 		void erase( const T &args );
 
 		/// Returns the maximum number of stored computations in the cache.
@@ -88,7 +95,7 @@ class ComputationCache : public RefCounted
 			ComputeIfMissing
 		} MissingBehaviour;
 
-		/// Returns the computation results if available on the cache, otherwise behaves 
+		/// Returns the computation results if available on the cache or the DiskObjectCache, otherwise behaves 
 		/// according to the missingBehavior parameter explained below:
 		/// ThrowIfMissing: Throws an Exception.
 		/// NullIfMissing: Returns NULL pointer.
@@ -101,6 +108,9 @@ class ComputationCache : public RefCounted
 		/// Returns the ObjectPool object used by this computation cache.
 		ObjectPool *objectPool() const;
 
+		/// Returns the DiskObjectCache used by this computation cache, or NULL if there is none.
+		DiskObjectCache *diskCache() const;
+
 	private :
 
 		ComputeFn m_computeFn;
@@ -110,6 +120,9 @@ class ComputationCache : public RefCounted
 		Cache m_cache;
 
 		ObjectPoolPtr m_objectPool;
+		DiskObjectCachePtr m_diskCache;
+
+		ConstObjectPtr retrieveFromDisk( const MurmurHash &computationHash );
 
 		static MurmurHash cacheGetter( const MurmurHash &h, size_t &cost );
 };
@@ -41,8 +41,8 @@ namespace IECore
 {
 
 template< typename T >
-ComputationCache<T>::ComputationCache( ComputeFn computeFn, HashFn hashFn, size_t maxResults, ObjectPoolPtr objectPool ) : 
-	m_computeFn(computeFn), m_hashFn(hashFn), m_cache( &ComputationCache<T>::cacheGetter, maxResults), m_objectPool(objectPool)
+ComputationCache<T>::ComputationCache( ComputeFn computeFn, HashFn hashFn, size_t maxResults, ObjectPoolPtr objectPool, DiskObjectCachePtr diskCache ) : 
+	m_computeFn(computeFn), m_hashFn(hashFn), m_cache( &ComputationCache<T>::cacheGetter, maxResults), m_objectPool(objectPool), m_diskCache(diskCache)
 {
 }
 
@@ -62,6 +62,10 @@ void ComputationCache<T>::erase( const T &args )
 {
 	MurmurHash computationHash = m_hashFn(args);
 	m_cache.erase( computationHash );
+	if ( m_diskCache )
+	{
+		m_diskCache->erase( computationHash );
+	}
 }
 
 template< typename T >
@@ -91,7 +95,13 @@ ConstObjectPtr ComputationCache<T>::get( const T &args, ComputationCache::Missin
 
 	if ( objectHash == MurmurHash() )
 	{
-		/// don't know the computation hash... check the missing behaviour
+		/// don't know the computation hash... see if another process left the result on disk
+		obj = retrieveFromDisk( computationHash );
+		if ( obj )
+		{
+			return obj;
+		}
+		/// not there either... check the missing behaviour
 		if ( missingBehaviour == ThrowIfMissing )
 		{
 			throw Exception( "Computation not available in the cache!" );
@@ -105,6 +115,10 @@ ConstObjectPtr ComputationCache<T>::get( const T &args, ComputationCache::Missin
 		{
 			m_cache.set( computationHash, obj->hash(), 1 );
 			obj = m_objectPool->store( obj.get(), ObjectPool::StoreReference );
+			if ( m_diskCache )
+			{
+				m_diskCache->store( computationHash, obj.get() );
+			}
 		}
 	}
 	else
@@ -112,7 +126,11 @@ ConstObjectPtr ComputationCache<T>::get( const T &args, ComputationCache::Missin
 		obj = m_objectPool->retrieve(objectHash);
 		if ( !obj )
 		{
-			/// the computation result was not in the object pool.... check the missing behavour
+			obj = retrieveFromDisk( computationHash );
+		}
+		if ( !obj )
+		{
+			/// the computation result was not in the object pool or on disk.... check the missing behavour
 			if ( missingBehaviour == ThrowIfMissing )
 			{
 				throw Exception( "Computation result not available in the cache!" );
@@ -132,6 +150,10 @@ ConstObjectPtr ComputationCache<T>::get( const T &args, ComputationCache::Missin
 					m_cache.set( computationHash, h, 1 );	
 					msg( Msg::Warning, "ComputationCache::get", "Inconsistent hash detected." );
 				}
+				if ( m_diskCache )
+				{
+					m_diskCache->store( computationHash, obj.get() );
+				}
 			}
 		}
 	}
@@ -146,6 +168,10 @@ void ComputationCache<T>::set( const T &args, const Object *obj, StoreMode store
 	{
 		m_objectPool->store(obj, storeMode);
 		m_cache.set( computationHash, obj->hash(), 1 );
+		if ( m_diskCache )
+		{
+			m_diskCache->store( computationHash, obj );
+		}
 	}
 }
 
@@ -162,6 +188,29 @@ ObjectPool *ComputationCache<T>::objectPool() const
 	return m_objectPool.get();
 }
 
+template< typename T >
+DiskObjectCache *ComputationCache<T>::diskCache() const
+{
+	return m_diskCache.get();
+}
+
+template< typename T >
+ConstObjectPtr ComputationCache<T>::retrieveFromDisk( const MurmurHash &computationHash )
+{
+	if ( !m_diskCache )
+	{
+		return 0;
+	}
+	ObjectPtr obj = m_diskCache->retrieve( computationHash );
+	if ( !obj )
+	{
+		return 0;
+	}
+	ConstObjectPtr result = m_objectPool->store( obj.get(), ObjectPool::StoreReference );
+	m_cache.set( computationHash, result->hash(), 1 );
+	return result;
+}
+
 } // namespace IECore
 
 #endif // IECORE_COMPUTATIONCACHE_H
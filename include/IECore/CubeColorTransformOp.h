@@ -42,6 +42,7 @@
 #include "IECore/CubeColorLookupData.h"
 #include "IECore/CubeColorLookupParameter.h"
 #include "IECore/ColorTransformOp.h"
+#include "IECore/ModifyOp.h"
 #include "IECore/Parameter.h"
 #include "IECore/NumericParameter.h"
 #include "IECore/Object.h"
@@ -50,6 +51,8 @@
 namespace IECore
 {
 
+/// The CubeColorTransformOp transforms colors using an interpolated lookup
+/// into a CubeColorLookup.
 /// \ingroup imageProcessingGroup
 class IECORE_API CubeColorTransformOp : public ColorTransformOp
 {
@@ -63,11 +66,27 @@ class IECORE_API CubeColorTransformOp : public ColorTransformOp
 		CubeColorLookupfParameter * cubeParameter();
 		const CubeColorLookupfParameter * cubeParameter() const;
 
+		/// Returns a lookup which approximates the effect of applying the given ops in
+		/// sequence, so that a chain of color conversions may be performed in a single
+		/// pass by a CubeColorTransformOp. Each op may be any ModifyOp which operates on
+		/// the "R", "G" and "B" channels of an ImagePrimitive, such as a ColorTransformOp,
+		/// ChannelOp or ColorSpaceTransformOp, and is applied using its current parameter
+		/// values. If tolerance is not negative, the lookup is compared against the ops
+		/// themselves for a set of random colors within the domain, and an Exception is
+		/// thrown if the error in any channel exceeds the tolerance.
+		static CubeColorLookupfDataPtr bake(
+			const std::vector<ModifyOpPtr> &ops,
+			const Imath::V3i &dimension = Imath::V3i( 33 ),
+			const Imath::Box3f &domain = Imath::Box3f( Imath::V3f( 0 ), Imath::V3f( 1 ) ),
+			float tolerance = -1.0f
+		);
+
 	protected :
 
 		virtual void begin( const CompoundObject * operands );
 
 		virtual void transform( Imath::Color3f &color ) const ;
+		virtual void transformSpan( float *r, float *g, float *b, size_t n ) const;
 
 	private :
 
@@ -79,10 +79,10 @@ class IECORE_API DPXImageReader : public ImageReader
 		/// If throwOnFailure is true then a descriptive Exception is thrown rather than false being returned.
 		bool open( bool throwOnFailure = false );
 
-		/// DPX image memory buffer - cineon image data is typically found in pixel-interlaced
-		/// format, so we will make one I/O pass and cache the image in memory while striping
-		/// off channels / planes
-		std::vector<unsigned int> m_buffer;
+		/// Cineon image data is typically found in pixel-interlaced format, so we read blocks
+		/// of scanlines (via the block cache shared by all ImageReaders), striping off the
+		/// channels from them.
+		virtual DataPtr decodeBlock( unsigned int blockIndex );
 
 		/// the filename in effect when we filled the buffer last.
 		std::string m_bufferFileName;
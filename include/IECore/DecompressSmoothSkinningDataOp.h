@@ -56,6 +56,10 @@ class IECORE_API DecompressSmoothSkinningDataOp : public ModifyOp
 
 		virtual void modify( Object *object, const CompoundObject *operands );
 
+	private :
+
+		struct DecompressPoints;
+
 };
 
 IE_CORE_DECLAREPTR( DecompressSmoothSkinningDataOp );
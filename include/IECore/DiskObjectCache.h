@@ -0,0 +1,119 @@
+//////////////////////////////////////////////////////////////////////////
+//
+//  Copyright (c) 2014, Image Engine Design Inc. All rights reserved.
+//
+//  Redistribution and use in source and binary forms, with or without
+//  modification, are permitted provided that the following conditions are
+//  met:
+//
+//     * Redistributions of source code must retain the above copyright
+//       notice, this list of conditions and the following disclaimer.
+//
+//     * Redistributions in binary form must reproduce the above copyright
+//       notice, this list of conditions and the following disclaimer in the
+//       documentation and/or other materials provided with the distribution.
+//
+//     * Neither the name of Image Engine Design nor the names of any
+//       other contributors to this software may be used to endorse or
+//       promote products derived from this software without specific prior
+//       written permission.
+//
+//  THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS
+//  IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO,
+//  THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR
+//  PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER OR
+//  CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+//  EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+//  PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR
+//  PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF
+//  LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING
+//  NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+//  SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+//
+//////////////////////////////////////////////////////////////////////////
+
+
+#ifndef IECORE_DISKOBJECTCACHE_H
+#define IECORE_DISKOBJECTCACHE_H
+
+#include "boost/shared_ptr.hpp"
+
+#include "IECore/Export.h"
+#include "IECore/Object.h"
+#include "IECore/MurmurHash.h"
+
+namespace IECore
+{
+
+IE_CORE_FORWARDDECLARE( DiskObjectCache );
+
+/// The DiskObjectCache class stores Object instances in a directory on disk, indexed by an
+/// arbitrary MurmurHash key, and limited by the total size of the files in that directory.
+/// It is intended as a persistent second level store behind an in-memory cache such as
+/// ComputationCache, so that results computed by one process may be reused by any other
+/// process with access to the same directory.
+///
+/// Each Object is held in its own FileIndexedIO file. Files are written under a temporary
+/// name and then renamed into place, so concurrent readers in other processes will only ever
+/// see complete entries. The modification time of a file is refreshed whenever it is
+/// retrieved, and when the size limit is exceeded the least recently used files are removed.
+/// Because many processes may share the directory the limit is only enforced approximately.
+///
+/// \ingroup utilityGroup
+class IECORE_API DiskObjectCache : public RefCounted
+{
+	public:
+
+		IE_CORE_DECLAREMEMBERPTR( DiskObjectCache );
+
+		/// Creates a cache storing files in the given directory, which is created
+		/// if it doesn't exist already. The maxDiskUsage is specified in bytes.
+		DiskObjectCache( const std::string &directory, size_t maxDiskUsage );
+		virtual ~DiskObjectCache();
+
+		/// Returns the directory holding the cache files.
+		const std::string &directory() const;
+
+		/// Removes all the files held in the cache directory.
+		void clear();
+
+		/// Erases the Object stored with the given key. Returns whether any item was removed.
+		bool erase( const MurmurHash &key );
+
+		/// Set the maximum size in bytes of the files held in the cache, discarding files if necessary.
+		void setMaxDiskUsage( size_t maxDiskUsage );
+
+		/// Get the maximum size in bytes of the files held in the cache.
+		size_t getMaxDiskUsage() const;
+
+		/// Returns the current size in bytes of the files held in the cache. This
+		/// scans the cache directory and is therefore relatively expensive.
+		size_t diskUsage() const;
+
+		/// Returns true if an Object is stored with the given key.
+		/// Note: this function doesn't guarantee that retrieve() will return an object, because
+		/// the entry may be removed by another thread or process in the meantime.
+		bool contains( const MurmurHash &key ) const;
+
+		/// Loads the Object stored with the given key, or returns NULL if it is not held in the cache.
+		/// Unreadable entries are treated as missing.
+		ObjectPtr retrieve( const MurmurHash &key ) const;
+
+		/// Saves the object to disk with the given key, replacing any previous entry, and then
+		/// removes the least recently used entries if the cache has grown beyond its limit.
+		/// Failures to write are reported with msg() rather than by throwing, since the cache
+		/// is only ever an optimisation.
+		void store( const MurmurHash &key, const Object *obj );
+
+	private:
+
+		std::string fileName( const MurmurHash &key ) const;
+		void prune( size_t targetUsage );
+
+		struct MemberData;
+		boost::shared_ptr<MemberData> m_data;
+};
+
+} // namespace IECore
+
+#endif // IECORE_DISKOBJECTCACHE_H
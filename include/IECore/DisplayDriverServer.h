@@ -52,7 +52,8 @@ namespace IECore
 /// Server class that receives images from ClientDisplayDriver connections and forwards the data to local display drivers.
 /// The type of the local display drivers is defined by the 'remoteDisplayType' parameter.
 /// 
-/// The server object creates a thread to control the socket connection. The thread dies when the object is destroyed.
+/// The server object creates a pool of threads to service the socket connections, so that many
+/// clients may stream data concurrently. The threads die when the object is destroyed.
 /// \ingroup renderingGroup
 class IECORE_API DisplayDriverServer : public RunTimeTyped
 {
@@ -60,7 +61,9 @@ class IECORE_API DisplayDriverServer : public RunTimeTyped
 
 		IE_CORE_DECLARERUNTIMETYPED( DisplayDriverServer, RunTimeTyped );
 
-		DisplayDriverServer( int portNumber );
+		/// Creates a server listening on portNumber. Sessions are serviced by numThreads
+		/// threads, and a value of 0 uses one thread per hardware core.
+		DisplayDriverServer( int portNumber, int numThreads = 0 );
 		virtual ~DisplayDriverServer();
 
 	private:
@@ -38,6 +38,7 @@
 #include "IECore/Export.h"
 #include "IECore/ImageWriter.h"
 #include "IECore/NumericParameter.h"
+#include "IECore/SimpleTypedParameter.h"
 
 // ILM
 #include "OpenEXR/Iex.h"
@@ -71,6 +72,38 @@ class IECORE_API EXRImageWriter : public ImageWriter
 		IntParameter * compressionParameter();
 		const IntParameter * compressionParameter() const;
 
+		/// When on, the image is written as a tiled file rather than
+		/// as scanlines.
+		BoolParameter * tiledParameter();
+		const BoolParameter * tiledParameter() const;
+
+		V2iParameter * tileSizeParameter();
+		const V2iParameter * tileSizeParameter() const;
+
+		/// Chooses between a single resolution, mip-mapped or rip-mapped
+		/// tiled file. The reduced resolution levels are computed by box
+		/// filtering the image. Ignored unless tiledParameter() is on.
+		IntParameter * levelModeParameter();
+		const IntParameter * levelModeParameter() const;
+
+		/// The number of threads used by OpenEXR to compress the file.
+		/// A value of 0 uses all the threads in OpenEXR's global thread
+		/// pool, and a value of 1 compresses in the calling thread only.
+		/// Compression can only be parallel if the global pool has been
+		/// given some threads with setGlobalThreadCount().
+		IntParameter * numThreadsParameter();
+		const IntParameter * numThreadsParameter() const;
+
+		//! @name Global thread pool
+		/// OpenEXR performs compression and decompression using a global
+		/// pool of threads, which is empty by default. These functions size
+		/// that pool. Note that it is shared by everything using OpenEXR in
+		/// the process, including the EXR readers, and any host application.
+		//@{
+		static void setGlobalThreadCount( int count );
+		static int getGlobalThreadCount();
+		//@}
+
 	private:
 
 		void constructCommon();
@@ -81,12 +114,6 @@ class IECORE_API EXRImageWriter : public ImageWriter
 		                        const ImagePrimitive * image,
 		                        const Imath::Box2i &dw) const;
 
-		template<typename T>
-		void writeTypedChannel(const char *name,
-		                       const Imath::Box2i &dw, const std::vector<T> &channel,
-		                       const Imf::PixelType TYPE, Imf::Header &header,
-		                       Imf::FrameBuffer &fb) const;
-
 };
 
 IE_CORE_DECLAREPTR(EXRImageWriter);
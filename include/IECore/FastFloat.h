@@ -51,6 +51,14 @@ IECORE_API inline int fastFloatRound(double v);
 IECORE_API inline int fastFloatFloor(double v);
 IECORE_API inline int fastFloatCeil(double v);
 
+/// Approximations to log2( x ), 2^x and x^y, accurate to a relative error of
+/// around 1e-6 for normalised floats and to 1e-5 for fastFloatPow(). They are
+/// only defined for x > 0, and are intended for use in the inner loops of
+/// per-pixel conversions, where they can be vectorised by the compiler.
+IECORE_API inline float fastFloatLog2( float x );
+IECORE_API inline float fastFloatExp2( float x );
+IECORE_API inline float fastFloatPow( float x, float y );
+
 } // namespace IECore
 
 #include "IECore/FastFloat.inl"
@@ -37,6 +37,13 @@
 
 namespace IECore
 {
+
+union FastFloatFloatInt
+{
+	float f;
+	int i;
+};
+
 #define IECORE_DOUBLEMAGICROUNDEPS	(.5-1.4e-11)
 
 #if (defined(__linux__) && ( defined(__i386__) || defined(__x86_64__) ) ) || defined(WIN32)
@@ -70,12 +77,6 @@ namespace IECore
 		return fastFloatRound( v + IECORE_DOUBLEMAGICROUNDEPS );
 	}
 
-	union FastFloatFloatInt
-	{
-		float f;
-		int i;
-	};
-
 	// From: http://www.beyond3d.com/articles/fastinvsqrt/
 	inline float fastFloatInvSqrt( float x )
 	{
@@ -118,6 +119,42 @@ namespace IECore
 	
 #endif
 
+// The mantissa is mapped to [ sqrt( 0.5 ), sqrt( 2 ) ) and log2 evaluated using
+// the series for atanh, which converges quickly over that interval. There are no
+// data dependent branches, so loops calling this can be vectorised by the compiler.
+inline float fastFloatLog2( float x )
+{
+	FastFloatFloatInt u;
+	u.f = x;
+	int e = ( ( u.i >> 23 ) & 0xff ) - 127;
+	u.i = ( u.i & 0x007fffff ) | 0x3f800000;
+	float m = u.f;
+	const bool high = m > 1.41421356f;
+	m = high ? m * 0.5f : m;
+	e = high ? e + 1 : e;
+	const float t = ( m - 1.0f ) / ( m + 1.0f );
+	const float t2 = t * t;
+	return t * ( 2.88539008f + t2 * ( 0.961796694f + t2 * ( 0.577078016f + t2 * ( 0.412198583f + t2 * 0.320598898f ) ) ) ) + (float)e;
+}
+
+// The integer part of x goes straight into the exponent, and the remaining
+// fraction in [ -0.5, 0.5 ] is evaluated with a polynomial.
+inline float fastFloatExp2( float x )
+{
+	x = x < -125.0f ? -125.0f : ( x > 127.0f ? 127.0f : x );
+	const int i = (int)( x + 127.5f ) - 127;
+	const float f = ( x - (float)i ) * 0.693147181f;
+	FastFloatFloatInt u;
+	u.f = 1.0f + f * ( 1.0f + f * ( 0.5f + f * ( 0.166666667f + f * ( 0.0416666667f + f * ( 0.00833333333f + f * 0.00138888889f ) ) ) ) );
+	u.i += i << 23;
+	return u.f;
+}
+
+inline float fastFloatPow( float x, float y )
+{
+	return fastFloatExp2( y * fastFloatLog2( x ) );
+}
+
 } // namespace IECore
 
 #endif // IE_CORE_FASTFLOAT_INL
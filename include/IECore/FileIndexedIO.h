@@ -61,6 +61,18 @@ class IECORE_API FileIndexedIO : public StreamIndexedIO
 		/// Returns the full file name accessed by this object.
 		const std::string &fileName() const;
 
+		/// Files opened for reading share a budget of open file handles. When it is
+		/// exceeded, the handles of the least recently used files are closed - their
+		/// indices are kept in memory, and their handles reopened transparently when
+		/// they are next read from, so a closed file is cheap to use again.
+		static void setMaxOpenFiles( size_t maxOpenFiles );
+		static size_t getMaxOpenFiles();
+		/// Returns the number of files with a handle currently open for reading.
+		static size_t numOpenFiles();
+		/// Returns the number of times a handle closed to stay within budget has
+		/// been reopened.
+		static size_t numReopens();
+
 	protected:
 
 		FileIndexedIO();
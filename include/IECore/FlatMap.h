@@ -0,0 +1,192 @@
+//////////////////////////////////////////////////////////////////////////
+//
+//  Copyright (c) 2013, Image Engine Design Inc. All rights reserved.
+//
+//  Redistribution and use in source and binary forms, with or without
+//  modification, are permitted provided that the following conditions are
+//  met:
+//
+//     * Redistributions of source code must retain the above copyright
+//       notice, this list of conditions and the following disclaimer.
+//
+//     * Redistributions in binary form must reproduce the above copyright
+//       notice, this list of conditions and the following disclaimer in the
+//       documentation and/or other materials provided with the distribution.
+//
+//     * Neither the name of Image Engine Design nor the names of any
+//       other contributors to this software may be used to endorse or
+//       promote products derived from this software without specific prior
+//       written permission.
+//
+//  THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS
+//  IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO,
+//  THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR
+//  PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER OR
+//  CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+//  EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+//  PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR
+//  PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF
+//  LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING
+//  NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+//  SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+//
+//////////////////////////////////////////////////////////////////////////
+
+
+#ifndef IECORE_FLATMAP_H
+#define IECORE_FLATMAP_H
+
+#include <vector>
+#include <utility>
+#include <functional>
+
+namespace IECore
+{
+
+/// An associative container with the same interface as std::map, but which
+/// stores its elements in a sorted std::vector rather than in a tree of
+/// individually allocated nodes. This makes it much cheaper to construct, copy,
+/// iterate and destroy, and gives faster lookups for small numbers of elements,
+/// at the expense of linear time insertion and erasure. It is therefore a
+/// good choice for the many small maps held by CompoundObject and CompoundData.
+///
+/// The main differences from std::map are as follows :
+///
+/// - Insertion and erasure invalidate all iterators and references to elements.
+/// - The value_type is std::pair<Key, T> rather than std::pair<const Key, T>.
+/// - The capacity may be managed using reserve().
+/// \ingroup utilityGroup
+template<typename Key, typename T, typename Compare = std::less<Key> >
+class FlatMap
+{
+
+	public :
+
+		typedef Key key_type;
+		typedef T mapped_type;
+		typedef std::pair<Key, T> value_type;
+		typedef Compare key_compare;
+
+	private :
+
+		typedef std::vector<value_type> Container;
+
+	public :
+
+		typedef typename Container::size_type size_type;
+		typedef typename Container::difference_type difference_type;
+		typedef typename Container::reference reference;
+		typedef typename Container::const_reference const_reference;
+		typedef typename Container::pointer pointer;
+		typedef typename Container::const_pointer const_pointer;
+		typedef typename Container::iterator iterator;
+		typedef typename Container::const_iterator const_iterator;
+		typedef typename Container::reverse_iterator reverse_iterator;
+		typedef typename Container::const_reverse_iterator const_reverse_iterator;
+
+		FlatMap( const Compare &compare = Compare() );
+		template<typename InputIterator>
+		FlatMap( InputIterator first, InputIterator last, const Compare &compare = Compare() );
+
+		//! @name Iterators
+		////////////////////////////////////////////
+		//@{
+		iterator begin();
+		const_iterator begin() const;
+		iterator end();
+		const_iterator end() const;
+		reverse_iterator rbegin();
+		const_reverse_iterator rbegin() const;
+		reverse_iterator rend();
+		const_reverse_iterator rend() const;
+		//@}
+
+		//! @name Capacity
+		////////////////////////////////////////////
+		//@{
+		bool empty() const;
+		size_type size() const;
+		size_type max_size() const;
+		size_type capacity() const;
+		void reserve( size_type n );
+		//@}
+
+		//! @name Modifiers
+		////////////////////////////////////////////
+		//@{
+		T &operator[]( const Key &key );
+		std::pair<iterator, bool> insert( const value_type &value );
+		/// Inserts value, using position as a hint for the insertion point.
+		/// Appending elements in sorted order with end() as the hint takes
+		/// constant time.
+		iterator insert( iterator position, const value_type &value );
+		/// Inserts the elements of the range whose keys aren't already present.
+		/// The range is sorted and merged in one go, so need not be sorted itself,
+		/// and doesn't cost a separate insertion per element.
+		template<typename InputIterator>
+		void insert( InputIterator first, InputIterator last );
+		/// Returns an iterator to the element following the erased one.
+		iterator erase( iterator position );
+		size_type erase( const Key &key );
+		iterator erase( iterator first, iterator last );
+		void swap( FlatMap &other );
+		void clear();
+		//@}
+
+		//! @name Lookup
+		////////////////////////////////////////////
+		//@{
+		iterator find( const Key &key );
+		const_iterator find( const Key &key ) const;
+		size_type count( const Key &key ) const;
+		iterator lower_bound( const Key &key );
+		const_iterator lower_bound( const Key &key ) const;
+		iterator upper_bound( const Key &key );
+		const_iterator upper_bound( const Key &key ) const;
+		std::pair<iterator, iterator> equal_range( const Key &key );
+		std::pair<const_iterator, const_iterator> equal_range( const Key &key ) const;
+		key_compare key_comp() const;
+		//@}
+
+		bool operator == ( const FlatMap &other ) const;
+		bool operator != ( const FlatMap &other ) const;
+		bool operator < ( const FlatMap &other ) const;
+
+	private :
+
+		// Compares elements against keys and each other, for use with
+		// the std binary search and sorting algorithms.
+		struct ValueCompare
+		{
+			ValueCompare( const Compare &compare );
+			bool operator()( const value_type &value, const Key &key ) const;
+			bool operator()( const Key &key, const value_type &value ) const;
+			bool operator()( const value_type &value1, const value_type &value2 ) const;
+			Compare compare;
+		};
+
+		// Tests elements for equivalent keys, for use with std::unique().
+		struct ValueEquivalent
+		{
+			ValueEquivalent( const Compare &compare );
+			bool operator()( const value_type &value1, const value_type &value2 ) const;
+			Compare compare;
+		};
+
+		// Below this size lower_bound() uses a linear search, which
+		// is faster than a binary one for a handful of elements.
+		static const size_type m_linearSearchSize = 8;
+
+		Container m_values;
+		Compare m_compare;
+
+};
+
+template<typename Key, typename T, typename Compare>
+void swap( FlatMap<Key, T, Compare> &a, FlatMap<Key, T, Compare> &b );
+
+} // namespace IECore
+
+#include "IECore/FlatMap.inl"
+
+#endif // IECORE_FLATMAP_H
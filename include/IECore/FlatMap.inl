@@ -0,0 +1,390 @@
+//////////////////////////////////////////////////////////////////////////
+//
+//  Copyright (c) 2013, Image Engine Design Inc. All rights reserved.
+//
+//  Redistribution and use in source and binary forms, with or without
+//  modification, are permitted provided that the following conditions are
+//  met:
+//
+//     * Redistributions of source code must retain the above copyright
+//       notice, this list of conditions and the following disclaimer.
+//
+//     * Redistributions in binary form must reproduce the above copyright
+//       notice, this list of conditions and the following disclaimer in the
+//       documentation and/or other materials provided with the distribution.
+//
+//     * Neither the name of Image Engine Design nor the names of any
+//       other contributors to this software may be used to endorse or
+//       promote products derived from this software without specific prior
+//       written permission.
+//
+//  THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS
+//  IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO,
+//  THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR
+//  PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER OR
+//  CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+//  EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+//  PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR
+//  PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF
+//  LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING
+//  NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+//  SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+//
+//////////////////////////////////////////////////////////////////////////
+
+
+#ifndef IECORE_FLATMAP_INL
+#define IECORE_FLATMAP_INL
+
+#include <algorithm>
+
+namespace IECore
+{
+
+template<typename Key, typename T, typename Compare>
+FlatMap<Key, T, Compare>::ValueCompare::ValueCompare( const Compare &c )
+	:	compare( c )
+{
+}
+
+template<typename Key, typename T, typename Compare>
+inline bool FlatMap<Key, T, Compare>::ValueCompare::operator()( const value_type &value, const Key &key ) const
+{
+	return compare( value.first, key );
+}
+
+template<typename Key, typename T, typename Compare>
+inline bool FlatMap<Key, T, Compare>::ValueCompare::operator()( const Key &key, const value_type &value ) const
+{
+	return compare( key, value.first );
+}
+
+template<typename Key, typename T, typename Compare>
+inline bool FlatMap<Key, T, Compare>::ValueCompare::operator()( const value_type &value1, const value_type &value2 ) const
+{
+	return compare( value1.first, value2.first );
+}
+
+template<typename Key, typename T, typename Compare>
+FlatMap<Key, T, Compare>::ValueEquivalent::ValueEquivalent( const Compare &c )
+	:	compare( c )
+{
+}
+
+template<typename Key, typename T, typename Compare>
+inline bool FlatMap<Key, T, Compare>::ValueEquivalent::operator()( const value_type &value1, const value_type &value2 ) const
+{
+	return !compare( value1.first, value2.first ) && !compare( value2.first, value1.first );
+}
+
+template<typename Key, typename T, typename Compare>
+FlatMap<Key, T, Compare>::FlatMap( const Compare &compare )
+	:	m_compare( compare )
+{
+}
+
+template<typename Key, typename T, typename Compare>
+template<typename InputIterator>
+FlatMap<Key, T, Compare>::FlatMap( InputIterator first, InputIterator last, const Compare &compare )
+	:	m_compare( compare )
+{
+	insert( first, last );
+}
+
+template<typename Key, typename T, typename Compare>
+inline typename FlatMap<Key, T, Compare>::iterator FlatMap<Key, T, Compare>::begin()
+{
+	return m_values.begin();
+}
+
+template<typename Key, typename T, typename Compare>
+inline typename FlatMap<Key, T, Compare>::const_iterator FlatMap<Key, T, Compare>::begin() const
+{
+	return m_values.begin();
+}
+
+template<typename Key, typename T, typename Compare>
+inline typename FlatMap<Key, T, Compare>::iterator FlatMap<Key, T, Compare>::end()
+{
+	return m_values.end();
+}
+
+template<typename Key, typename T, typename Compare>
+inline typename FlatMap<Key, T, Compare>::const_iterator FlatMap<Key, T, Compare>::end() const
+{
+	return m_values.end();
+}
+
+template<typename Key, typename T, typename Compare>
+inline typename FlatMap<Key, T, Compare>::reverse_iterator FlatMap<Key, T, Compare>::rbegin()
+{
+	return m_values.rbegin();
+}
+
+template<typename Key, typename T, typename Compare>
+inline typename FlatMap<Key, T, Compare>::const_reverse_iterator FlatMap<Key, T, Compare>::rbegin() const
+{
+	return m_values.rbegin();
+}
+
+template<typename Key, typename T, typename Compare>
+inline typename FlatMap<Key, T, Compare>::reverse_iterator FlatMap<Key, T, Compare>::rend()
+{
+	return m_values.rend();
+}
+
+template<typename Key, typename T, typename Compare>
+inline typename FlatMap<Key, T, Compare>::const_reverse_iterator FlatMap<Key, T, Compare>::rend() const
+{
+	return m_values.rend();
+}
+
+template<typename Key, typename T, typename Compare>
+inline bool FlatMap<Key, T, Compare>::empty() const
+{
+	return m_values.empty();
+}
+
+template<typename Key, typename T, typename Compare>
+inline typename FlatMap<Key, T, Compare>::size_type FlatMap<Key, T, Compare>::size() const
+{
+	return m_values.size();
+}
+
+template<typename Key, typename T, typename Compare>
+inline typename FlatMap<Key, T, Compare>::size_type FlatMap<Key, T, Compare>::max_size() const
+{
+	return m_values.max_size();
+}
+
+template<typename Key, typename T, typename Compare>
+inline typename FlatMap<Key, T, Compare>::size_type FlatMap<Key, T, Compare>::capacity() const
+{
+	return m_values.capacity();
+}
+
+template<typename Key, typename T, typename Compare>
+inline void FlatMap<Key, T, Compare>::reserve( size_type n )
+{
+	m_values.reserve( n );
+}
+
+template<typename Key, typename T, typename Compare>
+T &FlatMap<Key, T, Compare>::operator[]( const Key &key )
+{
+	iterator it = lower_bound( key );
+	if( it == m_values.end() || m_compare( key, it->first ) )
+	{
+		it = m_values.insert( it, value_type( key, T() ) );
+	}
+	return it->second;
+}
+
+template<typename Key, typename T, typename Compare>
+std::pair<typename FlatMap<Key, T, Compare>::iterator, bool> FlatMap<Key, T, Compare>::insert( const value_type &value )
+{
+	iterator it = lower_bound( value.first );
+	if( it == m_values.end() || m_compare( value.first, it->first ) )
+	{
+		return std::pair<iterator, bool>( m_values.insert( it, value ), true );
+	}
+	return std::pair<iterator, bool>( it, false );
+}
+
+template<typename Key, typename T, typename Compare>
+typename FlatMap<Key, T, Compare>::iterator FlatMap<Key, T, Compare>::insert( iterator position, const value_type &value )
+{
+	// the hint is correct if value belongs between the element
+	// before position and the element at position.
+	if(
+		( position == m_values.begin() || m_compare( (position - 1)->first, value.first ) ) &&
+		( position == m_values.end() || m_compare( value.first, position->first ) )
+	)
+	{
+		return m_values.insert( position, value );
+	}
+	return insert( value ).first;
+}
+
+template<typename Key, typename T, typename Compare>
+template<typename InputIterator>
+void FlatMap<Key, T, Compare>::insert( InputIterator first, InputIterator last )
+{
+	// inserting the elements one at a time would be quadratic in the
+	// number of elements, so instead we append them all, sort them once
+	// and merge them with the existing elements. the sort and merge are
+	// stable, so removing all but the first of each run of equivalent
+	// keys gives the same result as std::map, where existing elements
+	// are kept in preference to new ones, and earlier new elements in
+	// preference to later ones.
+	const size_type oldSize = m_values.size();
+	m_values.insert( m_values.end(), first, last );
+
+	const iterator middle = m_values.begin() + oldSize;
+	std::stable_sort( middle, m_values.end(), ValueCompare( m_compare ) );
+	std::inplace_merge( m_values.begin(), middle, m_values.end(), ValueCompare( m_compare ) );
+	m_values.erase( std::unique( m_values.begin(), m_values.end(), ValueEquivalent( m_compare ) ), m_values.end() );
+}
+
+template<typename Key, typename T, typename Compare>
+inline typename FlatMap<Key, T, Compare>::iterator FlatMap<Key, T, Compare>::erase( iterator position )
+{
+	return m_values.erase( position );
+}
+
+template<typename Key, typename T, typename Compare>
+typename FlatMap<Key, T, Compare>::size_type FlatMap<Key, T, Compare>::erase( const Key &key )
+{
+	iterator it = find( key );
+	if( it == m_values.end() )
+	{
+		return 0;
+	}
+	m_values.erase( it );
+	return 1;
+}
+
+template<typename Key, typename T, typename Compare>
+inline typename FlatMap<Key, T, Compare>::iterator FlatMap<Key, T, Compare>::erase( iterator first, iterator last )
+{
+	return m_values.erase( first, last );
+}
+
+template<typename Key, typename T, typename Compare>
+inline void FlatMap<Key, T, Compare>::swap( FlatMap &other )
+{
+	m_values.swap( other.m_values );
+	std::swap( m_compare, other.m_compare );
+}
+
+template<typename Key, typename T, typename Compare>
+inline void FlatMap<Key, T, Compare>::clear()
+{
+	m_values.clear();
+}
+
+template<typename Key, typename T, typename Compare>
+inline typename FlatMap<Key, T, Compare>::iterator FlatMap<Key, T, Compare>::find( const Key &key )
+{
+	iterator it = lower_bound( key );
+	if( it == m_values.end() || m_compare( key, it->first ) )
+	{
+		return m_values.end();
+	}
+	return it;
+}
+
+template<typename Key, typename T, typename Compare>
+inline typename FlatMap<Key, T, Compare>::const_iterator FlatMap<Key, T, Compare>::find( const Key &key ) const
+{
+	const_iterator it = lower_bound( key );
+	if( it == m_values.end() || m_compare( key, it->first ) )
+	{
+		return m_values.end();
+	}
+	return it;
+}
+
+template<typename Key, typename T, typename Compare>
+inline typename FlatMap<Key, T, Compare>::size_type FlatMap<Key, T, Compare>::count( const Key &key ) const
+{
+	return find( key ) == m_values.end() ? 0 : 1;
+}
+
+template<typename Key, typename T, typename Compare>
+inline typename FlatMap<Key, T, Compare>::iterator FlatMap<Key, T, Compare>::lower_bound( const Key &key )
+{
+	if( m_values.size() <= m_linearSearchSize )
+	{
+		iterator it = m_values.begin();
+		while( it != m_values.end() && m_compare( it->first, key ) )
+		{
+			++it;
+		}
+		return it;
+	}
+	return std::lower_bound( m_values.begin(), m_values.end(), key, ValueCompare( m_compare ) );
+}
+
+template<typename Key, typename T, typename Compare>
+inline typename FlatMap<Key, T, Compare>::const_iterator FlatMap<Key, T, Compare>::lower_bound( const Key &key ) const
+{
+	if( m_values.size() <= m_linearSearchSize )
+	{
+		const_iterator it = m_values.begin();
+		while( it != m_values.end() && m_compare( it->first, key ) )
+		{
+			++it;
+		}
+		return it;
+	}
+	return std::lower_bound( m_values.begin(), m_values.end(), key, ValueCompare( m_compare ) );
+}
+
+template<typename Key, typename T, typename Compare>
+inline typename FlatMap<Key, T, Compare>::iterator FlatMap<Key, T, Compare>::upper_bound( const Key &key )
+{
+	return std::upper_bound( m_values.begin(), m_values.end(), key, ValueCompare( m_compare ) );
+}
+
+template<typename Key, typename T, typename Compare>
+inline typename FlatMap<Key, T, Compare>::const_iterator FlatMap<Key, T, Compare>::upper_bound( const Key &key ) const
+{
+	return std::upper_bound( m_values.begin(), m_values.end(), key, ValueCompare( m_compare ) );
+}
+
+template<typename Key, typename T, typename Compare>
+inline std::pair<typename FlatMap<Key, T, Compare>::iterator, typename FlatMap<Key, T, Compare>::iterator> FlatMap<Key, T, Compare>::equal_range( const Key &key )
+{
+	iterator it = lower_bound( key );
+	if( it == m_values.end() || m_compare( key, it->first ) )
+	{
+		return std::pair<iterator, iterator>( it, it );
+	}
+	return std::pair<iterator, iterator>( it, it + 1 );
+}
+
+template<typename Key, typename T, typename Compare>
+inline std::pair<typename FlatMap<Key, T, Compare>::const_iterator, typename FlatMap<Key, T, Compare>::const_iterator> FlatMap<Key, T, Compare>::equal_range( const Key &key ) const
+{
+	const_iterator it = lower_bound( key );
+	if( it == m_values.end() || m_compare( key, it->first ) )
+	{
+		return std::pair<const_iterator, const_iterator>( it, it );
+	}
+	return std::pair<const_iterator, const_iterator>( it, it + 1 );
+}
+
+template<typename Key, typename T, typename Compare>
+inline typename FlatMap<Key, T, Compare>::key_compare FlatMap<Key, T, Compare>::key_comp() const
+{
+	return m_compare;
+}
+
+template<typename Key, typename T, typename Compare>
+inline bool FlatMap<Key, T, Compare>::operator == ( const FlatMap &other ) const
+{
+	return m_values == other.m_values;
+}
+
+template<typename Key, typename T, typename Compare>
+inline bool FlatMap<Key, T, Compare>::operator != ( const FlatMap &other ) const
+{
+	return m_values != other.m_values;
+}
+
+template<typename Key, typename T, typename Compare>
+inline bool FlatMap<Key, T, Compare>::operator < ( const FlatMap &other ) const
+{
+	return m_values < other.m_values;
+}
+
+template<typename Key, typename T, typename Compare>
+inline void swap( FlatMap<Key, T, Compare> &a, FlatMap<Key, T, Compare> &b )
+{
+	a.swap( b );
+}
+
+} // namespace IECore
+
+#endif // IECORE_FLATMAP_INL
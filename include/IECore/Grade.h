@@ -91,6 +91,7 @@ class IECORE_API Grade : public ColorTransformOp
 		/// initializes temporary values A, B and 1/gamma.
 		virtual void begin( const CompoundObject * operands );
 		virtual void transform( Imath::Color3f &color ) const;
+		virtual void transformSpan( float *r, float *g, float *b, size_t n ) const;
 
 	private :
 
@@ -108,6 +109,8 @@ class IECORE_API Grade : public ColorTransformOp
 		Imath::V3d m_A;
 		Imath::V3d m_B;
 		Imath::V3d m_invGamma;
+		bool m_blackClamp;
+		bool m_whiteClamp;
 };
 
 IE_CORE_DECLAREPTR( Grade );
@@ -39,6 +39,7 @@
 #include "IECore/Op.h"
 #include "IECore/SimpleTypedParameter.h"
 #include "IECore/NumericParameter.h"
+#include "IECore/VectorTypedParameter.h"
 
 namespace IECore
 {
@@ -46,6 +47,8 @@ namespace IECore
 IE_CORE_FORWARDDECLARE( ObjectParameter )
 
 /// The HdrMergeOp merges a set of images with different exposures into a single HDR image.
+/// Pixels are merged in parallel. The images may be provided either in memory, or as files
+/// which are streamed in a block of scanlines at a time.
 /// \todo Take in consideration Alpha channel from input images.
 /// \ingroup imageProcessingGroup
 class IECORE_API HdrMergeOp : public Op
@@ -61,6 +64,15 @@ class IECORE_API HdrMergeOp : public Op
 		ObjectParameter * inputGroupParameter();
 		const ObjectParameter * inputGroupParameter() const;
 
+		/// The Parameter for the names of image files to merge. When
+		/// specified, this takes precedence over the inputGroupParameter().
+		StringVectorParameter * inputFileNamesParameter();
+		const StringVectorParameter * inputFileNamesParameter() const;
+
+		/// The number of scanlines read from each file at a time.
+		IntParameter * scanlinesPerBlockParameter();
+		const IntParameter * scanlinesPerBlockParameter() const;
+
 		FloatParameter * exposureStepParameter();
 		const FloatParameter * exposureStepParameter() const;
 
@@ -77,6 +89,8 @@ class IECORE_API HdrMergeOp : public Op
 	private :
 
 		ObjectParameterPtr m_inputGroupParameter;
+		StringVectorParameterPtr m_inputFileNamesParameter;
+		IntParameterPtr m_scanlinesPerBlockParameter;
 		FloatParameterPtr m_exposureStepParameter;
 		FloatParameterPtr m_exposureAdjustmentParameter;
 		Box2fParameterPtr m_windowingParameter;
@@ -133,6 +133,11 @@ class IECORE_API IFFFile : public RefCounted
 				template<typename T>
 				size_t read( std::vector<Imath::Vec3<T> > &data );
 
+				/// Returns the stream and position of the Chunk data, for readers which
+				/// need only part of it. The data is stored in big endian byte order.
+				std::istream &dataStream();
+				std::streampos dataPosition() const;
+
 			private :
 				
 				Chunk( );
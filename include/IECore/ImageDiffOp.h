@@ -89,6 +89,7 @@ class IECORE_API ImageDiffOp : public Op
 		BoolParameterPtr m_alignDisplayWindowsParameter;
 
 		struct FloatConverter;
+		struct SquaredErrorSum;
 
 };
 
@@ -37,6 +37,7 @@
 
 #include "IECore/Export.h"
 #include "IECore/Reader.h"
+#include "IECore/MurmurHash.h"
 #include "IECore/SimpleTypedParameter.h"
 #include "IECore/VectorTypedParameter.h"
 
@@ -122,6 +123,23 @@ class IECORE_API ImageReader : public Reader
 
 		//@}
 
+		//! @name Block cache
+		/// Readers for formats which allow random access decode only the
+		/// strips, tiles or scanlines which overlap the dataWindowParameter(),
+		/// and store the decoded blocks in a cache shared by all ImageReaders.
+		/// This allows crops and repeated reads of large images to be made
+		/// without decoding the whole file each time. Blocks are only ever
+		/// reused by the reader which decoded them, and only until it opens
+		/// another file.
+		///////////////////////////////////////////////////////////////
+		//@{
+		/// Sets the maximum memory (in bytes) used by the block cache.
+		static void setBlockCacheMemoryLimit( size_t bytes );
+		static size_t getBlockCacheMemoryLimit();
+		/// Removes all blocks from the cache.
+		static void clearBlockCache();
+		//@}
+
 	protected:
 
 		/// Fills the passed vector with the intersection of channelNames() and
@@ -131,6 +149,21 @@ class IECORE_API ImageReader : public Reader
 		/// isn't wholly inside the available dataWindow().
 		Imath::Box2i dataWindowToRead();
 
+		/// Returns the block with the specified index from the file currently
+		/// open, calling decodeBlock() to decode it if it isn't in the cache.
+		ConstDataPtr block( unsigned int blockIndex );
+		/// Must be implemented by derived classes which use block(), to decode
+		/// the block with the specified index from the file currently open. The
+		/// default implementation throws.
+		virtual DataPtr decodeBlock( unsigned int blockIndex );
+		/// Must be called by derived classes which use block() whenever they open
+		/// a file, or otherwise change the data that decodeBlock() would return.
+		/// Blocks are shared between all readers of the same type which have opened
+		/// the same file, identified by its name, device, inode, size and modification
+		/// time, with the same decodeParameters. The decodeParameters should therefore
+		/// capture anything other than the file which decodeBlock() depends on.
+		void blockSourceChanged( const MurmurHash &decodeParameters = MurmurHash() );
+
 		/// Implemented using displayWindow(), dataWindow(), channelNames() and readChannel().
 		/// Derived classes should implement those methods rather than reimplement this function.
 		virtual ObjectPtr doOperation( const CompoundObject *operands );
@@ -148,6 +181,15 @@ class IECORE_API ImageReader : public Reader
 		StringVectorParameterPtr m_channelNamesParameter;
 		BoolParameterPtr m_rawChannelsParameter;
 		StringParameterPtr m_colorspaceParameter;
+
+		// Identifies the blocks decoded since the last call
+		// to blockSourceChanged().
+		MurmurHash m_blockSource;
+
+		struct BlockCacheKey;
+		class BlockCache;
+		static BlockCache *blockCache();
+
 };
 
 IE_CORE_DECLAREPTR(ImageReader);
@@ -86,10 +86,16 @@ class InverseDistanceWeightedInterpolation
 		/// reusing the same NeighbourVector than it is to call the version above, which
 		/// has to allocate a NeighbourVector each time.
 		Value operator()( const Point &p, NeighbourVector &neighbours ) const;
+		/// Evaluates the interpolated values for an array of points, resizing result
+		/// to match. The queries are performed in parallel, with each thread reusing
+		/// its own NeighbourVector.
+		void operator()( const std::vector<Point> &points, std::vector<Value> &result ) const;
 
 
 	private :
 
+		struct ParallelQuery;
+
 		Tree *m_tree;
 		PointIterator m_firstPoint;
 		ValueIterator m_firstValue;
@@ -36,6 +36,9 @@
 #include "IECore/VectorOps.h"
 #include "OpenEXR/ImathLimits.h"
 
+#include "tbb/enumerable_thread_specific.h"
+#include "tbb/parallel_for.h"
+
 namespace IECore
 {
 
@@ -111,5 +114,48 @@ typename InverseDistanceWeightedInterpolation<PointIterator, ValueIterator>::Val
 	return result;
 }
 
+template<typename PointIterator, typename ValueIterator>
+struct InverseDistanceWeightedInterpolation<PointIterator, ValueIterator>::ParallelQuery
+{
+
+	typedef tbb::enumerable_thread_specific<NeighbourVector> ThreadNeighbours;
+
+	ParallelQuery( const InverseDistanceWeightedInterpolation &interpolation, const Point *points, Value *result, ThreadNeighbours &neighbours )
+		:	m_interpolation( interpolation ), m_points( points ), m_result( result ), m_neighbours( neighbours )
+	{
+	}
+
+	void operator()( const tbb::blocked_range<size_t> &range ) const
+	{
+		NeighbourVector &neighbours = m_neighbours.local();
+		neighbours.reserve( m_interpolation.m_numNeighbours );
+		for( size_t i=range.begin(); i!=range.end(); ++i )
+		{
+			m_result[i] = m_interpolation( m_points[i], neighbours );
+		}
+	}
+
+	private :
+
+		const InverseDistanceWeightedInterpolation &m_interpolation;
+		const Point *m_points;
+		Value *m_result;
+		ThreadNeighbours &m_neighbours;
+
+};
+
+template<typename PointIterator, typename ValueIterator>
+void InverseDistanceWeightedInterpolation<PointIterator, ValueIterator>::operator()( const std::vector<Point> &points, std::vector<Value> &result ) const
+{
+	result.resize( points.size() );
+	if( points.empty() )
+	{
+		return;
+	}
+
+	typename ParallelQuery::ThreadNeighbours neighbours;
+	ParallelQuery f( *this, &points[0], &result[0], neighbours );
+	tbb::parallel_for( tbb::blocked_range<size_t>( 0, points.size(), 256 ), f );
+}
 
 } // namespace IECore
@@ -35,6 +35,8 @@
 #ifndef IE_CORE_LINEARTOALEXALOCGDATACONVERSION_H
 #define IE_CORE_LINEARTOALEXALOCGDATACONVERSION_H
 
+#include <cstddef>
+
 #include "boost/static_assert.hpp"
 #include "boost/type_traits/is_floating_point.hpp"
 
@@ -61,6 +63,10 @@ struct LinearToAlexaLogcDataConversion : public DataConversion< F, T >
 	/// Perform the conversion
 	T operator()( F f ) const;
 
+	/// Perform the conversion on n values, which may be done in place. Float values are
+	/// converted using a vectorisable approximation, accurate to a relative error of 1e-5.
+	void operator()( const F *from, T *to, size_t n ) const;
+
 	/// Returns an instance of a class able to perform the inverse conversion
 	InverseType inverse() const;
 };
@@ -39,6 +39,9 @@
 
 #include "OpenEXR/ImathMath.h"
 
+#include "IECore/FastFloat.h"
+#include "IECore/ApproximateDataConversion.h"
+
 namespace IECore
 {
 
@@ -64,6 +67,40 @@ T LinearToAlexaLogcDataConversion<F, T>::operator()( F f ) const
 	}
 }
 
+namespace Detail
+{
+
+struct LinearToAlexaLogcApproximation
+{
+	float operator()( float f ) const
+	{
+		const float kCut = 0.010591f;
+		const float kA = 5.555556f;
+		const float kB = 0.052272f;
+		const float kC = 0.247190f;
+		const float kD = 0.385537f;
+		const float kE = 5.367655f;
+		const float kF = 0.092809f;
+		// log10( x ) == log2( x ) * log10( 2 )
+		const float log10Two = 0.301029996f;
+		return f <= kCut ? kE*f + kF : kC * log10Two * fastFloatLog2( kA*f + kB ) + kD;
+	}
+
+	bool valid( float f ) const
+	{
+		// false for infinities and NaNs
+		return f >= -1e30f && f <= 1e30f;
+	}
+};
+
+} // namespace Detail
+
+template<typename F, typename T>
+void LinearToAlexaLogcDataConversion<F, T>::operator()( const F *from, T *to, size_t n ) const
+{
+	approximateDataConversion( *this, Detail::LinearToAlexaLogcApproximation(), from, to, n );
+}
+
 template<typename F, typename T>
 typename LinearToAlexaLogcDataConversion<F, T>::InverseType LinearToAlexaLogcDataConversion<F, T>::inverse() const
 {
@@ -43,6 +43,9 @@
 #include "OpenEXR/ImathLimits.h"
 #include "OpenEXR/ImathMath.h"
 
+#include "IECore/FastFloat.h"
+#include "IECore/ApproximateDataConversion.h"
+
 namespace IECore
 {
 
@@ -70,6 +73,42 @@ T LinearToPanalogDataConversion<F, T>::operator()( F f ) const
 	return T((m_c1 + Imath::Math<float>::log( (f + m_c2) / m_c2 ) / m_c3 ) / m_c4);
 }
 
+namespace Detail
+{
+
+struct LinearToPanalogApproximation
+{
+	LinearToPanalogApproximation( float c1, float c2, float c3, float c4 )
+		:	m_c1( c1 ), m_c2( c2 ), m_c3( c3 ), m_c4( c4 )
+	{
+	}
+
+	float operator()( float f ) const
+	{
+		// log( x ) == log2( x ) * log( 2 )
+		const float logTwo = 0.693147181f;
+		return (m_c1 + fastFloatLog2( (f + m_c2) / m_c2 ) * logTwo / m_c3 ) / m_c4;
+	}
+
+	bool valid( float f ) const
+	{
+		// fastFloatLog2() is only accurate for normalised positive
+		// values, so anything else must use the exact conversion.
+		const float x = (f + m_c2) / m_c2;
+		return x >= 1e-30f && x <= 1e30f;
+	}
+
+	float m_c1, m_c2, m_c3, m_c4;
+};
+
+} // namespace Detail
+
+template<typename F, typename T>
+void LinearToPanalogDataConversion<F, T>::operator()( const F *from, T *to, size_t n ) const
+{
+	approximateDataConversion( *this, Detail::LinearToPanalogApproximation( m_c1, m_c2, m_c3, m_c4 ), from, to, n );
+}
+
 template<typename F, typename T>
 typename LinearToPanalogDataConversion<F, T>::InverseType LinearToPanalogDataConversion<F, T>::inverse() const
 {
@@ -39,6 +39,9 @@
 
 #include "OpenEXR/ImathMath.h"
 
+#include "IECore/FastFloat.h"
+#include "IECore/ApproximateDataConversion.h"
+
 namespace IECore
 {
 
@@ -63,6 +66,35 @@ T LinearToRec709DataConversion<F, T>::operator()( F f ) const
 	}
 }
 
+namespace Detail
+{
+
+struct LinearToRec709Approximation
+{
+	float operator()( float f ) const
+	{
+		const float phi = 4.5f;
+		const float cutoff = (float)(0.081f / 4.5f);
+		const float alpha = 0.099f;
+		const float exponent = 1/.45;
+		return f <= cutoff ? f * phi : ( 1.0f + alpha ) * fastFloatPow( f, 1.0f / exponent ) - alpha;
+	}
+
+	bool valid( float f ) const
+	{
+		// false for infinities and NaNs
+		return f >= -1e30f && f <= 1e30f;
+	}
+};
+
+} // namespace Detail
+
+template<typename F, typename T>
+void LinearToRec709DataConversion<F, T>::operator()( const F *from, T *to, size_t n ) const
+{
+	approximateDataConversion( *this, Detail::LinearToRec709Approximation(), from, to, n );
+}
+
 template<typename F, typename T>
 typename LinearToRec709DataConversion<F, T>::InverseType LinearToRec709DataConversion<F, T>::inverse() const
 {
@@ -39,6 +39,9 @@
 
 #include "OpenEXR/ImathMath.h"
 
+#include "IECore/FastFloat.h"
+#include "IECore/ApproximateDataConversion.h"
+
 namespace IECore
 {
 
@@ -64,6 +67,35 @@ T LinearToSRGBDataConversion<F, T>::operator()( F f ) const
 	}
 }
 
+namespace Detail
+{
+
+struct LinearToSRGBApproximation
+{
+	float operator()( float f ) const
+	{
+		const float phi = 12.92f;
+		const float cutoff = 0.003130805f;
+		const float alpha = 0.055f;
+		const float exponent = 2.4f;
+		return f <= cutoff ? f * phi : ( 1.0f + alpha ) * fastFloatPow( f, 1.0f / exponent ) - alpha;
+	}
+
+	bool valid( float f ) const
+	{
+		// false for infinities and NaNs
+		return f >= -1e30f && f <= 1e30f;
+	}
+};
+
+} // namespace Detail
+
+template<typename F, typename T>
+void LinearToSRGBDataConversion<F, T>::operator()( const F *from, T *to, size_t n ) const
+{
+	approximateDataConversion( *this, Detail::LinearToSRGBApproximation(), from, to, n );
+}
+
 template<typename F, typename T>
 typename LinearToSRGBDataConversion<F, T>::InverseType LinearToSRGBDataConversion<F, T>::inverse() const
 {
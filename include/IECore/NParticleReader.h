@@ -111,9 +111,6 @@ class IECORE_API NParticleReader : public ParticleReader
 		
 		IntVectorDataPtr m_frames;
 		std::map<int, IFFFile::Chunk::ChunkIterator> frameToRootChildren;
-		
-		template<typename T, typename F>
-		typename T::Ptr filterAttr( const F * attr, float percentage );
 };
 
 IE_CORE_DECLAREPTR( NParticleReader );
@@ -61,6 +61,8 @@ class IECORE_API NormalizeSmoothSkinningWeightsOp : public ModifyOp
 	
 	private :
 		
+		struct NormalizeWeights;
+		
 		BoolParameterPtr m_useLocksParameter;
 		BoolVectorParameterPtr m_influenceLocksParameter;
 };
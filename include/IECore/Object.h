@@ -131,6 +131,11 @@ class IECORE_API Object : public RunTimeTyped
 		/// Saves the object in the current directory of ioInterface, in
 		/// a subdirectory with the specified name.
 		void save( IndexedIOPtr ioInterface, const IndexedIO::EntryID &name ) const;
+		/// As above, but if packed is true the object and all its members are
+		/// stored as a single PackedIndexedIO block rather than as a hierarchy
+		/// of entries. Packed objects take a single read to load, and are loaded
+		/// transparently by load() alongside objects saved in the regular layout.
+		void save( IndexedIOPtr ioInterface, const IndexedIO::EntryID &name, bool packed ) const;
 		/// Returns true if this object is equal to the other. Should
 		/// be reimplemented appropriately in derived classes, first calling
 		/// your base class isEqualTo() and returning false straight away
@@ -182,7 +187,7 @@ class IECORE_API Object : public RunTimeTyped
 		/// Throws an Exception if typeName is not a valid type.
 		static ObjectPtr create( const std::string &typeName );
 		/// Loads an object previously saved with the given name in the current directory
-		/// of ioInterface.
+		/// of ioInterface, in either the regular or the packed layout.
 		static ObjectPtr load( ConstIndexedIOPtr ioInterface, const IndexedIO::EntryID &name );
 		//@}
 
@@ -298,20 +303,33 @@ class IECORE_API Object : public RunTimeTyped
 				template<class T>
 				/// Load an Object instance previously saved by SaveContext::save().
 				typename T::Ptr load( const IndexedIO *container, const IndexedIO::EntryID &name );
+				/// Loads several Object instances previously saved by SaveContext::save(), storing
+				/// in results[i] the object saved as names[i] in containers[i]. This is equivalent to
+				/// calling the function above for each name in turn, but the objects are loaded in
+				/// parallel when the estimated size of the data to be loaded makes it worthwhile, and no
+				/// other parallel load is in progress.
+				template<class T>
+				void load( const std::vector<ConstIndexedIOPtr> &containers, const IndexedIO::EntryIDList &names, std::vector<typename T::Ptr> &results );
 				/// Returns an interface to a raw container created by SaveContext::rawContainer() - please see
 				/// documentation and cautionary notes for that function.
 				const IndexedIO *rawContainer();
 
 			private :
-				typedef std::map< IndexedIO::EntryIDList, ObjectPtr> LoadedObjectMap;
 
-				LoadContext( ConstIndexedIOPtr ioInterface, boost::shared_ptr<LoadedObjectMap> loadedObjects );
+				struct LoadedObjects;
+				class ObjectLoader;
+
+				LoadContext( ConstIndexedIOPtr ioInterface, boost::shared_ptr<LoadedObjects> loadedObjects );
 
 				ObjectPtr loadObjectOrReference( const IndexedIO *container, const IndexedIO::EntryID &name );
+				void loadObjectsOrReferences( const std::vector<ConstIndexedIOPtr> &containers, const IndexedIO::EntryIDList &names, std::vector<ObjectPtr> &results );
+				// Returns the object stored at path, loading it from ioObject (or from path
+				// if ioObject is null) unless it has been loaded already.
+				ObjectPtr loadInstance( const IndexedIO::EntryIDList &path, ConstIndexedIOPtr ioObject );
 				ObjectPtr loadObject( const IndexedIO *container );
 
 				ConstIndexedIOPtr m_ioInterface;
-				boost::shared_ptr<LoadedObjectMap> m_loadedObjects;
+				boost::shared_ptr<LoadedObjects> m_loadedObjects;
 		};
 		IE_CORE_DECLAREPTR( LoadContext );
 
@@ -86,6 +86,18 @@ typename T::Ptr Object::LoadContext::load( const IndexedIO *i, const IndexedIO::
 	return runTimeCast<T>( loadObjectOrReference( i, name ) );
 }
 
+template<class T>
+void Object::LoadContext::load( const std::vector<ConstIndexedIOPtr> &containers, const IndexedIO::EntryIDList &names, std::vector<typename T::Ptr> &results )
+{
+	std::vector<ObjectPtr> objects;
+	loadObjectsOrReferences( containers, names, objects );
+	results.resize( objects.size() );
+	for( size_t i = 0; i < objects.size(); i++ )
+	{
+		results[i] = runTimeCast<T>( objects[i] );
+	}
+}
+
 } // namespace IECore
 
 #endif // IE_CORE_OBJECT_INL
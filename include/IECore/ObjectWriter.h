@@ -37,13 +37,16 @@
 
 #include "IECore/Export.h"
 #include "IECore/Writer.h"
+#include "IECore/SimpleTypedParameter.h"
 
 namespace IECore
 {
 
 IE_CORE_FORWARDDECLARE( ObjectParameter )
 
-/// An ObjectWriter writes instances of a single Object to a file with a .cob extension
+/// An ObjectWriter writes instances of a single Object to a file with a .cob extension.
+/// The "packed" parameter stores the object as a single PackedIndexedIO block, which
+/// is quicker to load for objects made up of many small members.
 /// \ingroup ioGroup
 class IECORE_API ObjectWriter : public Writer
 {
@@ -64,6 +67,7 @@ class IECORE_API ObjectWriter : public Writer
 		virtual void doWrite( const CompoundObject *operands );
 
 		ObjectParameterPtr m_headerParameter;
+		BoolParameterPtr m_packedParameter;
 
 	private :
 
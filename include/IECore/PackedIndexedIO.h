@@ -0,0 +1,196 @@
+//////////////////////////////////////////////////////////////////////////
+//
+//  Copyright (c) 2013, Image Engine Design Inc. All rights reserved.
+//
+//  Redistribution and use in source and binary forms, with or without
+//  modification, are permitted provided that the following conditions are
+//  met:
+//
+//     * Redistributions of source code must retain the above copyright
+//       notice, this list of conditions and the following disclaimer.
+//
+//     * Redistributions in binary form must reproduce the above copyright
+//       notice, this list of conditions and the following disclaimer in the
+//       documentation and/or other materials provided with the distribution.
+//
+//     * Neither the name of Image Engine Design nor the names of any
+//       other contributors to this software may be used to endorse or
+//       promote products derived from this software without specific prior
+//       written permission.
+//
+//  THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS
+//  IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO,
+//  THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR
+//  PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER OR
+//  CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+//  EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+//  PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR
+//  PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF
+//  LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING
+//  NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+//  SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+//
+//////////////////////////////////////////////////////////////////////////
+
+
+#ifndef IE_CORE_PACKEDINDEXEDIO_H
+#define IE_CORE_PACKEDINDEXEDIO_H
+
+#include "IECore/Export.h"
+#include "IECore/IndexedIO.h"
+#include "IECore/VectorTypedData.h"
+
+namespace IECore
+{
+
+/// An implementation of IndexedIO which holds an entire hierarchy in a single contiguous
+/// block of memory. The block starts with a table describing every entry, followed by a
+/// string table of entry names and then the data for all files, each aligned to 8 bytes
+/// and stored little endian. Opening a block for reading decodes the table once and then
+/// serves all reads directly from the block, without copying it and without any further
+/// I/O, so many small reads cost no more than one large one.
+///
+/// Object::save() uses this to store an object as a single file entry in another
+/// IndexedIO, and Object::load() transparently unpacks such entries - see
+/// isPacked() and unpack(). Read operations are thread safe on read-only blocks.
+/// \ingroup ioGroup
+class IECORE_API PackedIndexedIO : public IndexedIO
+{
+	public:
+
+		IE_CORE_DECLARERUNTIMETYPED( PackedIndexedIO, IndexedIO );
+
+		/// Opens a block. In Read mode buf must contain a block previously returned by buffer(),
+		/// and is referenced rather than copied, so it must not be modified afterwards. In
+		/// Append mode buf may additionally be null or empty, and in Write mode it is ignored.
+		PackedIndexedIO( ConstCharVectorDataPtr buf, const IndexedIO::EntryIDList &root, IndexedIO::OpenMode mode );
+
+		virtual ~PackedIndexedIO();
+
+		/// Returns a new block containing the entire hierarchy.
+		CharVectorDataPtr buffer() const;
+
+		/// Returns true if the named entry of container is a file holding a packed block.
+		static bool isPacked( const IndexedIO *container, const IndexedIO::EntryID &name );
+		/// Reads the packed block held by the named entry of container with a single read,
+		/// and returns a read-only interface to its root.
+		static ConstIndexedIOPtr unpack( const IndexedIO *container, const IndexedIO::EntryID &name );
+
+		virtual IndexedIO::OpenMode openMode() const;
+
+		void path( IndexedIO::EntryIDList &result ) const;
+
+		bool hasEntry( const IndexedIO::EntryID &name ) const;
+
+		const IndexedIO::EntryID &currentEntryId() const;
+
+		void entryIds( IndexedIO::EntryIDList &names ) const;
+
+		void entryIds( IndexedIO::EntryIDList &names, IndexedIO::EntryType type ) const;
+
+		IndexedIOPtr subdirectory( const IndexedIO::EntryID &name, IndexedIO::MissingBehaviour missingBehaviour = IndexedIO::ThrowIfMissing );
+
+		ConstIndexedIOPtr subdirectory( const IndexedIO::EntryID &name, IndexedIO::MissingBehaviour missingBehaviour = IndexedIO::ThrowIfMissing ) const;
+
+		IndexedIO::Entry entry( const IndexedIO::EntryID &name ) const;
+
+		IndexedIOPtr createSubdirectory( const IndexedIO::EntryID &name );
+
+		void remove( const IndexedIO::EntryID &name );
+
+		void removeAll();
+
+		IndexedIOPtr parentDirectory();
+
+		ConstIndexedIOPtr parentDirectory() const;
+
+		IndexedIOPtr directory( const IndexedIO::EntryIDList &path, IndexedIO::MissingBehaviour missingBehaviour = IndexedIO::ThrowIfMissing );
+
+		ConstIndexedIOPtr directory( const IndexedIO::EntryIDList &path, IndexedIO::MissingBehaviour missingBehaviour = IndexedIO::ThrowIfMissing ) const;
+
+		void commit();
+
+		void write(const IndexedIO::EntryID &name, const float *x, unsigned long arrayLength);
+		void write(const IndexedIO::EntryID &name, const double *x, unsigned long arrayLength);
+		void write(const IndexedIO::EntryID &name, const half *x, unsigned long arrayLength);
+		void write(const IndexedIO::EntryID &name, const int *x, unsigned long arrayLength);
+		void write(const IndexedIO::EntryID &name, const int64_t *x, unsigned long arrayLength);
+		void write(const IndexedIO::EntryID &name, const uint64_t *x, unsigned long arrayLength);
+		void write(const IndexedIO::EntryID &name, const unsigned int *x, unsigned long arrayLength);
+		void write(const IndexedIO::EntryID &name, const char *x, unsigned long arrayLength);
+		void write(const IndexedIO::EntryID &name, const unsigned char *x, unsigned long arrayLength);
+		void write(const IndexedIO::EntryID &name, const std::string *x, unsigned long arrayLength);
+		void write(const IndexedIO::EntryID &name, const short *x, unsigned long arrayLength);
+		void write(const IndexedIO::EntryID &name, const unsigned short *x, unsigned long arrayLength);
+		void write(const IndexedIO::EntryID &name, const InternedString *x, unsigned long arrayLength);
+		void write(const IndexedIO::EntryID &name, const float &x);
+		void write(const IndexedIO::EntryID &name, const double &x);
+		void write(const IndexedIO::EntryID &name, const half &x);
+		void write(const IndexedIO::EntryID &name, const int &x);
+		void write(const IndexedIO::EntryID &name, const int64_t &x);
+		void write(const IndexedIO::EntryID &name, const uint64_t &x);
+		void write(const IndexedIO::EntryID &name, const std::string &x);
+		void write(const IndexedIO::EntryID &name, const unsigned int &x);
+		void write(const IndexedIO::EntryID &name, const char &x);
+		void write(const IndexedIO::EntryID &name, const unsigned char &x);
+		void write(const IndexedIO::EntryID &name, const short &x);
+		void write(const IndexedIO::EntryID &name, const unsigned short &x);
+
+		void read(const IndexedIO::EntryID &name, float *&x, unsigned long arrayLength) const;
+		void read(const IndexedIO::EntryID &name, double *&x, unsigned long arrayLength) const;
+		void read(const IndexedIO::EntryID &name, half *&x, unsigned long arrayLength) const;
+		void read(const IndexedIO::EntryID &name, int *&x, unsigned long arrayLength) const;
+		void read(const IndexedIO::EntryID &name, int64_t *&x, unsigned long arrayLength) const;
+		void read(const IndexedIO::EntryID &name, uint64_t *&x, unsigned long arrayLength) const;
+		void read(const IndexedIO::EntryID &name, unsigned int *&x, unsigned long arrayLength) const;
+		void read(const IndexedIO::EntryID &name, char *&x, unsigned long arrayLength) const;
+		void read(const IndexedIO::EntryID &name, unsigned char *&x, unsigned long arrayLength) const;
+		void read(const IndexedIO::EntryID &name, std::string *&x, unsigned long arrayLength) const;
+		void read(const IndexedIO::EntryID &name, short *&x, unsigned long arrayLength) const;
+		void read(const IndexedIO::EntryID &name, unsigned short *&x, unsigned long arrayLength) const;
+		void read(const IndexedIO::EntryID &name, InternedString *&x, unsigned long arrayLength) const;
+		void read(const IndexedIO::EntryID &name, float &x) const;
+		void read(const IndexedIO::EntryID &name, double &x) const;
+		void read(const IndexedIO::EntryID &name, half &x) const;
+		void read(const IndexedIO::EntryID &name, int &x) const;
+		void read(const IndexedIO::EntryID &name, int64_t &x) const;
+		void read(const IndexedIO::EntryID &name, uint64_t &x) const;
+		void read(const IndexedIO::EntryID &name, std::string &x) const;
+		void read(const IndexedIO::EntryID &name, unsigned int &x) const;
+		void read(const IndexedIO::EntryID &name, char &x) const;
+		void read(const IndexedIO::EntryID &name, unsigned char &x) const;
+		void read(const IndexedIO::EntryID &name, short &x) const;
+		void read(const IndexedIO::EntryID &name, unsigned short &x) const;
+
+	private :
+
+		class Block;
+		IE_CORE_DECLAREPTR( Block );
+
+		PackedIndexedIO( BlockPtr block, size_t node );
+
+		// Returns the index of the named child of the current directory, or of the newly
+		// created directory if it is missing and missingBehaviour is CreateIfMissing.
+		// Returns -1 if the child is missing otherwise, or throws if it is missing and
+		// missingBehaviour is ThrowIfMissing.
+		long directoryChild( size_t node, const IndexedIO::EntryID &name, IndexedIO::MissingBehaviour missingBehaviour ) const;
+
+		template<typename T>
+		void writeArray( const IndexedIO::EntryID &name, const T *x, unsigned long arrayLength );
+		template<typename T>
+		void writeValue( const IndexedIO::EntryID &name, const T &x );
+		template<typename T>
+		void readArray( const IndexedIO::EntryID &name, T *&x, unsigned long arrayLength ) const;
+		template<typename T>
+		void readValue( const IndexedIO::EntryID &name, T &x ) const;
+
+		BlockPtr m_block;
+		size_t m_node;
+
+};
+
+IE_CORE_DECLAREPTR( PackedIndexedIO )
+
+} // namespace IECore
+
+#endif // IE_CORE_PACKEDINDEXEDIO_H
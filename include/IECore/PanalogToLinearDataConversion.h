@@ -35,6 +35,7 @@
 #ifndef IE_CORE_PANALOGTOLINEARDATACONVERSION_H
 #define IE_CORE_PANALOGTOLINEARDATACONVERSION_H
 
+#include <cstddef>
 #include <vector>
 
 #include "boost/static_assert.hpp"
@@ -71,6 +72,10 @@ class PanalogToLinearDataConversion : public DataConversion< F, T >
 		/// Perform the conversion
 		T operator()( F f ) const;
 
+		/// Perform the conversion on n values, which may be done in place. Float values are
+		/// converted using a vectorisable approximation, accurate to a relative error of 1e-5.
+		void operator()( const F *from, T *to, size_t n ) const;
+
 		/// Returns an instance of a class able to perform the inverse conversion
 		InverseType inverse() const;
 
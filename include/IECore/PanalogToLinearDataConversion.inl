@@ -43,6 +43,9 @@
 #include "OpenEXR/ImathLimits.h"
 #include "OpenEXR/ImathMath.h"
 
+#include "IECore/FastFloat.h"
+#include "IECore/ApproximateDataConversion.h"
+
 namespace IECore
 {
 
@@ -70,6 +73,42 @@ T PanalogToLinearDataConversion<F, T>::operator()( F f ) const
 	return T(-m_c2 + m_c2 * Imath::Math<float>::exp(m_c3 * (f * m_c4 - m_c1)));
 }
 
+namespace Detail
+{
+
+struct PanalogToLinearApproximation
+{
+	PanalogToLinearApproximation( float c1, float c2, float c3, float c4 )
+		:	m_c1( c1 ), m_c2( c2 ), m_c3( c3 ), m_c4( c4 )
+	{
+	}
+
+	float operator()( float f ) const
+	{
+		// exp( x ) == 2^( x * log2( e ) )
+		const float log2E = 1.44269504f;
+		return -m_c2 + m_c2 * fastFloatExp2( m_c3 * (f * m_c4 - m_c1) * log2E );
+	}
+
+	bool valid( float f ) const
+	{
+		// false for infinities and NaNs, and for values which
+		// would take fastFloatExp2() out of range.
+		const float x = m_c3 * (f * m_c4 - m_c1) * 1.44269504f;
+		return x >= -120.0f && x <= 120.0f;
+	}
+
+	float m_c1, m_c2, m_c3, m_c4;
+};
+
+} // namespace Detail
+
+template<typename F, typename T>
+void PanalogToLinearDataConversion<F, T>::operator()( const F *from, T *to, size_t n ) const
+{
+	approximateDataConversion( *this, Detail::PanalogToLinearApproximation( m_c1, m_c2, m_c3, m_c4 ), from, to, n );
+}
+
 template<typename F, typename T>
 typename PanalogToLinearDataConversion<F, T>::InverseType PanalogToLinearDataConversion<F, T>::inverse() const
 {
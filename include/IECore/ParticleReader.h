@@ -134,11 +134,43 @@ class IECORE_API ParticleReader : public Reader
 		template<typename T, typename F>
 		typename T::Ptr filterAttr( const F * attr, float percentage, const Data *idAttr ) const;
 		
+		/// Returns the indices of the particles kept by percentage filtering, in
+		/// ascending order, or 0 if no filtering is needed. The particles selected
+		/// are the same as those kept by filterAttr(). The result is cached, so
+		/// the selection is made only once for all the attributes being read.
+		const std::vector<size_t> *filteredIndices( size_t numParticles, const Data *idAttr );
+
+		/// Reads an array attribute of numParticles elements, stored contiguously in
+		/// stream starting at pos, and returns the elements at indices (or all elements
+		/// if indices is 0) converted to type T. Kept particles are read in runs, each of
+		/// which is byte swapped (if swapBytes is true), filtered and converted in a
+		/// single pass. Small gaps between kept particles are read through, but large
+		/// gaps are skipped, and only the kept particles are ever stored, so reading a
+		/// small percentage of a large cache uses a correspondingly small amount of
+		/// I/O and memory.
+		template<typename T, typename F>
+		typename T::Ptr readFilteredAttr( std::istream &stream, std::streampos pos, size_t numParticles, bool swapBytes, const std::vector<size_t> *indices ) const;
+
 		/// Returns the name of the original position primVar should we need to convert it to "P"
 		virtual std::string positionPrimVarName() = 0;
 
 	private :
 
+		// the cached result of filteredIndices(), and the
+		// parameters it was computed for.
+		struct FilteredIndices
+		{
+			FilteredIndices();
+			bool valid;
+			std::string fileName;
+			size_t numParticles;
+			float percentage;
+			int seed;
+			bool haveIds;
+			std::vector<size_t> indices;
+		};
+		FilteredIndices m_filteredIndices;
+
 		template<typename T, typename F, typename U >
 		typename T::Ptr filterAttr( const F * attr, float percentage, const std::vector< U > &ids ) const;
 
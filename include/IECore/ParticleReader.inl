@@ -35,9 +35,14 @@
 #ifndef IE_CORE_PARTICLEREADER_INL
 #define IE_CORE_PARTICLEREADER_INL
 
+#include <istream>
+
 #include "OpenEXR/ImathRandom.h"
+#include "IECore/AlignedAllocator.h"
 #include "IECore/MessageHandler.h"
 #include "IECore/Convert.h"
+#include "IECore/ByteOrder.h"
+#include "IECore/Exception.h"
 
 namespace IECore
 {
@@ -121,6 +126,82 @@ typename T::Ptr ParticleReader::filterAttr( const F *attr, float percentage, con
 	return result;
 }
 
+template<typename T, typename F>
+typename T::Ptr ParticleReader::readFilteredAttr( std::istream &stream, std::streampos pos, size_t numParticles, bool swapBytes, const std::vector<size_t> *indices ) const
+{
+	typedef typename F::ValueType::value_type FileElement;
+	typedef typename F::BaseType FileBaseType;
+	typedef typename T::ValueType::value_type Element;
+	const size_t numComponents = sizeof( FileElement ) / sizeof( FileBaseType );
+	const size_t blockSize = 16384;
+	// Kept elements separated by gaps of up to this many elements are read
+	// together, as reading through a small gap is cheaper than seeking past
+	// it and refilling the stream buffer.
+	const size_t maxGap = std::max<size_t>( 1, 8192 / sizeof( FileElement ) );
+
+	// the output is filled in order, so is reserved rather than resized
+	// to avoid initialising elements which are about to be overwritten,
+	// and the block is left uninitialised by AlignedAllocator for the
+	// same reason.
+	const size_t outSize = indices ? indices->size() : numParticles;
+	typename T::Ptr result( new T );
+	typename T::ValueType &out = result->writable();
+	out.reserve( outSize );
+
+	typename AlignedVector<FileElement>::Type block( std::min( blockSize, numParticles ) );
+	size_t streamIndex = numParticles;
+	size_t outIndex = 0;
+	while( outIndex < outSize )
+	{
+		// find the next run of elements to read, and the kept
+		// elements within it.
+		size_t readBegin = outIndex;
+		size_t readEnd = std::min( readBegin + blockSize, numParticles );
+		size_t outEnd = readEnd;
+		if( indices )
+		{
+			readBegin = (*indices)[outIndex];
+			readEnd = readBegin + 1;
+			outEnd = outIndex + 1;
+			while(
+				outEnd < indices->size() &&
+				(*indices)[outEnd] - readEnd <= maxGap &&
+				(*indices)[outEnd] < readBegin + blockSize
+			)
+			{
+				readEnd = (*indices)[outEnd++] + 1;
+			}
+		}
+
+		if( readBegin != streamIndex )
+		{
+			stream.seekg( pos + std::streamoff( readBegin * sizeof( FileElement ) ) );
+		}
+		stream.read( (char *)&block[0], ( readEnd - readBegin ) * sizeof( FileElement ) );
+		if( !stream.good() )
+		{
+			throw IOException( ( boost::format( "Error reading particle data from file \"%s\"." ) % fileName() ).str() );
+		}
+		streamIndex = readEnd;
+
+		for( ; outIndex < outEnd; outIndex++ )
+		{
+			FileElement e = block[( indices ? (*indices)[outIndex] : outIndex ) - readBegin];
+			if( swapBytes )
+			{
+				FileBaseType *c = (FileBaseType *)&e;
+				for( size_t i = 0; i < numComponents; i++ )
+				{
+					c[i] = reverseBytes( c[i] );
+				}
+			}
+			out.push_back( convert<Element, FileElement>( e ) );
+		}
+	}
+
+	return result;
+}
+
 } // namespace IECore
 
 #endif // IE_CORE_PARTICLEREADER_INL
@@ -115,10 +115,25 @@ class PerlinNoise
 		/// As above but performs antialiasing using frequency clamping.
 		inline Value operator()( const Point &p, PointBaseType filterWidth ) const;
 
+		/// Computes the noise values for the points in the range [begin, end),
+		/// writing them to result, which must have room for end - begin values.
+		/// The results are identical to those of the single point functions above.
+		void noise( const Point *begin, const Point *end, Value *result ) const;
+		/// As above but performs antialiasing using frequency clamping.
+		void noise( const Point *begin, const Point *end, PointBaseType filterWidth, Value *result ) const;
+
+		/// Computes the noise values for an array of points, resizing result
+		/// to match. Large arrays are evaluated in parallel.
+		void noise( const std::vector<Point> &points, std::vector<Value> &result ) const;
+		/// As above but performs antialiasing using frequency clamping.
+		void noise( const std::vector<Point> &points, PointBaseType filterWidth, std::vector<Value> &result ) const;
+
 	private :
 
 		inline Value noiseWalk( int *pi, const Point &pf, int d ) const;
 
+		struct ParallelNoise;
+
 		static const unsigned int m_maxPointDimensions = 4;
 		static const unsigned int m_permSize = 256;
 		std::vector<unsigned int> m_perm;
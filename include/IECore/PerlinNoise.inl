@@ -43,6 +43,8 @@
 #include "OpenEXR/ImathFun.h"
 #include "OpenEXR/ImathRandom.h"
 
+#include "tbb/parallel_for.h"
+
 #include <vector>
 #include <algorithm>
 
@@ -147,6 +149,88 @@ inline typename PerlinNoise<P, V, F>::Value PerlinNoise<P, V, F>::operator()( co
 	return noise( p, filterWidth );
 }
 
+template<typename P, typename V, typename F>
+void PerlinNoise<P, V, F>::noise( const Point *begin, const Point *end, Value *result ) const
+{
+	for( ; begin != end; ++begin, ++result )
+	{
+		*result = noise( *begin );
+	}
+}
+
+template<typename P, typename V, typename F>
+void PerlinNoise<P, V, F>::noise( const Point *begin, const Point *end, PointBaseType filterWidth, Value *result ) const
+{
+	ValueBaseType w = 1.0 - smoothstep( ValueBaseType( 0.2 ), ValueBaseType( 0.6 ), filterWidth );
+	if( w > 0.0 )
+	{
+		noise( begin, end, result );
+		for( Value *r = result, *rEnd = result + ( end - begin ); r != rEnd; ++r )
+		{
+			*r = w * *r;
+		}
+	}
+	else
+	{
+		std::fill( result, result + ( end - begin ), Value( 0 ) );
+	}
+}
+
+template<typename P, typename V, typename F>
+struct PerlinNoise<P, V, F>::ParallelNoise
+{
+
+	ParallelNoise( const PerlinNoise &noise, const Point *points, bool filter, PointBaseType filterWidth, Value *result )
+		:	m_noise( noise ), m_points( points ), m_filter( filter ), m_filterWidth( filterWidth ), m_result( result )
+	{
+	}
+
+	void operator()( const tbb::blocked_range<size_t> &range ) const
+	{
+		if( m_filter )
+		{
+			m_noise.noise( m_points + range.begin(), m_points + range.end(), m_filterWidth, m_result + range.begin() );
+		}
+		else
+		{
+			m_noise.noise( m_points + range.begin(), m_points + range.end(), m_result + range.begin() );
+		}
+	}
+
+	private :
+
+		const PerlinNoise &m_noise;
+		const Point *m_points;
+		bool m_filter;
+		PointBaseType m_filterWidth;
+		Value *m_result;
+
+};
+
+template<typename P, typename V, typename F>
+void PerlinNoise<P, V, F>::noise( const std::vector<Point> &points, std::vector<Value> &result ) const
+{
+	result.resize( points.size() );
+	if( points.empty() )
+	{
+		return;
+	}
+	ParallelNoise f( *this, &points[0], false, 0, &result[0] );
+	tbb::parallel_for( tbb::blocked_range<size_t>( 0, points.size(), 1024 ), f );
+}
+
+template<typename P, typename V, typename F>
+void PerlinNoise<P, V, F>::noise( const std::vector<Point> &points, PointBaseType filterWidth, std::vector<Value> &result ) const
+{
+	result.resize( points.size() );
+	if( points.empty() )
+	{
+		return;
+	}
+	ParallelNoise f( *this, &points[0], true, filterWidth, &result[0] );
+	tbb::parallel_for( tbb::blocked_range<size_t>( 0, points.size(), 1024 ), f );
+}
+
 template<typename P, typename V, typename F>
 inline typename PerlinNoise<P, V, F>::Value PerlinNoise<P, V, F>::noiseWalk( int *pi, const P &p, int d ) const
 {
@@ -43,6 +43,7 @@
 #include "IECore/TypedPrimitiveParameter.h"
 #include "IECore/PrimitiveVariable.h"
 #include "IECore/Random.h"
+#include "IECore/BoundedKDTree.h"
 
 namespace IECore
 {
@@ -84,7 +85,10 @@ class IECORE_API PointRepulsionOp : public ModifyOp
 	protected :
 
 		void getNearestPointsAndDensities( ImagePrimitiveEvaluator *, const PrimitiveVariable &density, MeshPrimitiveEvaluator *, const PrimitiveVariable &s, const PrimitiveVariable &t, std::vector<Imath::V3f> &points, std::vector<float> &densities );
-		void calculateForces( std::vector<Imath::V3f> &points, std::vector<float> &radii, std::vector<Imath::Box3f> &bounds, std::vector<Imath::V3f> &forces, Imath::Rand48 &generator, std::vector<float> &densities, float densityInv );
+		/// Calculates the repulsion force on each point from its neighbours, in parallel. The tree must
+		/// contain the bounds. Incident points are pushed apart in random directions chosen using seed
+		/// and the point index, so the result doesn't depend on the number of threads used.
+		void calculateForces( const std::vector<Imath::V3f> &points, const std::vector<float> &radii, const std::vector<Imath::Box3f> &bounds, const Box3fTree &tree, std::vector<Imath::V3f> &forces, unsigned long seed, const std::vector<float> &densities, float densityInv );
 
 		virtual void modify( Object * object, const CompoundObject * operands );
 
@@ -95,6 +99,11 @@ class IECORE_API PointRepulsionOp : public ModifyOp
 		FloatParameterPtr m_magnitudeParameter;
 		StringParameterPtr m_weightsNameParameter;
 
+	private :
+
+		struct NearestPointsAndDensities;
+		struct Forces;
+
 };
 
 IE_CORE_DECLAREPTR( PointRepulsionOp );
@@ -104,7 +104,8 @@ class IECORE_API Primitive : public VisibleRenderable
 		/// Hash representing the topology only
 		virtual void topologyHash( MurmurHash &h ) const = 0;
 
-		/// Utility function that can be used in place of Object::load() to load only the primitive variables from a Primitive object stored in a IndexedIO file.
+		/// Utility function that can be used in place of Object::load() to load only the primitive variables from a Primitive object stored in a IndexedIO file,
+		/// in either the regular or the packed layout.
 		/// The function tries to load the requested primitive variables and will ignore the ones that do not exist in the file.
 		/// \param ioInterface File handle where the Primitive is stored.
 		/// \param name Name of the entry where the Primitive is stored under the file location.
@@ -115,6 +116,9 @@ class IECORE_API Primitive : public VisibleRenderable
 
 		static const unsigned int m_ioVersion;
 
+		/// Loads those of the named variables which exist in ioVariables.
+		static void loadVariables( LoadContext *context, const IndexedIO *ioVariables, const IndexedIO::EntryIDList &names, PrimitiveVariableMap &variables );
+
 };
 
 IE_CORE_DECLAREPTR( Primitive );
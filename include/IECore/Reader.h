@@ -99,6 +99,10 @@ class IECORE_API Reader : public Op
 		/// Definition of a function  to answer the
 		/// question can this file be read?
 		typedef boost::function<bool ( const std::string &fileName )> CanReadFn;
+		/// Definition of a function to answer the question might this file
+		/// be readable, given only the first size bytes of the file. This
+		/// is typically a check of the magic number of the file format.
+		typedef boost::function<bool ( const char *data, size_t size )> CanReadMagicFn;
 
 		/// Registers a Reader type which is capable of reading files ending with
 		/// the space separated extensions specified (e.g. "tif tiff"). Before creating a reader the canRead function
@@ -107,7 +111,14 @@ class IECORE_API Reader : public Op
 		/// canRead functions are called in a last ditch attempt to find a suitable reader. Typically
 		/// you will not call this function directly to register a reader type - you will instead use
 		/// the ReaderDescription registration utility class below.
-		static void registerReader( const std::string &extensions, CanReadFn canRead, CreatorFn creator, TypeId typeId );
+		///
+		/// The optional canReadMagic function allows create() to rule out a reader using the
+		/// start of the file, which is read at most once and shared between all registered readers,
+		/// so that canRead need only be called for the readers which pass. If magicIsConclusive
+		/// is true then a reader whose canReadMagic function passes is created without calling
+		/// canRead at all - this should only be used when canRead performs no checks beyond
+		/// those of canReadMagic.
+		static void registerReader( const std::string &extensions, CanReadFn canRead, CreatorFn creator, TypeId typeId, CanReadMagicFn canReadMagic = CanReadMagicFn(), bool magicIsConclusive = false );
 		//@}
 		
 	protected :
@@ -129,6 +140,7 @@ class IECORE_API Reader : public Op
 		{
 			public :
 				ReaderDescription( const std::string &extensions );
+				ReaderDescription( const std::string &extensions, CanReadMagicFn canReadMagic, bool magicIsConclusive = false );
 			private :
 				static ReaderPtr creator( const std::string &fileName );
 		};
@@ -141,10 +153,12 @@ class IECORE_API Reader : public Op
 		{
 			CreatorFn creator;
 			CanReadFn canRead;
+			CanReadMagicFn canReadMagic;
+			bool magicIsConclusive;
 			TypeId typeId;
 		};
-		typedef std::multimap<std::string, ReaderFns> ExtensionsToFnsMap;
-		static ExtensionsToFnsMap *extensionsToFns();
+		struct Registry;
+		static Registry &registry();
 
 };
 
@@ -44,6 +44,12 @@ Reader::ReaderDescription<T>::ReaderDescription( const std::string &extensions )
 	Reader::registerReader( extensions, T::canRead, creator, T::staticTypeId() );
 }
 
+template<class T>
+Reader::ReaderDescription<T>::ReaderDescription( const std::string &extensions, CanReadMagicFn canReadMagic, bool magicIsConclusive )
+{
+	Reader::registerReader( extensions, T::canRead, creator, T::staticTypeId(), canReadMagic, magicIsConclusive );
+}
+
 template<class T>
 ReaderPtr Reader::ReaderDescription<T>::creator( const std::string &fileName )
 {
@@ -37,6 +37,9 @@
 
 #include "OpenEXR/ImathMath.h"
 
+#include "IECore/FastFloat.h"
+#include "IECore/ApproximateDataConversion.h"
+
 namespace IECore
 {
 
@@ -61,6 +64,36 @@ T Rec709ToLinearDataConversion<F, T>::operator()( F f ) const
 	}
 }
 
+namespace Detail
+{
+
+struct Rec709ToLinearApproximation
+{
+	float operator()( float f ) const
+	{
+		const float k0 = 0.081f;
+		const float phi = 4.5f;
+		const float alpha = 0.099f;
+		const float exponent = 1/.45;
+		return f <= k0 ? f / phi : fastFloatPow( ( f + alpha ) / ( 1.0f + alpha ), exponent );
+	}
+
+	bool valid( float f ) const
+	{
+		// false for infinities and NaNs, and for values large
+		// enough to take fastFloatExp2() out of range.
+		return f >= -1e30f && f <= 1e15f;
+	}
+};
+
+} // namespace Detail
+
+template<typename F, typename T>
+void Rec709ToLinearDataConversion<F, T>::operator()( const F *from, T *to, size_t n ) const
+{
+	approximateDataConversion( *this, Detail::Rec709ToLinearApproximation(), from, to, n );
+}
+
 template<typename F, typename T>
 typename Rec709ToLinearDataConversion<F, T>::InverseType Rec709ToLinearDataConversion<F, T>::inverse() const
 {
@@ -147,6 +147,38 @@ class IECORE_API RefCounted : private boost::noncopyable
 		/// Returns the current reference count.
 		inline RefCount refCount() const { return m_numRefs; };
 
+		//! @name Allocation
+		/// RefCounted objects may optionally be allocated from a pool,
+		/// which serves small objects from per-thread free lists for each
+		/// size class. This greatly reduces the overhead of creating and
+		/// destroying many small objects such as SimpleTypedData or
+		/// CompoundData members, particularly when doing so concurrently
+		/// from many threads. It is enabled
+		/// by setting the IECORE_POOLED_ALLOCATION environment variable
+		/// to 1 before the first RefCounted object is created, and the
+		/// choice then remains fixed for the lifetime of the process.
+		/// Building with IECORE_POOLED_ALLOCATION_DEFAULT=1 defined enables
+		/// it when the environment variable isn't set.
+		////////////////////////////////////////////////////////////
+		//@{
+		static void *operator new( size_t size );
+		static void *operator new( size_t size, void *where );
+		/// The size argument is the size of the most derived type, as
+		/// provided by the virtual destructor, and is used to return the
+		/// memory to the appropriate free list.
+		static void operator delete( void *p, size_t size );
+		static void operator delete( void *p, void *where );
+		/// Returns true if pooled allocation is in use.
+		static bool pooledAllocation();
+		/// Returns the number of objects allocated since pooled allocation
+		/// began, summed over all threads. Always 0 if pooled allocation isn't
+		/// in use.
+		static size_t numAllocations();
+		/// Returns the number of the allocations above which couldn't be served
+		/// from a free list, and were passed on to the system allocator instead.
+		static size_t numSystemAllocations();
+		//@}
+
 	protected:
 
 		virtual ~RefCounted();
@@ -46,6 +46,7 @@
 #include <set>
 
 #include "tbb/spin_rw_mutex.h"
+#include "tbb/atomic.h"
 
 namespace IECore
 {
@@ -261,7 +262,9 @@ class IECORE_API RunTimeTyped : public RefCounted
 		static bool inheritsFrom( TypeId typeId );
 		/// Returns true if this class inherits from the specified type.
 		static bool inheritsFrom( const char *typeName );
-		/// Returns true if type inherits from baseType.
+		/// Returns true if type inherits from baseType. This is a constant time
+		/// lookup which takes no locks, and is therefore suitable for use in
+		/// heavily threaded code.
 		static bool inheritsFrom( TypeId type, TypeId baseType );
 		/// Returns true if typeName inherits from baseTypeName.
 		static bool inheritsFrom( const char *typeName, const char *baseTypeName );
@@ -279,6 +282,8 @@ class IECORE_API RunTimeTyped : public RefCounted
 		/// Returns all derived types of the given type, or an empty set if no such derived types exist.
 		/// Should not be called during static initialization as it's likely that not all types will
 		/// have been registered at that point, so to do so would yield an incomplete list.
+		/// The references returned by this function and by baseTypeIds() remain valid
+		/// indefinitely, but do not reflect types registered after the call was made.
 		static const std::set<TypeId> &derivedTypeIds( TypeId typeId );
 
 		/// Returns the corresponding TypeId for the specified
@@ -303,21 +308,14 @@ class IECORE_API RunTimeTyped : public RefCounted
 		};
 
 		typedef std::map< TypeId, TypeId > BaseTypeRegistryMap;
-		typedef std::map< TypeId, std::vector<TypeId> > BaseTypesRegistryMap;
-		typedef std::map< TypeId, std::set< TypeId > > DerivedTypesRegistryMap;
 		
 		typedef tbb::spin_rw_mutex Mutex;
 		
-		static Mutex g_baseTypeIdsMutex;
-		static Mutex g_derivedTypeIdsMutex;
+		/// Guards the registries below, which should only be accessed while
+		/// holding it.
+		static Mutex g_registryMutex;
 		
 		static BaseTypeRegistryMap &baseTypeRegistry();
-		static DerivedTypesRegistryMap &derivedTypesRegistry();
-
-		static BaseTypesRegistryMap &completeBaseTypesRegistry();
-		static DerivedTypesRegistryMap &completeDerivedTypesRegistry();
-
-		static void derivedTypeIdsWalk( TypeId typeId, std::set<TypeId> & );
 
 		typedef std::map<TypeId, std::string> TypeIdsToTypeNamesMap;
 		typedef std::map<std::string, TypeId> TypeNamesToTypeIdsMap;
@@ -325,6 +323,15 @@ class IECORE_API RunTimeTyped : public RefCounted
 		static TypeIdsToTypeNamesMap &typeIdsToTypeNames();
 		static TypeNamesToTypeIdsMap &typeNamesToTypeIds();
 
+	private :
+
+		/// An immutable snapshot of the registries, flattened into tables
+		/// which may be queried without locking. It is built on demand and
+		/// rebuilt lazily after any subsequent registration.
+		struct TypeHierarchy;
+		static tbb::atomic<const TypeHierarchy *> g_typeHierarchy;
+		static const TypeHierarchy &typeHierarchy();
+
 };
 
 IE_CORE_DECLAREPTR( RunTimeTyped );
@@ -37,6 +37,9 @@
 
 #include "OpenEXR/ImathMath.h"
 
+#include "IECore/FastFloat.h"
+#include "IECore/ApproximateDataConversion.h"
+
 namespace IECore
 {
 
@@ -62,6 +65,36 @@ T SRGBToLinearDataConversion<F, T>::operator()( F f ) const
 	}
 }
 
+namespace Detail
+{
+
+struct SRGBToLinearApproximation
+{
+	float operator()( float f ) const
+	{
+		const float k0 = 0.04045f;
+		const float phi = 12.92f;
+		const float alpha = 0.055f;
+		const float exponent = 2.4f;
+		return f <= k0 ? f / phi : fastFloatPow( ( f + alpha ) / ( 1.0f + alpha ), exponent );
+	}
+
+	bool valid( float f ) const
+	{
+		// false for infinities and NaNs, and for values large
+		// enough to take fastFloatExp2() out of range.
+		return f >= -1e30f && f <= 1e15f;
+	}
+};
+
+} // namespace Detail
+
+template<typename F, typename T>
+void SRGBToLinearDataConversion<F, T>::operator()( const F *from, T *to, size_t n ) const
+{
+	approximateDataConversion( *this, Detail::SRGBToLinearApproximation(), from, to, n );
+}
+
 template<typename F, typename T>
 typename SRGBToLinearDataConversion<F, T>::InverseType SRGBToLinearDataConversion<F, T>::inverse() const
 {
@@ -136,6 +136,15 @@ class IECORE_API SceneCache : public SampledSceneInterface
 
 		/// tells you if this scene cache is read only or writable:
 		bool readOnly() const;
+
+		/// Chooses whether the objects, attributes and transforms written from now on
+		/// are stored as single packed blocks, as described in Object::save(). This applies
+		/// to every location in the file, and is only available when writing. Packed and
+		/// regular samples may be mixed in the same file, and both are read transparently.
+		void setPackedObjects( bool packed );
+		/// Returns whether objects are being written as packed blocks. Always false when
+		/// reading.
+		bool getPackedObjects() const;
 		
 		// The attribute names used to mark animated topology and primitive variables
 		// when SceneCache objects are Primitives.
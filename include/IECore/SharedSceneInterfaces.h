@@ -53,6 +53,17 @@ class IECORE_API SharedSceneInterfaces
 		
 		/// Clear the entire cache
 		static void clear();
+
+		/// Sets the maximum number of scenes held in the cache. Because the file
+		/// handles of cached scenes are pooled separately by FileIndexedIO, this
+		/// budget limits only the memory used by their indices, and can be set
+		/// much higher than the number of files a process may have open.
+		static void setMaxScenes( size_t maxScenes );
+		static size_t getMaxScenes();
+
+		/// Returns the number of scenes which have been opened by the cache, including
+		/// those opened again after being evicted.
+		static size_t numLoads();
 	
 	private :
 		
@@ -43,6 +43,7 @@
 #include "boost/iostreams/filtering_stream.hpp"
 
 #include "IECore/Export.h"
+#include "IECore/AlignedAllocator.h"
 #include "IECore/IndexedIO.h"
 #include "IECore/Exception.h"
 #include "IECore/VectorTypedData.h"
@@ -192,12 +193,23 @@ class IECORE_API StreamIndexedIO : public IndexedIO
 				// This function allocates and if in read-mode also reads the Index of the file.
 				void setStream( std::iostream *stream, bool emptyFile );
 
+				/// Closes the stream, releasing any file handle it holds. Only valid in Read
+				/// mode, and must be called with the mutex held. The stream will be opened
+				/// again by reopenStream() the next time it is accessed.
+				void closeStream();
+				/// Called by seekg() if the stream has been closed by closeStream(). Must be
+				/// implemented to reopen the stream by derived classes which close it. The
+				/// default implementation throws.
+				virtual void reopenStream();
+
 				IndexedIO::OpenMode m_openmode;
 				std::iostream *m_stream;
 				Mutex m_mutex;
+				// set each time the stream is accessed, so that derived classes
+				// can tell which streams are in use.
+				bool m_accessed;
 
-				unsigned long m_ioBufferLen;
-				char *m_ioBuffer;
+				AlignedVector<char>::Type m_ioBuffer;
 		};
 		IE_CORE_DECLAREPTR( StreamFile );
 
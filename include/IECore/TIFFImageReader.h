@@ -129,10 +129,10 @@ class IECORE_API TIFFImageReader : public ImageReader
 		unsigned int m_numDirectories;
 		bool m_haveDirectory;
 
-		std::vector<unsigned char> m_buffer;
-
-		// Reads the interlaced data from the current directory into the buffer
-		void readBuffer();
+		// Returns the size of the strips or tiles in the current directory.
+		void blockSize( int &width, int &height );
+		// Decodes the interlaced data for a single strip or tile from the current directory.
+		virtual DataPtr decodeBlock( unsigned int blockIndex );
 
 		Imath::Box2i m_displayWindow;
 		Imath::Box2i m_dataWindow;
@@ -57,6 +57,8 @@ class IECORE_API TransferSmoothSkinningWeightsOp : public ModifyOp
 
 	private :
 
+		struct TransferWeights;
+
 		StringParameterPtr m_targetInfluenceNameParameter;
 		StringVectorParameterPtr m_sourceInfluenceNamesParameter;
 
@@ -45,9 +45,10 @@
 namespace IECore
 {
 
-/// A MeshPrimitiveOp to perform triangulation of MeshPrimitives.
-/// \todo Currently we just do a simple "fan" across the face, but we eventually need
-/// to deal with concave polygons, polgons with holes, and non-planar polygons
+/// A MeshPrimitiveOp to perform triangulation of MeshPrimitives. Convex faces are
+/// triangulated with a simple "fan", and concave faces by ear clipping. Faces are
+/// processed in parallel.
+/// \todo Deal with polygons with holes, and non-planar polygons.
 /// \ingroup geometryProcessingGroup
 class IECORE_API TriangulateOp : public TypedPrimitiveOp<MeshPrimitive>
 {
@@ -94,8 +94,26 @@ class Turbulence
 		/// As above but performs antialiasing using frequency clamping.
 		Value turbulence( const Point &p, PointBaseType filterWidth ) const;
 
+		/// Computes the turbulence values for an array of points, resizing
+		/// result to match. The results are identical to those of the single
+		/// point functions above, but the points are passed through each octave
+		/// in batches and large arrays are evaluated in parallel. Where Point
+		/// and Value are the same type, result may be the same vector as points.
+		void turbulence( const std::vector<Point> &points, std::vector<Value> &result ) const;
+		/// As above but performs antialiasing using frequency clamping.
+		void turbulence( const std::vector<Point> &points, PointBaseType filterWidth, std::vector<Value> &result ) const;
+
 	private :
 
+		// Computes turbulence for the points in the range [begin, end),
+		// one octave at a time. Result may be the same array as begin,
+		// but must not otherwise overlap it.
+		void turbulence( const Point *begin, const Point *end, PointBaseType filterWidth, Value *result ) const;
+
+		struct ParallelTurbulence;
+
+		static const unsigned int m_blockSize = 256;
+
 		// This calculates m_offset and m_scale so as to bring the
 		// result into the appropriate -0.5 to 0.5 range.
 		void calculateScaleAndOffset();
@@ -35,6 +35,10 @@
 #ifndef IE_CORE_TURBULENCE_INL
 #define IE_CORE_TURBULENCE_INL
 
+#include <algorithm>
+
+#include "tbb/parallel_for.h"
+
 namespace IECore
 {
 
@@ -177,6 +181,103 @@ typename Turbulence<N>::Value Turbulence<N>::turbulence( const Point &p, PointBa
 	return result;
 }
 
+template<typename N>
+void Turbulence<N>::turbulence( const Point *begin, const Point *end, PointBaseType filterWidth, Value *result ) const
+{
+	Point p[m_blockSize];
+	Point pp[m_blockSize];
+	Value v[m_blockSize];
+	while( begin < end )
+	{
+		const unsigned int n = std::min<size_t>( end - begin, m_blockSize );
+
+		// Take a copy of the input before the results are zeroed, as
+		// they may be stored in the same array.
+		std::copy( begin, begin + n, p );
+		for( unsigned int j=0; j<n; j++ )
+		{
+			vecSetAll( result[j], 0 );
+		}
+
+		Point frequency; vecSetAll( frequency, 1 );
+		Value scale; vecSetAll( scale, 1 );
+		PointBaseType octaveFilterWidth = filterWidth;
+		for( unsigned int i=0; i<m_octaves; i++ )
+		{
+			for( unsigned int j=0; j<n; j++ )
+			{
+				vecMul( p[j], frequency, pp[j] );
+			}
+			m_noise.noise( pp, pp + n, octaveFilterWidth, v );
+			for( unsigned int j=0; j<n; j++ )
+			{
+				vecMul( v[j], scale, v[j] );
+				if( m_turbulent )
+				{
+					for( unsigned int k=0; k<VectorTraits<Value>::dimensions(); k++ )
+					{
+						vecSet( v[j], k, Imath::Math<ValueBaseType>::fabs( vecGet( v[j], k ) ) );
+					}
+				}
+				vecAdd( result[j], v[j], result[j] );
+			}
+			vecMul( scale, m_gain, scale );
+			vecMul( frequency, m_lacunarity, frequency );
+			octaveFilterWidth *= m_lacunarity;
+		}
+
+		for( unsigned int j=0; j<n; j++ )
+		{
+			vecMul( result[j], m_scale, result[j] );
+			vecAdd( result[j], m_offset, result[j] );
+		}
+
+		begin += n;
+		result += n;
+	}
+}
+
+template<typename N>
+struct Turbulence<N>::ParallelTurbulence
+{
+
+	ParallelTurbulence( const Turbulence &turbulence, const Point *points, PointBaseType filterWidth, Value *result )
+		:	m_turbulence( turbulence ), m_points( points ), m_filterWidth( filterWidth ), m_result( result )
+	{
+	}
+
+	void operator()( const tbb::blocked_range<size_t> &range ) const
+	{
+		m_turbulence.turbulence( m_points + range.begin(), m_points + range.end(), m_filterWidth, m_result + range.begin() );
+	}
+
+	private :
+
+		const Turbulence &m_turbulence;
+		const Point *m_points;
+		PointBaseType m_filterWidth;
+		Value *m_result;
+
+};
+
+template<typename N>
+void Turbulence<N>::turbulence( const std::vector<Point> &points, std::vector<Value> &result ) const
+{
+	turbulence( points, 1.0e-6, result );
+}
+
+template<typename N>
+void Turbulence<N>::turbulence( const std::vector<Point> &points, PointBaseType filterWidth, std::vector<Value> &result ) const
+{
+	result.resize( points.size() );
+	if( points.empty() )
+	{
+		return;
+	}
+	ParallelTurbulence f( *this, &points[0], filterWidth, &result[0] );
+	tbb::parallel_for( tbb::blocked_range<size_t>( 0, points.size(), m_blockSize ), f );
+}
+
 } // namespace IECore
 
 #endif // IE_CORE_TURBULENCE_INL
@@ -50,6 +50,13 @@
 namespace IECore
 {
 
+/// \todo The vector types below store their data in a std::vector with the
+/// standard allocator, so resize() value-initialises elements which are often
+/// overwritten immediately afterwards. Temporary buffers may use AlignedVector
+/// to avoid this, but the types themselves can only switch to AlignedAllocator
+/// in a major version, as client code binds readable() and writable() to
+/// std::vector<T> references.
+
 // vectors of basic types
 
 IECORE_DECLARE_TYPEDDATA( BoolVectorData, std::vector<bool>, void, SharedDataHolder )
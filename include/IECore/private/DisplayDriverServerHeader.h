@@ -43,22 +43,37 @@ namespace IECore
 /* Header block used by back and forth messages with the server.
 * 7 bytes long:
 * [0] - magic number ( 0x82 )
-* [1] - protocol version ( 1 )
-* [2] - message type ( imageOpen, imageData, imageClose )
+* [1] - protocol version ( 1 or 2 )
+* [2] - message type ( imageOpen, imageData, imageClose, exception, imageBucket )
 * [3-6] - length of following data block.
+*
+* The data block for imageOpen and imageData messages is a MemoryIndexedIO
+* buffer. The data block for imageBucket messages is a compact binary framing
+* which the server can read straight into the display driver's input buffer :
+* [0-15] - box min.x, min.y, max.x, max.y as little endian 32 bit integers.
+* [16-] - the pixel data as little endian 32 bit floats.
+*
+* Messages are sent with protocol version 1, so that they are understood by
+* servers and clients which predate version 2, unless both ends are known to
+* support version 2. A client advertises its version with a "clientProtocolVersion"
+* IntData in the imageOpen parameters, and the server replies to imageOpen with
+* the version to be used for the rest of the session. The imageBucket message
+* is only valid in version 2.
 */
 class DisplayDriverServerHeader
 {
 	public:
 
-		enum MessageType { imageOpen = 1, imageData = 2, imageClose = 3, exception = 4 };
+		enum MessageType { imageOpen = 1, imageData = 2, imageClose = 3, exception = 4, imageBucket = 5 };
+
+		static const unsigned char bucketBoxLength = 16;
 
 		static const unsigned char headerLength = 7;
 		static const unsigned char magicNumber = 0x82;
-		static const unsigned char currentProtocolVersion = 1;
+		static const unsigned char currentProtocolVersion = 2;
 
 		DisplayDriverServerHeader();
-		DisplayDriverServerHeader( MessageType msg, size_t dataSize );
+		DisplayDriverServerHeader( MessageType msg, size_t dataSize, unsigned char protocolVersion = 1 );
 
 		// returns internal buffer ( length = headerLength constant )
 		unsigned char *buffer();
@@ -75,6 +90,9 @@ class DisplayDriverServerHeader
 		// returns the message type defined in the header.
 		MessageType messageType();
 
+		// returns the protocol version defined in the header.
+		unsigned char protocolVersion();
+
 	private:
 
 		unsigned char m_header[ headerLength ];
@@ -76,6 +76,12 @@ class IECOREGL_API Camera : public Renderable
 		/// Returns an empty box.
 		virtual Imath::Box3f bound() const;
 
+		/// Returns the projection matrix loaded by render(). This is computed
+		/// without reference to the GL state, so can be used to work with the
+		/// camera without a GL context. The default implementation returns the
+		/// identity.
+		virtual Imath::M44f projection() const;
+
 		//! @name OpenGL query functions
 		/// These functions provide basic information about the
 		/// current OpenGL camera based entirely on the current
@@ -41,6 +41,7 @@
 #include "OpenEXR/ImathMatrix.h"
 
 #include "tbb/recursive_mutex.h"
+#include "tbb/atomic.h"
 #include <list>
 
 
@@ -76,8 +77,26 @@ class IECOREGL_API Group : public Renderable
 
 		// render method ( assumes there's no threads modifying the group ).
 		virtual void render( State *currentState ) const;
+		/// As above, but skips any children whose bounds lie entirely outside
+		/// the view frustum. The frustum is specified as the matrix transforming
+		/// from the space this group's transform is applied in to GL clip space,
+		/// which for the root of a scene is Camera::matrix() * Camera::projectionMatrix().
+		/// Children with empty bounds are always rendered.
+		void render( State *currentState, const Imath::M44f &clipMatrix ) const;
+		/// Returns the bound of the children, transformed by getTransform().
+		/// The result is cached until the next edit to any Group, which
+		/// assumes that the bounds of primitives are not changed after they
+		/// are added to a Group.
 		virtual Imath::Box3f bound() const;
 
+		/// Returns true if any part of the box might be inside the view frustum
+		/// specified by the clip matrix. This is the test used by the culling
+		/// render() method above, and doesn't require a GL context.
+		static bool intersectsFrustum( const Imath::Box3f &box, const Imath::M44f &clipMatrix );
+		/// Returns a count which is incremented whenever any Group is edited.
+		/// This can be used to invalidate data derived from a scene.
+		static size_t editCount();
+
 		void addChild( RenderablePtr child );
 		void removeChild( Renderable *child );
 		void clearChildren();
@@ -90,11 +109,18 @@ class IECOREGL_API Group : public Renderable
 
 	private :
 
+		void renderInternal( State *currentState, const Imath::M44f *clipMatrix ) const;
+
 		StatePtr m_state;
 		Imath::M44f m_transform;
 		ChildContainer m_children;
 		mutable Mutex m_mutex;
 
+		mutable Imath::Box3f m_bound;
+		mutable size_t m_boundEditCount;
+
+		static tbb::atomic<size_t> g_editCount;
+
 };
 
 IE_CORE_DECLAREPTR( Group );
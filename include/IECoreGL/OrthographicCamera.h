@@ -55,6 +55,7 @@ class IECOREGL_API OrthographicCamera : public Camera
 		IE_CORE_DECLARERUNTIMETYPEDEXTENSION( IECoreGL::OrthographicCamera, OrthographicCameraTypeId, Camera );
 
 		virtual void render( State *currentState ) const;
+		virtual Imath::M44f projection() const;
 
 };
 
@@ -35,6 +35,8 @@
 #ifndef IECOREGL_SCENE_H
 #define IECOREGL_SCENE_H
 
+#include "tbb/mutex.h"
+
 #include "IECoreGL/Export.h"
 #include "IECoreGL/Renderable.h"
 #include "IECoreGL/HitRecord.h"
@@ -72,6 +74,19 @@ class IECOREGL_API Scene : public Renderable
 		/// \todo Have an overload which takes a Box2i specifying a raster space region
 		/// instead.
 		size_t select( Selector::Mode mode, const Imath::Box2f &region, std::vector<HitRecord> &hits ) const;
+		/// As above, but performs the selection on the CPU, so no GL context is required.
+		/// The Scene must have a camera. The bounds of all named, selectable primitives
+		/// are tested against the region, using a hierarchy which is built on demand and
+		/// rebuilt only after the scene has been edited (see Group::editCount()). Because
+		/// bounds rather than the geometry itself are tested, the hits are conservative,
+		/// and the depths are those of the bounds.
+		size_t select( const Imath::Box2f &region, std::vector<HitRecord> &hits ) const;
+
+		/// Frustum culling skips the rendering of Groups and Primitives which lie entirely
+		/// outside the view in render() and select(). It is on by default, but may
+		/// need to be turned off if custom shaders move geometry outside of its bounds.
+		void setFrustumCulling( bool frustumCulling );
+		bool getFrustumCulling() const;
 
 		/// Sets the camera used to view the scene. If unspecified then
 		/// you may position the scene using raw gl calls before
@@ -89,8 +104,15 @@ class IECOREGL_API Scene : public Renderable
 
 	private :
 
+		void renderRoot( State *state ) const;
+
 		GroupPtr m_root;
 		CameraPtr m_camera;
+		bool m_frustumCulling;
+
+		IE_CORE_FORWARDDECLARE( SelectionIndex );
+		mutable SelectionIndexPtr m_selectionIndex;
+		mutable tbb::mutex m_selectionIndexMutex;
 
 };
 
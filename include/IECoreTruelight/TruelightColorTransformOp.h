@@ -35,6 +35,8 @@
 #ifndef IECORETRUELIGHT_TRUELIGHTCOLORTRANSFORMOP_H
 #define IECORETRUELIGHT_TRUELIGHTCOLORTRANSFORMOP_H
 
+#include "tbb/mutex.h"
+
 #include "IECoreTruelight/TypeIds.h"
 
 #include "IECore/ColorTransformOp.h"
@@ -75,6 +77,9 @@ class TruelightColorTransformOp : public IECore::ColorTransformOp
 
 		virtual void begin( const IECore::CompoundObject * operands );
 		virtual void transform( Imath::Color3f &color ) const;
+		/// The truelight instance can't be used concurrently, so spans
+		/// are serialised.
+		virtual void transformSpan( float *r, float *g, float *b, size_t n ) const;
 
 	private :
 
@@ -89,6 +94,7 @@ class TruelightColorTransformOp : public IECore::ColorTransformOp
 		IECore::SRGBToLinearDataConversion<float, float> m_srgbToLinearConversion;
 
 		void *m_instance; // truelight instance
+		mutable tbb::mutex m_instanceMutex;
 
 };
 
@@ -67,10 +67,27 @@ struct CINImageReader::Header
 	/// Map from channel names to index into ImageInformation.channel_information array
 	typedef map< string, int > ChannelOffsetMap;
 	map< string, int > m_channelOffsets;
+
+	/// The file is kept open so that decodeBlock() reads from the
+	/// same file as the header was read from.
+	std::ifstream m_stream;
 };
 
 IE_CORE_DEFINERUNTIMETYPED( CINImageReader );
-const Reader::ReaderDescription<CINImageReader> CINImageReader::m_readerDescription( "cin" );
+
+static const int g_scanlinesPerBlock = 64;
+static bool canReadMagic( const char *data, size_t size )
+{
+	if( size < sizeof( unsigned int ) )
+	{
+		return false;
+	}
+	unsigned int magic;
+	memcpy( &magic, data, sizeof( unsigned int ) );
+	return magic == 0xd75f2a80 || magic == 0x802a5fd7;
+}
+
+const Reader::ReaderDescription<CINImageReader> CINImageReader::m_readerDescription( "cin", canReadMagic, true );
 
 CINImageReader::CINImageReader() :
 		ImageReader( "Reads Kodak Cineon (CIN) files." ),
@@ -108,14 +125,9 @@ bool CINImageReader::canRead( const string &fileName )
 	}
 
 	// check magic number
-	unsigned int magic;
-	in.read((char *) &magic, sizeof(unsigned int));
-	if ( in.fail() )
-	{
-		return false;
-	}
-
-	return magic == 0xd75f2a80 || magic == 0x802a5fd7;
+	char magic[sizeof(unsigned int)];
+	in.read( magic, sizeof(unsigned int) );
+	return canReadMagic( magic, in.gcount() );
 }
 
 void CINImageReader::channelNames( vector<string> &names )
@@ -203,17 +215,29 @@ DataPtr CINImageReader::readTypedChannel( const std::string &name, const Imath::
 	const int xMin = dataWindow.min.x - wholeDataWindow.min.x;
 	const int xMax = dataWindow.max.x - wholeDataWindow.min.x;
 
+	// only the blocks of scanlines overlapping the data window are read
+	ConstUIntVectorDataPtr scanlines = 0;
+	int blockIndex = -1;
+
 	int dataY = 0;
 	for ( int y = yMin ; y <= yMax ; ++y, ++dataY )
 	{
+		if ( y / g_scanlinesPerBlock != blockIndex )
+		{
+			blockIndex = y / g_scanlinesPerBlock;
+			scanlines = boost::static_pointer_cast<const UIntVectorData>( block( blockIndex ) );
+		}
+
 		typename TargetVector::ValueType::size_type dataOffset = dataY * dataWidth;
-		std::vector<unsigned int>::size_type bufferOffset = y * m_bufferWidth + xMin;
+		std::vector<unsigned int>::size_type bufferOffset = ( y - blockIndex * g_scanlinesPerBlock ) * m_bufferWidth + xMin;
+		const std::vector<unsigned int> &buffer = scanlines->readable();
 
 		for ( int x = xMin;  x <= xMax ; ++x, ++dataOffset, ++bufferOffset  )
 		{
 			assert( dataOffset < data.size() );
+			assert( bufferOffset < buffer.size() );
 
-			unsigned int cell = m_buffer[ bufferOffset ];
+			unsigned int cell = buffer[ bufferOffset ];
 			if ( m_reverseBytes )
 			{
 				cell = reverseBytes( cell );
@@ -247,6 +271,32 @@ DataPtr CINImageReader::readChannel( const string &name, const Imath::Box2i &dat
 	return dataContainer;
 }
 
+DataPtr CINImageReader::decodeBlock( unsigned int blockIndex )
+{
+	// remember that we're currently packing upto 3 channels into each 32-bit "cell"
+	const unsigned int cellsPerPixel = std::max<unsigned int>( 1u, m_header->m_channelOffsets.size() / 3 );
+	const unsigned int firstScanline = blockIndex * g_scanlinesPerBlock;
+	const unsigned int numScanlines = std::min<unsigned int>( g_scanlinesPerBlock, m_bufferHeight - firstScanline );
+
+	UIntVectorDataPtr result = new UIntVectorData;
+	std::vector<unsigned int> &buffer = result->writable();
+	buffer.resize( cellsPerPixel * m_bufferWidth * numScanlines, 0 );
+
+	// we read from the stream opened by open(), so that the data is guaranteed
+	// to come from the same file as the header, even if the file has since been
+	// replaced.
+	ifstream &in = m_header->m_stream;
+	in.clear();
+	in.seekg( m_header->m_fileInformation.image_data_offset + sizeof( unsigned int ) * cellsPerPixel * m_bufferWidth * firstScanline, ios_base::beg );
+	in.read( reinterpret_cast<char*>( &buffer[0] ), sizeof( unsigned int ) * buffer.size() );
+	if ( in.fail() )
+	{
+		throw IOException( "CINImageReader: Error reading " + fileName() );
+	}
+
+	return result;
+}
+
 bool CINImageReader::open( bool throwOnFailure )
 {
 	if ( fileName() == m_bufferFileName )
@@ -259,11 +309,11 @@ bool CINImageReader::open( bool throwOnFailure )
 	try
 	{
 		m_bufferFileName = fileName();
-		m_buffer.clear();
 		delete m_header;
 		m_header = new Header();
 
-		ifstream in( m_bufferFileName.c_str() );
+		ifstream &in = m_header->m_stream;
+		in.open( m_bufferFileName.c_str() );
 
 		if ( !in.is_open() || in.fail() )
 		{
@@ -411,15 +461,15 @@ bool CINImageReader::open( bool throwOnFailure )
 			throw IOException( "CINImageReader: Error reading " + fileName() );
 		}
 
-		// Read the data into the buffer - remember that we're currently packing upto 3 channels into each 32-bit "cell"
-		int bufferSize = ( std::max<unsigned int>( 1u, m_header->m_channelOffsets.size() / 3 ) ) * m_bufferWidth * m_bufferHeight;
-		m_buffer.resize( bufferSize, 0 );
-
-		in.read( reinterpret_cast<char*>(&m_buffer[0]), sizeof(unsigned int) * bufferSize );
-		if ( in.fail() )
+		// The pixel data itself is read on demand by decodeBlock(), but we check
+		// that it's all present so that isComplete() can detect truncated files.
+		in.seekg( 0, ios_base::end );
+		if ( in.fail() || (size_t)in.tellg() < m_header->m_fileInformation.image_data_offset + sizeof( unsigned int ) * m_bufferWidth * m_bufferHeight * std::max<unsigned int>( 1u, m_header->m_channelOffsets.size() / 3 ) )
 		{
 			throw IOException( "CINImageReader: Error reading " + fileName() );
 		}
+
+		blockSourceChanged();
 	}
 	catch (...)
 	{
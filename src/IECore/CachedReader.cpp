@@ -32,11 +32,18 @@
 //
 //////////////////////////////////////////////////////////////////////////
 
+#include <deque>
+#include <map>
+
 #include "tbb/mutex.h"
+#include "tbb/atomic.h"
 #include "tbb/concurrent_hash_map.h"
 
 #include "boost/format.hpp"
 #include "boost/lexical_cast.hpp"
+#include "boost/bind.hpp"
+#include "boost/exception_ptr.hpp"
+#include "boost/thread.hpp"
 
 #include "IECore/CachedReader.h"
 #include "IECore/ComputationCache.h"
@@ -64,6 +71,19 @@ struct CachedReader::MemberData
 		{
 		}
 
+		~MemberData()
+		{
+			{
+				IOMutex::scoped_lock lock( m_ioMutex );
+				// a job without a promise tells an I/O thread to exit. they're
+				// queued after any outstanding work, so that all futures are
+				// fulfilled before we shut down.
+				m_ioJobs.insert( m_ioJobs.end(), m_ioThreads.size(), IOJob() );
+				m_ioJobsCondition.notify_all();
+			}
+			m_ioThreads.join_all();
+		}
+
 		typedef std::pair< std::string, MemberData * > ComputeParameters;
 		typedef IECore::ComputationCache< ComputeParameters > Cache;
 
@@ -74,8 +94,183 @@ struct CachedReader::MemberData
 		typedef tbb::concurrent_hash_map< std::string, std::string > FileErrors;
 		FileErrors m_fileErrors;		
 
+		// Shared by all the jobs queued by a single call to prefetch(), to
+		// track how much memory they have loaded between them.
+		struct PrefetchBatch
+		{
+			size_t maxMemory;
+			tbb::atomic<size_t> loadedMemory;
+		};
+		typedef boost::shared_ptr<PrefetchBatch> PrefetchBatchPtr;
+
+		// Queues a load for the file unless it is cached already, returning
+		// a future for the result. Requests for files which are already in
+		// flight are coalesced with the existing load.
+		Future queue( const std::string &file, PrefetchBatchPtr batch )
+		{
+			ConstObjectPtr cached = m_cache.get( ComputeParameters( file, this ), Cache::NullIfMissing );
+			if( cached )
+			{
+				boost::promise<ConstObjectPtr> promise;
+				promise.set_value( cached );
+				return Future( promise.get_future() );
+			}
+
+			IOMutex::scoped_lock lock( m_ioMutex );
+
+			InFlightMap::iterator it = m_inFlight.find( file );
+			if( it != m_inFlight.end() )
+			{
+				if( !batch )
+				{
+					it->second.requested = true;
+				}
+				return it->second.future;
+			}
+
+			IOJob job;
+			job.file = file;
+			job.promise.reset( new boost::promise<ConstObjectPtr> );
+			job.batch = batch;
+
+			InFlight &inFlight = m_inFlight[file];
+			inFlight.future = Future( job.promise->get_future() );
+			inFlight.requested = !batch;
+
+			m_ioJobs.push_back( job );
+			if( m_ioThreads.size() < maxIOThreads() && m_ioThreads.size() < m_inFlight.size() )
+			{
+				m_ioThreads.create_thread( boost::bind( &MemberData::ioThread, this ) );
+			}
+			m_ioJobsCondition.notify_one();
+
+			return inFlight.future;
+		}
+
+		// Returns true and fills future if the file is currently being loaded
+		// in the background.
+		bool inFlight( const std::string &file, Future &future )
+		{
+			IOMutex::scoped_lock lock( m_ioMutex );
+			if( m_inFlight.empty() )
+			{
+				return false;
+			}
+			InFlightMap::iterator it = m_inFlight.find( file );
+			if( it == m_inFlight.end() )
+			{
+				return false;
+			}
+			it->second.requested = true;
+			future = it->second.future;
+			return true;
+		}
+
+		void waitForPendingReads()
+		{
+			IOMutex::scoped_lock lock( m_ioMutex );
+			while( !m_inFlight.empty() )
+			{
+				m_idleCondition.wait( lock );
+			}
+		}
+
 	private :
 
+		struct IOJob
+		{
+			std::string file;
+			boost::shared_ptr<boost::promise<ConstObjectPtr> > promise;
+			PrefetchBatchPtr batch;
+		};
+
+		struct InFlight
+		{
+			Future future;
+			// true if anything other than a prefetch is waiting on the future
+			bool requested;
+		};
+
+		typedef boost::mutex IOMutex;
+		typedef std::map<std::string, InFlight> InFlightMap;
+
+		IOMutex m_ioMutex;
+		std::deque<IOJob> m_ioJobs;
+		InFlightMap m_inFlight;
+		boost::condition_variable m_ioJobsCondition;
+		boost::condition_variable m_idleCondition;
+		boost::thread_group m_ioThreads;
+
+		static size_t maxIOThreads()
+		{
+			// the threads spend much of their time waiting on the filesystem,
+			// but decoding and post processing need the cpu too.
+			return std::min( std::max( boost::thread::hardware_concurrency(), 2u ), 8u );
+		}
+
+		void ioThread()
+		{
+			while( true )
+			{
+				IOJob job;
+				{
+					IOMutex::scoped_lock lock( m_ioMutex );
+					while( m_ioJobs.empty() )
+					{
+						m_ioJobsCondition.wait( lock );
+					}
+					job = m_ioJobs.front();
+					m_ioJobs.pop_front();
+
+					if( !job.promise )
+					{
+						return;
+					}
+
+					if( job.batch && job.batch->loadedMemory >= job.batch->maxMemory && !m_inFlight[job.file].requested )
+					{
+						// the prefetch has already loaded all that the pool can hold,
+						// and nobody has asked for this file explicitly, so don't load it.
+						// nothing can be waiting on the promise, so its value is irrelevant.
+						job.promise->set_value( 0 );
+						finishJob( job.file );
+						continue;
+					}
+				}
+
+				try
+				{
+					ConstObjectPtr o = m_cache.get( ComputeParameters( job.file, this ) );
+					if( job.batch && o )
+					{
+						job.batch->loadedMemory += o->memoryUsage();
+					}
+					job.promise->set_value( o );
+				}
+				catch( std::exception &e )
+				{
+					job.promise->set_exception( boost::copy_exception( Exception( e.what() ) ) );
+				}
+				catch( ... )
+				{
+					job.promise->set_exception( boost::copy_exception( Exception( "Unexpected error." ) ) );
+				}
+
+				IOMutex::scoped_lock lock( m_ioMutex );
+				finishJob( job.file );
+			}
+		}
+
+		// Must be called with m_ioMutex held.
+		void finishJob( const std::string &file )
+		{
+			m_inFlight.erase( file );
+			if( m_inFlight.empty() )
+			{
+				m_idleCondition.notify_all();
+			}
+		}
+
 		void registerFileError( const std::string &filePath, const std::string &errorMsg )
 		{
 			FileErrors::accessor it;
@@ -187,9 +382,36 @@ CachedReader::CachedReader( const SearchPath &paths, ConstModifyOpPtr postProces
 
 ConstObjectPtr CachedReader::read( const std::string &file )
 {
+	Future future;
+	if( m_data->inFlight( file, future ) )
+	{
+		// wait for the background load rather than duplicating it
+		return future.get();
+	}
 	return m_data->m_cache.get( PARAM(file) );
 }
 
+CachedReader::Future CachedReader::readAsync( const std::string &file )
+{
+	return m_data->queue( file, MemberData::PrefetchBatchPtr() );
+}
+
+void CachedReader::prefetch( const std::vector<std::string> &files )
+{
+	MemberData::PrefetchBatchPtr batch( new MemberData::PrefetchBatch );
+	batch->maxMemory = objectPool()->getMaxMemoryUsage();
+	batch->loadedMemory = 0;
+	for( std::vector<std::string>::const_iterator it = files.begin(); it != files.end(); ++it )
+	{
+		m_data->queue( *it, batch );
+	}
+}
+
+void CachedReader::waitForPendingReads()
+{
+	m_data->waitForPendingReads();
+}
+
 void CachedReader::insert( const std::string &file, ConstObjectPtr obj )
 {
 	m_data->m_fileErrors.erase( file );
@@ -35,11 +35,13 @@
 
 #include "boost/asio.hpp"
 #include "boost/bind.hpp"
+#include "boost/array.hpp"
 
 #include "IECore/ClientDisplayDriver.h"
 #include "IECore/private/DisplayDriverServerHeader.h"
 #include "IECore/SimpleTypedData.h"
 #include "IECore/MemoryIndexedIO.h"
+#include "IECore/ByteOrder.h"
 
 using namespace boost;
 using namespace std;
@@ -51,7 +53,7 @@ class ClientDisplayDriver::PrivateData : public RefCounted
 {
 	public :
 		PrivateData() :
-		m_service(), m_host(""), m_port(""), m_scanLineOrderOnly(false), m_acceptsRepeatedData(false), m_socket( m_service )
+		m_service(), m_host(""), m_port(""), m_scanLineOrderOnly(false), m_acceptsRepeatedData(false), m_protocolVersion( 1 ), m_socket( m_service )
 		{
 		}
 
@@ -65,6 +67,9 @@ class ClientDisplayDriver::PrivateData : public RefCounted
 		std::string m_port;
 		bool m_scanLineOrderOnly;
 		bool m_acceptsRepeatedData;
+		// The protocol version agreed with the server
+		// in response to the imageOpen message.
+		unsigned char m_protocolVersion;
 		boost::asio::ip::tcp::socket m_socket;
 };
 
@@ -110,6 +115,9 @@ ClientDisplayDriver::ClientDisplayDriver( const Imath::Box2i &displayWindow, con
 
 	IECore::CompoundDataPtr tmpParameters = parameters->copy();
 	tmpParameters->writable()[ "clientPID" ] = new IntData( getpid() );
+	// servers which understand it will reply with a header of this
+	// version, enabling the imageBucket message.
+	tmpParameters->writable()[ "clientProtocolVersion" ] = new IntData( DisplayDriverServerHeader::currentProtocolVersion );
 
 	// build the data block
 	io = new MemoryIndexedIO( ConstCharVectorDataPtr(), IndexedIO::rootPath, IndexedIO::Exclusive | IndexedIO::Write );
@@ -189,27 +197,56 @@ size_t ClientDisplayDriver::receiveHeader( int msg )
 	{
 		throw Exception( "Unexpected message type on display driver socket package." );
 	}
+	if ( msg == DisplayDriverServerHeader::imageOpen )
+	{
+		// servers which predate protocol version 2 will
+		// always reply with version 1.
+		m_data->m_protocolVersion = header.protocolVersion();
+	}
 	return bytesAhead;
 }
 
 void ClientDisplayDriver::imageData( const Box2i &box, const float *data, size_t dataSize )
 {
-	MemoryIndexedIOPtr io;
-	ConstCharVectorDataPtr buf;
+	if( m_data->m_protocolVersion < 2 || bigEndian() )
+	{
+		// the server doesn't support the imageBucket message, or we are big
+		// endian, in which case rather than make a byte swapped copy of the
+		// little endian bucket framing, we fall back to the endian safe
+		// IndexedIO encoding.
+		MemoryIndexedIOPtr io;
+		ConstCharVectorDataPtr buf;
+
+		// build the data block
+		Box2iDataPtr boxData = new Box2iData( box );
+		FloatVectorDataPtr dataData = new FloatVectorData( std::vector<float>( data, data+dataSize ) );
+
+		io = new MemoryIndexedIO( ConstCharVectorDataPtr(), IndexedIO::rootPath, IndexedIO::Exclusive | IndexedIO::Write );
+		boost::static_pointer_cast<Object>(boxData)->save( io, "box" );
+		boost::static_pointer_cast<Object>(dataData)->save( io, "data" );
+		buf = io->buffer();
+		size_t blockSize = buf->readable().size();
+
+		sendHeader( DisplayDriverServerHeader::imageData, blockSize );
+
+		m_data->m_socket.send( boost::asio::buffer( &(buf->readable()[0]), blockSize) );
+		return;
+	}
 
-	// build the data block
-	Box2iDataPtr boxData = new Box2iData( box );
-	FloatVectorDataPtr dataData = new FloatVectorData( std::vector<float>( data, data+dataSize ) );
+	// send the header, the box and the pixels in a single gather write, so the
+	// pixel data goes straight from the caller's buffer onto the socket.
+	size_t blockSize = DisplayDriverServerHeader::bucketBoxLength + dataSize * sizeof( float );
+	DisplayDriverServerHeader header( DisplayDriverServerHeader::imageBucket, blockSize, m_data->m_protocolVersion );
 
-	io = new MemoryIndexedIO( ConstCharVectorDataPtr(), IndexedIO::rootPath, IndexedIO::Exclusive | IndexedIO::Write );
-	boost::static_pointer_cast<Object>(boxData)->save( io, "box" );
-	boost::static_pointer_cast<Object>(dataData)->save( io, "data" );
-	buf = io->buffer();
-	size_t blockSize = buf->readable().size();
+	int32_t boxData[4] = { box.min.x, box.min.y, box.max.x, box.max.y };
 
-	sendHeader( DisplayDriverServerHeader::imageData, blockSize );
+	boost::array<boost::asio::const_buffer, 3> buffers = { {
+		boost::asio::buffer( header.buffer(), header.headerLength ),
+		boost::asio::buffer( boxData, sizeof( boxData ) ),
+		boost::asio::buffer( data, dataSize * sizeof( float ) )
+	} };
 
-	m_data->m_socket.send( boost::asio::buffer( &(buf->readable()[0]), blockSize) );
+	boost::asio::write( m_data->m_socket, buffers );
 }
 
 void ClientDisplayDriver::imageClose()
@@ -32,6 +32,10 @@
 //
 //////////////////////////////////////////////////////////////////////////
 
+#include <algorithm>
+
+#include "tbb/tbb.h"
+
 #include "IECore/ColorTransformOp.h"
 #include "IECore/CompoundObject.h"
 #include "IECore/CompoundParameter.h"
@@ -198,37 +202,97 @@ const typename T::BaseType *ColorTransformOp::alphaData( Primitive * primitive,
 	return d->baseReadable();
 }
 
-template <typename T>
-void ColorTransformOp::transformSeparate( Primitive * primitive, const CompoundObject * operands, T * r, T * g, T * b )
-{
-	size_t n = r->baseSize();
-	const typename T::BaseType *alpha = alphaData<T>( primitive, n );
+/// The number of elements converted to float and passed to transformSpan() at once.
+/// This is kept small enough that the temporary arrays stay in the cache.
+static const size_t g_spanLength = 256;
 
-	typename T::BaseType *rw = r->baseWritable();
-	typename T::BaseType *gw = g->baseWritable();
-	typename T::BaseType *bw = b->baseWritable();
+template<typename T>
+class ColorTransformOp::TransformSpans
+{
+	public :
 
-	begin( operands );
+		TransformSpans( const ColorTransformOp *op, T *r, T *g, T *b, size_t stride, const T *alpha )
+			:	m_op( op ), m_r( r ), m_g( g ), m_b( b ), m_stride( stride ), m_alpha( alpha )
+		{
+		}
 
-	try
-	{
-		for( size_t i=0; i<n; i++ )
+		void operator()( const tbb::blocked_range<size_t> &range ) const
 		{
-			Color3f c( *rw, *gw, *bw );
-			if( alpha && *alpha > 0 )
-			{
-				c /= *alpha;
-			}
-			transform( c );
-			if( alpha )
+			float r[g_spanLength];
+			float g[g_spanLength];
+			float b[g_spanLength];
+
+			for( size_t spanBegin = range.begin(); spanBegin < range.end(); spanBegin += g_spanLength )
 			{
-				c *= *alpha++;
+				const size_t n = std::min( g_spanLength, range.end() - spanBegin );
+
+				for( size_t i = 0; i < n; i++ )
+				{
+					const size_t e = ( spanBegin + i ) * m_stride;
+					r[i] = m_r[e];
+					g[i] = m_g[e];
+					b[i] = m_b[e];
+				}
+
+				if( m_alpha )
+				{
+					const T *alpha = m_alpha + spanBegin;
+					for( size_t i = 0; i < n; i++ )
+					{
+						if( alpha[i] > 0 )
+						{
+							const float a = alpha[i];
+							r[i] /= a;
+							g[i] /= a;
+							b[i] /= a;
+						}
+					}
+				}
+
+				m_op->transformSpan( r, g, b, n );
+
+				if( m_alpha )
+				{
+					const T *alpha = m_alpha + spanBegin;
+					for( size_t i = 0; i < n; i++ )
+					{
+						const float a = alpha[i];
+						r[i] *= a;
+						g[i] *= a;
+						b[i] *= a;
+					}
+				}
+
+				for( size_t i = 0; i < n; i++ )
+				{
+					const size_t e = ( spanBegin + i ) * m_stride;
+					m_r[e] = r[i];
+					m_g[e] = g[i];
+					m_b[e] = b[i];
+				}
 			}
-			
-			*rw++ = c[0];
-			*gw++ = c[1];
-			*bw++ = c[2];
 		}
+
+	private :
+
+		const ColorTransformOp *m_op;
+		T *m_r;
+		T *m_g;
+		T *m_b;
+		size_t m_stride;
+		const T *m_alpha;
+
+};
+
+template <typename T>
+void ColorTransformOp::transformSpans( const CompoundObject * operands, T *r, T *g, T *b, size_t stride, size_t n, const T *alpha )
+{
+	begin( operands );
+
+	try
+	{
+		TransformSpans<T> transformSpans( this, r, g, b, stride, alpha );
+		tbb::parallel_for( tbb::blocked_range<size_t>( 0, n, g_spanLength ), transformSpans );
 	}
 	catch ( ... )
 	{
@@ -239,6 +303,15 @@ void ColorTransformOp::transformSeparate( Primitive * primitive, const CompoundO
 	end();
 }
 
+template <typename T>
+void ColorTransformOp::transformSeparate( Primitive * primitive, const CompoundObject * operands, T * r, T * g, T * b )
+{
+	size_t n = r->baseSize();
+	const typename T::BaseType *alpha = alphaData<T>( primitive, n );
+
+	transformSpans( operands, r->baseWritable(), g->baseWritable(), b->baseWritable(), 1, n, alpha );
+}
+
 template<typename T>
 void ColorTransformOp::transformInterleaved( Primitive * primitive, const CompoundObject * operands, T * colors )
 {
@@ -247,36 +320,8 @@ void ColorTransformOp::transformInterleaved( Primitive * primitive, const Compou
 
 	const typename T::BaseType *alpha = alphaData<TypedData<std::vector<typename T::BaseType> > >( primitive, numElements );
 
-	begin( operands );
-	try
-	{
-
-		size_t i = 0;
-		typename T::BaseType *data = colors->baseWritable();
-		for( i=0; i<numElements; i++ )
-		{
-			Color3f c( data[0], data[1], data[2] );
-			if( alpha && *alpha > 0 )
-			{
-				c /= *alpha;
-			}
-			transform( c );
-			if( alpha )
-			{
-				c *= *alpha++;
-			}
-			*data++ = c[0];
-			*data++ = c[1];
-			*data++ = c[2];
-		}
-	}
-	catch ( ... )
-	{
-		end();
-		throw;
-	}
-
-	end();
+	typename T::BaseType *data = colors->baseWritable();
+	transformSpans( operands, data, data + 1, data + 2, 3, numElements, alpha );
 }
 
 void ColorTransformOp::modifyPrimitive( Primitive * primitive, const CompoundObject * operands )
@@ -369,6 +414,18 @@ void ColorTransformOp::begin( const CompoundObject * operands )
 {
 }
 
+void ColorTransformOp::transformSpan( float *r, float *g, float *b, size_t n ) const
+{
+	for( size_t i = 0; i < n; i++ )
+	{
+		Color3f c( r[i], g[i], b[i] );
+		transform( c );
+		r[i] = c[0];
+		g[i] = c[1];
+		b[i] = c[2];
+	}
+}
+
 void ColorTransformOp::end()
 {
 }
@@ -69,13 +69,15 @@ void CompoundObject::copyFrom( const Object *other, CopyContext *context )
 	Object::copyFrom( other, context );
 	const CompoundObject *tOther = static_cast<const CompoundObject *>( other );
 	m_members.clear();
+	m_members.reserve( tOther->m_members.size() );
 	for( ObjectMap::const_iterator it=tOther->m_members.begin(); it!=tOther->m_members.end(); it++ )
 	{
 		if ( !it->second )
 		{
 			throw Exception( "Cannot copy CompoundObject will NULL data pointers!" );
 		}
-		m_members[it->first] = context->copy<Object>( it->second.get() );
+		// the source is already sorted, so appending is always correct
+		m_members.insert( m_members.end(), ObjectMap::value_type( it->first, context->copy<Object>( it->second.get() ) ) );
 	}
 }
 
@@ -102,12 +104,18 @@ void CompoundObject::load( LoadContextPtr context )
 
 	IndexedIO::EntryIDList memberNames;
 	container->entryIds( memberNames );
-	IndexedIO::EntryIDList::const_iterator it;
 
-	for( it=memberNames.begin(); it!=memberNames.end(); it++ )
+	std::vector<ObjectPtr> members;
+	context->load<Object>( std::vector<ConstIndexedIOPtr>( memberNames.size(), container ), memberNames, members );
+	std::vector<ObjectMap::value_type> values;
+	values.reserve( memberNames.size() );
+	for( size_t i = 0; i < memberNames.size(); i++ )
 	{
-		m_members[*it] = context->load<Object>( container.get(), *it );
+		values.push_back( ObjectMap::value_type( memberNames[i], members[i] ) );
 	}
+	// the entries aren't necessarily sorted, so inserting them as
+	// a range is much quicker than one at a time.
+	m_members.insert( values.begin(), values.end() );
 }
 
 bool CompoundObject::isEqualTo( const Object *other ) const
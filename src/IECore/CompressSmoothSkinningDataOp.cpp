@@ -35,6 +35,9 @@
 #include <algorithm>
 #include <cassert>
 
+#include "tbb/parallel_for.h"
+#include "tbb/blocked_range.h"
+
 #include "IECore/CompressSmoothSkinningDataOp.h"
 
 #include "IECore/CompoundObject.h"
@@ -67,6 +70,83 @@ CompressSmoothSkinningDataOp::~CompressSmoothSkinningDataOp()
 {
 }
 
+struct CompressSmoothSkinningDataOp::CountWeights
+{
+	public :
+		
+		CountWeights( const std::vector<int> &pointIndexOffsets, const std::vector<int> &pointInfluenceCounts, const std::vector<float> &pointInfluenceWeights, float threshold, std::vector<int> &newCounts )
+			:	m_pointIndexOffsets( pointIndexOffsets ), m_pointInfluenceCounts( pointInfluenceCounts ), m_pointInfluenceWeights( pointInfluenceWeights ), m_threshold( threshold ), m_newCounts( newCounts )
+		{
+		}
+		
+		void operator()( const tbb::blocked_range<size_t> &r ) const
+		{
+			for ( size_t i=r.begin(); i!=r.end(); ++i )
+			{
+				int count = 0;
+				for ( int j=0; j < m_pointInfluenceCounts[i]; j++ )
+				{
+					if ( m_pointInfluenceWeights[ m_pointIndexOffsets[i] + j ] > m_threshold )
+					{
+						count++;
+					}
+				}
+				m_newCounts[i] = count;
+			}
+		}
+	
+	private :
+		
+		const std::vector<int> &m_pointIndexOffsets;
+		const std::vector<int> &m_pointInfluenceCounts;
+		const std::vector<float> &m_pointInfluenceWeights;
+		float m_threshold;
+		std::vector<int> &m_newCounts;
+		
+};
+
+struct CompressSmoothSkinningDataOp::CompressPoints
+{
+	public :
+		
+		CompressPoints( const std::vector<int> &pointIndexOffsets, const std::vector<int> &pointInfluenceCounts, const std::vector<int> &pointInfluenceIndices, const std::vector<float> &pointInfluenceWeights, float threshold, const std::vector<int> &newOffsets, std::vector<int> &newIndices, std::vector<float> &newWeights )
+			:	m_pointIndexOffsets( pointIndexOffsets ), m_pointInfluenceCounts( pointInfluenceCounts ), m_pointInfluenceIndices( pointInfluenceIndices ), m_pointInfluenceWeights( pointInfluenceWeights ), m_threshold( threshold ), m_newOffsets( newOffsets ), m_newIndices( newIndices ), m_newWeights( newWeights )
+		{
+		}
+		
+		void operator()( const tbb::blocked_range<size_t> &r ) const
+		{
+			for ( size_t i=r.begin(); i!=r.end(); ++i )
+			{
+				int offset = m_newOffsets[i];
+				for ( int j=0; j < m_pointInfluenceCounts[i]; j++ )
+				{
+					int current = m_pointIndexOffsets[i] + j;
+					float weight = m_pointInfluenceWeights[current];
+					
+					if ( weight > m_threshold )
+					{
+						m_newIndices[offset] = m_pointInfluenceIndices[current];
+						m_newWeights[offset] = weight;
+						offset++;
+					}
+				}
+			}
+		}
+	
+	private :
+		
+		const std::vector<int> &m_pointIndexOffsets;
+		const std::vector<int> &m_pointInfluenceCounts;
+		const std::vector<int> &m_pointInfluenceIndices;
+		const std::vector<float> &m_pointInfluenceWeights;
+		float m_threshold;
+		const std::vector<int> &m_newOffsets;
+		std::vector<int> &m_newIndices;
+		std::vector<float> &m_newWeights;
+		
+};
+
 void CompressSmoothSkinningDataOp::modify( Object * object, const CompoundObject * operands )
 {
 	SmoothSkinningData *skinningData = static_cast<SmoothSkinningData *>( object );
@@ -79,35 +159,32 @@ void CompressSmoothSkinningDataOp::modify( Object * object, const CompoundObject
 	const std::vector<int> &pointInfluenceIndices = skinningData->pointInfluenceIndices()->readable();
 	const std::vector<float> &pointInfluenceWeights = skinningData->pointInfluenceWeights()->readable();
 	
-	std::vector<int> newOffsets;
-	std::vector<int> newCounts;
-	std::vector<int> newIndices;
-	std::vector<float> newWeights;
+	// count the weights to keep for each point, so that we can compute the
+	// new offsets and then fill in all the points in parallel.
+	size_t numPoints = pointIndexOffsets.size();
+	std::vector<int> newOffsets( numPoints );
+	std::vector<int> newCounts( numPoints );
 	
-	int offset = 0;
+	tbb::parallel_for(
+		tbb::blocked_range<size_t>( 0, numPoints ),
+		CountWeights( pointIndexOffsets, pointInfluenceCounts, pointInfluenceWeights, threshold, newCounts )
+	);
 	
-	for ( unsigned i=0; i < pointIndexOffsets.size(); i++ )
+	int offset = 0;
+	for ( unsigned i=0; i < numPoints; i++ )
 	{
-		int count = 0;
-		
-		for ( int j=0; j < pointInfluenceCounts[i]; j++ )
-		{
-			int current = pointIndexOffsets[i] + j;
-			float weight = pointInfluenceWeights[current];
-			
-			if ( weight > threshold )
-			{
-				newIndices.push_back( pointInfluenceIndices[current] );
-				newWeights.push_back( weight );
-				count++;
-			}
-		}
-
-		newOffsets.push_back( offset );
-		newCounts.push_back( count );
-		offset += count;
+		newOffsets[i] = offset;
+		offset += newCounts[i];
 	}
 	
+	std::vector<int> newIndices( offset );
+	std::vector<float> newWeights( offset );
+	
+	tbb::parallel_for(
+		tbb::blocked_range<size_t>( 0, numPoints ),
+		CompressPoints( pointIndexOffsets, pointInfluenceCounts, pointInfluenceIndices, pointInfluenceWeights, threshold, newOffsets, newIndices, newWeights )
+	);
+	
 	// replace the vectors on the SmoothSkinningData
 	if (  newWeights.size() != pointInfluenceWeights.size() )
 	{
@@ -42,6 +42,10 @@
 #include "IECore/MessageHandler.h"
 #include "IECore/Primitive.h"
 #include "IECore/Interpolator.h"
+#include "IECore/ImagePrimitive.h"
+#include "IECore/VectorTypedData.h"
+
+#include "OpenEXR/ImathRandom.h"
 
 using namespace IECore;
 using namespace Imath;
@@ -88,3 +92,142 @@ void CubeColorTransformOp::transform( Imath::Color3f &color ) const
 	assert( m_data );
 	color = m_data->readable().operator()( color );
 }
+
+void CubeColorTransformOp::transformSpan( float *r, float *g, float *b, size_t n ) const
+{
+	assert( m_data );
+	const CubeColorLookupf &lookup = m_data->readable();
+	for( size_t i = 0; i < n; i++ )
+	{
+		const Color3f c = lookup( Color3f( r[i], g[i], b[i] ) );
+		r[i] = c[0];
+		g[i] = c[1];
+		b[i] = c[2];
+	}
+}
+
+//////////////////////////////////////////////////////////////////////////
+// Baking
+//////////////////////////////////////////////////////////////////////////
+
+namespace
+{
+
+/// Creates an image one pixel high, with R, G and B channels holding the given colors.
+ImagePrimitivePtr colorImage( const std::vector<Color3f> &colors )
+{
+	const Box2i window( V2i( 0 ), V2i( colors.size() - 1, 0 ) );
+	ImagePrimitivePtr image = new ImagePrimitive( window, window );
+	std::vector<float> &r = image->createChannel<float>( "R" )->writable();
+	std::vector<float> &g = image->createChannel<float>( "G" )->writable();
+	std::vector<float> &b = image->createChannel<float>( "B" )->writable();
+	for( size_t i = 0; i < colors.size(); i++ )
+	{
+		r[i] = colors[i][0];
+		g[i] = colors[i][1];
+		b[i] = colors[i][2];
+	}
+	return image;
+}
+
+/// Applies the ops to the colors in place.
+void applyOps( const std::vector<ModifyOpPtr> &ops, std::vector<Color3f> &colors )
+{
+	ImagePrimitivePtr image = colorImage( colors );
+	for( std::vector<ModifyOpPtr>::const_iterator it = ops.begin(); it != ops.end(); ++it )
+	{
+		// the input and copy parameters are restored afterwards, so that
+		// the op isn't left holding on to our temporary image.
+		ModifyOp *op = it->get();
+		ObjectPtr input = op->inputParameter()->getValue();
+		const bool copy = op->copyParameter()->getTypedValue();
+		op->inputParameter()->setValue( image );
+		op->copyParameter()->setTypedValue( false );
+		try
+		{
+			op->operate();
+		}
+		catch( ... )
+		{
+			op->inputParameter()->setValue( input );
+			op->copyParameter()->setTypedValue( copy );
+			throw;
+		}
+		op->inputParameter()->setValue( input );
+		op->copyParameter()->setTypedValue( copy );
+	}
+
+	const std::vector<float> &r = image->getChannel<float>( "R" )->readable();
+	const std::vector<float> &g = image->getChannel<float>( "G" )->readable();
+	const std::vector<float> &b = image->getChannel<float>( "B" )->readable();
+	for( size_t i = 0; i < colors.size(); i++ )
+	{
+		colors[i] = Color3f( r[i], g[i], b[i] );
+	}
+}
+
+} // namespace
+
+CubeColorLookupfDataPtr CubeColorTransformOp::bake( const std::vector<ModifyOpPtr> &ops, const Imath::V3i &dimension, const Imath::Box3f &domain, float tolerance )
+{
+	if( dimension.x < 2 || dimension.y < 2 || dimension.z < 2 )
+	{
+		throw InvalidArgumentException( "CubeColorTransformOp::bake : Dimension must be at least 2 in every axis" );
+	}
+
+	/// Evaluate the ops on the lattice points. All the points are processed at once, so
+	/// that each op only makes a single pass.
+	const V3f step = domain.size() / V3f( dimension - V3i( 1 ) );
+	std::vector<Color3f> lattice;
+	lattice.reserve( dimension.x * dimension.y * dimension.z );
+	for( int x = 0; x < dimension.x; x++ )
+	{
+		for( int y = 0; y < dimension.y; y++ )
+		{
+			for( int z = 0; z < dimension.z; z++ )
+			{
+				lattice.push_back( Color3f( domain.min + step * V3f( x, y, z ) ) );
+			}
+		}
+	}
+
+	applyOps( ops, lattice );
+
+	CubeColorLookupfDataPtr result = new CubeColorLookupfData( CubeColorLookupf( dimension, lattice, domain ) );
+	if( tolerance < 0.0f )
+	{
+		return result;
+	}
+
+	/// Check the accuracy against random colors, which will generally fall between the lattice points.
+	static const size_t numTestColors = 4096;
+	std::vector<Color3f> testColors;
+	testColors.reserve( numTestColors );
+	Rand32 random;
+	for( size_t i = 0; i < numTestColors; i++ )
+	{
+		const V3f f( random.nextf(), random.nextf(), random.nextf() );
+		testColors.push_back( Color3f( domain.min + domain.size() * f ) );
+	}
+
+	std::vector<Color3f> expected( testColors );
+	applyOps( ops, expected );
+
+	const CubeColorLookupf &lookup = result->readable();
+	float maxError = 0.0f;
+	for( size_t i = 0; i < numTestColors; i++ )
+	{
+		const Color3f error = lookup( testColors[i] ) - expected[i];
+		for( int c = 0; c < 3; c++ )
+		{
+			maxError = std::max( maxError, (float)fabs( error[c] ) );
+		}
+	}
+
+	if( !( maxError <= tolerance ) )
+	{
+		throw Exception( ( boost::format( "CubeColorTransformOp::bake : Maximum error %f exceeds tolerance %f." ) % maxError % tolerance ).str() );
+	}
+
+	return result;
+}
@@ -36,9 +36,14 @@
 #include <algorithm>
 #include <math.h>
 #include <cassert>
+#include <limits>
 
 #include "OpenEXR/ImathFrame.h"
 
+#include "tbb/parallel_for.h"
+#include "tbb/blocked_range.h"
+#include "tbb/mutex.h"
+
 #include "IECore/Object.h"
 #include "IECore/Group.h"
 #include "IECore/CurvesPrimitive.h"
@@ -556,6 +561,69 @@ PatchMeshPrimitivePtr CurveExtrudeOp::buildPatchMesh( const CurvesPrimitive * cu
 	return patchMesh;
 }
 
+struct CurveExtrudeOp::BuildPatchMeshes
+{
+
+	/// Exceptions can't be relied upon to propagate intact out of
+	/// parallel_for, so we store the error from the first failing curve
+	/// and rethrow it once all the work is done.
+	struct Error
+	{
+		Error()
+			:	curveIndex( std::numeric_limits<unsigned>::max() )
+		{
+		}
+
+		void rethrow() const
+		{
+			if( curveIndex != std::numeric_limits<unsigned>::max() )
+			{
+				throw InvalidArgumentException( message );
+			}
+		}
+
+		tbb::mutex mutex;
+		unsigned curveIndex;
+		std::string message;
+	};
+
+	BuildPatchMeshes( const CurveExtrudeOp *op, const CurvesPrimitive *curves, const std::vector<unsigned> &vertexOffsets, const std::vector<unsigned> &varyingOffsets, std::vector<PatchMeshPrimitivePtr> &patchMeshes, Error &error )
+		:	m_op( op ), m_curves( curves ), m_vertexOffsets( vertexOffsets ), m_varyingOffsets( varyingOffsets ), m_patchMeshes( patchMeshes ), m_error( error )
+	{
+	}
+
+	void operator()( const tbb::blocked_range<unsigned> &range ) const
+	{
+		for ( unsigned curveIndex = range.begin(); curveIndex != range.end(); curveIndex++ )
+		{
+			try
+			{
+				m_patchMeshes[curveIndex] = m_op->buildPatchMesh( m_curves, curveIndex, m_vertexOffsets[curveIndex], m_varyingOffsets[curveIndex] );
+			}
+			catch( const std::exception &e )
+			{
+				tbb::mutex::scoped_lock lock( m_error.mutex );
+				if( curveIndex < m_error.curveIndex )
+				{
+					m_error.curveIndex = curveIndex;
+					m_error.message = e.what();
+				}
+				return;
+			}
+		}
+	}
+
+	private :
+
+		const CurveExtrudeOp *m_op;
+		const CurvesPrimitive *m_curves;
+		const std::vector<unsigned> &m_vertexOffsets;
+		const std::vector<unsigned> &m_varyingOffsets;
+		std::vector<PatchMeshPrimitivePtr> &m_patchMeshes;
+		Error &m_error;
+
+};
+
 ObjectPtr CurveExtrudeOp::doOperation( const CompoundObject * operands )
 {
 	CurvesPrimitive * curves = m_curvesParameter->getTypedValue<CurvesPrimitive>();
@@ -568,19 +636,31 @@ ObjectPtr CurveExtrudeOp::doOperation( const CompoundObject * operands )
 	assert( verticesPerCurve );
 
 	unsigned numCurves = verticesPerCurve->readable().size();
+
+	/// Compute the offsets for each curve up front, so that the patch meshes
+	/// can then be built in parallel.
+	std::vector<unsigned> vertexOffsets( numCurves );
+	std::vector<unsigned> varyingOffsets( numCurves );
 	unsigned vertexOffset = 0;
 	unsigned varyingOffset = 0;
 	for ( unsigned curveIndex = 0; curveIndex < numCurves; curveIndex++ )
 	{
-		int numVertices = curves->variableSize( PrimitiveVariable::Vertex, curveIndex );
-
-		PatchMeshPrimitivePtr patchMesh = buildPatchMesh( curves, curveIndex, vertexOffset, varyingOffset );
-		assert( patchMesh );
+		vertexOffsets[curveIndex] = vertexOffset;
+		varyingOffsets[curveIndex] = varyingOffset;
+		vertexOffset += curves->variableSize( PrimitiveVariable::Vertex, curveIndex );
+		varyingOffset += curves->variableSize( PrimitiveVariable::Varying, curveIndex );
+	}
 
-		group->addChild( patchMesh );
+	std::vector<PatchMeshPrimitivePtr> patchMeshes( numCurves );
+	BuildPatchMeshes::Error error;
+	BuildPatchMeshes buildPatchMeshes( this, curves, vertexOffsets, varyingOffsets, patchMeshes, error );
+	tbb::parallel_for( tbb::blocked_range<unsigned>( 0, numCurves ), buildPatchMeshes );
+	error.rethrow();
 
-		vertexOffset += numVertices;
-		varyingOffset += curves->variableSize( PrimitiveVariable::Varying, curveIndex );
+	for ( unsigned curveIndex = 0; curveIndex < numCurves; curveIndex++ )
+	{
+		assert( patchMeshes[curveIndex] );
+		group->addChild( patchMeshes[curveIndex] );
 	}
 
 	assert( group->children().size() == numCurves );
@@ -34,6 +34,9 @@
 
 #include "boost/format.hpp"
 
+#include "tbb/parallel_for.h"
+#include "tbb/blocked_range.h"
+
 #include "IECore/CurveLineariser.h"
 #include "IECore/CompoundParameter.h"
 #include "IECore/FastFloat.h"
@@ -45,6 +48,90 @@ using namespace Imath;
 
 IE_CORE_DEFINERUNTIMETYPED( CurveLineariser );
 
+namespace
+{
+
+// Evaluates the vertices of a range of linearised curves. The output
+// vectors must already have been resized, and each curve is written
+// at the offset given by vertexOffsets, so that curves may be processed
+// in any order.
+class LineariseCurves
+{
+
+	public :
+
+		LineariseCurves(
+			const CurvesPrimitiveEvaluator *evaluator,
+			const std::vector<PrimitiveVariable> &primitiveVariables,
+			const std::vector<TypeId> &primitiveVariableTypes,
+			const std::vector<void *> &primitiveVariableVectors,
+			const std::vector<int> &newVerticesPerCurve,
+			const std::vector<size_t> &vertexOffsets,
+			bool periodic
+		)
+			:	m_evaluator( evaluator ), m_primitiveVariables( primitiveVariables ), m_primitiveVariableTypes( primitiveVariableTypes ),
+				m_primitiveVariableVectors( primitiveVariableVectors ), m_newVerticesPerCurve( newVerticesPerCurve ),
+				m_vertexOffsets( vertexOffsets ), m_periodic( periodic )
+		{
+		}
+
+		void operator()( const tbb::blocked_range<size_t> &range ) const
+		{
+			PrimitiveEvaluator::ResultPtr evaluatorResult = m_evaluator->createResult();
+
+			for( size_t curveIndex=range.begin(); curveIndex!=range.end(); curveIndex++ )
+			{
+				const int numVertices = m_newVerticesPerCurve[curveIndex];
+				const float vStep = m_periodic ? ( 1.0f / (float)( numVertices ) ) : ( 1.0f / (float)( numVertices - 1 ) );
+				size_t vertexIndex = m_vertexOffsets[curveIndex];
+				for( int i=0; i<numVertices; i++, vertexIndex++ )
+				{
+					float v = std::min( vStep * i, 1.0f );
+					m_evaluator->pointAtV( curveIndex, v, evaluatorResult.get() );
+					for( size_t j=0; j<m_primitiveVariables.size(); j++ )
+					{
+						switch( m_primitiveVariableTypes[j] )
+						{
+							case V3fVectorDataTypeId :
+								(*static_cast<std::vector<V3f> *>( m_primitiveVariableVectors[j] ))[vertexIndex] = evaluatorResult->vectorPrimVar( m_primitiveVariables[j] );
+								break;
+							case FloatVectorDataTypeId :
+								(*static_cast<std::vector<float> *>( m_primitiveVariableVectors[j] ))[vertexIndex] = evaluatorResult->floatPrimVar( m_primitiveVariables[j] );
+								break;
+							case IntVectorDataTypeId :
+								(*static_cast<std::vector<int> *>( m_primitiveVariableVectors[j] ))[vertexIndex] = evaluatorResult->intPrimVar( m_primitiveVariables[j] );
+								break;
+							case Color3fVectorDataTypeId :
+								(*static_cast<std::vector<Color3f> *>( m_primitiveVariableVectors[j] ))[vertexIndex] = evaluatorResult->colorPrimVar( m_primitiveVariables[j] );
+								break;
+							default :
+								assert( 0 ); // shouldn't get here
+						}
+					}
+				}
+			}
+		}
+
+	private :
+
+		const CurvesPrimitiveEvaluator *m_evaluator;
+		const std::vector<PrimitiveVariable> &m_primitiveVariables;
+		const std::vector<TypeId> &m_primitiveVariableTypes;
+		const std::vector<void *> &m_primitiveVariableVectors;
+		const std::vector<int> &m_newVerticesPerCurve;
+		const std::vector<size_t> &m_vertexOffsets;
+		bool m_periodic;
+
+};
+
+template<typename T>
+void resizeVector( void *v, size_t size )
+{
+	static_cast<std::vector<T> *>( v )->resize( size );
+}
+
+} // namespace
+
 CurveLineariser::CurveLineariser()
 	:	CurvesPrimitiveOp( "Converts cubic curves to linear curves." )
 {
@@ -81,7 +168,6 @@ void CurveLineariser::modifyTypedPrimitive( CurvesPrimitive * curves, const Comp
 	}
 	
 	CurvesPrimitiveEvaluatorPtr evaluator = new CurvesPrimitiveEvaluator( curves );
-	PrimitiveEvaluator::ResultPtr evaluatorResult = evaluator->createResult();
 	
 	std::vector<PrimitiveVariable> primitiveVariables;
 	std::vector<TypeId> primitiveVariableTypes;
@@ -156,40 +242,45 @@ void CurveLineariser::modifyTypedPrimitive( CurvesPrimitive * curves, const Comp
 	
 	float verticesPerSegment = operands->member<FloatData>( "verticesPerSegment" )->readable();
 	
+	// compute the output size of each curve up front, so that
+	// we can then fill in the vertices of all curves in parallel.
+	std::vector<size_t> vertexOffsets( numCurves );
+	size_t numNewVertices = 0;
 	for( size_t curveIndex=0; curveIndex<numCurves; curveIndex++ )
 	{
 		int numVertices = fastFloatFloor( verticesPerSegment * (float)curves->numSegments( curveIndex ) );
 		numVertices = std::max( numVertices, periodic ? 3 : 2 );
-		
-		float vStep = periodic ? ( 1.0f / (float)( numVertices ) ) : ( 1.0f / (float)( numVertices - 1 ) );
-		for( int i=0; i<numVertices; i++ )
+		newVerticesPerCurve[curveIndex] = numVertices;
+		vertexOffsets[curveIndex] = numNewVertices;
+		numNewVertices += numVertices;
+	}
+	
+	for( size_t j=0; j<primitiveVariables.size(); j++ )
+	{
+		switch( primitiveVariableTypes[j] )
 		{
-			float v = std::min( vStep * i, 1.0f );
-			evaluator->pointAtV( curveIndex, v, evaluatorResult.get() );
-			for( size_t j=0; j<primitiveVariables.size(); j++ )
-			{
-				switch( primitiveVariableTypes[j] )
-				{
-					case V3fVectorDataTypeId :
-						static_cast<std::vector<V3f> *>( primitiveVariableVectors[j] )->push_back( evaluatorResult->vectorPrimVar( primitiveVariables[j] ) );
-						break;
-					case FloatVectorDataTypeId :
-						static_cast<std::vector<float> *>( primitiveVariableVectors[j] )->push_back( evaluatorResult->floatPrimVar( primitiveVariables[j] ) );
-						break;
-					case IntVectorDataTypeId :
-						static_cast<std::vector<int> *>( primitiveVariableVectors[j] )->push_back( evaluatorResult->intPrimVar( primitiveVariables[j] ) );
-						break;
-					case Color3fVectorDataTypeId :
-						static_cast<std::vector<Color3f> *>( primitiveVariableVectors[j] )->push_back( evaluatorResult->colorPrimVar( primitiveVariables[j] ) );
-						break;
-					default :
-						assert( 0 ); // shouldn't get here
-				}
-			}
+			case V3fVectorDataTypeId :
+				resizeVector<V3f>( primitiveVariableVectors[j], numNewVertices );
+				break;
+			case FloatVectorDataTypeId :
+				resizeVector<float>( primitiveVariableVectors[j], numNewVertices );
+				break;
+			case IntVectorDataTypeId :
+				resizeVector<int>( primitiveVariableVectors[j], numNewVertices );
+				break;
+			case Color3fVectorDataTypeId :
+				resizeVector<Color3f>( primitiveVariableVectors[j], numNewVertices );
+				break;
+			default :
+				assert( 0 ); // shouldn't get here
 		}
-		
-		newVerticesPerCurve[curveIndex] = numVertices;
 	}
 	
+	LineariseCurves lineariseCurves(
+		evaluator.get(), primitiveVariables, primitiveVariableTypes, primitiveVariableVectors,
+		newVerticesPerCurve, vertexOffsets, periodic
+	);
+	tbb::parallel_for( tbb::blocked_range<size_t>( 0, numCurves ), lineariseCurves );
+	
 	curves->setTopology( newVerticesPerCurveData, CubicBasisf::linear(), periodic );
 }
@@ -35,6 +35,9 @@
 #include <algorithm>
 #include <cassert>
 
+#include "tbb/parallel_for.h"
+#include "tbb/blocked_range.h"
+
 #include "IECore/DecompressSmoothSkinningDataOp.h"
 
 #include "IECore/CompoundObject.h"
@@ -60,6 +63,83 @@ DecompressSmoothSkinningDataOp::~DecompressSmoothSkinningDataOp()
 {
 }
 
+struct DecompressSmoothSkinningDataOp::DecompressPoints
+{
+	public :
+		
+		DecompressPoints( const std::vector<int> &pointIndexOffsets, const std::vector<int> &pointInfluenceCounts, const std::vector<int> &pointInfluenceIndices, const std::vector<float> &pointInfluenceWeights, int numInfluences, std::vector<int> &newOffsets, std::vector<int> &newIndices, std::vector<float> &newWeights )
+			:	m_pointIndexOffsets( pointIndexOffsets ), m_pointInfluenceCounts( pointInfluenceCounts ), m_pointInfluenceIndices( pointInfluenceIndices ), m_pointInfluenceWeights( pointInfluenceWeights ), m_numInfluences( numInfluences ), m_newOffsets( newOffsets ), m_newIndices( newIndices ), m_newWeights( newWeights )
+		{
+		}
+		
+		void operator()( const tbb::blocked_range<size_t> &r ) const
+		{
+			for ( size_t i=r.begin(); i!=r.end(); ++i )
+			{
+				int offset = i * m_numInfluences;
+				m_newOffsets[i] = offset;
+				
+				for ( int j=0; j < m_numInfluences; j++ )
+				{
+					m_newIndices[offset + j] = j;
+				}
+				
+				// scatter the existing weights into place. we go backwards so that the first
+				// weight wins should an influence be listed more than once for a point.
+				for ( int j=m_pointInfluenceCounts[i] - 1; j >= 0; j-- )
+				{
+					int current = m_pointIndexOffsets[i] + j;
+					int index = m_pointInfluenceIndices[current];
+					if ( index >= 0 && index < m_numInfluences )
+					{
+						m_newWeights[ offset + index ] = m_pointInfluenceWeights[current];
+					}
+				}
+			}
+		}
+	
+	private :
+		
+		const std::vector<int> &m_pointIndexOffsets;
+		const std::vector<int> &m_pointInfluenceCounts;
+		const std::vector<int> &m_pointInfluenceIndices;
+		const std::vector<float> &m_pointInfluenceWeights;
+		int m_numInfluences;
+		std::vector<int> &m_newOffsets;
+		std::vector<int> &m_newIndices;
+		std::vector<float> &m_newWeights;
+		
+};
+
+static bool isDecompressed( const std::vector<int> &pointIndexOffsets, const std::vector<int> &pointInfluenceCounts, const std::vector<int> &pointInfluenceIndices, int numInfluences )
+{
+	// a matching size alone isn't enough, as the weights could still be in any order,
+	// so we check for exactly the layout that decompression would produce.
+	if ( pointInfluenceIndices.size() != pointIndexOffsets.size() * numInfluences )
+	{
+		return false;
+	}
+	
+	for ( size_t i=0; i < pointIndexOffsets.size(); i++ )
+	{
+		int offset = i * numInfluences;
+		if ( pointIndexOffsets[i] != offset || pointInfluenceCounts[i] != numInfluences )
+		{
+			return false;
+		}
+		
+		for ( int j=0; j < numInfluences; j++ )
+		{
+			if ( pointInfluenceIndices[offset + j] != j )
+			{
+				return false;
+			}
+		}
+	}
+	
+	return true;
+}
+
 void DecompressSmoothSkinningDataOp::modify( Object * object, const CompoundObject * operands )
 {
 	SmoothSkinningData *skinningData = static_cast<SmoothSkinningData *>( object );
@@ -71,45 +151,30 @@ void DecompressSmoothSkinningDataOp::modify( Object * object, const CompoundObje
 	const std::vector<int> &pointInfluenceIndices = skinningData->pointInfluenceIndices()->readable();
 	const std::vector<float> &pointInfluenceWeights = skinningData->pointInfluenceWeights()->readable();
 	
-	std::vector<int> newOffsets;
-	std::vector<int> newCounts;
-	std::vector<int> newIndices;
-	std::vector<float> newWeights;
-	
-	int offset = 0;
+	// every point has a weight for every influence, so the offsets are known up front
+	// and each point can be filled in independently.
 	int numInfluences = influenceNames.size();
+	size_t numPoints = pointIndexOffsets.size();
 	
-	for ( unsigned i=0; i < pointIndexOffsets.size(); i++ )
+	// the data is left untouched if it is already decompressed
+	if ( isDecompressed( pointIndexOffsets, pointInfluenceCounts, pointInfluenceIndices, numInfluences ) )
 	{
-		const std::vector<int>::const_iterator first = pointInfluenceIndices.begin() + pointIndexOffsets[i];
-		const std::vector<int>::const_iterator last = first + pointInfluenceCounts[i];
-		
-		for ( int j=0; j < numInfluences; j++ )
-		{			
-			newIndices.push_back( j );
-			
-			const std::vector<int>::const_iterator location = find( first, last, j );
-			if ( location != last )
-			{
-				newWeights.push_back( pointInfluenceWeights[ location - pointInfluenceIndices.begin() ] );
-			}
-			else
-			{
-				newWeights.push_back( 0.0f );
-			}
-		}
-
-		newOffsets.push_back( offset );
-		newCounts.push_back( numInfluences );
-		offset += numInfluences;
+		return;
 	}
 	
+	std::vector<int> newOffsets( numPoints );
+	std::vector<int> newCounts( numPoints, numInfluences );
+	std::vector<int> newIndices( numPoints * numInfluences );
+	std::vector<float> newWeights( numPoints * numInfluences, 0.0f );
+	
+	tbb::parallel_for(
+		tbb::blocked_range<size_t>( 0, numPoints ),
+		DecompressPoints( pointIndexOffsets, pointInfluenceCounts, pointInfluenceIndices, pointInfluenceWeights, numInfluences, newOffsets, newIndices, newWeights )
+	);
+	
 	// replace the vectors on the SmoothSkinningData
-	if ( newWeights.size() != pointInfluenceWeights.size() )
-	{
-		skinningData->pointIndexOffsets()->writable().swap( newOffsets );
-		skinningData->pointInfluenceCounts()->writable().swap( newCounts );
-		skinningData->pointInfluenceIndices()->writable().swap( newIndices );
-		skinningData->pointInfluenceWeights()->writable().swap( newWeights );
-	}
+	skinningData->pointIndexOffsets()->writable().swap( newOffsets );
+	skinningData->pointInfluenceCounts()->writable().swap( newCounts );
+	skinningData->pointInfluenceIndices()->writable().swap( newIndices );
+	skinningData->pointInfluenceWeights()->writable().swap( newWeights );
 }
@@ -0,0 +1,410 @@
+//////////////////////////////////////////////////////////////////////////
+//
+//  Copyright (c) 2014, Image Engine Design Inc. All rights reserved.
+//
+//  Redistribution and use in source and binary forms, with or without
+//  modification, are permitted provided that the following conditions are
+//  met:
+//
+//     * Redistributions of source code must retain the above copyright
+//       notice, this list of conditions and the following disclaimer.
+//
+//     * Redistributions in binary form must reproduce the above copyright
+//       notice, this list of conditions and the following disclaimer in the
+//       documentation and/or other materials provided with the distribution.
+//
+//     * Neither the name of Image Engine Design nor the names of any
+//       other contributors to this software may be used to endorse or
+//       promote products derived from this software without specific prior
+//       written permission.
+//
+//  THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS
+//  IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO,
+//  THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR
+//  PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER OR
+//  CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+//  EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+//  PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR
+//  PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF
+//  LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING
+//  NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+//  SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+//
+//////////////////////////////////////////////////////////////////////////
+
+
+#include <unistd.h>
+
+#include <ctime>
+#include <cstring>
+#include <vector>
+#include <algorithm>
+
+#include "boost/format.hpp"
+#include "boost/filesystem/operations.hpp"
+#include "boost/filesystem/path.hpp"
+
+#include "tbb/atomic.h"
+#include "tbb/mutex.h"
+
+#include "IECore/DiskObjectCache.h"
+#include "IECore/FileIndexedIO.h"
+#include "IECore/MessageHandler.h"
+
+using namespace IECore;
+namespace fs = boost::filesystem;
+
+//////////////////////////////////////////////////////////////////////////
+// Internal utilities
+//////////////////////////////////////////////////////////////////////////
+
+namespace
+{
+
+static const char *g_extension = ".cob";
+static const char *g_tmpExtension = ".tmp";
+// temporary files older than this are assumed to have been
+// left behind by a process which died while writing them.
+static const std::time_t g_tmpExpiry = 24 * 60 * 60;
+
+bool hasSuffix( const std::string &s, const char *suffix )
+{
+	const size_t n = strlen( suffix );
+	return s.size() >= n && s.compare( s.size() - n, n, suffix ) == 0;
+}
+
+struct Entry
+{
+	std::time_t time;
+	size_t size;
+	std::string fileName;
+
+	bool operator < ( const Entry &other ) const
+	{
+		return time < other.time;
+	}
+};
+
+// Collects all the cache entries below the directory, removing
+// expired temporary files as it goes. Entries may be removed by
+// other processes at any time, so errors are silently ignored.
+void scan( const fs::path &directory, std::vector<Entry> &entries )
+{
+	const std::time_t now = std::time( 0 );
+	fs::directory_iterator end;
+	try
+	{
+		for( fs::directory_iterator it( directory ); it != end; ++it )
+		{
+			try
+			{
+				if( fs::is_directory( it->status() ) )
+				{
+					scan( it->path(), entries );
+					continue;
+				}
+
+				const std::string fileName = it->path().string();
+				if( hasSuffix( fileName, g_extension ) )
+				{
+					Entry e;
+					e.time = fs::last_write_time( it->path() );
+					e.size = fs::file_size( it->path() );
+					e.fileName = fileName;
+					entries.push_back( e );
+				}
+				else if( hasSuffix( fileName, g_tmpExtension ) )
+				{
+					if( now - fs::last_write_time( it->path() ) > g_tmpExpiry )
+					{
+						fs::remove( it->path() );
+					}
+				}
+			}
+			catch( const std::exception & )
+			{
+			}
+		}
+	}
+	catch( const std::exception & )
+	{
+	}
+}
+
+} // namespace
+
+//////////////////////////////////////////////////////////////////////////
+// MemberData
+//////////////////////////////////////////////////////////////////////////
+
+struct DiskObjectCache::MemberData
+{
+
+	MemberData( const std::string &d, size_t m )
+		:	directory( d ), maxDiskUsage( m ), diskUsage( 0 ), diskUsageValid( false )
+	{
+		tmpFileCount = 0;
+
+		char hostName[256];
+		if( gethostname( hostName, sizeof( hostName ) ) != 0 )
+		{
+			hostName[0] = '\0';
+		}
+		hostName[sizeof( hostName ) - 1] = '\0';
+		// the host and process id make temporary file names unique across
+		// all the processes which may be sharing the directory over a network.
+		tmpFileSuffix = boost::str( boost::format( ".%s.%d" ) % hostName % getpid() );
+	}
+
+	std::string directory;
+	size_t maxDiskUsage;
+
+	typedef tbb::mutex Mutex;
+	// protects diskUsage and diskUsageValid
+	Mutex mutex;
+	// an estimate of the size of the files in the directory, being the
+	// size found by the last scan plus the size of the files we have
+	// written since.
+	size_t diskUsage;
+	bool diskUsageValid;
+
+	// prevents more than one thread at a time from pruning.
+	Mutex pruneMutex;
+
+	std::string tmpFileSuffix;
+	tbb::atomic<unsigned> tmpFileCount;
+
+};
+
+//////////////////////////////////////////////////////////////////////////
+// DiskObjectCache
+//////////////////////////////////////////////////////////////////////////
+
+DiskObjectCache::DiskObjectCache( const std::string &directory, size_t maxDiskUsage )
+	:	m_data( new MemberData( directory, maxDiskUsage ) )
+{
+	fs::create_directories( fs::path( directory ) );
+}
+
+DiskObjectCache::~DiskObjectCache()
+{
+}
+
+const std::string &DiskObjectCache::directory() const
+{
+	return m_data->directory;
+}
+
+void DiskObjectCache::clear()
+{
+	std::vector<Entry> entries;
+	scan( fs::path( m_data->directory ), entries );
+	for( std::vector<Entry>::const_iterator it = entries.begin(); it != entries.end(); ++it )
+	{
+		try
+		{
+			fs::remove( fs::path( it->fileName ) );
+		}
+		catch( const std::exception & )
+		{
+		}
+	}
+
+	MemberData::Mutex::scoped_lock lock( m_data->mutex );
+	m_data->diskUsage = 0;
+	m_data->diskUsageValid = true;
+}
+
+bool DiskObjectCache::erase( const MurmurHash &key )
+{
+	const fs::path path( fileName( key ) );
+	size_t size = 0;
+	try
+	{
+		size = fs::file_size( path );
+		if( !fs::remove( path ) )
+		{
+			return false;
+		}
+	}
+	catch( const std::exception & )
+	{
+		return false;
+	}
+
+	MemberData::Mutex::scoped_lock lock( m_data->mutex );
+	m_data->diskUsage -= std::min( size, m_data->diskUsage );
+	return true;
+}
+
+void DiskObjectCache::setMaxDiskUsage( size_t maxDiskUsage )
+{
+	m_data->maxDiskUsage = maxDiskUsage;
+	prune( maxDiskUsage );
+}
+
+size_t DiskObjectCache::getMaxDiskUsage() const
+{
+	return m_data->maxDiskUsage;
+}
+
+size_t DiskObjectCache::diskUsage() const
+{
+	std::vector<Entry> entries;
+	scan( fs::path( m_data->directory ), entries );
+
+	size_t result = 0;
+	for( std::vector<Entry>::const_iterator it = entries.begin(); it != entries.end(); ++it )
+	{
+		result += it->size;
+	}
+
+	MemberData::Mutex::scoped_lock lock( m_data->mutex );
+	m_data->diskUsage = result;
+	m_data->diskUsageValid = true;
+
+	return result;
+}
+
+bool DiskObjectCache::contains( const MurmurHash &key ) const
+{
+	try
+	{
+		return fs::exists( fs::path( fileName( key ) ) );
+	}
+	catch( const std::exception & )
+	{
+		return false;
+	}
+}
+
+ObjectPtr DiskObjectCache::retrieve( const MurmurHash &key ) const
+{
+	const std::string f = fileName( key );
+	if( !contains( key ) )
+	{
+		return 0;
+	}
+
+	ObjectPtr result = 0;
+	try
+	{
+		IndexedIOPtr io = new FileIndexedIO( f, IndexedIO::rootPath, IndexedIO::Shared | IndexedIO::Read );
+		result = Object::load( io, "object" );
+	}
+	catch( const std::exception &e )
+	{
+		// the file may have been removed by another process since we checked
+		// for it, in which case we just treat it as missing.
+		if( contains( key ) )
+		{
+			msg( Msg::Warning, "DiskObjectCache::retrieve", boost::format( "Unable to read \"%s\" : %s" ) % f % e.what() );
+		}
+		return 0;
+	}
+
+	// mark the entry as recently used, so that it survives pruning.
+	try
+	{
+		fs::last_write_time( fs::path( f ), std::time( 0 ) );
+	}
+	catch( const std::exception & )
+	{
+	}
+
+	return result;
+}
+
+void DiskObjectCache::store( const MurmurHash &key, const Object *obj )
+{
+	if( !obj )
+	{
+		return;
+	}
+
+	const std::string f = fileName( key );
+	const std::string tmp = f + m_data->tmpFileSuffix + boost::str( boost::format( ".%d" ) % m_data->tmpFileCount.fetch_and_increment() ) + g_tmpExtension;
+
+	size_t size = 0;
+	try
+	{
+		fs::create_directories( fs::path( f ).parent_path() );
+		{
+			IndexedIOPtr io = new FileIndexedIO( tmp, IndexedIO::rootPath, IndexedIO::Exclusive | IndexedIO::Write );
+			obj->save( io, "object" );
+		}
+		size = fs::file_size( fs::path( tmp ) );
+		// rename is atomic, so readers see either the previous entry or
+		// the complete new one, and never a partially written file.
+		fs::rename( fs::path( tmp ), fs::path( f ) );
+	}
+	catch( const std::exception &e )
+	{
+		msg( Msg::Warning, "DiskObjectCache::store", boost::format( "Unable to write \"%s\" : %s" ) % f % e.what() );
+		try
+		{
+			fs::remove( fs::path( tmp ) );
+		}
+		catch( const std::exception & )
+		{
+		}
+		return;
+	}
+
+	bool needsPruning = false;
+	{
+		MemberData::Mutex::scoped_lock lock( m_data->mutex );
+		m_data->diskUsage += size;
+		needsPruning = !m_data->diskUsageValid || m_data->diskUsage > m_data->maxDiskUsage;
+	}
+
+	if( needsPruning )
+	{
+		// prune a little further than strictly necessary, so that we don't
+		// end up scanning the directory again on every subsequent store.
+		prune( m_data->maxDiskUsage - m_data->maxDiskUsage / 10 );
+	}
+}
+
+std::string DiskObjectCache::fileName( const MurmurHash &key ) const
+{
+	// spread the files across subdirectories so no single directory
+	// becomes too large to list efficiently.
+	const std::string h = key.toString();
+	return ( fs::path( m_data->directory ) / h.substr( 0, 2 ) / ( h + g_extension ) ).string();
+}
+
+void DiskObjectCache::prune( size_t targetUsage )
+{
+	MemberData::Mutex::scoped_lock pruneLock( m_data->pruneMutex );
+
+	std::vector<Entry> entries;
+	scan( fs::path( m_data->directory ), entries );
+
+	size_t usage = 0;
+	for( std::vector<Entry>::const_iterator it = entries.begin(); it != entries.end(); ++it )
+	{
+		usage += it->size;
+	}
+
+	if( usage > targetUsage )
+	{
+		// remove the least recently used entries first
+		std::sort( entries.begin(), entries.end() );
+		for( std::vector<Entry>::const_iterator it = entries.begin(); it != entries.end() && usage > targetUsage; ++it )
+		{
+			try
+			{
+				fs::remove( fs::path( it->fileName ) );
+			}
+			catch( const std::exception & )
+			{
+			}
+			usage -= it->size;
+		}
+	}
+
+	MemberData::Mutex::scoped_lock lock( m_data->mutex );
+	m_data->diskUsage = usage;
+	m_data->diskUsageValid = true;
+}
@@ -35,8 +35,12 @@
 #include <unistd.h>
 #include <fcntl.h>
 
+#include <algorithm>
+
 #include "boost/asio.hpp"
 #include "boost/bind.hpp"
+#include "boost/array.hpp"
+#include "boost/thread.hpp"
 #include "tbb/tbb_thread.h"
 
 #include "IECore/DisplayDriverServer.h"
@@ -44,6 +48,7 @@
 #include "IECore/SimpleTypedData.h"
 #include "IECore/MemoryIndexedIO.h"
 #include "IECore/MessageHandler.h"
+#include "IECore/ByteOrder.h"
 
 using namespace IECore;
 using boost::asio::ip::tcp;
@@ -66,6 +71,8 @@ class DisplayDriverServer::Session : public RefCounted
 		void handleReadHeader( const boost::system::error_code& error );
 		void handleReadOpenParameters( const boost::system::error_code& error );
 		void handleReadDataParameters( const boost::system::error_code& error );
+		void handleReadBucket( const boost::system::error_code& error );
+		void readHeader();
 		void sendResult( DisplayDriverServerHeader::MessageType msg, size_t dataSize );
 		void sendException( const char *message );
 
@@ -74,6 +81,13 @@ class DisplayDriverServer::Session : public RefCounted
 		DisplayDriverPtr m_displayDriver;
 		DisplayDriverServerHeader m_header;
 		CharVectorDataPtr m_buffer;
+		// The protocol version agreed with the client, which
+		// is used for all messages sent back to it.
+		unsigned char m_protocolVersion;
+		// imageBucket messages are read directly into these,
+		// bypassing m_buffer and the IndexedIO decoding.
+		int32_t m_bucketBox[4];
+		std::vector<float> m_bucketData;
 };
 
 class DisplayDriverServer::PrivateData : public RefCounted
@@ -85,14 +99,14 @@ class DisplayDriverServer::PrivateData : public RefCounted
 		boost::asio::ip::tcp::endpoint m_endpoint;
 		boost::asio::io_service m_service;
 		boost::asio::ip::tcp::acceptor m_acceptor;
-		tbb::tbb_thread m_thread;
+		boost::thread_group m_threads;
 
 		PrivateData( int portNumber ) :
 			m_success(false),
 			m_endpoint(tcp::v4(), portNumber),
 			m_service(),
 			m_acceptor( m_service ),
-			m_thread()
+			m_threads()
 		{
 			m_acceptor.open(  m_endpoint.protocol() );
 			m_acceptor.set_option( boost::asio::ip::tcp::acceptor::reuse_address(true));
@@ -107,7 +121,7 @@ class DisplayDriverServer::PrivateData : public RefCounted
 			{
 				m_acceptor.cancel();
 				m_acceptor.close();
-				m_thread.join();
+				m_threads.join_all();
 			}
 		}
 
@@ -123,9 +137,14 @@ static void fixSocketFlags( int socketDesc )
 	}
 }
 
-DisplayDriverServer::DisplayDriverServer( int portNumber ) :
+DisplayDriverServer::DisplayDriverServer( int portNumber, int numThreads ) :
 		m_data( 0 )
 {
+	if( numThreads <= 0 )
+	{
+		numThreads = std::max( 1, (int)tbb::tbb_thread::hardware_concurrency() );
+	}
+
 	m_data = new DisplayDriverServer::PrivateData( portNumber );
 
 	DisplayDriverServer::SessionPtr newSession( new DisplayDriverServer::Session( m_data->m_service ) );
@@ -133,8 +152,13 @@ DisplayDriverServer::DisplayDriverServer( int portNumber ) :
 			boost::bind( &DisplayDriverServer::handleAccept, this, newSession,
 			boost::asio::placeholders::error));
 	fixSocketFlags( m_data->m_acceptor.native() );
-	tbb::tbb_thread newThread( boost::bind(&DisplayDriverServer::serverThread, this) );
-	m_data->m_thread = newThread;
+	// each session only ever has a single asynchronous operation outstanding,
+	// so the handlers for any one session are serialised even though they may be
+	// run by any of the threads in the pool.
+	for( int i = 0; i < numThreads; ++i )
+	{
+		m_data->m_threads.create_thread( boost::bind( &DisplayDriverServer::serverThread, this ) );
+	}
 }
 
 DisplayDriverServer::~DisplayDriverServer()
@@ -170,7 +194,7 @@ void DisplayDriverServer::handleAccept( DisplayDriverServer::SessionPtr session,
  */
 
 DisplayDriverServer::Session::Session( boost::asio::io_service& io_service ) :
-	m_socket( io_service ), m_displayDriver(0), m_buffer( new CharVectorData( ) )
+	m_socket( io_service ), m_displayDriver(0), m_buffer( new CharVectorData( ) ), m_protocolVersion( 1 )
 {
 }
 
@@ -185,6 +209,12 @@ boost::asio::ip::tcp::socket& DisplayDriverServer::Session::socket()
 }
 
 void DisplayDriverServer::Session::start()
+{
+	fixSocketFlags( m_socket.native() );
+	readHeader();
+}
+
+void DisplayDriverServer::Session::readHeader()
 {
 	boost::asio::async_read( m_socket,
 			boost::asio::buffer( m_header.buffer(), m_header.headerLength),
@@ -193,7 +223,6 @@ void DisplayDriverServer::Session::start()
 				boost::asio::placeholders::error
 			)
 	);
-	fixSocketFlags( m_socket.native() );
 }
 
 void DisplayDriverServer::Session::handleReadHeader( const boost::system::error_code& error )
@@ -215,6 +244,30 @@ void DisplayDriverServer::Session::handleReadHeader( const boost::system::error_
 	// get number of bytes ahead (unsigned int value)
 	size_t bytesAhead = m_header.getDataSize();
 
+	if( m_header.messageType() == DisplayDriverServerHeader::imageBucket )
+	{
+		if( bytesAhead < DisplayDriverServerHeader::bucketBoxLength || ( bytesAhead - DisplayDriverServerHeader::bucketBoxLength ) % sizeof( float ) )
+		{
+			msg( Msg::Error, "DisplayDriverServer::Session::handleReadHeader", "Invalid bucket size!" );
+			m_socket.close();
+			return;
+		}
+
+		// scatter the data block straight into the box and the pixel buffer,
+		// which is reused from bucket to bucket.
+		m_bucketData.resize( ( bytesAhead - DisplayDriverServerHeader::bucketBoxLength ) / sizeof( float ) );
+		boost::array<boost::asio::mutable_buffer, 2> buffers = { {
+			boost::asio::buffer( m_bucketBox, sizeof( m_bucketBox ) ),
+			boost::asio::buffer( m_bucketData )
+		} };
+
+		boost::asio::async_read( m_socket,
+				buffers,
+				boost::bind(&DisplayDriverServer::Session::handleReadBucket, SessionPtr(this),
+				boost::asio::placeholders::error));
+		return;
+	}
+
 	CharVectorData::ValueType &data = m_buffer->writable();
 	data.resize( bytesAhead );
 
@@ -298,6 +351,14 @@ void DisplayDriverServer::Session::handleReadOpenParameters( const boost::system
 		channelNames = boost::static_pointer_cast<StringVectorData>( Object::load( io, "channelNames" ) );
 		parameters = boost::static_pointer_cast<CompoundData>( Object::load( io, "parameters" ) );
 
+		// clients which predate protocol version 2 don't specify a version,
+		// and must be sent version 1 messages only.
+		if( const IntData *clientProtocolVersion = parameters->member<IntData>( "clientProtocolVersion" ) )
+		{
+			m_protocolVersion = std::max( 1, std::min( clientProtocolVersion->readable(), (int)DisplayDriverServerHeader::currentProtocolVersion ) );
+			parameters->writable().erase( "clientProtocolVersion" );
+		}
+
 		const StringData *displayType = parameters->member<StringData>( "remoteDisplayType", true /* throw if missing */ );
 
 		// create a displayDriver using the factory function.
@@ -324,13 +385,7 @@ void DisplayDriverServer::Session::handleReadOpenParameters( const boost::system
 		m_socket.send( boost::asio::buffer( &acceptsRepeatedData, sizeof(acceptsRepeatedData) ) );
 
 		// prepare for getting imageData packages
-		boost::asio::async_read( m_socket,
-			boost::asio::buffer( m_header.buffer(), m_header.headerLength),
-			boost::bind(
-				&DisplayDriverServer::Session::handleReadHeader, SessionPtr(this),
-				boost::asio::placeholders::error
-			)
-		);
+		readHeader();
 	}
 	catch( std::exception &e )
 	{
@@ -371,13 +426,7 @@ void DisplayDriverServer::Session::handleReadDataParameters( const boost::system
 		m_displayDriver->imageData( box->readable(), &(data->readable()[0]), data->readable().size() );
 
 		// prepare for getting more imageData packages or a imageClose.
-		boost::asio::async_read( m_socket,
-			boost::asio::buffer( m_header.buffer(), m_header.headerLength),
-			boost::bind(
-				&DisplayDriverServer::Session::handleReadHeader, SessionPtr(this),
-				boost::asio::placeholders::error
-			)
-		);
+		readHeader();
 	}
 	catch( std::exception &e )
 	{
@@ -387,9 +436,53 @@ void DisplayDriverServer::Session::handleReadDataParameters( const boost::system
 	}
 }
 
+void DisplayDriverServer::Session::handleReadBucket( const boost::system::error_code& error )
+{
+	if (error)
+	{
+		msg( Msg::Error, "DisplayDriverServer::Session::handleReadBucket", error.message().c_str() );
+		m_socket.close();
+		return;
+	}
+
+	if (! m_displayDriver )
+	{
+		msg( Msg::Error, "DisplayDriverServer::Session::handleReadBucket", "No display drivers!" );
+		m_socket.close();
+		return;
+	}
+
+	if( bigEndian() )
+	{
+		for( int i = 0; i < 4; ++i )
+		{
+			m_bucketBox[i] = reverseBytes( m_bucketBox[i] );
+		}
+		for( std::vector<float>::iterator it = m_bucketData.begin(); it != m_bucketData.end(); ++it )
+		{
+			*it = reverseBytes( *it );
+		}
+	}
+
+	try
+	{
+		const Imath::Box2i box( Imath::V2i( m_bucketBox[0], m_bucketBox[1] ), Imath::V2i( m_bucketBox[2], m_bucketBox[3] ) );
+		m_displayDriver->imageData( box, m_bucketData.empty() ? 0 : &m_bucketData[0], m_bucketData.size() );
+
+		// prepare for getting more imageData packages or a imageClose.
+		readHeader();
+	}
+	catch( std::exception &e )
+	{
+		msg( Msg::Error, "DisplayDriverServer::Session::handleReadBucket", e.what() );
+		m_socket.close();
+		return;
+	}
+}
+
 void DisplayDriverServer::Session::sendResult( DisplayDriverServerHeader::MessageType msg, size_t dataSize )
 {
-	DisplayDriverServerHeader header( msg, dataSize );
+	DisplayDriverServerHeader header( msg, dataSize, m_protocolVersion );
 	m_socket.send( boost::asio::buffer( header.buffer(), header.headerLength ) );
 }
 
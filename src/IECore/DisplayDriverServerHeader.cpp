@@ -51,10 +51,10 @@ DisplayDriverServerHeader::DisplayDriverServerHeader()
 	memset( &m_header[0], 0, sizeof(m_header) );
 }
 
-DisplayDriverServerHeader::DisplayDriverServerHeader( MessageType msg, size_t dataSize )
+DisplayDriverServerHeader::DisplayDriverServerHeader( MessageType msg, size_t dataSize, unsigned char protocolVersion )
 {
 	m_header[orderMagicNumber] = magicNumber;
-	m_header[orderProtocolVersion] = currentProtocolVersion;
+	m_header[orderProtocolVersion] = protocolVersion;
 	m_header[orderMessageType] = msg;
 	setDataSize( dataSize );
 }
@@ -67,11 +67,17 @@ unsigned char *DisplayDriverServerHeader::buffer()
 bool DisplayDriverServerHeader::valid()
 {
 	if ( m_header[orderMagicNumber] != magicNumber || 
-		 m_header[orderProtocolVersion] != currentProtocolVersion ||
+		 m_header[orderProtocolVersion] < 1 ||
+		 m_header[orderProtocolVersion] > currentProtocolVersion ||
 		( m_header[orderMessageType] != imageOpen && 
 			m_header[orderMessageType] != imageData &&
 			m_header[orderMessageType] != imageClose && 
-			m_header[orderMessageType] != exception ) )
+			m_header[orderMessageType] != exception &&
+			m_header[orderMessageType] != imageBucket ) )
+	{
+		return false;
+	}
+	if ( m_header[orderMessageType] == imageBucket && m_header[orderProtocolVersion] < 2 )
 	{
 		return false;
 	}
@@ -96,3 +102,8 @@ DisplayDriverServerHeader::MessageType DisplayDriverServerHeader::messageType()
 {
 	return (MessageType)m_header[2];
 }
+
+unsigned char DisplayDriverServerHeader::protocolVersion()
+{
+	return m_header[orderProtocolVersion];
+}
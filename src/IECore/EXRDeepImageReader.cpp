@@ -42,6 +42,7 @@
 #include "OpenEXR/half.h"
 #include "OpenEXR/ImfChannelList.h"
 #include "OpenEXR/ImfTestFile.h"
+#include "OpenEXR/ImfVersion.h"
 #include "OpenEXR/ImfDeepFrameBuffer.h"
 #include "OpenEXR/ImfPartType.h"
 
@@ -58,7 +59,12 @@ inline size_t pixelTypeSize( Imf::PixelType p )
 
 IE_CORE_DEFINERUNTIMETYPED( EXRDeepImageReader );
 
-const Reader::ReaderDescription<EXRDeepImageReader> EXRDeepImageReader::g_readerDescription( "dexr exr" );
+static bool canReadMagic( const char *data, size_t size )
+{
+	return size >= 4 && Imf::isImfMagic( data );
+}
+
+const Reader::ReaderDescription<EXRDeepImageReader> EXRDeepImageReader::g_readerDescription( "dexr exr", canReadMagic );
 
 EXRDeepImageReader::EXRDeepImageReader()
 	:	DeepImageReader( "Reads EXR 2.0 deep image file format." ),
@@ -49,6 +49,7 @@
 
 #include "OpenEXR/Iex.h"
 #include "OpenEXR/ImfTestFile.h"
+#include "OpenEXR/ImfVersion.h"
 #include "OpenEXR/ImfFloatAttribute.h"
 #include "OpenEXR/ImfDoubleAttribute.h"
 #include "OpenEXR/ImfIntAttribute.h"
@@ -77,7 +78,12 @@ using Imath::Box2i;
 
 IE_CORE_DEFINERUNTIMETYPED( EXRImageReader );
 
-const Reader::ReaderDescription<EXRImageReader> EXRImageReader::g_readerDescription("exr");
+static bool canReadMagic( const char *data, size_t size )
+{
+	return size >= 4 && Imf::isImfMagic( data );
+}
+
+const Reader::ReaderDescription<EXRImageReader> EXRImageReader::g_readerDescription( "exr", canReadMagic );
 
 EXRImageReader::EXRImageReader() :
 		ImageReader( "Reads ILM OpenEXR file format." ),
@@ -176,6 +182,35 @@ std::string EXRImageReader::sourceColorSpace() const
 	return "linear";
 }
 
+namespace
+{
+
+// The type of the buffer we provide to OpenEXR. This needn't match the
+// type of the channel in the file, as the library will convert while it
+// decodes.
+template<typename T>
+struct BufferPixelType;
+
+template<>
+struct BufferPixelType<unsigned int>
+{
+	static const PixelType value = UINT;
+};
+
+template<>
+struct BufferPixelType<half>
+{
+	static const PixelType value = HALF;
+};
+
+template<>
+struct BufferPixelType<float>
+{
+	static const PixelType value = FLOAT;
+};
+
+} // namespace
+
 template<class T>
 DataPtr EXRImageReader::readTypedChannel( const std::string &name, const Imath::Box2i &dataWindow, const Imf::Channel *channel )
 {
@@ -194,7 +229,7 @@ DataPtr EXRImageReader::readTypedChannel( const std::string &name, const Imath::
 		// into the result buffer
 		FrameBuffer frameBuffer;
 		T *buffer00 = data->baseWritable() - dataWindow.min.y * pixelDimensions.x - fullDataWindow.min.x;
-		Slice slice( channel->type, (char *)buffer00, sizeof(T), sizeof(T) * pixelDimensions.x );
+		Slice slice( BufferPixelType<T>::value, (char *)buffer00, sizeof(T), sizeof(T) * pixelDimensions.x );
 		frameBuffer.insert( name.c_str(), slice );
 		m_inputFile->setFrameBuffer( frameBuffer );
 		// exr library will choose the best order to read scanlines automatically (increasing or decreasing)
@@ -220,7 +255,7 @@ DataPtr EXRImageReader::readTypedChannel( const std::string &name, const Imath::
 		T *transferDestination = &(data->writable()[0]);
 
 		// slice has yStride of 0 so each successive scanline just overwrites the previous one
-		Slice slice( channel->type, (char *)(&(tmpBuffer[0]) - fullDataWindow.min.x), sizeof(T), 0 );
+		Slice slice( BufferPixelType<T>::value, (char *)(&(tmpBuffer[0]) - fullDataWindow.min.x), sizeof(T), 0 );
 		FrameBuffer frameBuffer;
 		frameBuffer.insert( name.c_str(), slice );
 		m_inputFile->setFrameBuffer( frameBuffer );
@@ -285,16 +320,15 @@ DataPtr EXRImageReader::readChannel( const string &name, const Imath::Box2i &dat
 				}
 
 			case HALF :
-				res = readTypedChannel<half>( name, dataWindow, channel );
 				if ( raw )
 				{
-					return res;
+					return readTypedChannel<half>( name, dataWindow, channel );
 				}
 				else
 				{
-					DataConvert< HalfVectorData, FloatVectorData, ScaledDataConversion< half, float > > converter;
-					ConstHalfVectorDataPtr vec = boost::static_pointer_cast< HalfVectorData >(res);
-					return converter( vec );
+					// let OpenEXR convert to float as it decodes, rather than
+					// making a second pass over a temporary half buffer.
+					return readTypedChannel<float>( name, dataWindow, channel );
 				}
 
 			case FLOAT :
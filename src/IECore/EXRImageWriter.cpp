@@ -50,10 +50,13 @@
 #include "OpenEXR/ImfMatrixAttribute.h"
 #include "OpenEXR/ImfStringAttribute.h"
 #include "OpenEXR/ImfTimeCodeAttribute.h"
+#include "OpenEXR/ImfTiledOutputFile.h"
+#include "OpenEXR/ImfThreading.h"
 
 #include "boost/format.hpp"
 
 #include <fstream>
+#include <algorithm>
 
 using namespace IECore;
 
@@ -61,6 +64,7 @@ using std::string;
 using std::vector;
 
 using Imath::Box2i;
+using Imath::V2i;
 using namespace Imf;
 
 IE_CORE_DEFINERUNTIMETYPED( EXRImageWriter )
@@ -113,6 +117,53 @@ void EXRImageWriter::constructCommon()
 
 	parameters()->addParameter( compressionParameter );
 
+	parameters()->addParameter(
+		new BoolParameter(
+			"tiled",
+			"When on, a tiled file is written rather than a scanline file.",
+			false
+		)
+	);
+
+	parameters()->addParameter(
+		new V2iParameter(
+			"tileSize",
+			"The size of the tiles used when writing a tiled file.",
+			V2i( 64 )
+		)
+	);
+
+	IntParameter::PresetsContainer levelModePresets;
+	levelModePresets.push_back( IntParameter::Preset( "oneLevel", ONE_LEVEL ) );
+	levelModePresets.push_back( IntParameter::Preset( "mipMap", MIPMAP_LEVELS ) );
+	levelModePresets.push_back( IntParameter::Preset( "ripMap", RIPMAP_LEVELS ) );
+
+	parameters()->addParameter(
+		new IntParameter(
+			"levelMode",
+			"Whether a tiled file holds a single resolution, or also contains "
+			"mip-mapped or rip-mapped levels of reduced resolution.",
+			ONE_LEVEL,
+			ONE_LEVEL,
+			RIPMAP_LEVELS,
+			levelModePresets,
+			true
+		)
+	);
+
+	parameters()->addParameter(
+		new IntParameter(
+			"numThreads",
+			"The number of threads used to compress the file. A value of 0 "
+			"uses all the threads in OpenEXR's global thread pool, and a value "
+			"of 1 compresses in the calling thread only. The global thread pool "
+			"is empty by default, so compression is only parallel once it has "
+			"been sized using EXRImageWriter.setGlobalThreadCount().",
+			0,
+			0
+		)
+	);
+
 }
 
 std::string EXRImageWriter::destinationColorSpace() const
@@ -130,6 +181,60 @@ const IntParameter * EXRImageWriter::compressionParameter() const
 	return parameters()->parameter< IntParameter >( "compression" );
 }
 
+BoolParameter * EXRImageWriter::tiledParameter()
+{
+	return parameters()->parameter< BoolParameter >( "tiled" );
+}
+
+const BoolParameter * EXRImageWriter::tiledParameter() const
+{
+	return parameters()->parameter< BoolParameter >( "tiled" );
+}
+
+V2iParameter * EXRImageWriter::tileSizeParameter()
+{
+	return parameters()->parameter< V2iParameter >( "tileSize" );
+}
+
+const V2iParameter * EXRImageWriter::tileSizeParameter() const
+{
+	return parameters()->parameter< V2iParameter >( "tileSize" );
+}
+
+IntParameter * EXRImageWriter::levelModeParameter()
+{
+	return parameters()->parameter< IntParameter >( "levelMode" );
+}
+
+const IntParameter * EXRImageWriter::levelModeParameter() const
+{
+	return parameters()->parameter< IntParameter >( "levelMode" );
+}
+
+IntParameter * EXRImageWriter::numThreadsParameter()
+{
+	return parameters()->parameter< IntParameter >( "numThreads" );
+}
+
+const IntParameter * EXRImageWriter::numThreadsParameter() const
+{
+	return parameters()->parameter< IntParameter >( "numThreads" );
+}
+
+void EXRImageWriter::setGlobalThreadCount( int count )
+{
+	if( count < 0 )
+	{
+		throw InvalidArgumentException( "EXRImageWriter: Thread count must not be negative" );
+	}
+	Imf::setGlobalThreadCount( count );
+}
+
+int EXRImageWriter::getGlobalThreadCount()
+{
+	return Imf::globalThreadCount();
+}
+
 static void blindDataToHeader( const CompoundData *blindData, Imf::Header &header, std::string prefix = "" )
 {
 	const CompoundDataMap &map = blindData->readable();
@@ -216,6 +321,172 @@ static void blindDataToHeader( const CompoundData *blindData, Imf::Header &heade
 	}
 }
 
+namespace
+{
+
+// A channel to be written. The full resolution pixels are referenced
+// directly from the image, so no copies are made unless reduced
+// resolution levels are required.
+struct OutputChannel
+{
+	OutputChannel( const char *n, PixelType t, size_t s, const void *p )
+		:	name( n ), type( t ), pixelSize( s ), pixels( static_cast<const char *>( p ) )
+	{
+	}
+
+	const char *name;
+	PixelType type;
+	size_t pixelSize;
+	const char *pixels;
+	// Storage for the reduced resolution levels.
+	std::vector<char> level;
+	std::vector<char> levelRowStart;
+};
+
+typedef std::vector<OutputChannel> OutputChannels;
+
+// Box filters src into dst, where each destination pixel averages the
+// source pixels within its footprint.
+template<typename T>
+void reduce( const T *src, const V2i &srcSize, const V2i &dstSize, T *dst )
+{
+	for( int y = 0; y < dstSize.y; ++y )
+	{
+		const int y0 = ( y * srcSize.y ) / dstSize.y;
+		const int y1 = std::max( y0 + 1, ( ( y + 1 ) * srcSize.y ) / dstSize.y );
+		for( int x = 0; x < dstSize.x; ++x )
+		{
+			const int x0 = ( x * srcSize.x ) / dstSize.x;
+			const int x1 = std::max( x0 + 1, ( ( x + 1 ) * srcSize.x ) / dstSize.x );
+			float sum = 0.0f;
+			for( int sy = y0; sy < y1; ++sy )
+			{
+				const T *row = src + sy * srcSize.x;
+				for( int sx = x0; sx < x1; ++sx )
+				{
+					sum += row[sx];
+				}
+			}
+			*dst++ = T( sum / float( ( y1 - y0 ) * ( x1 - x0 ) ) );
+		}
+	}
+}
+
+// Averaging makes no sense for integer channels, which typically hold ids,
+// so they are point sampled instead.
+void reduce( const unsigned int *src, const V2i &srcSize, const V2i &dstSize, unsigned int *dst )
+{
+	for( int y = 0; y < dstSize.y; ++y )
+	{
+		const unsigned int *row = src + ( ( y * srcSize.y ) / dstSize.y ) * srcSize.x;
+		for( int x = 0; x < dstSize.x; ++x )
+		{
+			*dst++ = row[( x * srcSize.x ) / dstSize.x];
+		}
+	}
+}
+
+void reduce( const OutputChannel &channel, const char *src, const V2i &srcSize, const V2i &dstSize, std::vector<char> &dst )
+{
+	std::vector<char> result( dstSize.x * dstSize.y * channel.pixelSize );
+	switch( channel.type )
+	{
+		case HALF :
+			reduce( reinterpret_cast<const half *>( src ), srcSize, dstSize, reinterpret_cast<half *>( &result[0] ) );
+			break;
+		case FLOAT :
+			reduce( reinterpret_cast<const float *>( src ), srcSize, dstSize, reinterpret_cast<float *>( &result[0] ) );
+			break;
+		case UINT :
+			reduce( reinterpret_cast<const unsigned int *>( src ), srcSize, dstSize, reinterpret_cast<unsigned int *>( &result[0] ) );
+			break;
+		default :
+			assert( 0 );
+	}
+	dst.swap( result );
+}
+
+V2i levelSize( const TiledOutputFile &file, int lx, int ly )
+{
+	return V2i( file.levelWidth( lx ), file.levelHeight( ly ) );
+}
+
+FrameBuffer frameBuffer( const OutputChannels &channels, const Box2i &dataWindow, bool fullResolution )
+{
+	const int width = dataWindow.max.x - dataWindow.min.x + 1;
+	const ptrdiff_t origin = dataWindow.min.x + width * dataWindow.min.y;
+
+	FrameBuffer result;
+	for( OutputChannels::const_iterator it = channels.begin(); it != channels.end(); ++it )
+	{
+		const char *pixels = fullResolution ? it->pixels : &(it->level[0]);
+		char *base = const_cast<char *>( pixels - origin * (ptrdiff_t)it->pixelSize );
+		result.insert( it->name, Slice( it->type, base, it->pixelSize, it->pixelSize * width ) );
+	}
+	return result;
+}
+
+void writeLevel( TiledOutputFile &file, const OutputChannels &channels, int lx, int ly )
+{
+	file.setFrameBuffer( frameBuffer( channels, file.dataWindowForLevel( lx, ly ), lx == 0 && ly == 0 ) );
+	file.writeTiles( 0, file.numXTiles( lx ) - 1, 0, file.numYTiles( ly ) - 1, lx, ly );
+}
+
+void writeTiled( const char *fileName, const Header &header, OutputChannels &channels, int numThreads )
+{
+	TiledOutputFile file( fileName, header, numThreads );
+
+	switch( file.levelMode() )
+	{
+		case ONE_LEVEL :
+			writeLevel( file, channels, 0, 0 );
+			break;
+		case MIPMAP_LEVELS :
+			for( int l = 0; l < file.numLevels(); ++l )
+			{
+				if( l )
+				{
+					for( OutputChannels::iterator it = channels.begin(); it != channels.end(); ++it )
+					{
+						const char *src = l == 1 ? it->pixels : &(it->level[0]);
+						reduce( *it, src, levelSize( file, l - 1, l - 1 ), levelSize( file, l, l ), it->level );
+					}
+				}
+				writeLevel( file, channels, l, l );
+			}
+			break;
+		case RIPMAP_LEVELS :
+			// Each row of levels is reduced from the start of the previous
+			// row, and each level within a row from the one before it.
+			for( int ly = 0; ly < file.numYLevels(); ++ly )
+			{
+				for( int lx = 0; lx < file.numXLevels(); ++lx )
+				{
+					for( OutputChannels::iterator it = channels.begin(); it != channels.end(); ++it )
+					{
+						if( lx == 0 && ly )
+						{
+							const char *src = ly == 1 ? it->pixels : &(it->levelRowStart[0]);
+							reduce( *it, src, levelSize( file, 0, ly - 1 ), levelSize( file, 0, ly ), it->levelRowStart );
+							it->level = it->levelRowStart;
+						}
+						else if( lx )
+						{
+							const char *src = lx == 1 && ly == 0 ? it->pixels : &(it->level[0]);
+							reduce( *it, src, levelSize( file, lx - 1, ly ), levelSize( file, lx, ly ), it->level );
+						}
+					}
+					writeLevel( file, channels, lx, ly );
+				}
+			}
+			break;
+		default :
+			throw IOException( "EXRImageWriter: Unsupported level mode" );
+	}
+}
+
+} // namespace
+
 void EXRImageWriter::writeImage( const vector<string> &names, const ImagePrimitive * image, const Box2i &dataWindow) const
 {
 	assert( image );
@@ -232,10 +503,11 @@ void EXRImageWriter::writeImage( const vector<string> &names, const ImagePrimiti
 		header.dataWindow() = dataWindow;
 		header.displayWindow() = image->getDisplayWindow();
 
-		// create the framebuffer
-		FrameBuffer fb;
-
-		// add the channels into the header with the appropriate types
+		// add the channels into the header with the appropriate types.
+		// the channel data is handed to OpenEXR as is, whatever its type,
+		// so that no intermediate copies are made.
+		OutputChannels channels;
+		channels.reserve( names.size() );
 		for (vector<string>::const_iterator i = names.begin(); i != names.end(); ++i)
 		{
 			const char *name = (*i).c_str();
@@ -256,33 +528,57 @@ void EXRImageWriter::writeImage( const vector<string> &names, const ImagePrimiti
 			switch (channelData->typeId())
 			{
 			case FloatVectorDataTypeId:
-				writeTypedChannel<float>(name, dataWindow,
-				                         static_cast<const FloatVectorData *>(channelData)->readable(),
-				                         FLOAT, header, fb);
+				channels.push_back( OutputChannel( name, FLOAT, sizeof( float ), &static_cast<const FloatVectorData *>(channelData)->readable()[0] ) );
 				break;
 
 			case UIntVectorDataTypeId:
-				writeTypedChannel<unsigned int>(name, dataWindow,
-				                                static_cast<const UIntVectorData *>(channelData)->readable(),
-				                                UINT, header, fb);
+				channels.push_back( OutputChannel( name, UINT, sizeof( unsigned int ), &static_cast<const UIntVectorData *>(channelData)->readable()[0] ) );
 				break;
 
 			case HalfVectorDataTypeId:
-				writeTypedChannel<half>(name, dataWindow,
-				                        static_cast<const HalfVectorData *>(channelData)->readable(),
-				                        HALF, header, fb);
+				channels.push_back( OutputChannel( name, HALF, sizeof( half ), &static_cast<const HalfVectorData *>(channelData)->readable()[0] ) );
 				break;
 
 			default:
 				throw IOException( ( boost::format("EXRImageWriter: Invalid data type \"%s\" for channel \"%s\"") % channelData->typeName() % name ).str() );
 			}
+
+			header.channels().insert( name, Channel( channels.back().type ) );
 		}
 
-		// create the output file, write, implicitly close
-		OutputFile out(fileName().c_str(), header);
+		// OpenEXR compresses concurrently using its global thread pool. That
+		// is shared with everything else in the process, so it is only sized
+		// by setGlobalThreadCount(), and here we just choose how many lines or
+		// tiles are compressed at once.
+		int numThreads = numThreadsParameter()->getNumericValue();
+		if( !numThreads )
+		{
+			numThreads = globalThreadCount();
+		}
+		else if( numThreads == 1 )
+		{
+			numThreads = 0;
+		}
 
-		out.setFrameBuffer(fb);
-		out.writePixels(height);
+		// create the output file, write, implicitly close
+		if( tiledParameter()->getTypedValue() )
+		{
+			const V2i &tileSize = tileSizeParameter()->getTypedValue();
+			if( tileSize.x < 1 || tileSize.y < 1 )
+			{
+				throw InvalidArgumentException( "EXRImageWriter: Tile size must be positive" );
+			}
+			header.setTileDescription(
+				TileDescription( tileSize.x, tileSize.y, static_cast<LevelMode>( levelModeParameter()->getNumericValue() ) )
+			);
+			writeTiled( fileName().c_str(), header, channels, numThreads );
+		}
+		else
+		{
+			OutputFile out( fileName().c_str(), header, numThreads );
+			out.setFrameBuffer( frameBuffer( channels, dataWindow, true ) );
+			out.writePixels( height );
+		}
 	}
 	catch ( Exception &e )
 	{
@@ -298,19 +594,3 @@ void EXRImageWriter::writeImage( const vector<string> &names, const ImagePrimiti
 	}
 
 }
-
-template<typename T>
-void EXRImageWriter::writeTypedChannel(const char *name, const Box2i &dataWindow,
-                                       const vector<T> &channel, const Imf::PixelType pixelType, Header &header, FrameBuffer &fb) const
-{
-	assert( name );
-
-	int width = 1 + dataWindow.max.x - dataWindow.min.x;
-
-	// update the header
-	header.channels().insert( name, Channel(pixelType) );
-
-	// update the framebuffer
-	char *offset = (char *) (&channel[0] - (dataWindow.min.x + width * dataWindow.min.y));
-	fb.insert(name, Slice(pixelType, offset, sizeof(T), sizeof(T) * width));
-}
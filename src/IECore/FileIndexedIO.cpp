@@ -32,8 +32,15 @@
 //
 //////////////////////////////////////////////////////////////////////////
 
+#include <list>
+
+#include <sys/stat.h>
+
 #include "boost/filesystem/operations.hpp"
 
+#include "tbb/mutex.h"
+#include "tbb/atomic.h"
+
 #include "IECore/MessageHandler.h"
 #include "IECore/FileIndexedIO.h"
 
@@ -66,9 +73,153 @@ class FileIndexedIO::StreamFile : public StreamIndexedIO::StreamFile
 
 		void flush( size_t endPosition );
 
+		// Adds a file opened for reading to the pool of open files, so it
+		// is closed when others need its handle.
+		void addToPool();
+
+		struct Pool;
+		static Pool &pool();
+
+	protected :
+
+		virtual void reopenStream();
+
+	private :
+
+		bool m_pooled;
+		std::list<StreamFile *>::iterator m_poolPosition;
+
+		// Identifies the file on disk when it was opened for reading, so that
+		// reopenStream() can refuse to use the in-memory index with a file which
+		// has since been modified or replaced.
+		struct Identity
+		{
+			Identity();
+			// Returns false if the file can't be stat'ed.
+			bool get( const std::string &fileName );
+			bool operator == ( const Identity &other ) const;
+
+			dev_t device;
+			ino_t inode;
+			off_t size;
+			time_t modificationTime;
+			long modificationTimeNanoseconds;
+		};
+
+		Identity m_identity;
+
 };
 
-FileIndexedIO::StreamFile::StreamFile( const std::string &filename, IndexedIO::OpenMode mode ) : StreamIndexedIO::StreamFile(mode), m_filename( filename ), m_endPosition(0)
+FileIndexedIO::StreamFile::Identity::Identity()
+	:	device( 0 ), inode( 0 ), size( 0 ), modificationTime( 0 ), modificationTimeNanoseconds( 0 )
+{
+}
+
+bool FileIndexedIO::StreamFile::Identity::get( const std::string &fileName )
+{
+	struct stat s;
+	if( stat( fileName.c_str(), &s ) != 0 )
+	{
+		return false;
+	}
+
+	device = s.st_dev;
+	inode = s.st_ino;
+	size = s.st_size;
+	modificationTime = s.st_mtime;
+#ifdef __APPLE__
+	modificationTimeNanoseconds = s.st_mtimespec.tv_nsec;
+#else
+	modificationTimeNanoseconds = s.st_mtim.tv_nsec;
+#endif
+	return true;
+}
+
+bool FileIndexedIO::StreamFile::Identity::operator == ( const Identity &other ) const
+{
+	return
+		device == other.device &&
+		inode == other.inode &&
+		size == other.size &&
+		modificationTime == other.modificationTime &&
+		modificationTimeNanoseconds == other.modificationTimeNanoseconds;
+}
+
+// The files open for reading. When there are more than maxOpenFiles of them,
+// the least recently used are closed, using the "second chance" scheme - files
+// accessed since they were last looked at are moved to the back of the list
+// rather than closed. Files which are in use by another thread are skipped
+// rather than waited for, so a file can be added to the pool while its own
+// mutex is held.
+struct FileIndexedIO::StreamFile::Pool
+{
+
+	Pool()
+		:	maxOpenFiles( 512 )
+	{
+		reopens = 0;
+	}
+
+	typedef std::list<StreamFile *> FileList;
+
+	tbb::mutex mutex;
+	FileList files;
+	size_t maxOpenFiles;
+	tbb::atomic<size_t> reopens;
+
+	// the functions below must be called with the mutex held.
+
+	void add( StreamFile *file )
+	{
+		file->m_poolPosition = files.insert( files.end(), file );
+		file->m_pooled = true;
+		closeUnused( file );
+	}
+
+	void remove( StreamFile *file )
+	{
+		if( file->m_pooled )
+		{
+			files.erase( file->m_poolPosition );
+			file->m_pooled = false;
+		}
+	}
+
+	void closeUnused( const StreamFile *exclude )
+	{
+		// each file needs looking at no more than twice - once to clear
+		// its access flag and once to close it.
+		size_t maxVisits = files.size() * 2;
+		while( files.size() > maxOpenFiles && maxVisits-- )
+		{
+			StreamFile *file = files.front();
+			StreamFile::MutexLock lock;
+			if( file != exclude && lock.try_acquire( file->mutex() ) )
+			{
+				if( !file->m_accessed )
+				{
+					file->closeStream();
+					files.pop_front();
+					file->m_pooled = false;
+					continue;
+				}
+				file->m_accessed = false;
+			}
+			files.splice( files.end(), files, files.begin() );
+		}
+	}
+
+};
+
+FileIndexedIO::StreamFile::Pool &FileIndexedIO::StreamFile::pool()
+{
+	// deliberately leaked, as files may still be open during
+	// static destruction.
+	static Pool *p = new Pool;
+	return *p;
+}
+
+FileIndexedIO::StreamFile::StreamFile( const std::string &filename, IndexedIO::OpenMode mode ) : StreamIndexedIO::StreamFile(mode), m_filename( filename ), m_endPosition(0), m_pooled( false )
 {
 	if (mode & IndexedIO::Write)
 	{
@@ -124,8 +275,9 @@ FileIndexedIO::StreamFile::StreamFile( const std::string &filename, IndexedIO::O
 		assert( mode & IndexedIO::Read );
 		std::fstream *f = new std::fstream(filename.c_str(), std::ios::binary | std::ios::in );
 
-		if (! f->is_open() )
+		if (! f->is_open() || !m_identity.get( filename ) )
 		{
+			delete f;
 			throw IOException( "FileIndexedIO: Cannot open file '" + filename + "' for read" );
 		}
 
@@ -153,6 +305,13 @@ void FileIndexedIO::StreamFile::flush( size_t endPosition )
 
 FileIndexedIO::StreamFile::~StreamFile()
 {
+	if ( m_openmode & IndexedIO::Read )
+	{
+		Pool &p = pool();
+		tbb::mutex::scoped_lock lock( p.mutex );
+		p.remove( this );
+	}
+
 	if ( m_openmode == IndexedIO::Write || m_openmode == IndexedIO::Append )
 	{
 		std::fstream *f = static_cast< std::fstream * >( m_stream );
@@ -173,6 +332,39 @@ FileIndexedIO::StreamFile::~StreamFile()
 	}
 }
 
+void FileIndexedIO::StreamFile::addToPool()
+{
+	Pool &p = pool();
+	tbb::mutex::scoped_lock lock( p.mutex );
+	p.add( this );
+}
+
+void FileIndexedIO::StreamFile::reopenStream()
+{
+	std::fstream *f = new std::fstream( m_filename.c_str(), std::ios::binary | std::ios::in );
+	if ( !f->is_open() )
+	{
+		delete f;
+		throw IOException( "FileIndexedIO: Cannot reopen file '" + m_filename + "' for read - it may have been deleted since it was opened" );
+	}
+
+	// our index was read from the original file, and would give
+	// garbage if used with a different one.
+	Identity identity;
+	if ( !identity.get( m_filename ) || !( identity == m_identity ) )
+	{
+		delete f;
+		throw IOException( "FileIndexedIO: Cannot reopen file '" + m_filename + "' for read - it has been modified or replaced since it was opened" );
+	}
+
+	m_stream = f;
+
+	Pool &p = pool();
+	p.reopens++;
+	tbb::mutex::scoped_lock lock( p.mutex );
+	p.add( this );
+}
+
 bool FileIndexedIO::StreamFile::canRead( const std::string &path )
 {
 	std::fstream d( path.c_str(), std::ios::binary | std::ios::in);
@@ -222,7 +414,13 @@ FileIndexedIO::FileIndexedIO(const std::string &path, const IndexedIO::EntryIDLi
 	{
 		throw FileNotFoundIOException(filename);
 	}
-	open( new StreamFile( filename, mode ), root );
+	StreamFile *file = new StreamFile( filename, mode );
+	open( file, root );
+	if ( file->openMode() & IndexedIO::Read )
+	{
+		// the index has been read, so the handle can be closed if need be.
+		file->addToPool();
+	}
 }
 
 FileIndexedIO::FileIndexedIO( StreamIndexedIO::Node &rootNode ) : StreamIndexedIO( rootNode )
@@ -244,3 +442,30 @@ const std::string &FileIndexedIO::fileName() const
 	StreamFile &stream = static_cast<StreamFile&>( streamFile() );
 	return stream.m_filename;
 }
+
+void FileIndexedIO::setMaxOpenFiles( size_t maxOpenFiles )
+{
+	StreamFile::Pool &p = StreamFile::pool();
+	tbb::mutex::scoped_lock lock( p.mutex );
+	p.maxOpenFiles = maxOpenFiles;
+	p.closeUnused( 0 );
+}
+
+size_t FileIndexedIO::getMaxOpenFiles()
+{
+	StreamFile::Pool &p = StreamFile::pool();
+	tbb::mutex::scoped_lock lock( p.mutex );
+	return p.maxOpenFiles;
+}
+
+size_t FileIndexedIO::numOpenFiles()
+{
+	StreamFile::Pool &p = StreamFile::pool();
+	tbb::mutex::scoped_lock lock( p.mutex );
+	return p.files.size();
+}
+
+size_t FileIndexedIO::numReopens()
+{
+	return StreamFile::pool().reopens;
+}
@@ -44,6 +44,10 @@
 #include "boost/filesystem/path.hpp"
 #include "boost/filesystem/convenience.hpp"
 #include "boost/algorithm/string.hpp"
+#include "boost/unordered_map.hpp"
+
+#include "tbb/parallel_for.h"
+#include "tbb/blocked_range.h"
 
 #include "IECore/Exception.h"
 #include "IECore/FileSequence.h"
@@ -81,103 +85,340 @@
 
 using namespace IECore;
 
-void IECore::findSequences( const std::vector< std::string > &names, std::vector< FileSequencePtr > &sequences, size_t minSequenceSize )
+namespace
 {
-	sequences.clear();
 
-	/// this matches names of the form $prefix$frameNumber$suffix
-	/// placing each of those in a group of the resulting match.
-	/// both $prefix and $suffix may be the empty string and $frameNumber
-	/// may be preceded by a minus sign.
-	/// It also matches file extensions with 3 or 4 characters that contain numbers (for example: CR2, MP3 )
-	boost::regex matchExpression( std::string( "^([^#]*?)(-?[0-9]+)([^0-9#]*|[^0-9#]*\\.[a-zA-Z]{2,3}[0-9])$" ) );
+inline bool isDigit( char c )
+{
+	return c >= '0' && c <= '9';
+}
+
+inline bool isAlpha( char c )
+{
+	return ( c >= 'a' && c <= 'z' ) || ( c >= 'A' && c <= 'Z' );
+}
 
-	/// build a mapping from ($prefix, $suffix) to a list of $frameNumbers
-	typedef std::vector< std::string > Frames;
-	typedef std::map< std::pair< std::string, std::string >, Frames > SequenceMap;
+/// Splits names of the form $prefix$frameNumber$suffix, returning the range of
+/// the $frameNumber within the name. Both $prefix and $suffix may be the empty
+/// string and $frameNumber may be preceded by a minus sign. Names with file extensions
+/// of 2 or 3 letters followed by a number (for example: CR2, MP3) take the frame
+/// number from before the extension. This gives identical results to matching
+/// against "^([^#]*?)(-?[0-9]+)([^0-9#]*|[^0-9#]*\\.[a-zA-Z]{2,3}[0-9])$", but
+/// without the considerable overhead of a regex.
+bool frameNumberRange( const std::string &name, size_t &frameBegin, size_t &frameEnd )
+{
+	if( name.find( '#' ) != std::string::npos )
+	{
+		return false;
+	}
+
+	const size_t size = name.size();
+
+	// find the last run of digits
+	size_t end = size;
+	while( end && !isDigit( name[end-1] ) )
+	{
+		--end;
+	}
+	if( !end )
+	{
+		return false;
+	}
 
-	SequenceMap sequenceMap;
+	size_t begin = end - 1;
+	while( begin && isDigit( name[begin-1] ) )
+	{
+		--begin;
+	}
 
-	for ( std::vector< std::string >::const_iterator it = names.begin(); it != names.end(); ++it )
+	// if that run is a single digit terminating an extension, then
+	// the frame number is the run of digits before it, if there is one.
+	if( end == size && begin == size - 1 )
 	{
-		boost::smatch matches;
-		if ( boost::regex_match( *it, matches, matchExpression ) )
+		for( size_t extensionLength = 2; extensionLength <= 3; ++extensionLength )
 		{
-			sequenceMap[
-				SequenceMap::key_type(
-					std::string( matches[1].first, matches[1].second ),
-					std::string( matches[3].first, matches[3].second )
-				)
-			].push_back( std::string( matches[2].first, matches[2].second ) );
+			if( size < extensionLength + 2 || name[size-extensionLength-2] != '.' )
+			{
+				continue;
+			}
+
+			bool alpha = true;
+			for( size_t i = size - extensionLength - 1; i < size - 1; ++i )
+			{
+				alpha = alpha && isAlpha( name[i] );
+			}
+			if( !alpha )
+			{
+				continue;
+			}
+
+			size_t extensionEnd = size - extensionLength - 2;
+			while( extensionEnd && !isDigit( name[extensionEnd-1] ) )
+			{
+				--extensionEnd;
+			}
+			if( extensionEnd )
+			{
+				end = extensionEnd;
+				begin = end - 1;
+				while( begin && isDigit( name[begin-1] ) )
+				{
+					--begin;
+				}
+				break;
+			}
+		}
+	}
+
+	if( begin && name[begin-1] == '-' )
+	{
+		--begin;
+	}
+
+	frameBegin = begin;
+	frameEnd = end;
+	return true;
+}
+
+FrameList::Frame frameNumber( const std::string &digits )
+{
+	// an int64 can hold any 18 digit number, so we only need to
+	// fall back to lexical_cast (and its overflow checks) for longer
+	// strings.
+	if( digits.size() > 18 )
+	{
+		return boost::lexical_cast<FrameList::Frame>( digits );
+	}
+
+	FrameList::Frame result = 0;
+	for( std::string::const_iterator it = digits.begin(); it != digits.end(); ++it )
+	{
+		result = result * 10 + ( *it - '0' );
+	}
+	return result;
+}
+
+typedef std::vector< std::string > Frames;
+typedef std::pair< std::string, std::string > Fixes;
+typedef boost::unordered_map< Fixes, Frames > SequenceMap;
+
+/// Builds FileSequences for a single ($prefix, $suffix) pair.
+void buildSequences( const Fixes &fixes, const Frames &frames, size_t minSequenceSize, std::vector< FileSequencePtr > &sequences )
+{
+	// todo: could be more efficient by writing a custom comparison function that uses indexes 
+	//	 into the const Frames vector rather than duplicating the strings and sorting them directly
+	Frames sortedFrames = frames;
+	std::sort( sortedFrames.begin(), sortedFrames.end() );
+
+	/// in diabolical cases the elements of frames may not all have the same padding
+	/// so we'll sort them out into padded and unpadded frame sequences here, by creating
+	/// a map of padding->list of frames. unpadded things will be considered to have a padding
+	/// of 1.
+	typedef std::vector< FrameList::Frame > NumericFrames;
+	typedef std::map< unsigned int, NumericFrames > PaddingToFramesMap;
+	PaddingToFramesMap paddingToFrames;
+	for ( Frames::const_iterator fIt = sortedFrames.begin(); fIt != sortedFrames.end(); ++fIt )
+	{
+		std::string frame = *fIt;
+		int sign = 1;
+
+		assert( frame.size() );
+		if ( *frame.begin() == '-' )
+		{
+			frame = frame.substr( 1, frame.size() - 1 );
+			sign = -1;
+		}
+		if ( *frame.begin() == '0' || paddingToFrames.find( frame.size() ) != paddingToFrames.end() )
+		{
+			paddingToFrames[ frame.size() ].push_back( sign * frameNumber( frame ) );
+		}
+		else
+		{
+			paddingToFrames[ 1 ].push_back( sign * frameNumber( frame ) );
 		}
 	}
 
-	for ( SequenceMap::const_iterator it = sequenceMap.begin(); it != sequenceMap.end(); ++it )
+	for ( PaddingToFramesMap::iterator pIt = paddingToFrames.begin(); pIt != paddingToFrames.end(); ++pIt )
 	{
-		const SequenceMap::key_type &fixes = it->first;
-		const Frames &frames = it->second;
-		// todo: could be more efficient by writing a custom comparison function that uses indexes 
-		//	 into the const Frames vector rather than duplicating the strings and sorting them directly
-		Frames sortedFrames = frames;
-		std::sort( sortedFrames.begin(), sortedFrames.end() );
-		
-		/// in diabolical cases the elements of frames may not all have the same padding
-		/// so we'll sort them out into padded and unpadded frame sequences here, by creating
-		/// a map of padding->list of frames. unpadded things will be considered to have a padding
-		/// of 1.
-		typedef std::vector< FrameList::Frame > NumericFrames;
-		typedef std::map< unsigned int, NumericFrames > PaddingToFramesMap;
-		PaddingToFramesMap paddingToFrames;
-		for ( Frames::const_iterator fIt = sortedFrames.begin(); fIt != sortedFrames.end(); ++fIt )
+		const PaddingToFramesMap::key_type &padding = pIt->first;
+		NumericFrames &numericFrames = pIt->second;
+		std::sort( numericFrames.begin(), numericFrames.end() );
+
+		FrameListPtr frameList = frameListFromList( numericFrames );
+
+		std::vector< FrameList::Frame > expandedFrameList;
+		frameList->asList( expandedFrameList );
+
+		/// remove any sequences with less than the given minimum.
+		if ( expandedFrameList.size() >= minSequenceSize )
+		{
+			std::string frameTemplate( padding, '#' );
+			sequences.push_back(
+				new FileSequence(
+					fixes.first + frameTemplate + fixes.second,
+					frameList
+				)
+			);
+		}
+	}
+}
+
+/// Sorts names into buckets keyed by their ($prefix, $suffix) pair. Names may be
+/// added one at a time as they are streamed from a directory listing, without first
+/// building a list of them all.
+class SequenceBuilder
+{
+
+	public :
+
+		SequenceBuilder()
+			:	m_lastFixes( 0 ), m_lastFrames( 0 )
+		{
+		}
+
+		void add( const std::string &name )
 		{
-			std::string frame = *fIt;
-			int sign = 1;
+			size_t frameBegin, frameEnd;
+			if( frameNumberRange( name, frameBegin, frameEnd ) )
+			{
+				add( name, frameBegin, frameEnd );
+			}
+		}
 
-			assert( frame.size() );
-			if ( *frame.begin() == '-' )
+		void add( const std::string &name, size_t frameBegin, size_t frameEnd )
+		{
+			// consecutive names very often belong to the same sequence, in which
+			// case we can avoid constructing and hashing a key altogether.
+			if(
+				!m_lastFrames ||
+				m_lastFixes->first.size() != frameBegin ||
+				m_lastFixes->second.size() != name.size() - frameEnd ||
+				name.compare( 0, frameBegin, m_lastFixes->first ) ||
+				name.compare( frameEnd, std::string::npos, m_lastFixes->second )
+			)
 			{
-				frame = frame.substr( 1, frame.size() - 1 );
-				sign = -1;
+				SequenceMap::value_type &entry = *m_sequenceMap.insert(
+					SequenceMap::value_type(
+						Fixes( name.substr( 0, frameBegin ), name.substr( frameEnd ) ),
+						Frames()
+					)
+				).first;
+				// references to the elements of an unordered_map are
+				// not invalidated by rehashing, so these are safe to keep.
+				m_lastFixes = &entry.first;
+				m_lastFrames = &entry.second;
 			}
-			if ( *frame.begin() == '0' || paddingToFrames.find( frame.size() ) != paddingToFrames.end() )
+			m_lastFrames->push_back( name.substr( frameBegin, frameEnd - frameBegin ) );
+		}
+
+		void sequences( std::vector< FileSequencePtr > &sequences, size_t minSequenceSize ) const
+		{
+			// we output sequences ordered by prefix and suffix, so
+			// the results don't depend on the hashing.
+			std::vector< const SequenceMap::value_type * > entries;
+			entries.reserve( m_sequenceMap.size() );
+			for( SequenceMap::const_iterator it = m_sequenceMap.begin(); it != m_sequenceMap.end(); ++it )
 			{
-				paddingToFrames[ frame.size() ].push_back( sign * boost::lexical_cast<FrameList::Frame>( frame ) );
+				entries.push_back( &*it );
 			}
-			else
+			std::sort( entries.begin(), entries.end(), EntryLess() );
+
+			std::vector< std::vector< FileSequencePtr > > entrySequences( entries.size() );
+			tbb::parallel_for(
+				tbb::blocked_range<size_t>( 0, entries.size() ),
+				EntryBuilder( entries, minSequenceSize, entrySequences )
+			);
+
+			for( std::vector< std::vector< FileSequencePtr > >::const_iterator it = entrySequences.begin(); it != entrySequences.end(); ++it )
 			{
-				paddingToFrames[ 1 ].push_back( sign * boost::lexical_cast<FrameList::Frame>( frame ) );
+				sequences.insert( sequences.end(), it->begin(), it->end() );
 			}
 		}
 
-		for ( PaddingToFramesMap::iterator pIt = paddingToFrames.begin(); pIt != paddingToFrames.end(); ++pIt )
-		{
-			const PaddingToFramesMap::key_type &padding = pIt->first;
-			NumericFrames &numericFrames = pIt->second;
-			std::sort( numericFrames.begin(), numericFrames.end() );
+	private :
 
-			FrameListPtr frameList = frameListFromList( numericFrames );
+		struct EntryLess
+		{
+			bool operator()( const SequenceMap::value_type *a, const SequenceMap::value_type *b ) const
+			{
+				return a->first < b->first;
+			}
+		};
 
-			std::vector< FrameList::Frame > expandedFrameList;
-			frameList->asList( expandedFrameList );
+		struct EntryBuilder
+		{
+			EntryBuilder( const std::vector< const SequenceMap::value_type * > &entries, size_t minSequenceSize, std::vector< std::vector< FileSequencePtr > > &sequences )
+				:	m_entries( entries ), m_minSequenceSize( minSequenceSize ), m_sequences( sequences )
+			{
+			}
 
-			/// remove any sequences with less than the given minimum.
-			if ( expandedFrameList.size() >= minSequenceSize )
+			void operator()( const tbb::blocked_range<size_t> &r ) const
 			{
-				std::string frameTemplate;
-				for ( PaddingToFramesMap::key_type i = 0; i < padding; i++ )
+				for( size_t i = r.begin(); i != r.end(); ++i )
 				{
-					frameTemplate += "#";
+					buildSequences( m_entries[i]->first, m_entries[i]->second, m_minSequenceSize, m_sequences[i] );
 				}
+			}
 
-				sequences.push_back(
-					new FileSequence(
-						fixes.first + frameTemplate + fixes.second,
-						frameList
-					)
-				);
+			const std::vector< const SequenceMap::value_type * > &m_entries;
+			size_t m_minSequenceSize;
+			std::vector< std::vector< FileSequencePtr > > &m_sequences;
+		};
+
+		SequenceMap m_sequenceMap;
+		const Fixes *m_lastFixes;
+		Frames *m_lastFrames;
+
+};
+
+typedef std::pair< size_t, size_t > FrameNumberRange;
+
+/// Computes the frame number ranges for a list of names in parallel.
+struct FrameNumberRanges
+{
+	FrameNumberRanges( const std::vector< std::string > &names, std::vector< FrameNumberRange > &ranges )
+		:	m_names( names ), m_ranges( ranges )
+	{
+	}
+
+	void operator()( const tbb::blocked_range<size_t> &r ) const
+	{
+		for( size_t i = r.begin(); i != r.end(); ++i )
+		{
+			FrameNumberRange &range = m_ranges[i];
+			if( !frameNumberRange( m_names[i], range.first, range.second ) )
+			{
+				range.first = range.second = std::string::npos;
 			}
 		}
 	}
+
+	const std::vector< std::string > &m_names;
+	std::vector< FrameNumberRange > &m_ranges;
+};
+
+} // namespace
+
+void IECore::findSequences( const std::vector< std::string > &names, std::vector< FileSequencePtr > &sequences, size_t minSequenceSize )
+{
+	sequences.clear();
+
+	std::vector< FrameNumberRange > ranges( names.size() );
+	tbb::parallel_for(
+		tbb::blocked_range<size_t>( 0, names.size(), 1000 ),
+		FrameNumberRanges( names, ranges )
+	);
+
+	SequenceBuilder builder;
+	for( size_t i = 0, e = names.size(); i < e; ++i )
+	{
+		if( ranges[i].first != std::string::npos )
+		{
+			builder.add( names[i], ranges[i].first, ranges[i].second );
+		}
+	}
+
+	builder.sequences( sequences, minSequenceSize );
 }
 
 void IECore::findSequences( const std::vector< std::string > &names, std::vector< FileSequencePtr > &sequences )
@@ -192,14 +433,14 @@ void IECore::ls( const std::string &path, std::vector< FileSequencePtr > &sequen
 
 	if ( boost::filesystem::is_directory( path ) )
 	{
+		SequenceBuilder builder;
 		boost::filesystem::directory_iterator end;
-	 	std::vector< std::string > files;
 		for ( boost::filesystem::directory_iterator it( path ); it != end; ++it )
 		{
-			files.push_back( it->path().PATH_TO_STRING );
+			builder.add( it->path().PATH_TO_STRING );
 		}
 
-		findSequences( files, sequences, minSequenceSize );
+		builder.sequences( sequences, minSequenceSize );
 	}
 }
 
@@ -216,8 +457,6 @@ void IECore::ls( const std::string &sequencePath, FileSequencePtr &sequence, siz
 	const std::string paddingStr( matches[2].first, matches[2].second );
 	const unsigned padding = paddingStr.size();
 
- 	std::vector< std::string > files;
-
 	boost::filesystem::path dir = boost::filesystem::path( sequencePath ).parent_path();
 
 	std::string baseSequencePath = boost::filesystem::path( sequencePath ).PATH_TO_STRING;
@@ -236,20 +475,21 @@ void IECore::ls( const std::string &sequencePath, FileSequencePtr &sequence, siz
 		dirToCheck = ".";
 	}
 
+	SequenceBuilder builder;
 	boost::filesystem::directory_iterator end;
 
 	for ( boost::filesystem::directory_iterator it( dirToCheck ); it != end; ++it )
 	{
 		const std::string fileName = it->path().PATH_TO_STRING;
 
-		if ( fileName.size() >= std::min( prefix.size(), suffix.size() ) && fileName.substr( 0, prefix.size() ) == prefix && fileName.substr( fileName.size() - suffix.size(), suffix.size() ) == suffix )
+		if ( fileName.size() >= std::min( prefix.size(), suffix.size() ) && fileName.compare( 0, prefix.size(), prefix ) == 0 && fileName.size() >= suffix.size() && fileName.compare( fileName.size() - suffix.size(), suffix.size(), suffix ) == 0 )
 		{
-			files.push_back( ( dir / boost::filesystem::path( fileName ) ).string() );
+			builder.add( ( dir / boost::filesystem::path( fileName ) ).string() );
 		}
 	}
 
 	std::vector< FileSequencePtr > sequences;
-	findSequences( files, sequences, minSequenceSize );
+	builder.sequences( sequences, minSequenceSize );
 
 	for ( std::vector< FileSequencePtr >::iterator it = sequences.begin(); it != sequences.end() ; ++it )
 	{
@@ -32,6 +32,8 @@
 //
 //////////////////////////////////////////////////////////////////////////
 
+#include <algorithm>
+
 #include "IECore/Grade.h"
 #include "IECore/CompoundParameter.h"
 #include "IECore/MessageHandler.h"
@@ -228,6 +230,9 @@ void Grade::begin( const CompoundObject * operands )
 
 	m_A = multiply * ( gain - lift ) / ( whitePoint - blackPoint );
 	m_B = offset + lift - m_A * blackPoint;
+
+	m_blackClamp = m_blackClampParameter->getTypedValue();
+	m_whiteClamp = m_whiteClampParameter->getTypedValue();
 }
 
 void Grade::transform( Imath::Color3f &color ) const
@@ -237,17 +242,61 @@ void Grade::transform( Imath::Color3f &color ) const
 	color.y = ( c.y >= 0.0 ? (float)pow( c.y, m_invGamma.y ) : c.y );
 	color.z = ( c.z >= 0.0 ? (float)pow( c.z, m_invGamma.z ) : c.z );
 
-	if ( m_blackClampParameter->getTypedValue() )
+	if ( m_blackClamp )
 	{
 		if ( color.x < 0.0 ) color.x = 0.0;
 		if ( color.y < 0.0 ) color.y = 0.0;
 		if ( color.z < 0.0 ) color.z = 0.0;
 	}
 
-	if ( m_whiteClampParameter->getTypedValue() )
+	if ( m_whiteClamp )
 	{
 		if ( color.x > 1.0 ) color.x = 1.0;
 		if ( color.y > 1.0 ) color.y = 1.0;
 		if ( color.z > 1.0 ) color.z = 1.0;
 	}
 }
+
+/// Grades a single channel. The loops are kept free of branches where
+/// possible so that the compiler can vectorise them.
+static void gradeChannel( float *c, size_t n, double a, double b, double invGamma, bool blackClamp, bool whiteClamp )
+{
+	if( invGamma == 1.0 )
+	{
+		for( size_t i = 0; i < n; i++ )
+		{
+			c[i] = a * c[i] + b;
+		}
+	}
+	else
+	{
+		for( size_t i = 0; i < n; i++ )
+		{
+			const double v = a * c[i] + b;
+			c[i] = ( v >= 0.0 ? (float)pow( v, invGamma ) : v );
+		}
+	}
+
+	if( blackClamp )
+	{
+		for( size_t i = 0; i < n; i++ )
+		{
+			c[i] = std::max( c[i], 0.0f );
+		}
+	}
+
+	if( whiteClamp )
+	{
+		for( size_t i = 0; i < n; i++ )
+		{
+			c[i] = std::min( c[i], 1.0f );
+		}
+	}
+}
+
+void Grade::transformSpan( float *r, float *g, float *b, size_t n ) const
+{
+	gradeChannel( r, n, m_A.x, m_B.x, m_invGamma.x, m_blackClamp, m_whiteClamp );
+	gradeChannel( g, n, m_A.y, m_B.y, m_invGamma.y, m_blackClamp, m_whiteClamp );
+	gradeChannel( b, n, m_A.z, m_B.z, m_invGamma.z, m_blackClamp, m_whiteClamp );
+}
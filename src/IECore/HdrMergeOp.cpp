@@ -40,6 +40,11 @@
 #include "IECore/Math.h"
 #include "IECore/Group.h"
 #include "IECore/ImagePrimitive.h"
+#include "IECore/ImageReader.h"
+#include "IECore/VectorTypedParameter.h"
+
+#include "tbb/parallel_for.h"
+#include "tbb/blocked_range.h"
 
 #include <cassert>
 
@@ -99,7 +104,22 @@ HdrMergeOp::HdrMergeOp()
 		"zones are weighted with a smooth curve.",
 		new Box2fData( Box2f( V2f( 0.0, 0.05 ), V2f( 0.9, 1.0 ) ) )
 	);
+	m_inputFileNamesParameter = new StringVectorParameter(
+		"inputFileNames",
+		"The names of image files to be merged, ordered from the least to the most exposed. When "
+		"specified, these are used instead of the inputGroup, and are read a block of scanlines at a "
+		"time so that all the images don't need to be held in memory at once.",
+		new StringVectorData()
+	);
+	m_scanlinesPerBlockParameter = new IntParameter(
+		"scanlinesPerBlock",
+		"The number of scanlines read from each of the inputFileNames at a time.",
+		64,
+		1
+	);
 	parameters()->addParameter( m_inputGroupParameter );
+	parameters()->addParameter( m_inputFileNamesParameter );
+	parameters()->addParameter( m_scanlinesPerBlockParameter );
 	parameters()->addParameter( m_exposureStepParameter );
 	parameters()->addParameter( m_exposureAdjustmentParameter );
 	parameters()->addParameter( m_windowingParameter );
@@ -149,66 +169,291 @@ const Box2fParameter * HdrMergeOp::windowingParameter() const
 	return m_windowingParameter.get();
 }
 
-template< typename T >
-inline void merge( bool firstImage, size_t &pixelCount,
-					const ImagePrimitive * img, ImagePrimitive * outImg,
-					const Imath::Box2f &windowing, float intensityMultiplier,
-					FloatVectorData * outR, FloatVectorData * outG, FloatVectorData * outB, FloatVectorData * outA )
+IntParameter * HdrMergeOp::scanlinesPerBlockParameter()
 {
+	return m_scanlinesPerBlockParameter.get();
+}
+
+const IntParameter * HdrMergeOp::scanlinesPerBlockParameter() const
+{
+	return m_scanlinesPerBlockParameter.get();
+}
 
-	const TypedData< std::vector< T > > *inR = img->getChannel< T >( "R" );
-	const TypedData< std::vector< T > > *inG = img->getChannel< T >( "G" );
-	const TypedData< std::vector< T > > *inB = img->getChannel< T >( "B" );
+StringVectorParameter * HdrMergeOp::inputFileNamesParameter()
+{
+	return m_inputFileNamesParameter.get();
+}
+
+const StringVectorParameter * HdrMergeOp::inputFileNamesParameter() const
+{
+	return m_inputFileNamesParameter.get();
+}
+
+namespace
+{
 
-	if ( firstImage )
+// The RGB channels of a single input image, which may be either
+// float or half.
+struct InputChannels
+{
+
+	InputChannels( const ImagePrimitive *image )
+	{
+		const FloatVectorData *r = image->getChannel<float>( "R" );
+		if( r )
+		{
+			floatChannels[0] = &r->readable()[0];
+			floatChannels[1] = &image->getChannel<float>( "G" )->readable()[0];
+			floatChannels[2] = &image->getChannel<float>( "B" )->readable()[0];
+			size = r->readable().size();
+			isHalf = false;
+		}
+		else
+		{
+			const HalfVectorData *rh = image->getChannel<half>( "R" );
+			halfChannels[0] = &rh->readable()[0];
+			halfChannels[1] = &image->getChannel<half>( "G" )->readable()[0];
+			halfChannels[2] = &image->getChannel<half>( "B" )->readable()[0];
+			size = rh->readable().size();
+			isHalf = true;
+		}
+	}
+
+	static bool valid( const ImagePrimitive *image )
 	{
-		pixelCount = inR->readable().size();
-		outR->writable().resize( pixelCount, 0 );
-		outG->writable().resize( pixelCount, 0 );
-		outB->writable().resize( pixelCount, 0 );
-		outA->writable().resize( pixelCount, 0 );
-		outImg->setDisplayWindow( img->getDisplayWindow() );
-		outImg->setDataWindow( img->getDataWindow() );
+		if( image->getChannel<float>( "R" ) && image->getChannel<float>( "G" ) && image->getChannel<float>( "B" ) )
+		{
+			return true;
+		}
+		return image->getChannel<half>( "R" ) && image->getChannel<half>( "G" ) && image->getChannel<half>( "B" );
 	}
-	else
+
+	static size_t channelSize( const ImagePrimitive *image, const char *channel )
 	{
-		if ( pixelCount != inR->readable().size() ||
-			 pixelCount != inG->readable().size() ||
-			 pixelCount != inB->readable().size() )
+		if( const FloatVectorData *f = image->getChannel<float>( channel ) )
 		{
-			throw Exception( "Images are not of the same resolution!!" );
+			return f->readable().size();
 		}
+		return image->getChannel<half>( channel )->readable().size();
 	}
 
-	const T *ptrInR = &(inR->readable()[0]);
-	const T *ptrInG = &(inG->readable()[0]);
-	const T *ptrInB = &(inB->readable()[0]);
-	float *ptrOutR = &(outR->writable()[0]);
-	float *ptrOutG = &(outG->writable()[0]);
-	float *ptrOutB = &(outB->writable()[0]);
-	float *ptrOutA = &(outA->writable()[0]);
+	const float *floatChannels[3];
+	const half *halfChannels[3];
+	size_t size;
+	bool isHalf;
 
-	for ( size_t i = 0; i < pixelCount; i++ )
+};
+
+template< typename T >
+inline void accumulate( const T *inR, const T *inG, const T *inB, size_t begin, size_t end, bool firstImage,
+	const Imath::Box2f &windowing, float intensityMultiplier,
+	float *outR, float *outG, float *outB, float *outA )
+{
+	for ( size_t i = begin; i < end; i++ )
 	{
-		float intensity = (*ptrInR + *ptrInG + *ptrInB) / 3.0;
+		float intensity = (inR[i] + inG[i] + inB[i]) / 3.0;
 		float weight = smoothstep( windowing.min[0], windowing.min[1], intensity );
 		if ( !firstImage )
 		{
 			weight *= 1.0f - smoothstep( windowing.max[0], windowing.max[1], intensity );
 		}
 		float m = weight * intensityMultiplier;
-		*ptrOutR += *ptrInR * m;
-		*ptrOutG += *ptrInG * m;
-		*ptrOutB += *ptrInB * m;
-		*ptrOutA += weight;
+		outR[i] += inR[i] * m;
+		outG[i] += inG[i] * m;
+		outB[i] += inB[i] * m;
+		outA[i] += weight;
+	}
+}
+
+// Merges a range of pixels from all the inputs. The inputs are accumulated
+// in order for each pixel, so the result doesn't depend on how the range
+// is split between threads.
+class MergePixels
+{
+
+	public :
+
+		MergePixels( const std::vector<InputChannels> &inputs, const std::vector<float> &intensityMultipliers,
+			const Imath::Box2f &windowing, float adjustment, float *outR, float *outG, float *outB, float *outA )
+			:	m_inputs( inputs ), m_intensityMultipliers( intensityMultipliers ), m_windowing( windowing ), m_adjustment( adjustment ),
+				m_outR( outR ), m_outG( outG ), m_outB( outB ), m_outA( outA )
+		{
+		}
+
+		void operator()( const tbb::blocked_range<size_t> &range ) const
+		{
+			for( size_t i = range.begin(); i != range.end(); i++ )
+			{
+				m_outR[i] = m_outG[i] = m_outB[i] = m_outA[i] = 0.0f;
+			}
+
+			for( size_t j = 0; j < m_inputs.size(); j++ )
+			{
+				const InputChannels &input = m_inputs[j];
+				if( input.isHalf )
+				{
+					accumulate<half>(
+						input.halfChannels[0], input.halfChannels[1], input.halfChannels[2], range.begin(), range.end(),
+						j == 0, m_windowing, m_intensityMultipliers[j], m_outR, m_outG, m_outB, m_outA
+					);
+				}
+				else
+				{
+					accumulate<float>(
+						input.floatChannels[0], input.floatChannels[1], input.floatChannels[2], range.begin(), range.end(),
+						j == 0, m_windowing, m_intensityMultipliers[j], m_outR, m_outG, m_outB, m_outA
+					);
+				}
+			}
 
-		ptrInR++; ptrInG++; ptrInB++;
-		ptrOutR++; ptrOutG++; ptrOutB++; ptrOutA++;
+			// normalize the outputs
+			for( size_t i = range.begin(); i != range.end(); i++ )
+			{
+				float w = m_adjustment * m_outA[i];
+				if ( w > 0 )
+				{
+					m_outR[i] /= w;
+					m_outG[i] /= w;
+					m_outB[i] /= w;
+				}
+			}
+		}
+
+	private :
+
+		const std::vector<InputChannels> &m_inputs;
+		const std::vector<float> &m_intensityMultipliers;
+		Imath::Box2f m_windowing;
+		float m_adjustment;
+		float *m_outR;
+		float *m_outG;
+		float *m_outB;
+		float *m_outA;
+
+};
+
+ImagePrimitivePtr createOutput( const Imath::Box2i &dataWindow, const Imath::Box2i &displayWindow )
+{
+	ImagePrimitivePtr result = new ImagePrimitive();
+	result->setDisplayWindow( displayWindow );
+	result->setDataWindow( dataWindow );
+
+	const size_t pixelCount = result->variableSize( PrimitiveVariable::Vertex );
+	const char *channels[] = { "R", "G", "B", "A" };
+	for( int i = 0; i < 4; i++ )
+	{
+		FloatVectorDataPtr data = new FloatVectorData();
+		data->writable().resize( pixelCount );
+		result->variables[channels[i]] = PrimitiveVariable( PrimitiveVariable::Vertex, data );
 	}
+
+	return result;
 }
 
+void mergeRange( const CompoundObject *operands, const std::vector<InputChannels> &inputs, ImagePrimitive *outImg, size_t offset, size_t pixelCount )
+{
+	float exposureStep = operands->member< FloatData >( "exposureStep" )->readable();
+	float exposureAdjustment = operands->member< FloatData >("exposureAdjustment")->readable();
+	Imath::Box2f windowing = operands->member< Box2fData >("windowing" )->readable();
+
+	int numInputs = inputs.size();
+	std::vector<float> intensityMultipliers;
+	float exposure = exposureStep * (numInputs-1)/2.0;
+	for( int i = 0; i < numInputs; i++ )
+	{
+		intensityMultipliers.push_back( pow( 2.0f, exposure ) );
+		exposure -= exposureStep;
+	}
+
+	float adjustment = pow( 2.0f, -exposureAdjustment );
+
+	MergePixels mergePixels(
+		inputs, intensityMultipliers, windowing, adjustment,
+		&(outImg->getChannel<float>( "R" )->writable()[offset]),
+		&(outImg->getChannel<float>( "G" )->writable()[offset]),
+		&(outImg->getChannel<float>( "B" )->writable()[offset]),
+		&(outImg->getChannel<float>( "A" )->writable()[offset])
+	);
+	tbb::parallel_for( tbb::blocked_range<size_t>( 0, pixelCount, 4096 ), mergePixels );
+}
+
+ObjectPtr mergeFiles( const CompoundObject * operands )
+{
+	const std::vector<std::string> &fileNames = operands->member<StringVectorData>( "inputFileNames" )->readable();
+	const int scanlinesPerBlock = std::max( 1, operands->member<IntData>( "scanlinesPerBlock" )->readable() );
+
+	std::vector<ImageReaderPtr> readers;
+	std::vector<std::string> channelNames;
+	channelNames.push_back( "R" );
+	channelNames.push_back( "G" );
+	channelNames.push_back( "B" );
+	for( std::vector<std::string>::const_iterator it = fileNames.begin(); it != fileNames.end(); it++ )
+	{
+		ImageReaderPtr reader = runTimeCast<ImageReader>( Reader::create( *it ) );
+		if( !reader )
+		{
+			throw Exception( boost::str( boost::format( "File \"%s\" is not an image." ) % *it ) );
+		}
+		if( readers.size() && ( reader->dataWindow() != readers.front()->dataWindow() ) )
+		{
+			throw Exception( "Images are not of the same resolution!!" );
+		}
+		reader->channelNamesParameter()->setTypedValue( channelNames );
+		readers.push_back( reader );
+	}
+
+	const Box2i dataWindow = readers.front()->dataWindow();
+	ImagePrimitivePtr outImg = createOutput( dataWindow, readers.front()->displayWindow() );
+	const size_t width = dataWindow.size().x + 1;
+
+	// Read a block of scanlines from every input at a time, so that only one
+	// block of each image needs to be held in memory.
+	for( int y = dataWindow.min.y; y <= dataWindow.max.y; y += scanlinesPerBlock )
+	{
+		const Box2i blockWindow(
+			V2i( dataWindow.min.x, y ),
+			V2i( dataWindow.max.x, std::min( y + scanlinesPerBlock - 1, dataWindow.max.y ) )
+		);
+
+		std::vector<ConstImagePrimitivePtr> blocks;
+		std::vector<InputChannels> inputs;
+		for( std::vector<ImageReaderPtr>::const_iterator it = readers.begin(); it != readers.end(); it++ )
+		{
+			(*it)->dataWindowParameter()->setTypedValue( blockWindow );
+			ConstImagePrimitivePtr block = runTimeCast<const ImagePrimitive>( (*it)->read() );
+			if( !block || !InputChannels::valid( block.get() ) )
+			{
+				throw Exception( "Input images must have RGB channels of either half or float data types." );
+			}
+			blocks.push_back( block );
+			inputs.push_back( InputChannels( block.get() ) );
+			if(
+				inputs.back().size != block->variableSize( PrimitiveVariable::Vertex ) ||
+				InputChannels::channelSize( block.get(), "G" ) != inputs.back().size ||
+				InputChannels::channelSize( block.get(), "B" ) != inputs.back().size ||
+				block->getDataWindow() != blockWindow
+			)
+			{
+				throw Exception( "Image channels do not match the size of the data window." );
+			}
+		}
+
+		mergeRange( operands, inputs, outImg.get(), ( y - dataWindow.min.y ) * width, ( blockWindow.size().y + 1 ) * width );
+	}
+
+	return outImg;
+}
+
+} // namespace
+
 ObjectPtr HdrMergeOp::doOperation( const CompoundObject * operands )
 {
+	const std::vector<std::string> &fileNames = operands->member<StringVectorData>( "inputFileNames" )->readable();
+	if( fileNames.size() )
+	{
+		return mergeFiles( operands );
+	}
+
 	Group *imageGroup = static_cast<Group *>( m_inputGroupParameter->getValue() );
 
 	// first of all, check if the group contains ImagePrimitive objects with float or half vector data types and "R","G","B" channels.
@@ -219,15 +464,7 @@ ObjectPtr HdrMergeOp::doOperation( const CompoundObject * operands )
 		{
 			throw Exception( "Input group should contain images only!" );
 		}
-		ImagePrimitivePtr img = boost::static_pointer_cast< ImagePrimitive >(*it);
-		if ( !((img->getChannel< float >( "R" ) &&
-				img->getChannel< float >( "G" ) &&
-				img->getChannel< float >( "B" )) ||
-			   (img->getChannel< half >( "R" ) &&
-			    img->getChannel< half >( "G" ) &&
-			    img->getChannel< half >( "B" ))
-			  )
-			)
+		if ( !InputChannels::valid( static_cast<const ImagePrimitive *>( it->get() ) ) )
 		{
 			throw Exception( "Input images must have RGB channels of either half or float data types." );
 		}
@@ -237,59 +474,29 @@ ObjectPtr HdrMergeOp::doOperation( const CompoundObject * operands )
 		throw Exception( "Input group has no images to merge!" );
 	}
 
-	float exposureStep = operands->member< FloatData >( "exposureStep" )->readable();
-	float exposureAdjustment = operands->member< FloatData >("exposureAdjustment")->readable();
-	Imath::Box2f windowing = operands->member< Box2fData >("windowing" )->readable();
-
-	FloatVectorDataPtr outR = new FloatVectorData();
-	FloatVectorDataPtr outG = new FloatVectorData();
-	FloatVectorDataPtr outB = new FloatVectorData();
-	FloatVectorDataPtr outA = new FloatVectorData();
-
-	ImagePrimitivePtr outImg = new ImagePrimitive();
-	outImg->variables["R"] = PrimitiveVariable( PrimitiveVariable::Vertex, outR );
-	outImg->variables["G"] = PrimitiveVariable( PrimitiveVariable::Vertex, outG );
-	outImg->variables["B"] = PrimitiveVariable( PrimitiveVariable::Vertex, outB );
-	outImg->variables["A"] = PrimitiveVariable( PrimitiveVariable::Vertex, outA );
-
-	// loop over inputs accumulating them into the buffer
-	int numInputs = images.size();
-
-	float exposure = exposureStep * (numInputs-1)/2.0;
-	size_t pixelCount = 0;
-	bool firstImage = true;
-	for ( Group::ChildContainer::const_iterator it = images.begin(); it != images.end(); it++, firstImage = false )
+	std::vector<InputChannels> inputs;
+	for ( Group::ChildContainer::const_iterator it = images.begin(); it != images.end(); it++ )
 	{
 		const ImagePrimitive *img = static_cast<const ImagePrimitive *>( it->get() );
-		float intensityMultiplier = pow( 2.0f, exposure );
-		if ( img->getChannel< float >( "R" ) )
-		{
-			merge< float >( firstImage, pixelCount, img, outImg.get(), windowing, intensityMultiplier, outR.get(), outG.get(), outB.get(), outA.get() );
-		}
-		else
+		inputs.push_back( InputChannels( img ) );
+		if (
+			inputs.back().size != inputs.front().size ||
+			InputChannels::channelSize( img, "G" ) != inputs.front().size ||
+			InputChannels::channelSize( img, "B" ) != inputs.front().size
+		)
 		{
-			merge< half >( firstImage, pixelCount, img, outImg.get(), windowing, intensityMultiplier, outR.get(), outG.get(), outB.get(), outA.get() );
+			throw Exception( "Images are not of the same resolution!!" );
 		}
-		exposure -= exposureStep;
 	}
-	
-	// normalize the outputs
-	float adjustment = pow( 2.0f, -exposureAdjustment );
-	float *ptrOutR = &(outR->writable()[0]);
-	float *ptrOutG = &(outG->writable()[0]);
-	float *ptrOutB = &(outB->writable()[0]);
-	float *ptrOutA = &(outA->writable()[0]);
 
-	for ( size_t i = 0; i < pixelCount; i++ )
+	const ImagePrimitive *firstImage = static_cast<const ImagePrimitive *>( images.front().get() );
+	if( inputs.front().size != firstImage->variableSize( PrimitiveVariable::Vertex ) )
 	{
-		float w = adjustment * ptrOutA[i];
-		if ( w > 0 )
-		{
-			ptrOutR[i] /= w;
-			ptrOutG[i] /= w;
-			ptrOutB[i] /= w;
-		}
+		throw Exception( "Image channels do not match the size of the data window." );
 	}
+	ImagePrimitivePtr outImg = createOutput( firstImage->getDataWindow(), firstImage->getDisplayWindow() );
+
+	mergeRange( operands, inputs, outImg.get(), 0, inputs.front().size );
 
 	return outImg;
 }
@@ -203,6 +203,16 @@ void IFFFile::Chunk::read( std::string &data )
 	data = buffer;
 }
 
+std::istream &IFFFile::Chunk::dataStream()
+{
+	return *m_file->m_iStream;
+}
+
+std::streampos IFFFile::Chunk::dataPosition() const
+{
+	return m_filePosition;
+}
+
 int IFFFile::Chunk::alignmentQuota()
 {
 	if ( !isGroup() )
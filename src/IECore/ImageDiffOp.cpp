@@ -37,6 +37,9 @@
 
 #include "boost/format.hpp"
 
+#include "tbb/parallel_reduce.h"
+#include "tbb/blocked_range.h"
+
 #include "IECore/ImageDiffOp.h"
 
 #include "IECore/MessageHandler.h"
@@ -51,7 +54,6 @@
 #include "IECore/ImagePrimitive.h"
 #include "IECore/DataConvert.h"
 #include "IECore/ScaledDataConversion.h"
-#include "IECore/MeanSquaredError.h"
 #include "IECore/ImageCropOp.h"
 
 using namespace IECore;
@@ -183,6 +185,44 @@ struct ImageDiffOp::FloatConverter
 	};
 };
 
+/// Sums the squared differences between two channels, so that the error
+/// can be computed for blocks of pixels in parallel. The sum is accumulated
+/// in double precision, so it doesn't lose accuracy for large images.
+struct ImageDiffOp::SquaredErrorSum
+{
+
+	SquaredErrorSum( const float *a, const float *b )
+		:	m_a( a ), m_b( b ), m_sum( 0 )
+	{
+	}
+
+	SquaredErrorSum( SquaredErrorSum &that, tbb::split )
+		:	m_a( that.m_a ), m_b( that.m_b ), m_sum( 0 )
+	{
+	}
+
+	void operator()( const tbb::blocked_range<size_t> &range )
+	{
+		double sum = m_sum;
+		for( size_t i = range.begin(); i != range.end(); i++ )
+		{
+			const double d = m_a[i] - m_b[i];
+			sum += d * d;
+		}
+		m_sum = sum;
+	}
+
+	void join( const SquaredErrorSum &that )
+	{
+		m_sum += that.m_sum;
+	}
+
+	const float *m_a;
+	const float *m_b;
+	double m_sum;
+
+};
+
 ObjectPtr ImageDiffOp::doOperation( const CompoundObject * operands )
 {
 	ImagePrimitivePtr imageA = m_imageAParameter->getTypedValue< ImagePrimitive >();
@@ -331,7 +371,16 @@ ObjectPtr ImageDiffOp::doOperation( const CompoundObject * operands )
 		assert( bFloatData );
 		assert( aFloatData->readable().size() == bFloatData->readable().size() );
 
-		float rms = sqrt( MeanSquaredError<FloatVectorData>()( aFloatData, bFloatData ) );
+		const size_t numPixels = aFloatData->readable().size();
+		if ( !numPixels )
+		{
+			continue;
+		}
+
+		SquaredErrorSum sum( &aFloatData->readable()[0], &bFloatData->readable()[0] );
+		tbb::parallel_reduce( tbb::blocked_range<size_t>( 0, numPixels, 4096 ), sum );
+
+		float rms = sqrt( sum.m_sum / numPixels );
 		if ( rms > maxError )
 		{
 			return new BoolData( true );
@@ -32,7 +32,13 @@
 //
 //////////////////////////////////////////////////////////////////////////
 
+#include <sys/stat.h>
+
+#include "tbb/atomic.h"
+
 #include "IECore/ImageReader.h"
+#include "IECore/LRUCache.h"
+#include "IECore/MurmurHash.h"
 #include "IECore/VectorTypedData.h"
 #include "IECore/TypedParameter.h"
 #include "IECore/ImagePrimitive.h"
@@ -50,6 +56,141 @@ using namespace Imath;
 
 IE_CORE_DEFINERUNTIMETYPED( ImageReader );
 
+//////////////////////////////////////////////////////////////////////////
+// Block cache
+//////////////////////////////////////////////////////////////////////////
+
+// Blocks are identified by a hash of the file they were decoded from and the
+// parameters used to decode them, along with their index within the file. Blocks
+// are therefore shared between readers of the same file. The reader itself is
+// stored so that the cache can call decodeBlock(), but doesn't form part of the
+// identity of the block.
+struct ImageReader::BlockCacheKey
+{
+
+	BlockCacheKey()
+		:	blockIndex( 0 ), reader( 0 )
+	{
+	}
+
+	BlockCacheKey( const MurmurHash &s, unsigned int b, ImageReader *r )
+		:	source( s ), blockIndex( b ), reader( r )
+	{
+	}
+
+	bool operator == ( const BlockCacheKey &other ) const
+	{
+		return source == other.source && blockIndex == other.blockIndex;
+	}
+
+	friend size_t tbb_hasher( const BlockCacheKey &key )
+	{
+		MurmurHash h( key.source );
+		h.append( key.blockIndex );
+		return tbb_hasher( h );
+	}
+
+	MurmurHash source;
+	unsigned int blockIndex;
+	ImageReader *reader;
+
+};
+
+class ImageReader::BlockCache : public LRUCache<BlockCacheKey, ConstDataPtr>
+{
+
+	public :
+
+		BlockCache()
+			:	LRUCache<BlockCacheKey, ConstDataPtr>( getter, 128 * 1024 * 1024 )
+		{
+		}
+
+	private :
+
+		static ConstDataPtr getter( const BlockCacheKey &key, Cost &cost )
+		{
+			DataPtr result = key.reader->decodeBlock( key.blockIndex );
+			cost = result->Object::memoryUsage();
+			return result;
+		}
+
+};
+
+namespace
+{
+
+// Used to give a unique source to readers whose files can't be
+// stat'ed, so that their blocks are never shared.
+tbb::atomic<uint64_t> g_unsharedBlockSources;
+
+} // namespace
+
+ImageReader::BlockCache *ImageReader::blockCache()
+{
+	static BlockCache *c = new BlockCache();
+	return c;
+}
+
+void ImageReader::setBlockCacheMemoryLimit( size_t bytes )
+{
+	blockCache()->setMaxCost( bytes );
+}
+
+size_t ImageReader::getBlockCacheMemoryLimit()
+{
+	return blockCache()->getMaxCost();
+}
+
+void ImageReader::clearBlockCache()
+{
+	blockCache()->clear();
+}
+
+ConstDataPtr ImageReader::block( unsigned int blockIndex )
+{
+	return blockCache()->get( BlockCacheKey( m_blockSource, blockIndex, this ) );
+}
+
+DataPtr ImageReader::decodeBlock( unsigned int blockIndex )
+{
+	throw NotImplementedException( "ImageReader::decodeBlock" );
+}
+
+void ImageReader::blockSourceChanged( const MurmurHash &decodeParameters )
+{
+	MurmurHash h;
+	h.append( (int)typeId() );
+	h.append( fileName() );
+	h.append( decodeParameters );
+
+	// files may be replaced or rewritten in place, so the name alone
+	// isn't enough to identify the data within them.
+	struct stat s;
+	if( stat( fileName().c_str(), &s ) == 0 )
+	{
+		h.append( (uint64_t)s.st_dev );
+		h.append( (uint64_t)s.st_ino );
+		h.append( (int64_t)s.st_size );
+		h.append( (int64_t)s.st_mtime );
+#ifdef __APPLE__
+		h.append( (int64_t)s.st_mtimespec.tv_nsec );
+#else
+		h.append( (int64_t)s.st_mtim.tv_nsec );
+#endif
+	}
+	else
+	{
+		h.append( (uint64_t)++g_unsharedBlockSources );
+	}
+
+	m_blockSource = h;
+}
+
+//////////////////////////////////////////////////////////////////////////
+// ImageReader
+//////////////////////////////////////////////////////////////////////////
+
 ImageReader::ImageReader( const std::string &description ) :
 		Reader( description, new ObjectParameter( "result", "The loaded object", new NullObject, ImagePrimitive::staticTypeId() ) )
 {
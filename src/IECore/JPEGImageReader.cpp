@@ -63,7 +63,18 @@ using namespace std;
 
 IE_CORE_DEFINERUNTIMETYPED( JPEGImageReader );
 
-const Reader::ReaderDescription <JPEGImageReader> JPEGImageReader::m_readerDescription ("jpeg jpg");
+static bool canReadMagic( const char *data, size_t size )
+{
+	if( size < sizeof( unsigned int ) )
+	{
+		return false;
+	}
+	unsigned int magic;
+	memcpy( &magic, data, sizeof( unsigned int ) );
+	return magic == 0xe0ffd8ff || magic == 0xffd8ffe0 || magic == 0xe1ffd8ff || magic == 0xffd8ffe1 || magic == 0xdbffd8ff;
+}
+
+const Reader::ReaderDescription <JPEGImageReader> JPEGImageReader::m_readerDescription ( "jpeg jpg", canReadMagic, true );
 
 JPEGImageReader::JPEGImageReader() :
 		ImageReader( "Reads Joint Photographic Experts Group (JPEG) files" )
@@ -91,11 +102,11 @@ bool JPEGImageReader::canRead( const string &fileName )
 
 	// check the magic number of the input file
 	// a jpeg should have 0xffd8ffe0 from offset 0
-	unsigned int magic;
+	char magic[sizeof(unsigned int)];
 	in.seekg(0, ios_base::beg);
-	in.read((char *) &magic, sizeof(unsigned int));
+	in.read( magic, sizeof(unsigned int) );
 
-	return magic == 0xe0ffd8ff || magic == 0xffd8ffe0 || magic == 0xe1ffd8ff || magic == 0xffd8ffe1 || magic == 0xdbffd8ff;
+	return canReadMagic( magic, in.gcount() );
 }
 
 void JPEGImageReader::channelNames( vector<string> &names )
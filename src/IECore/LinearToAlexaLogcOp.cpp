@@ -64,13 +64,9 @@ struct LinearToAlexaLogcOp::Converter
 	{
 		typedef typename T::ValueType Container;
 		typedef typename Container::value_type V;
-		typedef typename Container::iterator It;
 		LinearToAlexaLogcDataConversion< V, V > converter;
-		It end = data->writable().end();
-		for ( It it = data->writable().begin(); it != end; it++ )
-		{
-			*it = converter( *it );
-		}
+		V *v = data->baseWritable();
+		converter( v, v, data->baseSize() );
 	}
 };
 
@@ -40,8 +40,8 @@
 #include "IECore/FileNameParameter.h"
 #include "IECore/CompoundParameter.h"
 #include "IECore/Timer.h"
+#include "IECore/ParticleReader.inl"
 
-#include "OpenEXR/ImathRandom.h"
 
 #include <boost/algorithm/string/predicate.hpp>
 
@@ -246,44 +246,6 @@ const IntVectorData * NParticleReader::frameTimes()
 	return m_frames.get();
 }
 
-template<typename T, typename F>
-typename T::Ptr NParticleReader::filterAttr( const F *attr, float percentage )
-{
-	if( percentage < 100.0f )
-	{
-		// percentage filtering (and type conversion if necessary)
-		typename T::Ptr result( new T );
-		const typename F::ValueType &in = attr->readable();
-		typename T::ValueType &out = result->writable();
-		int seed = particlePercentageSeed();
-		float fraction = percentage / 100.0f;
-		Rand48 r;
-		r.init( seed );
-		for( typename F::ValueType::size_type i=0; i<in.size(); i++ )
-		{
-			if( r.nextf() <= fraction )
-			{
-				out.push_back( in[i] );
-			}
-		}
-		return result;
-	}
-
-	if( T::staticTypeId()!=F::staticTypeId() )
-	{
-		// type conversion only
-		typename T::Ptr result( new T );
-		const typename F::ValueType &in = attr->readable();
-		typename T::ValueType &out = result->writable();
-		out.resize( in.size() );
-		copy( in.begin(), in.end(), out.begin() );
-		return result;
-	}
-
-	// no filtering of any sort needed
-	return typename T::Ptr( (T *)attr );
-}
-
 DataPtr NParticleReader::readAttribute( const std::string &name )
 {
 	if( !open() )
@@ -341,63 +303,48 @@ DataPtr NParticleReader::readAttribute( const std::string &name )
 	int numParticles = 0;
 	(attrIt+1)->read( numParticles );
 	
-	switch( (attrIt+2)->type().id() )
+	// nCaches have no ids, so the filtering is based on particle order. the
+	// data is read directly from the file, reading only the kept particles.
+	const std::vector<size_t> *indices = filteredIndices( numParticles, 0 );
+	IFFFile::Chunk &data = *(attrIt+2);
+	const bool swapBytes = littleEndian();
+
+	switch( data.type().id() )
 	{
 		case kDBLA :
+			switch( realType() )
 			{
-				DoubleVectorDataPtr d( new DoubleVectorData );
-				d->writable().resize( numParticles );
-				(attrIt+2)->read( d->writable() );
-				switch( realType() )
-				{
-					case Native :
-					case Double :
-						result = filterAttr<DoubleVectorData, DoubleVectorData>( d.get(), particlePercentage() );
-						break;
-					case Float :
-						result = filterAttr<FloatVectorData, DoubleVectorData>( d.get(), particlePercentage() );
-						break;
-				}
+				case Native :
+				case Double :
+					result = readFilteredAttr<DoubleVectorData, DoubleVectorData>( data.dataStream(), data.dataPosition(), numParticles, swapBytes, indices );
+					break;
+				case Float :
+					result = readFilteredAttr<FloatVectorData, DoubleVectorData>( data.dataStream(), data.dataPosition(), numParticles, swapBytes, indices );
+					break;
 			}
 			break;
 		case kDVCA :
+			switch( realType() )
 			{
-				V3dVectorDataPtr d( new V3dVectorData );
-				/// \todo: by all accounts the line below should be this :
-				/// d->writable().resize( numParticles() );
-				/// see PDCParticleReader for an explanation
-				d->writable().resize( numParticles, V3d( 0 ) );
-				(attrIt+2)->read( d->writable() );
-				switch( realType() )
-				{
-					case Native :
-					case Double :
-						result = filterAttr<V3dVectorData, V3dVectorData>( d.get(), particlePercentage() );
-						break;
-					case Float :
-						result = filterAttr<V3fVectorData, V3dVectorData>( d.get(), particlePercentage() );
-						break;
-				}
+				case Native :
+				case Double :
+					result = readFilteredAttr<V3dVectorData, V3dVectorData>( data.dataStream(), data.dataPosition(), numParticles, swapBytes, indices );
+					break;
+				case Float :
+					result = readFilteredAttr<V3fVectorData, V3dVectorData>( data.dataStream(), data.dataPosition(), numParticles, swapBytes, indices );
+					break;
 			}
 			break;
 		case kFVCA :
+			switch( realType() )
 			{
-				V3fVectorDataPtr d( new V3fVectorData );
-				/// \todo: by all accounts the line below should be this :
-				/// d->writable().resize( numParticles() );
-				/// see PDCParticleReader for an explanation
-				d->writable().resize( numParticles, V3f( 0 ) );
-				(attrIt+2)->read( d->writable() );
-				switch( realType() )
-				{
-					case Native :
-					case Double :
-						result = filterAttr<V3dVectorData, V3fVectorData>( d.get(), particlePercentage() );
-						break;
-					case Float :
-						result = filterAttr<V3fVectorData, V3fVectorData>( d.get(), particlePercentage() );
-						break;
-				}
+				case Native :
+				case Double :
+					result = readFilteredAttr<V3dVectorData, V3fVectorData>( data.dataStream(), data.dataPosition(), numParticles, swapBytes, indices );
+					break;
+				case Float :
+					result = readFilteredAttr<V3fVectorData, V3fVectorData>( data.dataStream(), data.dataPosition(), numParticles, swapBytes, indices );
+					break;
 			}
 			break;
 		default :
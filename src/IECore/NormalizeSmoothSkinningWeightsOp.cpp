@@ -35,6 +35,9 @@
 #include <algorithm>
 #include <cassert>
 
+#include "tbb/parallel_for.h"
+#include "tbb/blocked_range.h"
+
 #include "IECore/NormalizeSmoothSkinningWeightsOp.h"
 
 #include "IECore/CompoundObject.h"
@@ -74,6 +77,69 @@ NormalizeSmoothSkinningWeightsOp::~NormalizeSmoothSkinningWeightsOp()
 {
 }
 
+struct NormalizeSmoothSkinningWeightsOp::NormalizeWeights
+{
+	public :
+		
+		NormalizeWeights( const std::vector<int> &pointIndexOffsets, const std::vector<int> &pointInfluenceCounts, const std::vector<int> &pointInfluenceIndices, const std::vector<bool> &locks, std::vector<float> &pointInfluenceWeights )
+			:	m_pointIndexOffsets( pointIndexOffsets ), m_pointInfluenceCounts( pointInfluenceCounts ), m_pointInfluenceIndices( pointInfluenceIndices ), m_locks( locks ), m_pointInfluenceWeights( pointInfluenceWeights )
+		{
+		}
+		
+		void operator()( const tbb::blocked_range<size_t> &r ) const
+		{
+			for ( size_t i=r.begin(); i!=r.end(); ++i )
+			{
+				const int first = m_pointIndexOffsets[i];
+				const int last = first + m_pointInfluenceCounts[i];
+				
+				float totalLockedWeights = 0.0f;
+				float totalUnlockedWeights = 0.0f;
+				
+				for ( int current=first; current < last; current++ )
+				{
+					if ( m_locks[ m_pointInfluenceIndices[current] ] )
+					{
+						totalLockedWeights += m_pointInfluenceWeights[current];
+					}
+					else
+					{
+						totalUnlockedWeights += m_pointInfluenceWeights[current];
+					}
+				}
+				
+				float remainingWeight = 1.0f - totalLockedWeights;
+				bool zero = (remainingWeight == 0.0f) || (totalUnlockedWeights == 0.0f);
+				
+				for ( int current=first; current < last; current++ )
+				{
+					if ( m_locks[ m_pointInfluenceIndices[current] ] )
+					{
+						continue;
+					}
+					
+					if ( zero )
+					{
+						m_pointInfluenceWeights[current] = 0.0f;
+					}
+					else
+					{
+						m_pointInfluenceWeights[current] = (m_pointInfluenceWeights[current] * remainingWeight) / totalUnlockedWeights;
+					}
+				}
+			}
+		}
+	
+	private :
+		
+		const std::vector<int> &m_pointIndexOffsets;
+		const std::vector<int> &m_pointInfluenceCounts;
+		const std::vector<int> &m_pointInfluenceIndices;
+		const std::vector<bool> &m_locks;
+		std::vector<float> &m_pointInfluenceWeights;
+		
+};
+
 void NormalizeSmoothSkinningWeightsOp::modify( Object * object, const CompoundObject * operands )
 {
 	SmoothSkinningData *skinningData = static_cast<SmoothSkinningData *>( object );
@@ -87,7 +153,6 @@ void NormalizeSmoothSkinningWeightsOp::modify( Object * object, const CompoundOb
 	
 	bool useLocks = m_useLocksParameter->getTypedValue();
 	std::vector<bool> &locks = m_influenceLocksParameter->getTypedValue();
-	std::vector<int> unlockedIndices;
 		
 	// make sure there is one lock per influence
 	if ( useLocks && ( locks.size() != skinningData->influenceNames()->readable().size() ) )
@@ -101,42 +166,8 @@ void NormalizeSmoothSkinningWeightsOp::modify( Object * object, const CompoundOb
 		locks.resize( skinningData->influenceNames()->readable().size(), false );
 	}
 	
-	for ( unsigned i=0; i < pointIndexOffsets.size(); i++ )
-	{
-		unlockedIndices.clear();
-		float totalLockedWeights = 0.0f;
-		float totalUnlockedWeights = 0.0f;
-
-		for ( int j=0; j < pointInfluenceCounts[i]; j++ )
-		{
-			int current = pointIndexOffsets[i] + j;
-
-			if ( locks[ pointInfluenceIndices[current] ] )
-			{
-				totalLockedWeights += pointInfluenceWeights[current];
-			}
-			else
-			{
-				totalUnlockedWeights += pointInfluenceWeights[current];
-				unlockedIndices.push_back( current );
-			}
-		}
-
-		float remainingWeight = 1.0f - totalLockedWeights;
-
-		if ( (remainingWeight == 0.0f) || (totalUnlockedWeights == 0.0f) )
-		{
-			for ( unsigned j=0; j < unlockedIndices.size(); j++ )
-			{
-				pointInfluenceWeights[ unlockedIndices[j] ] = 0.0f;
-			}
-		}
-		else
-		{
-			for ( unsigned j=0; j < unlockedIndices.size(); j++ )
-			{
-				pointInfluenceWeights[ unlockedIndices[j] ] = (pointInfluenceWeights[ unlockedIndices[j] ] * remainingWeight) / totalUnlockedWeights;
-			}
-		}
-	}
+	tbb::parallel_for(
+		tbb::blocked_range<size_t>( 0, pointIndexOffsets.size() ),
+		NormalizeWeights( pointIndexOffsets, pointInfluenceCounts, pointInfluenceIndices, locks, pointInfluenceWeights )
+	);
 }
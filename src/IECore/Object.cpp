@@ -34,9 +34,17 @@
 
 #include "IECore/Object.h"
 #include "IECore/MurmurHash.h"
+#include "IECore/PackedIndexedIO.h"
 
 #include "boost/format.hpp"
 #include "boost/tokenizer.hpp"
+#include "boost/unordered_map.hpp"
+
+#include "tbb/atomic.h"
+#include "tbb/mutex.h"
+#include "tbb/spin_mutex.h"
+#include "tbb/parallel_for.h"
+#include "tbb/blocked_range.h"
 
 #include <iostream>
 
@@ -51,6 +59,13 @@ const Object::AbstractTypeDescription<Object> Object::m_typeDescription;
 static IndexedIO::EntryID g_ioVersionEntry("ioVersion");
 static IndexedIO::EntryID g_dataEntry("data");
 static IndexedIO::EntryID g_typeEntry("type");
+// loading in parallel only pays off if there is enough to load, so we
+// estimate the number of bytes in each batch, and only go parallel
+// if it exceeds this.
+static const size_t g_minParallelLoadSize = 64 * 1024;
+// a nominal size for each directory, to account for the cost of creating
+// objects, so that many small objects are still loaded in parallel.
+static const size_t g_directoryLoadSize = 256;
 const unsigned int Object::m_ioVersion = 0;
 
 //////////////////////////////////////////////////////////////////////////////////////////
@@ -74,8 +89,8 @@ Object::~Object()
 struct Object::TypeInformation
 {
 	typedef std::pair< CreatorFn, void *> CreatorAndData;
-	typedef std::map< TypeId, CreatorAndData > TypeIdsToCreatorsMap;
-	typedef std::map< std::string, CreatorAndData > TypeNamesToCreatorsMap;
+	typedef boost::unordered_map< TypeId, CreatorAndData > TypeIdsToCreatorsMap;
+	typedef boost::unordered_map< std::string, CreatorAndData > TypeNamesToCreatorsMap;
 
 	TypeIdsToCreatorsMap typeIdsToCreators;
 	TypeNamesToCreatorsMap typeNamesToCreators;
@@ -169,12 +184,78 @@ void Object::SaveContext::save( const Object *toSave, IndexedIO *container, cons
 // load context stuff
 //////////////////////////////////////////////////////////////////////////////////////////
 
+// The objects loaded so far, shared between all the contexts used in loading
+// a single object. Each instance is locked while it is being loaded, so that
+// a thread asking for an instance which another thread is still loading waits
+// for it rather than loading a second copy.
+struct Object::LoadContext::LoadedObjects
+{
+
+	typedef boost::shared_ptr<tbb::atomic<bool> > FlagPtr;
+
+	LoadedObjects()
+		:	parallelLoad( new tbb::atomic<bool> )
+	{
+		*parallelLoad = false;
+	}
+
+	LoadedObjects( FlagPtr parallelLoad )
+		:	parallelLoad( parallelLoad )
+	{
+	}
+
+	struct Instance
+	{
+		tbb::mutex mutex;
+		ObjectPtr object;
+	};
+
+	typedef boost::shared_ptr<Instance> InstancePtr;
+	typedef std::map<IndexedIO::EntryIDList, InstancePtr> InstanceMap;
+
+	tbb::spin_mutex mutex;
+	InstanceMap instances;
+	// Set while a parallel load is in progress. Only one is allowed at a time, so
+	// that the only threads which can wait on tasks while holding an instance lock
+	// are those loading the ancestors of the objects loaded by the tasks.
+	FlagPtr parallelLoad;
+
+};
+
+// Body for the parallel_for in loadObjectsOrReferences().
+class Object::LoadContext::ObjectLoader
+{
+
+	public :
+
+		ObjectLoader( LoadContext *context, const std::vector<ConstIndexedIOPtr> &containers, const IndexedIO::EntryIDList &names, std::vector<ObjectPtr> &results )
+			:	m_context( context ), m_containers( containers ), m_names( names ), m_results( results )
+		{
+		}
+
+		void operator()( const tbb::blocked_range<size_t> &r ) const
+		{
+			for( size_t i=r.begin(); i!=r.end(); ++i )
+			{
+				m_results[i] = m_context->loadObjectOrReference( m_containers[i].get(), m_names[i] );
+			}
+		}
+
+	private :
+
+		LoadContext *m_context;
+		const std::vector<ConstIndexedIOPtr> &m_containers;
+		const IndexedIO::EntryIDList &m_names;
+		std::vector<ObjectPtr> &m_results;
+
+};
+
 Object::LoadContext::LoadContext( ConstIndexedIOPtr ioInterface )
-	:	m_ioInterface( ioInterface ), m_loadedObjects( new LoadedObjectMap )
+	:	m_ioInterface( ioInterface ), m_loadedObjects( new LoadedObjects )
 {
 }
 
-Object::LoadContext::LoadContext( ConstIndexedIOPtr ioInterface, boost::shared_ptr<LoadedObjectMap> loadedObjects )
+Object::LoadContext::LoadContext( ConstIndexedIOPtr ioInterface, boost::shared_ptr<LoadedObjects> loadedObjects )
 	:	m_ioInterface( ioInterface ), m_loadedObjects( loadedObjects )
 {
 }
@@ -204,7 +285,17 @@ const IndexedIO *Object::LoadContext::rawContainer()
 ObjectPtr Object::LoadContext::loadObjectOrReference( const IndexedIO *container, const IndexedIO::EntryID &name )
 {
 	IndexedIO::Entry e = container->entry( name );
-	if( e.entryType()==IndexedIO::File )
+	if( e.entryType()==IndexedIO::File && e.dataType()==IndexedIO::CharArray )
+	{
+		// a packed object, saved under the same name in its own block. it's
+		// self contained, so gets a context of its own for resolving references.
+		ConstIndexedIOPtr packedIO = PackedIndexedIO::unpack( container, name );
+		// it still shares our parallel load flag though.
+		boost::shared_ptr<LoadedObjects> loadedObjects( new LoadedObjects( m_loadedObjects->parallelLoad ) );
+		LoadContextPtr context = new LoadContext( packedIO, loadedObjects );
+		return context->loadObjectOrReference( packedIO.get(), name );
+	}
+	else if( e.entryType()==IndexedIO::File )
 	{
 		IndexedIO::EntryIDList pathParts;
 		if ( e.dataType() == IndexedIO::InternedStringArray )
@@ -228,15 +319,7 @@ ObjectPtr Object::LoadContext::loadObjectOrReference( const IndexedIO *container
 				pathParts.push_back( *t );
 			}
 		}
-		std::pair< LoadedObjectMap::iterator,bool > ret = m_loadedObjects->insert( std::pair<IndexedIO::EntryIDList, ObjectPtr>( pathParts, NULL ) );
-		if ( ret.second )
-		{
-			// jump to the path..
-			ConstIndexedIOPtr ioObject = m_ioInterface->directory( pathParts );
-			// add the loaded object to the map.
-			ret.first->second = loadObject( ioObject.get() );
-		}
-		return ret.first->second;
+		return loadInstance( pathParts, 0 );
 	}
 	else
 	{
@@ -245,14 +328,162 @@ ObjectPtr Object::LoadContext::loadObjectOrReference( const IndexedIO *container
 		IndexedIO::EntryIDList pathParts;
 		ioObject->path( pathParts );
 
-		std::pair< LoadedObjectMap::iterator,bool > ret = m_loadedObjects->insert( std::pair<IndexedIO::EntryIDList, ObjectPtr>( pathParts, NULL ) );
-		if ( ret.second )
+		return loadInstance( pathParts, ioObject );
+	}
+}
+
+static size_t dataTypeSize( IndexedIO::DataType dataType )
+{
+	switch( dataType )
+	{
+		case IndexedIO::Char :
+		case IndexedIO::CharArray :
+		case IndexedIO::UChar :
+		case IndexedIO::UCharArray :
+			return 1;
+		case IndexedIO::Half :
+		case IndexedIO::HalfArray :
+		case IndexedIO::Short :
+		case IndexedIO::ShortArray :
+		case IndexedIO::UShort :
+		case IndexedIO::UShortArray :
+			return 2;
+		case IndexedIO::Double :
+		case IndexedIO::DoubleArray :
+		case IndexedIO::Long :
+		case IndexedIO::LongArray :
+		case IndexedIO::Int64 :
+		case IndexedIO::Int64Array :
+		case IndexedIO::UInt64 :
+		case IndexedIO::UInt64Array :
+			return 8;
+		case IndexedIO::String :
+		case IndexedIO::StringArray :
+		case IndexedIO::InternedStringArray :
+			// we don't know the lengths of the strings, so guess
+			return 16;
+		default :
+			return 4;
+	}
+}
+
+// returns an estimate of the number of bytes to be loaded from the named
+// entry, giving up once the estimate reaches limit, so the cost is bounded
+// however large the entry is.
+static size_t estimateLoadSize( const IndexedIO *container, const IndexedIO::EntryID &name, size_t limit )
+{
+	const IndexedIO::Entry entry = container->entry( name );
+	if( entry.entryType() == IndexedIO::File )
+	{
+		const size_t size = dataTypeSize( entry.dataType() );
+		return IndexedIO::Entry::isArray( entry.dataType() ) ? size * entry.arrayLength() : size;
+	}
+
+	ConstIndexedIOPtr directory = container->subdirectory( name );
+	IndexedIO::EntryIDList childNames;
+	directory->entryIds( childNames );
+
+	size_t result = g_directoryLoadSize;
+	for( IndexedIO::EntryIDList::const_iterator it = childNames.begin(); it != childNames.end() && result < limit; ++it )
+	{
+		result += estimateLoadSize( directory.get(), *it, limit - result );
+	}
+	return result;
+}
+
+static bool worthLoadingInParallel( const std::vector<ConstIndexedIOPtr> &containers, const IndexedIO::EntryIDList &names )
+{
+	if( names.size() < 2 )
+	{
+		return false;
+	}
+
+	size_t size = 0;
+	for( size_t i = 0; i < names.size(); ++i )
+	{
+		size += estimateLoadSize( containers[i].get(), names[i], g_minParallelLoadSize - size );
+		if( size >= g_minParallelLoadSize )
 		{
-			// add the loaded object to the map.
-			ret.first->second = loadObject( ioObject.get() );
+			return true;
 		}
-		return ret.first->second;
 	}
+	return false;
+}
+
+void Object::LoadContext::loadObjectsOrReferences( const std::vector<ConstIndexedIOPtr> &containers, const IndexedIO::EntryIDList &names, std::vector<ObjectPtr> &results )
+{
+	assert( containers.size() == names.size() );
+	results.resize( names.size() );
+
+	ObjectLoader loader( this, containers, names, results );
+	tbb::blocked_range<size_t> range( 0, names.size() );
+
+	// we check the flag before estimating the size, as the estimate is wasted
+	// effort if we're already being called from within a parallel load.
+	if(
+		!*m_loadedObjects->parallelLoad &&
+		worthLoadingInParallel( containers, names ) &&
+		m_loadedObjects->parallelLoad->compare_and_swap( true, false ) == false
+	)
+	{
+		try
+		{
+			tbb::parallel_for( range, loader );
+		}
+		catch( ... )
+		{
+			*m_loadedObjects->parallelLoad = false;
+			throw;
+		}
+		*m_loadedObjects->parallelLoad = false;
+	}
+	else
+	{
+		// either there's too little to be worth it, or we're being called
+		// from within a parallel load already.
+		loader( range );
+	}
+}
+
+// returns the object at path, loading it from ioObject if it hasn't been loaded
+// already. if ioObject is null then the object is found relative to the root of
+// m_ioInterface.
+ObjectPtr Object::LoadContext::loadInstance( const IndexedIO::EntryIDList &path, ConstIndexedIOPtr ioObject )
+{
+	LoadedObjects::InstancePtr instance;
+	tbb::mutex::scoped_lock loadLock;
+	bool load = false;
+	{
+		tbb::spin_mutex::scoped_lock lock( m_loadedObjects->mutex );
+		LoadedObjects::InstancePtr &i = m_loadedObjects->instances[path];
+		if( !i )
+		{
+			// we're first - lock the instance before anyone else can see it.
+			i.reset( new LoadedObjects::Instance );
+			loadLock.acquire( i->mutex );
+			load = true;
+		}
+		instance = i;
+	}
+
+	if( load )
+	{
+		if( !ioObject )
+		{
+			// jump to the path..
+			ioObject = m_ioInterface->directory( path );
+		}
+		instance->object = loadObject( ioObject.get() );
+		return instance->object;
+	}
+
+	// wait for whoever is loading it to finish
+	tbb::mutex::scoped_lock lock( instance->mutex );
+	if( !instance->object )
+	{
+		throw IOException( "Failed to load referenced object." );
+	}
+	return instance->object;
 }
 
 // this function can only load concrete objects. it can't load references to
@@ -333,6 +564,25 @@ void Object::save( IndexedIOPtr ioInterface, const IndexedIO::EntryID &name ) co
 	context->save( this, ioInterface.get(), name );
 }
 
+void Object::save( IndexedIOPtr ioInterface, const IndexedIO::EntryID &name, bool packed ) const
+{
+	if( !packed )
+	{
+		save( ioInterface, name );
+		return;
+	}
+
+	PackedIndexedIOPtr packedIO = new PackedIndexedIO( 0, IndexedIO::rootPath, IndexedIO::Exclusive | IndexedIO::Write );
+	save( packedIO, name );
+	ConstCharVectorDataPtr block = packedIO->buffer();
+
+	if( ioInterface->hasEntry( name ) )
+	{
+		ioInterface->remove( name );
+	}
+	ioInterface->write( name, &(block->readable()[0]), block->readable().size() );
+}
+
 void Object::copyFrom( const Object *toCopy )
 {
 	if ( !toCopy->isInstanceOf( typeId() ) )
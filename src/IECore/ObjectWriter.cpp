@@ -102,7 +102,7 @@ void ObjectWriter::doWrite( const CompoundObject *operands )
 	((ObjectPtr)header)->save( io, "header" );
 
 	// write the object
-	object()->save( io, "object" );
+	object()->save( io, "object", m_packedParameter->getTypedValue() );
 }
 
 void ObjectWriter::constructParameters()
@@ -115,4 +115,14 @@ void ObjectWriter::constructParameters()
 	);
 
 	parameters()->addParameter( m_headerParameter );
+
+	m_packedParameter = new BoolParameter(
+		"packed",
+		"Stores the object as a single contiguous block rather than as a hierarchy of entries. "
+		"This makes loading objects with many small members considerably quicker. Packed files "
+		"can only be read by versions of the library which support them.",
+		false
+	);
+
+	parameters()->addParameter( m_packedParameter );
 }
@@ -55,7 +55,12 @@ using namespace std;
 
 IE_CORE_DEFINERUNTIMETYPED( PDCParticleReader );
 
-const Reader::ReaderDescription<PDCParticleReader> PDCParticleReader::m_readerDescription( "pdc" );
+static bool canReadMagic( const char *data, size_t size )
+{
+	return size >= 4 && !strncmp( "PDC ", data, 4 );
+}
+
+const Reader::ReaderDescription<PDCParticleReader> PDCParticleReader::m_readerDescription( "pdc", canReadMagic, true );
 
 PDCParticleReader::PDCParticleReader( )
 	:	ParticleReader( "Reads Maya .pdc format particle caches" ), m_iStream( 0 ), m_idAttribute( 0 )
@@ -82,11 +87,7 @@ bool PDCParticleReader::canRead( const std::string &fileName )
 	}
 	char id[4];
 	i.read( id, 4 );
-	if( strncmp( "PDC ", id, 4 ) )
-	{
-		return false;
-	}
-	return true;
+	return canReadMagic( id, i.gcount() );
 }
 
 bool PDCParticleReader::open()
@@ -265,6 +266,10 @@ DataPtr PDCParticleReader::readAttribute( const std::string &name )
 		msg( Msg::Warning, "PDCParticleReader::filterAttr", format( "Percentage filtering requested but file \"%s\" contains no particle Id attribute." ) % fileName() );
 	}
 
+	// the kept particles are selected once, and only those are read
+	// from each attribute.
+	const std::vector<size_t> *indices = filteredIndices( numParticles(), idAttr );
+
 	DataPtr result = 0;
 	switch( it->second.type )
 	{
@@ -276,12 +281,7 @@ DataPtr PDCParticleReader::readAttribute( const std::string &name )
 			}
 			break;
 		case IntegerArray :
-			{
-				IntVectorDataPtr d( new IntVectorData );
-				d->writable().resize( numParticles() );
-				readElements( &d->writable()[0], it->second.position, numParticles() );
-				result = filterAttr<IntVectorData, IntVectorData>( d.get(), particlePercentage(), idAttr );
-			}
+			result = readFilteredAttr<IntVectorData, IntVectorData>( *m_iStream, it->second.position, numParticles(), m_header.reverseBytes, indices );
 			break;
 		case Double :
 			{
@@ -300,20 +300,15 @@ DataPtr PDCParticleReader::readAttribute( const std::string &name )
 			}
 			break;
 		case DoubleArray :
+			switch( realType() )
 			{
-				DoubleVectorDataPtr d( new DoubleVectorData );
-				d->writable().resize( numParticles() );
-				readElements( &d->writable()[0], it->second.position, numParticles() );
-				switch( realType() )
-				{
-					case Native :
-					case Double :
-						result = filterAttr<DoubleVectorData, DoubleVectorData>( d.get(), particlePercentage(), idAttr );
-						break;
-					case Float :
-						result = filterAttr<FloatVectorData, DoubleVectorData>( d.get(), particlePercentage(), idAttr );
-						break;
-				}
+				case Native :
+				case Double :
+					result = readFilteredAttr<DoubleVectorData, DoubleVectorData>( *m_iStream, it->second.position, numParticles(), m_header.reverseBytes, indices );
+					break;
+				case Float :
+					result = readFilteredAttr<FloatVectorData, DoubleVectorData>( *m_iStream, it->second.position, numParticles(), m_header.reverseBytes, indices );
+					break;
 			}
 			break;
 		case Vector :
@@ -333,34 +328,15 @@ DataPtr PDCParticleReader::readAttribute( const std::string &name )
 			}
 			break;
 		case VectorArray :
+			switch( realType() )
 			{
-				V3dVectorDataPtr d( new V3dVectorData );
-				/// \todo
-				/// by all accounts the line below should be this :
-				///
-				/// d->writable().resize( numParticles() );
-				///
-				/// ie it shouldn't initialize the memory. but for some reason
-				/// that runs far far slower for us (at least an order of magnitude
-				/// slower) when we're in maya or python. we don't know why but it seems
-				/// to be related to libstdc++ (maya has it's own). so we're opting for
-				/// the initialized version - this seems slightly (~10%) slower when the planets
-				/// are aligned correctly, but so much faster when the planets are aligned against
-				/// us, as they seem to be whenever we're coding in maya. testing seems to show that
-				/// this resize problem only occurs with V3d, and not with V3f, or double, or even
-				/// a struct with 3 doubles in, or even a template struct with 3 doubles in.
-				d->writable().resize( numParticles(), V3d( 0 ) );
-				readElements( (double *)&d->writable()[0], it->second.position, numParticles() * 3 );
-				switch( realType() )
-				{
-					case Native :
-					case Double :
-						result = filterAttr<V3dVectorData, V3dVectorData>( d.get(), particlePercentage(), idAttr );
-						break;
-					case Float :
-						result = filterAttr<V3fVectorData, V3dVectorData>( d.get(), particlePercentage(), idAttr );
-						break;
-				}
+				case Native :
+				case Double :
+					result = readFilteredAttr<V3dVectorData, V3dVectorData>( *m_iStream, it->second.position, numParticles(), m_header.reverseBytes, indices );
+					break;
+				case Float :
+					result = readFilteredAttr<V3fVectorData, V3dVectorData>( *m_iStream, it->second.position, numParticles(), m_header.reverseBytes, indices );
+					break;
 			}
 			break;
 		default :
@@ -107,7 +107,17 @@ struct PNGImageData
 
 IE_CORE_DEFINERUNTIMETYPED( PNGImageReader );
 
-const Reader::ReaderDescription <PNGImageReader> PNGImageReader::m_readerDescription ("png");
+static bool canReadMagic( const char *data, size_t size )
+{
+	// 8 is the maximum size that can be checked
+	if( size < 8 )
+	{
+		return false;
+	}
+	return !png_sig_cmp( (png_bytep)data, 0, 8 );
+}
+
+const Reader::ReaderDescription <PNGImageReader> PNGImageReader::m_readerDescription ( "png", canReadMagic, true );
 
 PNGImageReader::PNGImageReader() :
 		ImageReader( "Reads Portable Network Graphics (PNG) files" )
@@ -152,19 +162,13 @@ bool PNGImageReader::canRead( const string &fileName )
 		return false;
 	}
 
-	png_byte header[8];    // 8 is the maximum size that can be checked
+	char header[8];    // 8 is the maximum size that can be checked
 	
 	// read in the header
 	in.seekg(0, ios_base::beg);
-	in.read((char*)header, 8);
+	in.read( header, 8 );
 
-	// check the header
-	if (png_sig_cmp(header, 0, 8))
-	{
-		return false;
-	}
-
-	return true;
+	return canReadMagic( header, in.gcount() );
 }
 
 void PNGImageReader::channelNames(  vector<string> &names )
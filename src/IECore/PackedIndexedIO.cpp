@@ -0,0 +1,978 @@
+//////////////////////////////////////////////////////////////////////////
+//
+//  Copyright (c) 2013, Image Engine Design Inc. All rights reserved.
+//
+//  Redistribution and use in source and binary forms, with or without
+//  modification, are permitted provided that the following conditions are
+//  met:
+//
+//     * Redistributions of source code must retain the above copyright
+//       notice, this list of conditions and the following disclaimer.
+//
+//     * Redistributions in binary form must reproduce the above copyright
+//       notice, this list of conditions and the following disclaimer in the
+//       documentation and/or other materials provided with the distribution.
+//
+//     * Neither the name of Image Engine Design nor the names of any
+//       other contributors to this software may be used to endorse or
+//       promote products derived from this software without specific prior
+//       written permission.
+//
+//  THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS
+//  IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO,
+//  THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR
+//  PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER OR
+//  CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+//  EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+//  PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR
+//  PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF
+//  LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING
+//  NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+//  SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+//
+//////////////////////////////////////////////////////////////////////////
+
+
+#include <cstring>
+#include <algorithm>
+
+#include "boost/unordered_map.hpp"
+
+#include "IECore/PackedIndexedIO.h"
+#include "IECore/ByteOrder.h"
+#include "IECore/Exception.h"
+
+using namespace IECore;
+
+IE_CORE_DEFINERUNTIMETYPEDDESCRIPTION( PackedIndexedIO )
+
+//////////////////////////////////////////////////////////////////////////
+// Block layout. All integers are little endian.
+//
+// header  : uint32 magic, uint32 version, uint64 node count, uint64 string table size
+// nodes   : uint32 parent, uint32 name offset, uint8 entry type, uint8 data type,
+//           6 bytes padding, uint64 array length, uint64 data offset, uint64 data size
+// strings : null terminated entry names, padded to a multiple of 8 bytes
+// data    : file contents, each starting on an 8 byte boundary
+//
+// Nodes are stored with parents before their children, and the first
+// node is always the root.
+//////////////////////////////////////////////////////////////////////////
+
+namespace
+{
+
+const uint32_t g_magic = 0x4b504549; // "IEPK"
+const uint32_t g_version = 1;
+const uint32_t g_noParent = 0xffffffff;
+const size_t g_headerSize = 24;
+const size_t g_nodeSize = 40;
+const size_t g_alignment = 8;
+
+inline size_t align( size_t size )
+{
+	return ( size + g_alignment - 1 ) & ~( g_alignment - 1 );
+}
+
+inline void writeUInt( char *&p, uint64_t v, int bytes )
+{
+	for( int i = 0; i < bytes; i++ )
+	{
+		*p++ = (char)( v >> ( 8 * i ) );
+	}
+}
+
+inline uint64_t readUInt( const char *&p, int bytes )
+{
+	uint64_t v = 0;
+	for( int i = 0; i < bytes; i++ )
+	{
+		v |= uint64_t( (unsigned char)*p++ ) << ( 8 * i );
+	}
+	return v;
+}
+
+} // namespace
+
+//////////////////////////////////////////////////////////////////////////
+// PackedIndexedIO::Block
+//////////////////////////////////////////////////////////////////////////
+
+/// Holds the hierarchy shared by all the PackedIndexedIO instances opened
+/// on the same block. Entries decoded from a source block refer to their data
+/// in place, while entries written afterwards store theirs in m_written.
+class PackedIndexedIO::Block : public RefCounted
+{
+	public :
+
+		struct Node
+		{
+			IndexedIO::EntryID name;
+			size_t parent;
+			IndexedIO::EntryType entryType;
+			IndexedIO::DataType dataType;
+			unsigned long arrayLength;
+			bool written;
+			size_t dataOffset;
+			size_t dataSize;
+			std::vector<size_t> children;
+		};
+
+		Block( IndexedIO::OpenMode mode, ConstCharVectorDataPtr source )
+			:	m_mode( mode ), m_source( source ), m_sourceData( 0 )
+		{
+			if( m_source && m_source->readable().size() )
+			{
+				decode();
+			}
+			else if( mode & IndexedIO::Read )
+			{
+				throw IOException( "PackedIndexedIO: No block to read from." );
+			}
+			else
+			{
+				addNode( g_noParent, IndexedIO::rootName, IndexedIO::Directory, IndexedIO::Invalid, 0 );
+			}
+		}
+
+		IndexedIO::OpenMode openMode() const
+		{
+			return m_mode;
+		}
+
+		const Node &node( size_t index ) const
+		{
+			return m_nodes[index];
+		}
+
+		long child( size_t parent, const IndexedIO::EntryID &name ) const
+		{
+			ChildMap::const_iterator it = m_childMap.find( ChildKey( parent, &name.value() ) );
+			return it != m_childMap.end() ? (long)it->second : -1;
+		}
+
+		size_t addDirectory( size_t parent, const IndexedIO::EntryID &name )
+		{
+			return addNode( parent, name, IndexedIO::Directory, IndexedIO::Invalid, 0 );
+		}
+
+		/// Adds a file, replacing any existing file of the same name, and
+		/// returns the storage into which its size bytes should be written.
+		char *addFile( size_t parent, const IndexedIO::EntryID &name, IndexedIO::DataType dataType, unsigned long arrayLength, size_t size )
+		{
+			long existing = child( parent, name );
+			if( existing >= 0 )
+			{
+				if( m_nodes[existing].entryType == IndexedIO::Directory )
+				{
+					throw IOException( "PackedIndexedIO: Cannot overwrite directory '" + name.value() + "' with a file." );
+				}
+				removeChild( parent, existing );
+			}
+
+			size_t index = addNode( parent, name, IndexedIO::File, dataType, arrayLength );
+			Node &n = m_nodes[index];
+			n.written = true;
+			n.dataOffset = align( m_written.size() );
+			n.dataSize = size;
+			m_written.resize( n.dataOffset + size );
+			return size ? &m_written[n.dataOffset] : 0;
+		}
+
+		void removeChild( size_t parent, size_t index )
+		{
+			// the removed node and its descendants are left orphaned in m_nodes,
+			// and are skipped when packing.
+			m_childMap.erase( ChildKey( parent, &m_nodes[index].name.value() ) );
+			std::vector<size_t> &children = m_nodes[parent].children;
+			children.erase( std::find( children.begin(), children.end(), index ) );
+			m_nodes[index].parent = g_noParent;
+		}
+
+		/// Returns the data for the named file, throwing if it doesn't exist.
+		const char *fileData( size_t parent, const IndexedIO::EntryID &name, size_t &size ) const
+		{
+			long index = child( parent, name );
+			if( index < 0 || m_nodes[index].entryType != IndexedIO::File )
+			{
+				throw IOException( "PackedIndexedIO::read: Data entry not found '" + name.value() + "'" );
+			}
+			const Node &n = m_nodes[index];
+			size = n.dataSize;
+			return data( n );
+		}
+
+		CharVectorDataPtr pack() const
+		{
+			// parents are visited before their children, and orphaned
+			// nodes are never visited.
+			std::vector<size_t> order;
+			std::vector<uint32_t> packedIndex( m_nodes.size(), g_noParent );
+			order.push_back( 0 );
+			packedIndex[0] = 0;
+			for( size_t i = 0; i < order.size(); i++ )
+			{
+				const std::vector<size_t> &children = m_nodes[order[i]].children;
+				for( std::vector<size_t>::const_iterator it = children.begin(); it != children.end(); it++ )
+				{
+					packedIndex[*it] = order.size();
+					order.push_back( *it );
+				}
+			}
+
+			typedef boost::unordered_map<const std::string *, size_t> StringOffsets;
+			StringOffsets stringOffsets;
+			std::vector<size_t> nameOffsets( order.size() );
+			std::vector<size_t> dataOffsets( order.size(), 0 );
+			size_t stringsSize = 0;
+			size_t dataSize = 0;
+			for( size_t i = 0; i < order.size(); i++ )
+			{
+				const Node &n = m_nodes[order[i]];
+				std::pair<StringOffsets::iterator, bool> s = stringOffsets.insert( StringOffsets::value_type( &n.name.value(), stringsSize ) );
+				if( s.second )
+				{
+					stringsSize += n.name.value().size() + 1;
+				}
+				nameOffsets[i] = s.first->second;
+				if( n.entryType == IndexedIO::File )
+				{
+					dataOffsets[i] = align( dataSize );
+					dataSize = dataOffsets[i] + n.dataSize;
+				}
+			}
+			stringsSize = align( stringsSize );
+
+			CharVectorDataPtr result = new CharVectorData;
+			std::vector<char> &buffer = result->writable();
+			buffer.resize( g_headerSize + order.size() * g_nodeSize + stringsSize + dataSize, 0 );
+
+			char *p = &buffer[0];
+			writeUInt( p, g_magic, 4 );
+			writeUInt( p, g_version, 4 );
+			writeUInt( p, order.size(), 8 );
+			writeUInt( p, stringsSize, 8 );
+
+			char *strings = p + order.size() * g_nodeSize;
+			char *data = strings + stringsSize;
+			for( size_t i = 0; i < order.size(); i++ )
+			{
+				const Node &n = m_nodes[order[i]];
+				writeUInt( p, i ? packedIndex[n.parent] : g_noParent, 4 );
+				writeUInt( p, nameOffsets[i], 4 );
+				writeUInt( p, n.entryType, 1 );
+				writeUInt( p, n.dataType, 1 );
+				p += 6;
+				writeUInt( p, n.arrayLength, 8 );
+				writeUInt( p, dataOffsets[i], 8 );
+				writeUInt( p, n.dataSize, 8 );
+
+				memcpy( strings + nameOffsets[i], n.name.c_str(), n.name.value().size() + 1 );
+				if( n.dataSize )
+				{
+					memcpy( data + dataOffsets[i], this->data( n ), n.dataSize );
+				}
+			}
+
+			return result;
+		}
+
+	private :
+
+		size_t addNode( size_t parent, const IndexedIO::EntryID &name, IndexedIO::EntryType entryType, IndexedIO::DataType dataType, unsigned long arrayLength )
+		{
+			size_t index = m_nodes.size();
+			m_nodes.push_back( Node() );
+			Node &n = m_nodes.back();
+			n.name = name;
+			n.parent = parent;
+			n.entryType = entryType;
+			n.dataType = dataType;
+			n.arrayLength = arrayLength;
+			n.written = false;
+			n.dataOffset = 0;
+			n.dataSize = 0;
+			if( parent != g_noParent )
+			{
+				m_nodes[parent].children.push_back( index );
+				m_childMap[ChildKey( parent, &n.name.value() )] = index;
+			}
+			return index;
+		}
+
+		const char *data( const Node &n ) const
+		{
+			if( !n.dataSize )
+			{
+				return 0;
+			}
+			return n.written ? &m_written[n.dataOffset] : m_sourceData + n.dataOffset;
+		}
+
+		void decode()
+		{
+			const std::vector<char> &buffer = m_source->readable();
+			const char *begin = &buffer[0];
+			const char *p = begin;
+
+			if( buffer.size() < g_headerSize || readUInt( p, 4 ) != g_magic )
+			{
+				throw IOException( "PackedIndexedIO: Not a packed block." );
+			}
+			if( readUInt( p, 4 ) > g_version )
+			{
+				throw IOException( "PackedIndexedIO: Block version greater than library version." );
+			}
+			const uint64_t numNodes = readUInt( p, 8 );
+			const uint64_t stringsSize = readUInt( p, 8 );
+			const size_t available = buffer.size() - g_headerSize;
+			if( !numNodes || numNodes > available / g_nodeSize || stringsSize > available - numNodes * g_nodeSize )
+			{
+				throw IOException( "PackedIndexedIO: Corrupt block header." );
+			}
+
+			const char *strings = p + numNodes * g_nodeSize;
+			m_sourceData = strings + stringsSize;
+			const size_t dataSize = buffer.size() - ( m_sourceData - begin );
+
+			m_nodes.reserve( numNodes );
+			for( size_t i = 0; i < numNodes; i++ )
+			{
+				const uint64_t parent = readUInt( p, 4 );
+				const uint64_t nameOffset = readUInt( p, 4 );
+				const uint64_t entryType = readUInt( p, 1 );
+				const uint64_t dataType = readUInt( p, 1 );
+				p += 6;
+				const uint64_t arrayLength = readUInt( p, 8 );
+				const uint64_t dataOffset = readUInt( p, 8 );
+				const uint64_t size = readUInt( p, 8 );
+
+				bool valid = i ? parent < i && m_nodes[parent].entryType == IndexedIO::Directory : parent == g_noParent;
+				valid = valid && nameOffset < stringsSize && memchr( strings + nameOffset, 0, stringsSize - nameOffset );
+				valid = valid && entryType <= IndexedIO::File && dataType <= IndexedIO::InternedStringArray;
+				valid = valid && dataOffset <= dataSize && size <= dataSize - dataOffset;
+				if( !valid )
+				{
+					throw IOException( "PackedIndexedIO: Corrupt block entry." );
+				}
+
+				size_t index = addNode(
+					i ? parent : g_noParent, InternedString( strings + nameOffset ),
+					(IndexedIO::EntryType)entryType, (IndexedIO::DataType)dataType, arrayLength
+				);
+				m_nodes[index].dataOffset = dataOffset;
+				m_nodes[index].dataSize = size;
+			}
+		}
+
+		typedef std::pair<size_t, const std::string *> ChildKey;
+		typedef boost::unordered_map<ChildKey, size_t> ChildMap;
+
+		IndexedIO::OpenMode m_mode;
+		ConstCharVectorDataPtr m_source;
+		const char *m_sourceData;
+		std::vector<Node> m_nodes;
+		ChildMap m_childMap;
+		std::vector<char> m_written;
+
+};
+
+//////////////////////////////////////////////////////////////////////////
+// PackedIndexedIO
+//////////////////////////////////////////////////////////////////////////
+
+PackedIndexedIO::PackedIndexedIO( ConstCharVectorDataPtr buf, const IndexedIO::EntryIDList &root, IndexedIO::OpenMode mode )
+	:	m_node( 0 )
+{
+	validateOpenMode( mode );
+	if( mode & IndexedIO::Write )
+	{
+		buf = 0;
+	}
+	m_block = new Block( mode, buf );
+
+	IndexedIO::MissingBehaviour missingBehaviour = ( mode & IndexedIO::Read ) ? IndexedIO::ThrowIfMissing : IndexedIO::CreateIfMissing;
+	for( IndexedIO::EntryIDList::const_iterator it = root.begin(); it != root.end(); it++ )
+	{
+		m_node = directoryChild( m_node, *it, missingBehaviour );
+	}
+}
+
+PackedIndexedIO::PackedIndexedIO( BlockPtr block, size_t node )
+	:	m_block( block ), m_node( node )
+{
+}
+
+PackedIndexedIO::~PackedIndexedIO()
+{
+}
+
+CharVectorDataPtr PackedIndexedIO::buffer() const
+{
+	return m_block->pack();
+}
+
+bool PackedIndexedIO::isPacked( const IndexedIO *container, const IndexedIO::EntryID &name )
+{
+	if( !container->hasEntry( name ) )
+	{
+		return false;
+	}
+	IndexedIO::Entry e = container->entry( name );
+	return e.entryType() == IndexedIO::File && e.dataType() == IndexedIO::CharArray;
+}
+
+ConstIndexedIOPtr PackedIndexedIO::unpack( const IndexedIO *container, const IndexedIO::EntryID &name )
+{
+	if( !isPacked( container, name ) )
+	{
+		throw IOException( "PackedIndexedIO::unpack: Entry '" + name.value() + "' is not a packed block." );
+	}
+
+	CharVectorDataPtr buf = new CharVectorData;
+	std::vector<char> &data = buf->writable();
+	data.resize( container->entry( name ).arrayLength() );
+	if( data.size() )
+	{
+		char *p = &data[0];
+		container->read( name, p, data.size() );
+	}
+	return new PackedIndexedIO( buf, IndexedIO::rootPath, IndexedIO::Read );
+}
+
+IndexedIO::OpenMode PackedIndexedIO::openMode() const
+{
+	return m_block->openMode();
+}
+
+void PackedIndexedIO::path( IndexedIO::EntryIDList &result ) const
+{
+	result.clear();
+	for( size_t n = m_node; n != 0; n = m_block->node( n ).parent )
+	{
+		result.push_back( m_block->node( n ).name );
+	}
+	std::reverse( result.begin(), result.end() );
+}
+
+bool PackedIndexedIO::hasEntry( const IndexedIO::EntryID &name ) const
+{
+	return m_block->child( m_node, name ) >= 0;
+}
+
+const IndexedIO::EntryID &PackedIndexedIO::currentEntryId() const
+{
+	return m_block->node( m_node ).name;
+}
+
+void PackedIndexedIO::entryIds( IndexedIO::EntryIDList &names ) const
+{
+	names.clear();
+	const std::vector<size_t> &children = m_block->node( m_node ).children;
+	for( std::vector<size_t>::const_iterator it = children.begin(); it != children.end(); it++ )
+	{
+		names.push_back( m_block->node( *it ).name );
+	}
+}
+
+void PackedIndexedIO::entryIds( IndexedIO::EntryIDList &names, IndexedIO::EntryType type ) const
+{
+	names.clear();
+	const std::vector<size_t> &children = m_block->node( m_node ).children;
+	for( std::vector<size_t>::const_iterator it = children.begin(); it != children.end(); it++ )
+	{
+		const Block::Node &n = m_block->node( *it );
+		if( n.entryType == type )
+		{
+			names.push_back( n.name );
+		}
+	}
+}
+
+long PackedIndexedIO::directoryChild( size_t node, const IndexedIO::EntryID &name, IndexedIO::MissingBehaviour missingBehaviour ) const
+{
+	long index = m_block->child( node, name );
+	if( index >= 0 && m_block->node( index ).entryType == IndexedIO::Directory )
+	{
+		return index;
+	}
+
+	if( missingBehaviour == IndexedIO::CreateIfMissing && index < 0 )
+	{
+		writable( name );
+		return m_block->addDirectory( node, name );
+	}
+	else if( missingBehaviour == IndexedIO::NullIfMissing )
+	{
+		return -1;
+	}
+	throw IOException( "PackedIndexedIO: Could not find child '" + name.value() + "'" );
+}
+
+IndexedIOPtr PackedIndexedIO::subdirectory( const IndexedIO::EntryID &name, IndexedIO::MissingBehaviour missingBehaviour )
+{
+	long index = directoryChild( m_node, name, missingBehaviour );
+	if( index < 0 )
+	{
+		return 0;
+	}
+	return new PackedIndexedIO( m_block, index );
+}
+
+ConstIndexedIOPtr PackedIndexedIO::subdirectory( const IndexedIO::EntryID &name, IndexedIO::MissingBehaviour missingBehaviour ) const
+{
+	if( missingBehaviour == IndexedIO::CreateIfMissing )
+	{
+		missingBehaviour = IndexedIO::ThrowIfMissing;
+	}
+	long index = directoryChild( m_node, name, missingBehaviour );
+	if( index < 0 )
+	{
+		return 0;
+	}
+	return new PackedIndexedIO( m_block, index );
+}
+
+IndexedIO::Entry PackedIndexedIO::entry( const IndexedIO::EntryID &name ) const
+{
+	long index = m_block->child( m_node, name );
+	if( index < 0 )
+	{
+		throw IOException( "PackedIndexedIO::entry: Entry not found '" + name.value() + "'" );
+	}
+	const Block::Node &n = m_block->node( index );
+	return IndexedIO::Entry( n.name, n.entryType, n.dataType, n.arrayLength );
+}
+
+IndexedIOPtr PackedIndexedIO::createSubdirectory( const IndexedIO::EntryID &name )
+{
+	if( hasEntry( name ) )
+	{
+		throw IOException( "Child '" + name.value() + "' already exists!" );
+	}
+	writable( name );
+	return new PackedIndexedIO( m_block, m_block->addDirectory( m_node, name ) );
+}
+
+void PackedIndexedIO::remove( const IndexedIO::EntryID &name )
+{
+	writable( name );
+	long index = m_block->child( m_node, name );
+	if( index < 0 )
+	{
+		throw IOException( "PackedIndexedIO::remove: Entry not found '" + name.value() + "'" );
+	}
+	m_block->removeChild( m_node, index );
+}
+
+void PackedIndexedIO::removeAll()
+{
+	writable( currentEntryId() );
+	while( m_block->node( m_node ).children.size() )
+	{
+		m_block->removeChild( m_node, m_block->node( m_node ).children.back() );
+	}
+}
+
+IndexedIOPtr PackedIndexedIO::parentDirectory()
+{
+	if( !m_node )
+	{
+		return 0;
+	}
+	return new PackedIndexedIO( m_block, m_block->node( m_node ).parent );
+}
+
+ConstIndexedIOPtr PackedIndexedIO::parentDirectory() const
+{
+	if( !m_node )
+	{
+		return 0;
+	}
+	return new PackedIndexedIO( m_block, m_block->node( m_node ).parent );
+}
+
+IndexedIOPtr PackedIndexedIO::directory( const IndexedIO::EntryIDList &path, IndexedIO::MissingBehaviour missingBehaviour )
+{
+	long index = 0;
+	for( IndexedIO::EntryIDList::const_iterator it = path.begin(); it != path.end() && index >= 0; it++ )
+	{
+		index = directoryChild( index, *it, missingBehaviour );
+	}
+	if( index < 0 )
+	{
+		return 0;
+	}
+	return new PackedIndexedIO( m_block, index );
+}
+
+ConstIndexedIOPtr PackedIndexedIO::directory( const IndexedIO::EntryIDList &path, IndexedIO::MissingBehaviour missingBehaviour ) const
+{
+	if( missingBehaviour == IndexedIO::CreateIfMissing )
+	{
+		missingBehaviour = IndexedIO::ThrowIfMissing;
+	}
+	long index = 0;
+	for( IndexedIO::EntryIDList::const_iterator it = path.begin(); it != path.end() && index >= 0; it++ )
+	{
+		index = directoryChild( index, *it, missingBehaviour );
+	}
+	if( index < 0 )
+	{
+		return 0;
+	}
+	return new PackedIndexedIO( m_block, index );
+}
+
+void PackedIndexedIO::commit()
+{
+	// everything stays in memory until buffer() is called.
+}
+
+//////////////////////////////////////////////////////////////////////////
+// Writing. On little endian platforms the block layout of numeric arrays
+// matches their layout in memory, so they're copied directly.
+//////////////////////////////////////////////////////////////////////////
+
+template<typename T>
+void PackedIndexedIO::writeArray( const IndexedIO::EntryID &name, const T *x, unsigned long arrayLength )
+{
+	writable( name );
+	const unsigned long size = IndexedIO::DataSizeTraits<T*>::size( x, arrayLength );
+	char *dst = m_block->addFile( m_node, name, IndexedIO::DataTypeTraits<T*>::type(), arrayLength, size );
+#ifdef IE_CORE_LITTLE_ENDIAN
+	if( size )
+	{
+		memcpy( dst, x, size );
+	}
+#else
+	IndexedIO::DataFlattenTraits<T*>::flatten( x, arrayLength, dst );
+#endif
+}
+
+template<typename T>
+void PackedIndexedIO::writeValue( const IndexedIO::EntryID &name, const T &x )
+{
+	writable( name );
+	char *dst = m_block->addFile( m_node, name, IndexedIO::DataTypeTraits<T>::type(), 0, IndexedIO::DataSizeTraits<T>::size( x ) );
+	IndexedIO::DataFlattenTraits<T>::flatten( x, dst );
+}
+
+void PackedIndexedIO::write(const IndexedIO::EntryID &name, const float *x, unsigned long arrayLength)
+{
+	writeArray( name, x, arrayLength );
+}
+
+void PackedIndexedIO::write(const IndexedIO::EntryID &name, const double *x, unsigned long arrayLength)
+{
+	writeArray( name, x, arrayLength );
+}
+
+void PackedIndexedIO::write(const IndexedIO::EntryID &name, const half *x, unsigned long arrayLength)
+{
+	writeArray( name, x, arrayLength );
+}
+
+void PackedIndexedIO::write(const IndexedIO::EntryID &name, const int *x, unsigned long arrayLength)
+{
+	writeArray( name, x, arrayLength );
+}
+
+void PackedIndexedIO::write(const IndexedIO::EntryID &name, const int64_t *x, unsigned long arrayLength)
+{
+	writeArray( name, x, arrayLength );
+}
+
+void PackedIndexedIO::write(const IndexedIO::EntryID &name, const uint64_t *x, unsigned long arrayLength)
+{
+	writeArray( name, x, arrayLength );
+}
+
+void PackedIndexedIO::write(const IndexedIO::EntryID &name, const unsigned int *x, unsigned long arrayLength)
+{
+	writeArray( name, x, arrayLength );
+}
+
+void PackedIndexedIO::write(const IndexedIO::EntryID &name, const char *x, unsigned long arrayLength)
+{
+	writeArray( name, x, arrayLength );
+}
+
+void PackedIndexedIO::write(const IndexedIO::EntryID &name, const unsigned char *x, unsigned long arrayLength)
+{
+	writeArray( name, x, arrayLength );
+}
+
+void PackedIndexedIO::write(const IndexedIO::EntryID &name, const short *x, unsigned long arrayLength)
+{
+	writeArray( name, x, arrayLength );
+}
+
+void PackedIndexedIO::write(const IndexedIO::EntryID &name, const unsigned short *x, unsigned long arrayLength)
+{
+	writeArray( name, x, arrayLength );
+}
+
+void PackedIndexedIO::write(const IndexedIO::EntryID &name, const std::string *x, unsigned long arrayLength)
+{
+	writable( name );
+	const unsigned long size = IndexedIO::DataSizeTraits<std::string*>::size( x, arrayLength );
+	char *dst = m_block->addFile( m_node, name, IndexedIO::StringArray, arrayLength, size );
+	IndexedIO::DataFlattenTraits<std::string*>::flatten( x, arrayLength, dst );
+}
+
+void PackedIndexedIO::write(const IndexedIO::EntryID &name, const InternedString *x, unsigned long arrayLength)
+{
+	writable( name );
+	std::vector<std::string> strings( arrayLength );
+	for( unsigned long i = 0; i < arrayLength; i++ )
+	{
+		strings[i] = x[i].value();
+	}
+	const std::string *s = arrayLength ? &strings[0] : 0;
+	const unsigned long size = IndexedIO::DataSizeTraits<std::string*>::size( s, arrayLength );
+	char *dst = m_block->addFile( m_node, name, IndexedIO::InternedStringArray, arrayLength, size );
+	IndexedIO::DataFlattenTraits<std::string*>::flatten( s, arrayLength, dst );
+}
+
+void PackedIndexedIO::write(const IndexedIO::EntryID &name, const float &x)
+{
+	writeValue( name, x );
+}
+
+void PackedIndexedIO::write(const IndexedIO::EntryID &name, const double &x)
+{
+	writeValue( name, x );
+}
+
+void PackedIndexedIO::write(const IndexedIO::EntryID &name, const half &x)
+{
+	writeValue( name, x );
+}
+
+void PackedIndexedIO::write(const IndexedIO::EntryID &name, const int &x)
+{
+	writeValue( name, x );
+}
+
+void PackedIndexedIO::write(const IndexedIO::EntryID &name, const int64_t &x)
+{
+	writeValue( name, x );
+}
+
+void PackedIndexedIO::write(const IndexedIO::EntryID &name, const uint64_t &x)
+{
+	writeValue( name, x );
+}
+
+void PackedIndexedIO::write(const IndexedIO::EntryID &name, const std::string &x)
+{
+	writeValue( name, x );
+}
+
+void PackedIndexedIO::write(const IndexedIO::EntryID &name, const unsigned int &x)
+{
+	writeValue( name, x );
+}
+
+void PackedIndexedIO::write(const IndexedIO::EntryID &name, const char &x)
+{
+	writeValue( name, x );
+}
+
+void PackedIndexedIO::write(const IndexedIO::EntryID &name, const unsigned char &x)
+{
+	writeValue( name, x );
+}
+
+void PackedIndexedIO::write(const IndexedIO::EntryID &name, const short &x)
+{
+	writeValue( name, x );
+}
+
+void PackedIndexedIO::write(const IndexedIO::EntryID &name, const unsigned short &x)
+{
+	writeValue( name, x );
+}
+
+//////////////////////////////////////////////////////////////////////////
+// Reading
+//////////////////////////////////////////////////////////////////////////
+
+template<typename T>
+void PackedIndexedIO::readArray( const IndexedIO::EntryID &name, T *&x, unsigned long arrayLength ) const
+{
+	readable( name );
+	size_t size = 0;
+	const char *src = m_block->fileData( m_node, name, size );
+	if( size < arrayLength * IndexedIODetail::size<T>() )
+	{
+		throw IOException( "PackedIndexedIO::read: Array length mismatch for '" + name.value() + "'" );
+	}
+	if( !x )
+	{
+		x = new T[arrayLength];
+	}
+#ifdef IE_CORE_LITTLE_ENDIAN
+	if( arrayLength )
+	{
+		memcpy( x, src, arrayLength * sizeof( T ) );
+	}
+#else
+	IndexedIO::DataFlattenTraits<T*>::unflatten( src, x, arrayLength );
+#endif
+}
+
+template<typename T>
+void PackedIndexedIO::readValue( const IndexedIO::EntryID &name, T &x ) const
+{
+	readable( name );
+	size_t size = 0;
+	const char *src = m_block->fileData( m_node, name, size );
+	if( size < (size_t)IndexedIODetail::size<T>() )
+	{
+		throw IOException( "PackedIndexedIO::read: Data size mismatch for '" + name.value() + "'" );
+	}
+	IndexedIO::DataFlattenTraits<T>::unflatten( src, x );
+}
+
+void PackedIndexedIO::read(const IndexedIO::EntryID &name, float *&x, unsigned long arrayLength) const
+{
+	readArray( name, x, arrayLength );
+}
+
+void PackedIndexedIO::read(const IndexedIO::EntryID &name, double *&x, unsigned long arrayLength) const
+{
+	readArray( name, x, arrayLength );
+}
+
+void PackedIndexedIO::read(const IndexedIO::EntryID &name, half *&x, unsigned long arrayLength) const
+{
+	readArray( name, x, arrayLength );
+}
+
+void PackedIndexedIO::read(const IndexedIO::EntryID &name, int *&x, unsigned long arrayLength) const
+{
+	readArray( name, x, arrayLength );
+}
+
+void PackedIndexedIO::read(const IndexedIO::EntryID &name, int64_t *&x, unsigned long arrayLength) const
+{
+	readArray( name, x, arrayLength );
+}
+
+void PackedIndexedIO::read(const IndexedIO::EntryID &name, uint64_t *&x, unsigned long arrayLength) const
+{
+	readArray( name, x, arrayLength );
+}
+
+void PackedIndexedIO::read(const IndexedIO::EntryID &name, unsigned int *&x, unsigned long arrayLength) const
+{
+	readArray( name, x, arrayLength );
+}
+
+void PackedIndexedIO::read(const IndexedIO::EntryID &name, char *&x, unsigned long arrayLength) const
+{
+	readArray( name, x, arrayLength );
+}
+
+void PackedIndexedIO::read(const IndexedIO::EntryID &name, unsigned char *&x, unsigned long arrayLength) const
+{
+	readArray( name, x, arrayLength );
+}
+
+void PackedIndexedIO::read(const IndexedIO::EntryID &name, short *&x, unsigned long arrayLength) const
+{
+	readArray( name, x, arrayLength );
+}
+
+void PackedIndexedIO::read(const IndexedIO::EntryID &name, unsigned short *&x, unsigned long arrayLength) const
+{
+	readArray( name, x, arrayLength );
+}
+
+void PackedIndexedIO::read(const IndexedIO::EntryID &name, std::string *&x, unsigned long arrayLength) const
+{
+	readable( name );
+	size_t size = 0;
+	const char *src = m_block->fileData( m_node, name, size );
+	IndexedIO::DataFlattenTraits<std::string*>::unflatten( src, x, arrayLength );
+}
+
+void PackedIndexedIO::read(const IndexedIO::EntryID &name, InternedString *&x, unsigned long arrayLength) const
+{
+	std::string *strings = 0;
+	read( name, strings, arrayLength );
+	if( !x )
+	{
+		x = new InternedString[arrayLength];
+	}
+	for( unsigned long i = 0; i < arrayLength; i++ )
+	{
+		x[i] = strings[i];
+	}
+	delete [] strings;
+}
+
+void PackedIndexedIO::read(const IndexedIO::EntryID &name, float &x) const
+{
+	readValue( name, x );
+}
+
+void PackedIndexedIO::read(const IndexedIO::EntryID &name, double &x) const
+{
+	readValue( name, x );
+}
+
+void PackedIndexedIO::read(const IndexedIO::EntryID &name, half &x) const
+{
+	readValue( name, x );
+}
+
+void PackedIndexedIO::read(const IndexedIO::EntryID &name, int &x) const
+{
+	readValue( name, x );
+}
+
+void PackedIndexedIO::read(const IndexedIO::EntryID &name, int64_t &x) const
+{
+	readValue( name, x );
+}
+
+void PackedIndexedIO::read(const IndexedIO::EntryID &name, uint64_t &x) const
+{
+	readValue( name, x );
+}
+
+void PackedIndexedIO::read(const IndexedIO::EntryID &name, std::string &x) const
+{
+	readable( name );
+	size_t size = 0;
+	const char *src = m_block->fileData( m_node, name, size );
+	x = std::string( src, std::find( src, src + size, '\0' ) );
+}
+
+void PackedIndexedIO::read(const IndexedIO::EntryID &name, unsigned int &x) const
+{
+	readValue( name, x );
+}
+
+void PackedIndexedIO::read(const IndexedIO::EntryID &name, char &x) const
+{
+	readValue( name, x );
+}
+
+void PackedIndexedIO::read(const IndexedIO::EntryID &name, unsigned char &x) const
+{
+	readValue( name, x );
+}
+
+void PackedIndexedIO::read(const IndexedIO::EntryID &name, short &x) const
+{
+	readValue( name, x );
+}
+
+void PackedIndexedIO::read(const IndexedIO::EntryID &name, unsigned short &x) const
+{
+	readValue( name, x );
+}
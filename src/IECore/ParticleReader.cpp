@@ -46,6 +46,8 @@
 #include "IECore/DespatchTypedData.h"
 #include "IECore/TestTypedData.h"
 
+#include "OpenEXR/ImathRandom.h"
+
 #include <algorithm>
 
 using namespace std;
@@ -104,6 +106,11 @@ ParticleReader::ParticleReader( const std::string &description )
 	parameters()->addParameter( m_convertPrimVarNamesParameter );
 }
 
+ParticleReader::FilteredIndices::FilteredIndices()
+	:	valid( false ), numParticles( 0 ), percentage( 100.0f ), seed( 0 ), haveIds( false )
+{
+}
+
 FloatParameter * ParticleReader::percentageParameter()
 {
 	return m_percentageParameter.get();
@@ -240,3 +247,77 @@ bool ParticleReader::convertPrimVarNames() const
 	return m_convertPrimVarNamesParameter->getTypedValue();
 }
 
+template<typename T>
+static void filterIndices( const std::vector<T> &ids, size_t numParticles, int seed, float fraction, std::vector<size_t> &indices )
+{
+	// must match ParticleReader::filterAttr() exactly
+	Imath::Rand48 r;
+	for( size_t i=0, e=std::min( numParticles, ids.size() ); i<e; i++ )
+	{
+		r.init( seed + (int)ids[i] );
+		if( r.nextf() <= fraction )
+		{
+			indices.push_back( i );
+		}
+	}
+}
+
+const std::vector<size_t> *ParticleReader::filteredIndices( size_t numParticles, const Data *idAttr )
+{
+	const float percentage = particlePercentage();
+	if( percentage >= 100.0f )
+	{
+		return 0;
+	}
+
+	if( idAttr && idAttr->typeId() != DoubleVectorDataTypeId && idAttr->typeId() != IntVectorDataTypeId )
+	{
+		msg( Msg::Warning, "ParticleReader::filteredIndices", format( "Unrecognized id data type in file \"%s\"! Disabling filtering." ) % fileName() );
+		return 0;
+	}
+
+	const int seed = particlePercentageSeed();
+	FilteredIndices &f = m_filteredIndices;
+	if(
+		f.valid && f.fileName == fileName() && f.numParticles == numParticles &&
+		f.percentage == percentage && f.seed == seed && f.haveIds == ( idAttr != 0 )
+	)
+	{
+		return &f.indices;
+	}
+
+	f.indices.clear();
+	const float fraction = percentage / 100.0f;
+	if( idAttr )
+	{
+		if( idAttr->typeId() == DoubleVectorDataTypeId )
+		{
+			filterIndices( static_cast<const DoubleVectorData *>( idAttr )->readable(), numParticles, seed, fraction, f.indices );
+		}
+		else
+		{
+			filterIndices( static_cast<const IntVectorData *>( idAttr )->readable(), numParticles, seed, fraction, f.indices );
+		}
+	}
+	else
+	{
+		Imath::Rand48 r;
+		r.init( seed );
+		for( size_t i=0; i<numParticles; i++ )
+		{
+			if( r.nextf() <= fraction )
+			{
+				f.indices.push_back( i );
+			}
+		}
+	}
+
+	f.valid = true;
+	f.fileName = fileName();
+	f.numParticles = numParticles;
+	f.percentage = percentage;
+	f.seed = seed;
+	f.haveIds = idAttr != 0;
+
+	return &f.indices;
+}
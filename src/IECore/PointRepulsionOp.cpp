@@ -38,6 +38,10 @@
 
 #include "boost/format.hpp"
 
+#include "tbb/parallel_for.h"
+#include "tbb/blocked_range.h"
+#include "tbb/atomic.h"
+
 #include "IECore/Reader.h"
 #include "IECore/ImagePrimitive.h"
 
@@ -205,106 +209,184 @@ const StringParameter * PointRepulsionOp::weightsNameParameter() const
 	return m_weightsNameParameter.get();
 }
 
-void PointRepulsionOp::getNearestPointsAndDensities( ImagePrimitiveEvaluator * imageEvaluator, const PrimitiveVariable &densityPrimVar, MeshPrimitiveEvaluator * meshEvaluator, const PrimitiveVariable &sPrimVar, const PrimitiveVariable &tPrimVar, std::vector<Imath::V3f> &points, std::vector<float> &densities )
+// the number of iterations after which the tree of point bounds is rebuilt, rather than
+// just updated to account for the movement of the points.
+static const int g_treeRebuildInterval = 16;
+
+struct PointRepulsionOp::NearestPointsAndDensities
 {
-	densities.resize( points.size() );
 
-	PrimitiveEvaluator::ResultPtr meshResult = meshEvaluator->createResult();
-	PrimitiveEvaluator::ResultPtr imageResult = imageEvaluator->createResult();
+	/// Exceptions can't be relied upon to propagate intact out of
+	/// parallel_for, so we just flag failure and let the caller throw.
+	NearestPointsAndDensities( const ImagePrimitiveEvaluator *imageEvaluator, const PrimitiveVariable &densityPrimVar, const MeshPrimitiveEvaluator *meshEvaluator, const PrimitiveVariable &sPrimVar, const PrimitiveVariable &tPrimVar, std::vector<Imath::V3f> &points, std::vector<float> &densities, tbb::atomic<bool> &failed )
+		:	m_imageEvaluator( imageEvaluator ), m_densityPrimVar( densityPrimVar ), m_meshEvaluator( meshEvaluator ),
+			m_sPrimVar( sPrimVar ), m_tPrimVar( tPrimVar ), m_points( points ), m_densities( densities ), m_failed( failed )
+	{
+	}
 
-	for ( std::vector<Imath::V3f>::size_type p = 0; p < points.size(); p++ )
+	void operator()( const tbb::blocked_range<size_t> &r ) const
 	{
-		bool found = meshEvaluator->closestPoint( points[p], meshResult.get() );
-		if ( !found )
+		PrimitiveEvaluator::ResultPtr meshResult = m_meshEvaluator->createResult();
+		PrimitiveEvaluator::ResultPtr imageResult = m_imageEvaluator->createResult();
+
+		for ( size_t p = r.begin(); p != r.end(); p++ )
 		{
-			throw InvalidArgumentException( "PointRepulsionOp: Invaid mesh - closest point is undefined" );
-		}
+			bool found = m_meshEvaluator->closestPoint( m_points[p], meshResult.get() );
+			if ( !found )
+			{
+				m_failed = true;
+				return;
+			}
 
-		points[p] = meshResult->point();
+			m_points[p] = meshResult->point();
 
-		Imath::V2f uv(
-		        meshResult->floatPrimVar( sPrimVar ),
-		        meshResult->floatPrimVar( tPrimVar )
-		);
+			Imath::V2f uv(
+			        meshResult->floatPrimVar( m_sPrimVar ),
+			        meshResult->floatPrimVar( m_tPrimVar )
+			);
 
-		/// \todo Texture repeat
-		float repeatU = 1.0;
-		float repeatV = 1.0;
+			/// \todo Texture repeat
+			float repeatU = 1.0;
+			float repeatV = 1.0;
 
-		/// \todo Wrap modes
-		bool wrapU = true;
-		bool wrapV = true;
+			/// \todo Wrap modes
+			bool wrapU = true;
+			bool wrapV = true;
 
-		Imath::V2f placedUv(
-		        uv.x * repeatU,
-		        uv.y * repeatV
-		);
+			Imath::V2f placedUv(
+			        uv.x * repeatU,
+			        uv.y * repeatV
+			);
 
-		if ( wrapU )
-		{
-			placedUv.x = fmodf( placedUv.x, 1.0f );
-		}
+			if ( wrapU )
+			{
+				placedUv.x = fmodf( placedUv.x, 1.0f );
+			}
 
-		if ( wrapV )
-		{
-			placedUv.y = fmodf( placedUv.y, 1.0f );
+			if ( wrapV )
+			{
+				placedUv.y = fmodf( placedUv.y, 1.0f );
+			}
+
+			m_imageEvaluator->pointAtUV( placedUv, imageResult.get() );
+
+			m_densities[p] = imageResult->floatPrimVar( m_densityPrimVar );
 		}
+	}
+
+	private :
+
+		const ImagePrimitiveEvaluator *m_imageEvaluator;
+		const PrimitiveVariable &m_densityPrimVar;
+		const MeshPrimitiveEvaluator *m_meshEvaluator;
+		const PrimitiveVariable &m_sPrimVar;
+		const PrimitiveVariable &m_tPrimVar;
+		std::vector<Imath::V3f> &m_points;
+		std::vector<float> &m_densities;
+		tbb::atomic<bool> &m_failed;
+
+};
 
-		imageEvaluator->pointAtUV( placedUv, imageResult.get() );
+void PointRepulsionOp::getNearestPointsAndDensities( ImagePrimitiveEvaluator * imageEvaluator, const PrimitiveVariable &densityPrimVar, MeshPrimitiveEvaluator * meshEvaluator, const PrimitiveVariable &sPrimVar, const PrimitiveVariable &tPrimVar, std::vector<Imath::V3f> &points, std::vector<float> &densities )
+{
+	densities.resize( points.size() );
 
-		densities[p] = imageResult->floatPrimVar( densityPrimVar );
+	tbb::atomic<bool> failed;
+	failed = false;
+	tbb::parallel_for(
+		tbb::blocked_range<size_t>( 0, points.size() ),
+		NearestPointsAndDensities( imageEvaluator, densityPrimVar, meshEvaluator, sPrimVar, tPrimVar, points, densities, failed )
+	);
+
+	if ( failed )
+	{
+		throw InvalidArgumentException( "PointRepulsionOp: Invaid mesh - closest point is undefined" );
 	}
 }
 
-void PointRepulsionOp::calculateForces( std::vector<V3f> &points, std::vector<float> &radii, std::vector<Imath::Box3f> &bounds, std::vector<Imath::V3f> &forces, Imath::Rand48 &generator, std::vector<float> &densities, float densityInv )
+struct PointRepulsionOp::Forces
 {
-	unsigned numPoints = points.size();
-
-	Box3fTree tree( bounds.begin(), bounds.end(), 16 );
 
-	typedef std::vector< Box3fTree::Iterator> Bounds;
+	Forces( const std::vector<V3f> &points, const std::vector<float> &radii, const std::vector<Imath::Box3f> &bounds, const Box3fTree &tree, std::vector<Imath::V3f> &forces, unsigned long seed, const std::vector<float> &densities, float densityInv )
+		:	m_points( points ), m_radii( radii ), m_bounds( bounds ), m_tree( tree ), m_forces( forces ), m_seed( seed ), m_densities( densities ), m_densityInv( densityInv )
+	{
+	}
 
-	for ( std::vector<V3f>::size_type p = 0; p < numPoints; p++ )
+	void operator()( const tbb::blocked_range<size_t> &r ) const
 	{
+		typedef std::vector< Box3fTree::Iterator> Bounds;
 		Bounds approximateBounds;
-		tree.intersectingBounds( bounds[p], approximateBounds );
 
-		for ( Bounds::const_iterator it = approximateBounds.begin(); it != approximateBounds.end(); ++it )
+		for ( size_t p = r.begin(); p != r.end(); p++ )
 		{
-			const std::vector<V3f>::size_type other = *it - bounds.begin();
-			assert( other < numPoints );
-			assert( other < radii.size() );
+			m_tree.intersectingBounds( m_bounds[p], approximateBounds );
+
+			// each point has its own random sequence, made only if it's needed, so that
+			// the result is independent of the order in which points are processed.
+			Rand48 generator;
+			bool generatorInitialised = false;
 
-			if ( p != other )
+			for ( Bounds::const_iterator it = approximateBounds.begin(); it != approximateBounds.end(); ++it )
 			{
-				Imath::V3f separation = points[p] - points[other];
+				const size_t other = *it - m_bounds.begin();
+				assert( other < m_points.size() );
+				assert( other < m_radii.size() );
 
-				float dist = separation.length();
+				if ( p != other )
+				{
+					Imath::V3f separation = m_points[p] - m_points[other];
 
-				float densityDiff = 1.0f - fabsf( densities[p] * densityInv - densities[other] * densityInv );
+					float dist = separation.length();
 
-				if ( dist < radii[p] + radii[other] )
-				{
-					float overlap = radii[p] + radii[other] - dist;
-					assert( overlap >= 0.0f );
-					float overlapNorm = overlap / ( radii[p] + radii[other] );
+					float densityDiff = 1.0f - fabsf( m_densities[p] * m_densityInv - m_densities[other] * m_densityInv );
 
-					if ( dist < 1.e-6f )
-					{
-						/// Points are incident, so force acts to move current point away from neighbour in a random direction
-						forces[ p ] += densityDiff * overlapNorm * solidSphereRand< V3f, Rand48 >( generator ) ;
-					}
-					else
+					if ( dist < m_radii[p] + m_radii[other] )
 					{
-						/// Force acts to move current point away from neighbour along their line of separation
-						forces[ p ] += densityDiff * overlapNorm * separation.normalized() ;
+						float overlap = m_radii[p] + m_radii[other] - dist;
+						assert( overlap >= 0.0f );
+						float overlapNorm = overlap / ( m_radii[p] + m_radii[other] );
+
+						if ( dist < 1.e-6f )
+						{
+							if( !generatorInitialised )
+							{
+								generator.init( m_seed * m_points.size() + p );
+								generatorInitialised = true;
+							}
+							/// Points are incident, so force acts to move current point away from neighbour in a random direction
+							m_forces[ p ] += densityDiff * overlapNorm * solidSphereRand< V3f, Rand48 >( generator ) ;
+						}
+						else
+						{
+							/// Force acts to move current point away from neighbour along their line of separation
+							m_forces[ p ] += densityDiff * overlapNorm * separation.normalized() ;
+						}
 					}
 				}
 			}
 		}
 	}
-}
 
+	private :
+
+		const std::vector<V3f> &m_points;
+		const std::vector<float> &m_radii;
+		const std::vector<Imath::Box3f> &m_bounds;
+		const Box3fTree &m_tree;
+		std::vector<Imath::V3f> &m_forces;
+		unsigned long m_seed;
+		const std::vector<float> &m_densities;
+		float m_densityInv;
+
+};
+
+void PointRepulsionOp::calculateForces( const std::vector<V3f> &points, const std::vector<float> &radii, const std::vector<Imath::Box3f> &bounds, const Box3fTree &tree, std::vector<Imath::V3f> &forces, unsigned long seed, const std::vector<float> &densities, float densityInv )
+{
+	tbb::parallel_for(
+		tbb::blocked_range<size_t>( 0, points.size() ),
+		Forces( points, radii, bounds, tree, forces, seed, densities, densityInv )
+	);
+}
 
 void PointRepulsionOp::modify( Object * object, const CompoundObject * operands )
 {
@@ -514,11 +596,10 @@ void PointRepulsionOp::modify( Object * object, const CompoundObject * operands
 	std::vector<float> radii( numPoints );
 	std::vector<Imath::V3f> oldPoints( numPoints );
 	std::vector<Imath::Box3f> bounds( numPoints );
+	Box3fTree tree;
 
 	float lastEnergy = std::numeric_limits<float>::max();
 
-	Rand48 generator( 1 );
-
 	for ( int i = 0; i < numIterations; ++i )
 	{
 		assert( points.size() == originalDensities.size() );
@@ -561,17 +642,26 @@ void PointRepulsionOp::modify( Object * object, const CompoundObject * operands
 			forces[p] = V3f( 0.0 );
 		}
 
-		calculateForces( points, radii, bounds, forces, generator, originalDensities, textureArea / ( float )numPoints );
+		// the points move only a little between iterations, so the tree is just
+		// updated most of the time, and only rebuilt occasionally.
+		if ( i % g_treeRebuildInterval == 0 )
+		{
+			tree.init( bounds.begin(), bounds.end(), 16 );
+		}
+		else
+		{
+			tree.update();
+		}
 
-		std::copy( points.begin(), points.end(), oldPoints.begin() );
+		calculateForces( points, radii, bounds, tree, forces, i + 1, originalDensities, textureArea / ( float )numPoints );
 
+		// keep the current positions in oldPoints, and advect points by the force applied to them
+		points.swap( oldPoints );
 		float totalEnergy = 0.0f;
 		for ( PointArray::size_type p = 0; p < numPoints; p++ )
 		{
 			totalEnergy += forces[p].length();
-
-			/// Advect point by force applied to it
-			points[p] += forces[p] * magnitude;
+			points[p] = oldPoints[p] + forces[p] * magnitude;
 		}
 
 		// Snap points back to mesh, and calculate new densities
@@ -39,6 +39,7 @@
 #include "IECore/TypeTraits.h"
 #include "IECore/DespatchTypedData.h"
 #include "IECore/MurmurHash.h"
+#include "IECore/PackedIndexedIO.h"
 
 using namespace IECore;
 using namespace boost;
@@ -107,6 +108,34 @@ void Primitive::save( IECore::Object::SaveContext *context ) const
 	}
 }
 
+void Primitive::loadVariables( LoadContext *context, const IndexedIO *ioVariables, const IndexedIO::EntryIDList &names, PrimitiveVariableMap &variables )
+{
+	IndexedIO::EntryIDList loadNames;
+	std::vector<ConstIndexedIOPtr> containers;
+	std::vector<PrimitiveVariable::Interpolation> interpolations;
+	for( IndexedIO::EntryIDList::const_iterator it=names.begin(); it!=names.end(); it++ )
+	{
+		ConstIndexedIOPtr ioPrimVar = ioVariables->subdirectory( *it, IndexedIO::NullIfMissing );
+		if( !ioPrimVar )
+		{
+			continue;
+		}
+		int i;
+		ioPrimVar->read( g_interpolationEntry, i );
+		loadNames.push_back( *it );
+		containers.push_back( ioPrimVar );
+		interpolations.push_back( (PrimitiveVariable::Interpolation)i );
+	}
+
+	// the interpolations are all read first, so the data can be loaded in one batch.
+	std::vector<DataPtr> data;
+	context->load<Data>( containers, IndexedIO::EntryIDList( containers.size(), g_dataEntry ), data );
+	for( size_t i = 0; i < loadNames.size(); i++ )
+	{
+		variables.insert( PrimitiveVariableMap::value_type( loadNames[i], PrimitiveVariable( interpolations[i], data[i] ) ) );
+	}
+}
+
 void Primitive::load( IECore::Object::LoadContextPtr context )
 {
 	unsigned int v = m_ioVersion;
@@ -127,20 +156,17 @@ void Primitive::load( IECore::Object::LoadContextPtr context )
 	variables.clear();
 	IndexedIO::EntryIDList names;
 	ioVariables->entryIds( names, IndexedIO::Directory );
-	IndexedIO::EntryIDList::const_iterator it;
-	for( it=names.begin(); it!=names.end(); it++ )
-	{
-		ConstIndexedIOPtr ioPrimVar = ioVariables->subdirectory( *it );
-		int i; 
-		ioPrimVar->read( g_interpolationEntry, i );
-		variables.insert( 
-			PrimitiveVariableMap::value_type( *it, PrimitiveVariable( (PrimitiveVariable::Interpolation)i, context->load<Data>( ioPrimVar.get(), g_dataEntry ) ) ) 
-		);
-	}
+	loadVariables( context.get(), ioVariables.get(), names, variables );
 }
 
 PrimitiveVariableMap Primitive::loadPrimitiveVariables( const IndexedIO *ioInterface, const IndexedIO::EntryID &name, const IndexedIO::EntryIDList &primVarNames )
 {
+	if( PackedIndexedIO::isPacked( ioInterface, name ) )
+	{
+		ConstIndexedIOPtr packedIO = PackedIndexedIO::unpack( ioInterface, name );
+		return loadPrimitiveVariables( packedIO.get(), name, primVarNames );
+	}
+
 	IECore::Object::LoadContextPtr context = new Object::LoadContext( ioInterface->subdirectory( name )->subdirectory( g_dataEntry ) );
 
 	unsigned int v = m_ioVersion;
@@ -152,20 +178,7 @@ PrimitiveVariableMap Primitive::loadPrimitiveVariables( const IndexedIO *ioInter
 	ConstIndexedIOPtr ioVariables = container->subdirectory( g_variablesEntry );
 
 	PrimitiveVariableMap variables;
-	IndexedIO::EntryIDList::const_iterator it;
-	for( it=primVarNames.begin(); it!=primVarNames.end(); it++ )
-	{
-		ConstIndexedIOPtr ioPrimVar = ioVariables->subdirectory( *it, IndexedIO::NullIfMissing );
-		if ( !ioPrimVar )
-		{
-			continue;
-		}
-		int i; 
-		ioPrimVar->read( g_interpolationEntry, i );
-		variables.insert( 
-			PrimitiveVariableMap::value_type( *it, PrimitiveVariable( (PrimitiveVariable::Interpolation)i, context->load<Data>( ioPrimVar.get(), g_dataEntry ) ) ) 
-		);
-	}
+	loadVariables( context.get(), ioVariables.get(), primVarNames, variables );
 
 	return variables;
 }
@@ -40,6 +40,9 @@
 #include "boost/algorithm/string/split.hpp"
 #include "boost/algorithm/string/classification.hpp"
 #include "boost/filesystem/convenience.hpp"
+#include "boost/unordered_map.hpp"
+
+#include <fstream>
 
 using namespace std;
 using namespace IECore;
@@ -74,41 +77,131 @@ const std::string &Reader::fileName() const
 	return m_fileNameParameter->getTypedValue();
 }
 
+namespace
+{
+
+// The number of bytes from the start of a file passed to the
+// CanReadMagicFns. This comfortably covers the magic numbers
+// of all the formats we know of.
+const size_t g_magicSize = 64;
+
+// The start of a file, read on first use only, so that files
+// are never opened just to check magic numbers when the readers
+// being considered have no CanReadMagicFns.
+class FileMagic
+{
+
+	public :
+
+		FileMagic( const std::string &fileName )
+			:	m_fileName( fileName ), m_size( 0 ), m_read( false )
+		{
+		}
+
+		const char *data()
+		{
+			read();
+			return m_data;
+		}
+
+		size_t size()
+		{
+			read();
+			return m_size;
+		}
+
+	private :
+
+		void read()
+		{
+			if( m_read )
+			{
+				return;
+			}
+			m_read = true;
+			std::ifstream in( m_fileName.c_str(), std::ios_base::in | std::ios_base::binary );
+			if( in.is_open() )
+			{
+				in.read( m_data, g_magicSize );
+				m_size = in.gcount();
+			}
+		}
+
+		const std::string &m_fileName;
+		char m_data[g_magicSize];
+		size_t m_size;
+		bool m_read;
+
+};
+
+} // namespace
+
+struct Reader::Registry
+{
+	// All registered readers, in the order of registration.
+	typedef std::vector<ReaderFns> ReaderFnsVector;
+	ReaderFnsVector readers;
+	// Maps from extensions (with preceding '.') to indices into readers.
+	typedef boost::unordered_map<std::string, std::vector<size_t> > ExtensionsToReadersMap;
+	ExtensionsToReadersMap extensionsToReaders;
+
+	// Returns true if the reader can read the file, using the magic
+	// number check where possible to avoid calling canRead.
+	static bool canRead( const ReaderFns &fns, const std::string &fileName, FileMagic &magic )
+	{
+		if( fns.canReadMagic )
+		{
+			if( !fns.canReadMagic( magic.data(), magic.size() ) )
+			{
+				return false;
+			}
+			if( fns.magicIsConclusive )
+			{
+				return true;
+			}
+		}
+		return fns.canRead( fileName );
+	}
+};
+
 ReaderPtr Reader::create( const std::string &fileName )
 {
+	const Registry &r = registry();
+
+	FileMagic magic( fileName );
+	std::vector<bool> tried( r.readers.size(), false );
+
 	bool knownExtension = false;
-	ExtensionsToFnsMap *m = extensionsToFns();
-	assert( m );
 	string ext = extension(boost::filesystem::path(fileName));
 	if( ext!="" )
 	{
-		ExtensionsToFnsMap::const_iterator it = m->find( ext );
-		
-		if( it!=m->end() )
+		Registry::ExtensionsToReadersMap::const_iterator it = r.extensionsToReaders.find( ext );
+		if( it!=r.extensionsToReaders.end() )
 		{
 			knownExtension = true;
-			
-			ExtensionsToFnsMap::const_iterator lastElement = m->upper_bound( ext );
-			
-			for ( ; it != lastElement; ++it )
-			{			
-				if( it->second.canRead( fileName ) )
+			for( std::vector<size_t>::const_iterator iIt = it->second.begin(); iIt != it->second.end(); ++iIt )
+			{
+				const ReaderFns &fns = r.readers[*iIt];
+				tried[*iIt] = true;
+				if( Registry::canRead( fns, fileName, magic ) )
 				{
-					return it->second.creator( fileName );
+					return fns.creator( fileName );
 				}
 			}
 		}
 	}
 
-	// failed to find a reader based on extension. try all canRead functions
-	// as a last ditch attempt.
-	for( ExtensionsToFnsMap::const_iterator it=m->begin(); it!=m->end(); it++ )
+	// failed to find a reader based on extension. try all the other readers
+	// in order of registration as a last ditch attempt.
+	for( size_t i = 0; i < r.readers.size(); ++i )
 	{
-		if( it->second.canRead( fileName ) )
+		const ReaderFns &fns = r.readers[i];
+		if( !tried[i] && Registry::canRead( fns, fileName, magic ) )
 		{
-			return( it->second.creator( fileName ) );
+			return fns.creator( fileName );
 		}
 	}
+
 	if ( knownExtension )
 	{
 		throw Exception( string( "Unable to load file '" ) + fileName + "'!" );
@@ -122,12 +215,11 @@ ReaderPtr Reader::create( const std::string &fileName )
 void Reader::supportedExtensions( std::vector<std::string> &extensions )
 {
 	extensions.clear();
-	ExtensionsToFnsMap *m = extensionsToFns();
-	assert( m );
+	const Registry &r = registry();
 	
 	std::set<std::string> uniqueExtensions;
 	
-	for( ExtensionsToFnsMap::const_iterator it=m->begin(); it!=m->end(); it++ )
+	for( Registry::ExtensionsToReadersMap::const_iterator it=r.extensionsToReaders.begin(); it!=r.extensionsToReaders.end(); it++ )
 	{
 		uniqueExtensions.insert( it->first.substr( 1 ) );
 	}
@@ -139,18 +231,20 @@ void Reader::supportedExtensions( std::vector<std::string> &extensions )
 void Reader::supportedExtensions( TypeId typeId, std::vector<std::string> &extensions )
 {
 	extensions.clear();
-	ExtensionsToFnsMap *m = extensionsToFns();
-	assert( m );
+	const Registry &r = registry();
 	
 	std::set<std::string> uniqueExtensions;
 
-	const std::set< TypeId > &derivedTypes = RunTimeTyped::derivedTypeIds( typeId );
-
-	for( ExtensionsToFnsMap::const_iterator it=m->begin(); it!=m->end(); it++ )
+	for( Registry::ExtensionsToReadersMap::const_iterator it=r.extensionsToReaders.begin(); it!=r.extensionsToReaders.end(); it++ )
 	{
-		if ( it->second.typeId == typeId || std::find( derivedTypes.begin(), derivedTypes.end(), it->second.typeId ) != derivedTypes.end() )
+		for( std::vector<size_t>::const_iterator iIt = it->second.begin(); iIt != it->second.end(); ++iIt )
 		{
-			uniqueExtensions.insert( it->first.substr( 1 ) );
+			const TypeId readerTypeId = r.readers[*iIt].typeId;
+			if ( readerTypeId == typeId || RunTimeTyped::inheritsFrom( readerTypeId, typeId ) )
+			{
+				uniqueExtensions.insert( it->first.substr( 1 ) );
+				break;
+			}
 		}
 	}
 
@@ -158,28 +252,30 @@ void Reader::supportedExtensions( TypeId typeId, std::vector<std::string> &exten
 	std::copy( uniqueExtensions.begin(), uniqueExtensions.end(), extensions.begin() );
 }
 
-void Reader::registerReader( const std::string &extensions, CanReadFn canRead, CreatorFn creator, TypeId typeId )
+void Reader::registerReader( const std::string &extensions, CanReadFn canRead, CreatorFn creator, TypeId typeId, CanReadMagicFn canReadMagic, bool magicIsConclusive )
 {
 	assert( canRead );
 	assert( creator );
 	assert( typeId != InvalidTypeId );
 
-	ExtensionsToFnsMap *m = extensionsToFns();
-	assert( m );
+	Registry &r = registry();
 	vector<string> splitExt;
 	split( splitExt, extensions, is_any_of( " " ) );
-	ReaderFns r;
-	r.creator = creator;
-	r.canRead = canRead;
-	r.typeId = typeId;
+	ReaderFns fns;
+	fns.creator = creator;
+	fns.canRead = canRead;
+	fns.canReadMagic = canReadMagic;
+	fns.magicIsConclusive = canReadMagic && magicIsConclusive;
+	fns.typeId = typeId;
+	r.readers.push_back( fns );
 	for( vector<string>::const_iterator it=splitExt.begin(); it!=splitExt.end(); it++ )
 	{
-		m->insert( ExtensionsToFnsMap::value_type( "." + *it, r ) );
+		r.extensionsToReaders["." + *it].push_back( r.readers.size() - 1 );
 	}
 }
 
-Reader::ExtensionsToFnsMap *Reader::extensionsToFns()
+Reader::Registry &Reader::registry()
 {
-	static ExtensionsToFnsMap *m = new ExtensionsToFnsMap;
-	return m;
+	static Registry *r = new Registry;
+	return *r;
 }
@@ -33,11 +33,218 @@
 //////////////////////////////////////////////////////////////////////////
 
 #include <cassert>
+#include <cstdlib>
+#include <cstring>
+#include <new>
+#include <set>
+
+#include <pthread.h>
+
+#include "tbb/atomic.h"
+#include "tbb/mutex.h"
 
 #include "IECore/RefCounted.h"
 
+#ifndef IECORE_POOLED_ALLOCATION_DEFAULT
+#define IECORE_POOLED_ALLOCATION_DEFAULT 0
+#endif
+
 namespace IECore {
 
+namespace
+{
+
+bool initPooledAllocation()
+{
+	const char *p = getenv( "IECORE_POOLED_ALLOCATION" );
+	if( p )
+	{
+		return strcmp( p, "0" ) != 0;
+	}
+	return IECORE_POOLED_ALLOCATION_DEFAULT;
+}
+
+// Pooled allocation serves small objects from per-thread free lists,
+// one for each 16 byte size class. Freed blocks are pushed onto the list
+// of the deallocating thread and reused by subsequent allocations on that
+// thread, with no locking at all. Each list has a maximum length beyond
+// which blocks are returned to the system allocator, so that memory freed
+// in bulk is not held onto indefinitely. Each thread also counts its own
+// allocations, and the counts are only summed when they are queried.
+
+const size_t g_sizeClassShift = 4;
+const size_t g_numSizeClasses = 16;
+const size_t g_maxPooledSize = g_numSizeClasses << g_sizeClassShift;
+const size_t g_maxFreeListLength = 1024;
+
+struct FreeBlock
+{
+	FreeBlock *next;
+};
+
+struct FreeLists;
+
+// Keeps track of the free lists of all live threads, so that their
+// allocation counts can be summed, along with the totals for threads
+// which have exited.
+struct Registry
+{
+
+	Registry()
+	{
+		numAllocations = 0;
+		numSystemAllocations = 0;
+	}
+
+	tbb::mutex mutex;
+	std::set<FreeLists *> freeLists;
+	size_t numAllocations;
+	size_t numSystemAllocations;
+
+};
+
+// Allocated on the heap and never destroyed, because threads
+// may exit after static destruction has taken place.
+Registry &registry()
+{
+	static Registry *r = new Registry;
+	return *r;
+}
+
+struct FreeLists
+{
+
+	FreeLists()
+	{
+		for( size_t i = 0; i < g_numSizeClasses; i++ )
+		{
+			heads[i] = 0;
+			lengths[i] = 0;
+		}
+		numAllocations = 0;
+		numSystemAllocations = 0;
+
+		Registry &r = registry();
+		tbb::mutex::scoped_lock lock( r.mutex );
+		r.freeLists.insert( this );
+	}
+
+	~FreeLists()
+	{
+		Registry &r = registry();
+		{
+			tbb::mutex::scoped_lock lock( r.mutex );
+			r.freeLists.erase( this );
+			r.numAllocations += numAllocations;
+			r.numSystemAllocations += numSystemAllocations;
+		}
+
+		for( size_t i = 0; i < g_numSizeClasses; i++ )
+		{
+			while( heads[i] )
+			{
+				FreeBlock *b = heads[i];
+				heads[i] = b->next;
+				free( b );
+			}
+		}
+	}
+
+	FreeBlock *heads[g_numSizeClasses];
+	size_t lengths[g_numSizeClasses];
+
+	// Only ever modified by the owning thread, so they are updated with
+	// a plain load and store rather than a locked increment. They are
+	// atomic so that other threads may read them safely.
+	tbb::atomic<size_t> numAllocations;
+	tbb::atomic<size_t> numSystemAllocations;
+
+};
+
+pthread_key_t g_freeListsKey;
+pthread_once_t g_freeListsKeyOnce = PTHREAD_ONCE_INIT;
+
+void destroyFreeLists( void *freeLists )
+{
+	delete static_cast<FreeLists *>( freeLists );
+}
+
+void createFreeListsKey()
+{
+	pthread_key_create( &g_freeListsKey, destroyFreeLists );
+}
+
+// We use pthread thread specific storage rather than a
+// tbb::enumerable_thread_specific, because the lookup is
+// significantly cheaper, and here it is performed for every
+// single allocation. It also destroys the lists of threads as
+// they exit, whereas enumerable_thread_specific would keep them
+// until its own destruction.
+FreeLists &freeLists()
+{
+	pthread_once( &g_freeListsKeyOnce, createFreeListsKey );
+	FreeLists *result = static_cast<FreeLists *>( pthread_getspecific( g_freeListsKey ) );
+	if( !result )
+	{
+		result = new FreeLists;
+		pthread_setspecific( g_freeListsKey, result );
+	}
+	return *result;
+}
+
+void *pooledAllocate( size_t size )
+{
+	FreeLists &lists = freeLists();
+	lists.numAllocations = lists.numAllocations + 1;
+
+	if( size == 0 || size > g_maxPooledSize )
+	{
+		lists.numSystemAllocations = lists.numSystemAllocations + 1;
+		return ::operator new( size );
+	}
+
+	const size_t sizeClass = ( size - 1 ) >> g_sizeClassShift;
+	FreeBlock *b = lists.heads[sizeClass];
+	if( b )
+	{
+		lists.heads[sizeClass] = b->next;
+		lists.lengths[sizeClass]--;
+		return b;
+	}
+
+	lists.numSystemAllocations = lists.numSystemAllocations + 1;
+	void *result = malloc( ( sizeClass + 1 ) << g_sizeClassShift );
+	if( !result )
+	{
+		throw std::bad_alloc();
+	}
+	return result;
+}
+
+void pooledDeallocate( void *p, size_t size )
+{
+	if( size == 0 || size > g_maxPooledSize )
+	{
+		::operator delete( p );
+		return;
+	}
+
+	const size_t sizeClass = ( size - 1 ) >> g_sizeClassShift;
+	FreeLists &lists = freeLists();
+	if( lists.lengths[sizeClass] >= g_maxFreeListLength )
+	{
+		free( p );
+		return;
+	}
+
+	FreeBlock *b = static_cast<FreeBlock *>( p );
+	b->next = lists.heads[sizeClass];
+	lists.heads[sizeClass] = b;
+	lists.lengths[sizeClass]++;
+}
+
+} // namespace
+
 RefCounted::RefCounted()
 {
 	m_numRefs = 0;
@@ -47,4 +254,70 @@ RefCounted::~RefCounted()
 {
 }
 
+bool RefCounted::pooledAllocation()
+{
+	// a function level static ensures that the choice is made
+	// before the first allocation, even when that happens during
+	// static initialisation, and that it can never change between
+	// the allocation and deallocation of an object.
+	static const bool pooled = initPooledAllocation();
+	return pooled;
+}
+
+size_t RefCounted::numAllocations()
+{
+	Registry &r = registry();
+	tbb::mutex::scoped_lock lock( r.mutex );
+	size_t result = r.numAllocations;
+	for( std::set<FreeLists *>::const_iterator it = r.freeLists.begin(); it != r.freeLists.end(); ++it )
+	{
+		result += (*it)->numAllocations;
+	}
+	return result;
+}
+
+size_t RefCounted::numSystemAllocations()
+{
+	Registry &r = registry();
+	tbb::mutex::scoped_lock lock( r.mutex );
+	size_t result = r.numSystemAllocations;
+	for( std::set<FreeLists *>::const_iterator it = r.freeLists.begin(); it != r.freeLists.end(); ++it )
+	{
+		result += (*it)->numSystemAllocations;
+	}
+	return result;
+}
+
+void *RefCounted::operator new( size_t size )
+{
+	if( pooledAllocation() )
+	{
+		return pooledAllocate( size );
+	}
+	return ::operator new( size );
+}
+
+void *RefCounted::operator new( size_t size, void *where )
+{
+	return where;
+}
+
+void RefCounted::operator delete( void *p, size_t size )
+{
+	if( !p )
+	{
+		return;
+	}
+	if( pooledAllocation() )
+	{
+		pooledDeallocate( p, size );
+		return;
+	}
+	::operator delete( p );
+}
+
+void RefCounted::operator delete( void *p, void *where )
+{
+}
+
 } // namespace IECore
@@ -32,19 +32,187 @@
 //
 //////////////////////////////////////////////////////////////////////////
 
-#include <cassert>
 
-#include "tbb/mutex.h"
+#include <cassert>
 
 #include "boost/format.hpp"
+#include "boost/shared_ptr.hpp"
+#include "boost/unordered_map.hpp"
 
 #include "IECore/RunTimeTyped.h"
 #include "IECore/MessageHandler.h"
 
 using namespace IECore;
 
-RunTimeTyped::Mutex RunTimeTyped::g_baseTypeIdsMutex;
-RunTimeTyped::Mutex RunTimeTyped::g_derivedTypeIdsMutex;
+//////////////////////////////////////////////////////////////////////////
+// TypeHierarchy
+//////////////////////////////////////////////////////////////////////////
+
+struct RunTimeTyped::TypeHierarchy
+{
+
+	typedef std::vector<TypeId> BaseTypeIds;
+	typedef std::set<TypeId> DerivedTypeIds;
+	typedef boost::shared_ptr<const BaseTypeIds> ConstBaseTypeIdsPtr;
+	typedef boost::shared_ptr<const DerivedTypeIds> ConstDerivedTypeIdsPtr;
+
+	struct Type
+	{
+		Type() : baseTypeId( InvalidTypeId ), name( "" ), begin( 0 ), end( 0 )
+		{
+		}
+
+		TypeId baseTypeId;
+		const char *name;
+		// The range of indices occupied by this type and its derived
+		// types in a preorder walk of the hierarchy, where the walk is
+		// numbered from 1 so that a 0 begin denotes an unreachable type.
+		// A type inherits from another exactly when its begin lies
+		// within the other's range.
+		size_t begin;
+		size_t end;
+		ConstBaseTypeIdsPtr baseTypeIds;
+		ConstDerivedTypeIdsPtr derivedTypeIds;
+	};
+
+	typedef boost::unordered_map<TypeId, Type> Types;
+	typedef boost::unordered_map<std::string, TypeId> Names;
+
+	// Must be called with g_registryMutex locked. The base and derived type
+	// lists of any type unaffected by registrations since the previous
+	// hierarchy are shared with it rather than copied.
+	TypeHierarchy( const TypeHierarchy *previous )
+		:	m_previous( previous )
+	{
+		const BaseTypeRegistryMap &baseRegistry = baseTypeRegistry();
+		const TypeIdsToTypeNamesMap &idsToNames = typeIdsToTypeNames();
+		const TypeNamesToTypeIdsMap &namesToIds = typeNamesToTypeIds();
+
+		for( TypeIdsToTypeNamesMap::const_iterator it = idsToNames.begin(); it != idsToNames.end(); ++it )
+		{
+			m_types[it->first].name = it->second.c_str();
+		}
+
+		m_names.insert( namesToIds.begin(), namesToIds.end() );
+
+		ChildrenMap children;
+		for( BaseTypeRegistryMap::const_iterator it = baseRegistry.begin(); it != baseRegistry.end(); ++it )
+		{
+			m_types[it->first].baseTypeId = it->second;
+			if( it->second != InvalidTypeId )
+			{
+				m_types[it->second];
+				children[it->second].push_back( it->first );
+			}
+		}
+
+		// Walk the hierarchy from each of its roots.
+		std::vector<TypeId> preorder;
+		BaseTypeIds bases;
+		for( Types::iterator it = m_types.begin(); it != m_types.end(); ++it )
+		{
+			if( it->second.baseTypeId == InvalidTypeId )
+			{
+				walk( it->first, children, bases, preorder );
+			}
+		}
+
+		for( Types::iterator it = m_types.begin(); it != m_types.end(); ++it )
+		{
+			Type &type = it->second;
+			if( !type.begin )
+			{
+				// Only reachable through a cycle in the registrations.
+				continue;
+			}
+
+			DerivedTypeIds derived( preorder.begin() + type.begin, preorder.begin() + type.end - 1 );
+			const Type *previousType = previous ? previous->find( it->first ) : 0;
+			if( previousType && previousType->derivedTypeIds && *previousType->derivedTypeIds == derived )
+			{
+				type.derivedTypeIds = previousType->derivedTypeIds;
+			}
+			else
+			{
+				type.derivedTypeIds.reset( new DerivedTypeIds( derived ) );
+			}
+		}
+	}
+
+	const Type *find( TypeId typeId ) const
+	{
+		Types::const_iterator it = m_types.find( typeId );
+		return it != m_types.end() ? &(it->second) : 0;
+	}
+
+	TypeId typeId( const char *typeName ) const
+	{
+		Names::const_iterator it = m_names.find( typeName );
+		return it != m_names.end() ? it->second : InvalidTypeId;
+	}
+
+	bool inheritsFrom( TypeId typeId, TypeId baseTypeId ) const
+	{
+		const Type *type = find( typeId );
+		const Type *baseType = find( baseTypeId );
+		if( !type || !baseType )
+		{
+			return false;
+		}
+		return baseType->begin < type->begin && type->begin < baseType->end;
+	}
+
+	private :
+
+		typedef std::map<TypeId, std::vector<TypeId> > ChildrenMap;
+
+		void walk( TypeId typeId, const ChildrenMap &children, BaseTypeIds &bases, std::vector<TypeId> &preorder )
+		{
+			Type &type = m_types[typeId];
+			preorder.push_back( typeId );
+			type.begin = preorder.size();
+
+			// Bases are ordered from the immediate base outwards.
+			BaseTypeIds typeBases( bases.rbegin(), bases.rend() );
+			const Type *previousType = m_previous ? m_previous->find( typeId ) : 0;
+			if( previousType && previousType->baseTypeIds && *previousType->baseTypeIds == typeBases )
+			{
+				type.baseTypeIds = previousType->baseTypeIds;
+			}
+			else
+			{
+				type.baseTypeIds.reset( new BaseTypeIds( typeBases ) );
+			}
+
+			ChildrenMap::const_iterator it = children.find( typeId );
+			if( it != children.end() )
+			{
+				bases.push_back( typeId );
+				for( std::vector<TypeId>::const_iterator cIt = it->second.begin(); cIt != it->second.end(); ++cIt )
+				{
+					walk( *cIt, children, bases, preorder );
+				}
+				bases.pop_back();
+			}
+
+			type.end = preorder.size() + 1;
+		}
+
+		Types m_types;
+		Names m_names;
+		// Hierarchies are never deleted, because references into them
+		// may be held by callers of baseTypeIds() and derivedTypeIds().
+		// Instead each one keeps the one it replaced.
+		const TypeHierarchy *m_previous;
+
+};
+
+//////////////////////////////////////////////////////////////////////////
+// RunTimeTyped
+//////////////////////////////////////////////////////////////////////////
+
+RunTimeTyped::Mutex RunTimeTyped::g_registryMutex;
+tbb::atomic<const RunTimeTyped::TypeHierarchy *> RunTimeTyped::g_typeHierarchy;
 
 RunTimeTyped::RunTimeTyped()
 {
@@ -108,19 +276,21 @@ bool RunTimeTyped::inheritsFrom( const char *typeName )
 
 bool RunTimeTyped::inheritsFrom( TypeId type, TypeId baseType )
 {
-	const std::vector<TypeId> &baseTypes = baseTypeIds( type );
-	return find( baseTypes.begin(), baseTypes.end(), baseType ) != baseTypes.end();
+	return typeHierarchy().inheritsFrom( type, baseType );
 }
 
 bool RunTimeTyped::inheritsFrom( const char *typeName, const char *baseTypeName )
 {
-	return inheritsFrom( typeIdFromTypeName( typeName ), typeIdFromTypeName( baseTypeName ) );
+	const TypeHierarchy &hierarchy = typeHierarchy();
+	return hierarchy.inheritsFrom( hierarchy.typeId( typeName ), hierarchy.typeId( baseTypeName ) );
 }
 		
 void RunTimeTyped::registerType( TypeId derivedTypeId, const char *derivedTypeName, TypeId baseTypeId )
 {
 	assert( derivedTypeName );
 
+	Mutex::scoped_lock lock( g_registryMutex, true );
+
 	{
 		BaseTypeRegistryMap &baseRegistry = baseTypeRegistry();
 		BaseTypeRegistryMap::iterator lb = baseRegistry.lower_bound( derivedTypeId );
@@ -138,10 +308,6 @@ void RunTimeTyped::registerType( TypeId derivedTypeId, const char *derivedTypeNa
 		}
 	}
 
-	/// Inserted derived type id into set of base classes derived type ids
-	DerivedTypesRegistryMap &derivedRegistry = derivedTypesRegistry();
-	derivedRegistry[ baseTypeId ].insert( derivedTypeId );
-
 	/// Put in id->name map
 	{
 		TypeIdsToTypeNamesMap &idsToNames = typeIdsToTypeNames();
@@ -157,7 +323,6 @@ void RunTimeTyped::registerType( TypeId derivedTypeId, const char *derivedTypeNa
 		{
 			/// Use the lower-bound as a hint for the position, yielding constant insert time
 			idsToNames.insert( lb, TypeIdsToTypeNamesMap::value_type( derivedTypeId, derivedTypeName ) );
-			assert( !strcmp( typeNameFromTypeId( derivedTypeId ), derivedTypeName ) );
 		}
 	}
 
@@ -176,9 +341,12 @@ void RunTimeTyped::registerType( TypeId derivedTypeId, const char *derivedTypeNa
 		{
 			/// Use the lower-bound as a hint for the position, yielding constant insert time
 			namesToIds.insert( lb, TypeNamesToTypeIdsMap::value_type( derivedTypeName, derivedTypeId ) );
-			assert( typeIdFromTypeName( derivedTypeName ) == derivedTypeId );
 		}
 	}
+
+	/// Withdraw the current hierarchy, so the next query builds one including the new type.
+	/// It isn't deleted, because other threads may still be using it.
+	g_typeHierarchy = 0;
 }
 
 RunTimeTyped::BaseTypeRegistryMap &RunTimeTyped::baseTypeRegistry()
@@ -189,133 +357,96 @@ RunTimeTyped::BaseTypeRegistryMap &RunTimeTyped::baseTypeRegistry()
 	return *registry;
 }
 
-RunTimeTyped::DerivedTypesRegistryMap &RunTimeTyped::derivedTypesRegistry()
+const RunTimeTyped::TypeHierarchy &RunTimeTyped::typeHierarchy()
 {
-	static DerivedTypesRegistryMap *registry = new DerivedTypesRegistryMap();
-
-	assert( registry );
-	return *registry;
-}
-
-TypeId RunTimeTyped::baseTypeId( TypeId typeId )
-{
-	BaseTypeRegistryMap &baseRegistry = baseTypeRegistry();
-	BaseTypeRegistryMap::const_iterator it = baseRegistry.find( typeId );
-
-	if ( it == baseRegistry.end() )
+	const TypeHierarchy *result = g_typeHierarchy;
+	if( result )
 	{
-		return InvalidTypeId;
+		return *result;
 	}
-	else
+
+	Mutex::scoped_lock lock( g_registryMutex, true );
+	result = g_typeHierarchy;
+	if( !result )
 	{
-		return it->second;
+		static const TypeHierarchy *g_previous = 0;
+		result = new TypeHierarchy( g_previous );
+		g_previous = result;
+		g_typeHierarchy = result;
 	}
+
+	return *result;
 }
 
+// The simple lookups below use the current hierarchy where there is one, but
+// don't build a new one, because they may be interleaved with many registrations
+// while types are being defined. In that case they use the registries directly.
 
-const std::vector<TypeId> &RunTimeTyped::baseTypeIds( TypeId typeId )
+TypeId RunTimeTyped::baseTypeId( TypeId typeId )
 {
-	Mutex::scoped_lock lock( g_baseTypeIdsMutex, false ); // read-only lock
-	BaseTypesRegistryMap &baseTypes = completeBaseTypesRegistry();
-
-	BaseTypesRegistryMap::iterator it = baseTypes.find( typeId );
-	if ( it != baseTypes.end() )
+	if( const TypeHierarchy *hierarchy = g_typeHierarchy )
 	{
-		return it->second;
-	}
-	
-	lock.upgrade_to_writer();
-	
-	baseTypes.insert( BaseTypesRegistryMap::value_type( typeId, std::vector<TypeId>() ) );
-	it = baseTypes.find( typeId );
-	assert( it != baseTypes.end() );
-
-	TypeId baseType = baseTypeId( typeId );
-	while ( baseType != InvalidTypeId )
-	{
-		it->second.push_back( baseType );
-		baseType = baseTypeId( baseType );
+		const TypeHierarchy::Type *type = hierarchy->find( typeId );
+		return type ? type->baseTypeId : InvalidTypeId;
 	}
 
-	return it->second;
+	Mutex::scoped_lock lock( g_registryMutex, false );
+	const BaseTypeRegistryMap &baseRegistry = baseTypeRegistry();
+	BaseTypeRegistryMap::const_iterator it = baseRegistry.find( typeId );
+	return it != baseRegistry.end() ? it->second : InvalidTypeId;
 }
 
-const std::set<TypeId> &RunTimeTyped::derivedTypeIds( TypeId typeId )
+const std::vector<TypeId> &RunTimeTyped::baseTypeIds( TypeId typeId )
 {
-	Mutex::scoped_lock lock( g_derivedTypeIdsMutex, false ); // read-only lock
-	DerivedTypesRegistryMap &derivedTypes = completeDerivedTypesRegistry();
-	DerivedTypesRegistryMap::iterator it = derivedTypes.find( typeId );
-
-	if ( it == derivedTypes.end() )
-	{	
-		lock.upgrade_to_writer();
-		derivedTypes.insert( DerivedTypesRegistryMap::value_type( typeId, std::set<TypeId>() ) );
-		it = derivedTypes.find( typeId );
-		assert( it != derivedTypes.end() );
-
-		// Walk over the hierarchy of derived types
-		derivedTypeIdsWalk( typeId, it->second );
+	const TypeHierarchy::Type *type = typeHierarchy().find( typeId );
+	if( type && type->baseTypeIds )
+	{
+		return *type->baseTypeIds;
 	}
 
-	return it->second;
+	static const std::vector<TypeId> g_empty;
+	return g_empty;
 }
 
-void RunTimeTyped::derivedTypeIdsWalk( TypeId typeId, std::set<TypeId> &typeIds )
+const std::set<TypeId> &RunTimeTyped::derivedTypeIds( TypeId typeId )
 {
-	DerivedTypesRegistryMap &derivedRegistry = derivedTypesRegistry();
-	DerivedTypesRegistryMap::const_iterator it = derivedRegistry.find( typeId );
-	if ( it == derivedRegistry.end() )
+	const TypeHierarchy::Type *type = typeHierarchy().find( typeId );
+	if( type && type->derivedTypeIds )
 	{
-		/// Termination condition: No derived types
-		return;
+		return *type->derivedTypeIds;
 	}
 
-	for ( std::set<TypeId>::const_iterator typesIt = it->second.begin(); typesIt != it->second.end(); ++ typesIt )
-	{
-		typeIds.insert( *typesIt );
-
-		// Recurse down into derived types
-		derivedTypeIdsWalk( *typesIt, typeIds );
-	}
-}
-
-RunTimeTyped::BaseTypesRegistryMap &RunTimeTyped::completeBaseTypesRegistry()
-{
-	static BaseTypesRegistryMap *baseTypes = new BaseTypesRegistryMap();
-	assert( baseTypes );
-	return *baseTypes;
-}
-
-RunTimeTyped::DerivedTypesRegistryMap &RunTimeTyped::completeDerivedTypesRegistry()
-{
-	static DerivedTypesRegistryMap *derivedTypes = new DerivedTypesRegistryMap();
-	assert( derivedTypes );
-	return *derivedTypes;
+	static const std::set<TypeId> g_empty;
+	return g_empty;
 }
 
 TypeId RunTimeTyped::typeIdFromTypeName( const char *typeName )
 {
 	assert( typeName );
 
-	TypeNamesToTypeIdsMap &namesToIds = typeNamesToTypeIds();
-	const std::string key( typeName );
-	TypeNamesToTypeIdsMap::const_iterator it = namesToIds.find( key );
-	if( it == namesToIds.end() )
+	if( const TypeHierarchy *hierarchy = g_typeHierarchy )
 	{
-		return InvalidTypeId;
+		return hierarchy->typeId( typeName );
 	}
-	return it->second;
+
+	Mutex::scoped_lock lock( g_registryMutex, false );
+	const TypeNamesToTypeIdsMap &namesToIds = typeNamesToTypeIds();
+	TypeNamesToTypeIdsMap::const_iterator it = namesToIds.find( typeName );
+	return it != namesToIds.end() ? it->second : InvalidTypeId;
 }
 
 const char *RunTimeTyped::typeNameFromTypeId( TypeId typeId )
 {
-	TypeIdsToTypeNamesMap &idsToNames = typeIdsToTypeNames();
-	TypeIdsToTypeNamesMap::const_iterator it = idsToNames.find( typeId );
-	if( it == idsToNames.end() )
+	if( const TypeHierarchy *hierarchy = g_typeHierarchy )
 	{
-		return "";
+		const TypeHierarchy::Type *type = hierarchy->find( typeId );
+		return type ? type->name : "";
 	}
-	return it->second.c_str();
+
+	Mutex::scoped_lock lock( g_registryMutex, false );
+	const TypeIdsToTypeNamesMap &idsToNames = typeIdsToTypeNames();
+	TypeIdsToTypeNamesMap::const_iterator it = idsToNames.find( typeId );
+	return it != idsToNames.end() ? it->second.c_str() : "";
 }
 
 RunTimeTyped::TypeIdsToTypeNamesMap &RunTimeTyped::typeIdsToTypeNames()
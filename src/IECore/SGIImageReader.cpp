@@ -90,7 +90,30 @@ struct SGIImageReader::Header
 	map< string, int > m_channelOffsets;
 };
 
-const Reader::ReaderDescription<SGIImageReader> SGIImageReader::m_readerDescription( "sgi rgb rgba bw" );
+static bool canReadMagic( const char *data, size_t size )
+{
+	if( size < sizeof( uint16_t ) )
+	{
+		return false;
+	}
+
+	uint16_t magic;
+	memcpy( &magic, data, sizeof( uint16_t ) );
+
+	/// SGI files are written big-endian. Nuke seems to support little-endian files, but this isn't in the spec.
+	if ( littleEndian() )
+	{
+		magic = reverseBytes( magic );
+	}
+	else
+	{
+		assert( bigEndian() );
+	}
+
+	return magic == 474;
+}
+
+const Reader::ReaderDescription<SGIImageReader> SGIImageReader::m_readerDescription( "sgi rgb rgba bw", canReadMagic, true );
 
 SGIImageReader::SGIImageReader() :
 		ImageReader( "Reads SGI RGB files." )
@@ -124,32 +147,9 @@ bool SGIImageReader::canRead( const string &fileName )
 	}
 
 	// check magic number
-	uint16_t magic;
-	in.read((char *) &magic, sizeof(uint16_t));
-	if ( in.fail() )
-	{
-		return false;
-	}
-
-	/// SGI files are written big-endian. Nuke seems to support little-endian files, but this isn't in the spec.
-	if ( littleEndian() )
-	{
-		if ( reverseBytes( magic ) == 474 )
-		{
-			return true;
-		}
-	}
-	else
-	{
-		assert( bigEndian() );
-
-		if ( magic == 474 )
-		{
-			return true;
-		}
-	}
-
-	return false;
+	char magic[sizeof(uint16_t)];
+	in.read( magic, sizeof(uint16_t) );
+	return canReadMagic( magic, in.gcount() );
 }
 
 void SGIImageReader::channelNames( vector<string> &names )
@@ -1115,7 +1115,7 @@ class SceneCache::WriterImplementation : public SceneCache::Implementation
 
 		IE_CORE_DECLAREPTR( WriterImplementation )
 
-		WriterImplementation( IndexedIOPtr io, Implementation *parent = 0) : SceneCache::Implementation( io ), m_parent(static_cast< WriterImplementation* >( parent ))
+		WriterImplementation( IndexedIOPtr io, Implementation *parent = 0) : SceneCache::Implementation( io ), m_parent(static_cast< WriterImplementation* >( parent )), m_packedObjects( false )
 		{
 			if ( m_parent )
 			{
@@ -1218,7 +1218,7 @@ class SceneCache::WriterImplementation : public SceneCache::Implementation
 			size_t sampleIndex = m_transformSampleTimes.size();
 			m_transformSampleTimes.push_back( time );
 			IndexedIOPtr io = m_indexedIO->subdirectory( transformEntry, IndexedIO::CreateIfMissing );
-			((const Object *)transform)->save( io, sampleEntry(sampleIndex) );
+			((const Object *)transform)->save( io, sampleEntry(sampleIndex), root()->m_packedObjects );
 			m_transformSamples.push_back( transform );
 		}
 
@@ -1244,7 +1244,7 @@ class SceneCache::WriterImplementation : public SceneCache::Implementation
 			sampleTimes.push_back( time );
 			IndexedIOPtr io = m_indexedIO->subdirectory( attributesEntry, IndexedIO::CreateIfMissing );
 			io = io->subdirectory( name, IndexedIO::CreateIfMissing );
-			attribute->save( io, sampleEntry(sampleIndex) );
+			attribute->save( io, sampleEntry(sampleIndex), root()->m_packedObjects );
 		}
 
 		void writeLocalTag( const char *tag )
@@ -1309,7 +1309,7 @@ class SceneCache::WriterImplementation : public SceneCache::Implementation
 			size_t sampleIndex = m_objectSampleTimes.size();
 			m_objectSampleTimes.push_back( time );
 			IndexedIOPtr io = m_indexedIO->subdirectory( objectEntry, IndexedIO::CreateIfMissing );
-			object->save( io, sampleEntry(sampleIndex) );
+			object->save( io, sampleEntry(sampleIndex), root()->m_packedObjects );
 			
 			const VisibleRenderable *renderable = runTimeCast< const VisibleRenderable >( object );
 			if ( renderable )
@@ -1422,6 +1422,16 @@ class SceneCache::WriterImplementation : public SceneCache::Implementation
 			return result;
 		}
 
+		void setPackedObjects( bool packed )
+		{
+			root()->m_packedObjects = packed;
+		}
+
+		bool getPackedObjects()
+		{
+			return root()->m_packedObjects;
+		}
+
 		static WriterImplementation *writer( Implementation *impl, bool throwException = true )
 		{
 			WriterImplementation *writer = dynamic_cast< WriterImplementation* >( impl );
@@ -1988,8 +1998,20 @@ class SceneCache::WriterImplementation : public SceneCache::Implementation
 			}
 		}
 
+		WriterImplementation *root()
+		{
+			WriterImplementation *result = this;
+			while( result->m_parent )
+			{
+				result = result->m_parent;
+			}
+			return result;
+		}
+
 		WriterImplementation* m_parent;
 		std::map< SceneCache::Name, WriterImplementationPtr > m_children;
+		// only used by the root location.
+		bool m_packedObjects;
 
 		typedef std::map< SampleTimes, uint64_t > SampleTimesMap;
 		typedef std::map< SceneCache::Name, SampleTimes > AttributeSamplesMap;
@@ -2416,3 +2438,15 @@ bool SceneCache::readOnly() const
 {
 	return dynamic_cast< const ReaderImplementation* >( m_implementation.get() ) != NULL;
 }
+
+void SceneCache::setPackedObjects( bool packed )
+{
+	WriterImplementation *writer = WriterImplementation::writer( m_implementation.get() );
+	writer->setPackedObjects( packed );
+}
+
+bool SceneCache::getPackedObjects() const
+{
+	WriterImplementation *writer = WriterImplementation::writer( m_implementation.get(), false );
+	return writer ? writer->getPackedObjects() : false;
+}
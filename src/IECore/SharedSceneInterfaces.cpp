@@ -32,6 +32,8 @@
 //
 //////////////////////////////////////////////////////////////////////////
 
+#include "tbb/atomic.h"
+
 #include "IECore/LRUCache.h"
 #include "IECore/SharedSceneInterfaces.h"
 
@@ -51,6 +53,11 @@ class SharedSceneInterfaces::Cache : public SceneLRUCache
 			: SceneLRUCache( fileCacheGetter, maxCost )
 		{
 		}
+
+		static size_t numLoads()
+		{
+			return m_numLoads;
+		}
 	
 	private :
 		
@@ -58,13 +65,18 @@ class SharedSceneInterfaces::Cache : public SceneLRUCache
 		{
 			SceneInterfacePtr result = SceneInterface::create( fileName, IECore::IndexedIO::Read );
 			cost = 1;
+			m_numLoads++;
 			return result;
 		}
+
+		static tbb::atomic<size_t> m_numLoads;
 };
 
+tbb::atomic<size_t> SharedSceneInterfaces::Cache::m_numLoads;
+
 SharedSceneInterfaces::Cache &SharedSceneInterfaces::cache()
 {
-	static Cache cache( 200 );
+	static Cache cache( 2000 );
 	return cache;
 }
 
@@ -86,3 +98,18 @@ void SharedSceneInterfaces::clear()
 {
 	cache().clear();
 }
+
+void SharedSceneInterfaces::setMaxScenes( size_t maxScenes )
+{
+	cache().setMaxCost( maxScenes );
+}
+
+size_t SharedSceneInterfaces::getMaxScenes()
+{
+	return cache().getMaxCost();
+}
+
+size_t SharedSceneInterfaces::numLoads()
+{
+	return Cache::numLoads();
+}
@@ -35,6 +35,9 @@
 #include <algorithm>
 #include <cassert>
 
+#include "tbb/parallel_for.h"
+#include "tbb/blocked_range.h"
+
 #include "IECore/SmoothSmoothSkinningWeightsOp.h"
 
 #include "IECore/CompoundObject.h"
@@ -109,6 +112,96 @@ SmoothSmoothSkinningWeightsOp::~SmoothSmoothSkinningWeightsOp()
 {
 }
 
+struct SmoothSmoothSkinningWeightsOp::SmoothWeights
+{
+	public :
+		
+		SmoothWeights( const std::vector<int64_t> &vertexIds, const std::vector<int> &neighbourOffsets, const std::vector<int> &neighbourCounts, const std::vector<int> &neighbours, const std::vector<int> &pointIndexOffsets, const std::vector<int> &pointInfluenceCounts, const std::vector<float> &pointInfluenceWeights, float smoothingRatio, std::vector<float> &smoothInfluenceWeights )
+			:	m_vertexIds( vertexIds ), m_neighbourOffsets( neighbourOffsets ), m_neighbourCounts( neighbourCounts ), m_neighbours( neighbours ), m_pointIndexOffsets( pointIndexOffsets ), m_pointInfluenceCounts( pointInfluenceCounts ), m_pointInfluenceWeights( pointInfluenceWeights ), m_smoothingRatio( smoothingRatio ), m_smoothInfluenceWeights( smoothInfluenceWeights )
+		{
+		}
+		
+		void operator()( const tbb::blocked_range<size_t> &r ) const
+		{
+			LinearInterpolator<float> lerp;
+			
+			for ( size_t i=r.begin(); i!=r.end(); ++i )
+			{
+				int currentVertId = m_vertexIds[i];
+				std::vector<int>::const_iterator neighbourFirst = m_neighbours.begin() + m_neighbourOffsets[currentVertId];
+				std::vector<int>::const_iterator neighbourLast = neighbourFirst + m_neighbourCounts[currentVertId];
+				float numNeighbours = m_neighbourCounts[currentVertId];
+				
+				for ( int j=0; j < m_pointInfluenceCounts[currentVertId]; j++ )
+				{
+					int current = m_pointIndexOffsets[currentVertId] + j;
+					
+					// calculate the average neighbour weight
+					float totalNeighbourWeight = 0.0f;
+					for ( std::vector<int>::const_iterator nIt = neighbourFirst; nIt != neighbourLast; ++nIt )
+					{
+						totalNeighbourWeight += m_pointInfluenceWeights[ m_pointIndexOffsets[*nIt] + j ];
+					}
+					float averageNeighbourWeight = totalNeighbourWeight / numNeighbours;
+					
+					lerp( m_pointInfluenceWeights[current], averageNeighbourWeight, m_smoothingRatio, m_smoothInfluenceWeights[current] );
+				}
+			}
+		}
+	
+	private :
+		
+		const std::vector<int64_t> &m_vertexIds;
+		const std::vector<int> &m_neighbourOffsets;
+		const std::vector<int> &m_neighbourCounts;
+		const std::vector<int> &m_neighbours;
+		const std::vector<int> &m_pointIndexOffsets;
+		const std::vector<int> &m_pointInfluenceCounts;
+		const std::vector<float> &m_pointInfluenceWeights;
+		float m_smoothingRatio;
+		std::vector<float> &m_smoothInfluenceWeights;
+		
+};
+
+struct SmoothSmoothSkinningWeightsOp::ApplyWeights
+{
+	public :
+		
+		ApplyWeights( const std::vector<int64_t> &vertexIds, const std::vector<int> &pointIndexOffsets, const std::vector<int> &pointInfluenceCounts, const std::vector<int> &pointInfluenceIndices, const std::vector<bool> &locks, const std::vector<float> &smoothInfluenceWeights, std::vector<float> &pointInfluenceWeights )
+			:	m_vertexIds( vertexIds ), m_pointIndexOffsets( pointIndexOffsets ), m_pointInfluenceCounts( pointInfluenceCounts ), m_pointInfluenceIndices( pointInfluenceIndices ), m_locks( locks ), m_smoothInfluenceWeights( smoothInfluenceWeights ), m_pointInfluenceWeights( pointInfluenceWeights )
+		{
+		}
+		
+		void operator()( const tbb::blocked_range<size_t> &r ) const
+		{
+			for ( size_t i=r.begin(); i!=r.end(); ++i )
+			{
+				int currentVertId = m_vertexIds[i];
+				
+				for ( int j=0; j < m_pointInfluenceCounts[currentVertId]; j++ )
+				{
+					int current = m_pointIndexOffsets[currentVertId] + j;
+					
+					if ( !m_locks[ m_pointInfluenceIndices[current] ] )
+					{
+						m_pointInfluenceWeights[current] = m_smoothInfluenceWeights[current];
+					}
+				}
+			}
+		}
+	
+	private :
+		
+		const std::vector<int64_t> &m_vertexIds;
+		const std::vector<int> &m_pointIndexOffsets;
+		const std::vector<int> &m_pointInfluenceCounts;
+		const std::vector<int> &m_pointInfluenceIndices;
+		const std::vector<bool> &m_locks;
+		const std::vector<float> &m_smoothInfluenceWeights;
+		std::vector<float> &m_pointInfluenceWeights;
+		
+};
+
 void SmoothSmoothSkinningWeightsOp::modify( Object * object, const CompoundObject * operands )
 {
 	SmoothSkinningData *skinningData = static_cast<SmoothSkinningData *>( object );
@@ -162,7 +255,7 @@ void SmoothSmoothSkinningWeightsOp::modify( Object * object, const CompoundObjec
 	// make sure all vertex ids are valid
 	for ( unsigned i=0; i < vertexIds.size(); i++ )
 	{
-		if ( vertexIds[i] > numSsdVerts )
+		if ( vertexIds[i] < 0 || vertexIds[i] >= numSsdVerts )
 		{
 			throw IECore::Exception( ( boost::format( "SmoothSmoothSkinningWeightsOp: VertexId \"%d\" is outside the range of the SmoothSkinningData and mesh" ) % vertexIds[i] ).str() );
 		}
@@ -177,50 +270,52 @@ void SmoothSmoothSkinningWeightsOp::modify( Object * object, const CompoundObjec
 		}
 	}
 	
-	// add the mesh vertices to the neighbourhood graph
+	// build compressed neighbour lists for the mesh vertices. each vertex is given space
+	// for every edge it is part of, and we record the number of unique neighbours
+	// actually found. neighbours are stored in the order they are first encountered.
 	/// \todo: consider moving this mesh connectivity graphing to the MeshPrimitive
-	Graph meshGraph;
+	const std::vector<int> &verticesPerFace = mesh->verticesPerFace()->readable();
+	unsigned numFaces = verticesPerFace.size();
+	
+	std::vector<int> neighbourOffsets( numMeshVerts + 1, 0 );
+	std::vector<int> neighbourCounts( numMeshVerts, 0 );
+	int v = 0;
+	for ( unsigned f=0; f < numFaces; f++ )
+	{
+		for ( int fv=0; fv < verticesPerFace[f]; fv++ )
+		{
+			// each face vertex is on two of the face's edges
+			neighbourOffsets[ meshVertexIds[v+fv] + 1 ] += 2;
+		}
+		v += verticesPerFace[f];
+	}
+	
 	for ( int i=0; i < numMeshVerts; i++ )
 	{
-		boost::add_vertex( meshGraph );
+		neighbourOffsets[i+1] += neighbourOffsets[i];
 	}
 	
-	// add the mesh edges to the neighbourhood graph
-	int v = 0, v1, v2;
-	const std::vector<int> &verticesPerFace = mesh->verticesPerFace()->readable();
-	unsigned numFaces = verticesPerFace.size();
+	std::vector<int> neighbours( neighbourOffsets[numMeshVerts] );
+	v = 0;
 	for ( unsigned f=0; f < numFaces; f++ )
 	{
-		for ( int fv=0; fv < verticesPerFace[f] - 1; fv++ )
+		for ( int fv=0; fv < verticesPerFace[f]; fv++ )
 		{
-			v1 = meshVertexIds[v+fv];
-			v2 = meshVertexIds[v+fv+1];
+			int v1 = meshVertexIds[v+fv];
+			int v2 = meshVertexIds[ fv < verticesPerFace[f] - 1 ? v+fv+1 : v ];
 			
-			Vertex source = boost::vertex( v1, meshGraph );
-			Vertex target = boost::vertex( v2, meshGraph );
-			if ( !boost::edge( source, target, meshGraph ).second )
+			std::vector<int>::iterator first = neighbours.begin() + neighbourOffsets[v1];
+			std::vector<int>::iterator last = first + neighbourCounts[v1];
+			if ( std::find( first, last, v2 ) == last )
 			{
-				boost::add_edge( source, target, meshGraph );
+				neighbours[ neighbourOffsets[v1] + neighbourCounts[v1]++ ] = v2;
+				neighbours[ neighbourOffsets[v2] + neighbourCounts[v2]++ ] = v1;
 			}
 		}
-		
-		v1 = meshVertexIds[v + verticesPerFace[f] - 1];
-		v2 = meshVertexIds[v];
-		Vertex source = boost::vertex( v1, meshGraph );
-		Vertex target = boost::vertex( v2, meshGraph );
-		if ( !boost::edge( source, target, meshGraph ).second )
-		{
-			boost::add_edge( source, target, meshGraph );
-		}
-		
 		v += verticesPerFace[f];
 	}
 	
-	// get the property map that relates each Graph Vertex to a vertexId
-	VertexIdMap vertexIdMap = boost::get( boost::vertex_index, meshGraph );
-	
 	std::vector<float> smoothInfluenceWeights( skinningData->pointInfluenceWeights()->readable().size(), 0.0f );
-	LinearInterpolator<float> lerp;
 	float smoothingRatio = m_smoothingRatioParameter->getNumericValue();
 	int numIterations = m_iterationsParameter->getNumericValue();
 	
@@ -229,50 +324,18 @@ void SmoothSmoothSkinningWeightsOp::modify( Object * object, const CompoundObjec
 	normalizeOp.parameters()->setParameterValue( "applyLocks", m_useLocksParameter->getValue() );
 	normalizeOp.parameters()->setParameterValue( "influenceLocks", m_influenceLocksParameter->getValue() );
 	
+	SmoothWeights smoothWeights( vertexIds, neighbourOffsets, neighbourCounts, neighbours, pointIndexOffsets, pointInfluenceCounts, pointInfluenceWeights, smoothingRatio, smoothInfluenceWeights );
+	ApplyWeights applyWeights( vertexIds, pointIndexOffsets, pointInfluenceCounts, pointInfluenceIndices, locks, smoothInfluenceWeights, pointInfluenceWeights );
+	
 	// iterate
 	for ( int iteration=0; iteration < numIterations; iteration++ )
 	{
-		// smooth the weights
-		for ( unsigned i=0; i < vertexIds.size(); i++ )
-		{
-			int currentVertId = vertexIds[i];
-			Vertex currentVert = boost::vertex( currentVertId, meshGraph );
-			NeighbourIteratorRange neighbourhood = boost::adjacent_vertices( currentVert, meshGraph );
-			float numNeighbours = boost::out_degree( currentVert, meshGraph );
-			
-			for ( int j=0; j < pointInfluenceCounts[currentVertId]; j++ )
-			{
-				int current = pointIndexOffsets[currentVertId] + j;
-				
-				// calculate the average neighbour weight
-				float totalNeighbourWeight = 0.0f;
-				for( NeighbourIterator nIt = neighbourhood.first; nIt != neighbourhood.second; nIt++ )
-				{
-					int neighbourId = vertexIdMap[*nIt];					
-					float currentNeighbourWeight = pointInfluenceWeights[ pointIndexOffsets[neighbourId] + j ];
-					totalNeighbourWeight += currentNeighbourWeight;
-				}
-				float averageNeighbourWeight = totalNeighbourWeight / numNeighbours;
-				
-				lerp( pointInfluenceWeights[current], averageNeighbourWeight, smoothingRatio, smoothInfluenceWeights[current] );
-			}
-		}
+		// smooth the weights. the smoothed values are written to a separate
+		// buffer, so all vertices can be processed in parallel.
+		tbb::parallel_for( tbb::blocked_range<size_t>( 0, vertexIds.size() ), smoothWeights );
 		
 		// apply the per-influence locks
-		for ( unsigned i=0; i < vertexIds.size(); i++ )
-		{
-			int currentVertId = vertexIds[i];
-
-			for ( int j=0; j < pointInfluenceCounts[currentVertId]; j++ )
-			{
-				int current = pointIndexOffsets[currentVertId] + j;
-
-				if ( !locks[ pointInfluenceIndices[current] ] )
-				{
-					pointInfluenceWeights[current] = smoothInfluenceWeights[current];
-				}
-			}
-		}
+		tbb::parallel_for( tbb::blocked_range<size_t>( 0, vertexIds.size() ), applyWeights );
 		
 		// normalize
 		normalizeOp.inputParameter()->setValidatedValue( skinningData );
@@ -2000,7 +2000,7 @@ void StreamIndexedIO::Index::lockDirectory( MutexLock &lock, const DirectoryNode
 //
 ///////////////////////////////////////////////
 
-StreamIndexedIO::StreamFile::StreamFile( IndexedIO::OpenMode mode ) : m_openmode(mode), m_stream(0), m_ioBufferLen(0), m_ioBuffer(0)
+StreamIndexedIO::StreamFile::StreamFile( IndexedIO::OpenMode mode ) : m_openmode(mode), m_stream(0), m_accessed(false)
 {
 	IndexedIO::validateOpenMode(m_openmode);
 }
@@ -2011,10 +2011,6 @@ StreamIndexedIO::StreamFile::~StreamFile()
 	{
 		delete m_stream;
 	}
-	if ( m_ioBuffer )
-	{
-		delete [] m_ioBuffer;
-	}
 }
 
 IndexedIO::OpenMode StreamIndexedIO::StreamFile::openMode() const
@@ -2031,20 +2027,29 @@ void StreamIndexedIO::StreamFile::setStream( std::iostream *stream, bool emptyFi
 	}
 }
 
+void StreamIndexedIO::StreamFile::closeStream()
+{
+	assert( m_openmode & IndexedIO::Read );
+	delete m_stream;
+	m_stream = 0;
+}
+
+void StreamIndexedIO::StreamFile::reopenStream()
+{
+	throw IOException( "StreamIndexedIO: Stream has been closed" );
+}
+
 char *StreamIndexedIO::StreamFile::ioBuffer( unsigned long size )
 {
-	if ( !m_ioBuffer )
-	{
-		m_ioBuffer = new char[size];
-		m_ioBufferLen = size;
-	}
-	else if ( size > m_ioBufferLen )
+	if ( m_ioBuffer.empty() || size > m_ioBuffer.size() )
 	{
-		delete [] m_ioBuffer;
-		m_ioBuffer = new char[size];
-		m_ioBufferLen = size;
+		// the old contents aren't needed, so are cleared to avoid
+		// copying them into the new storage. the new elements are
+		// left uninitialised by AlignedAllocator.
+		m_ioBuffer.clear();
+		m_ioBuffer.resize( std::max( size, 1ul ) );
 	}
-	return m_ioBuffer;
+	return &m_ioBuffer[0];
 }
 
 StreamIndexedIO::StreamFile::Mutex & StreamIndexedIO::StreamFile::mutex()
@@ -2080,6 +2085,11 @@ bool StreamIndexedIO::StreamFile::canRead( std::iostream &f )
 
 void StreamIndexedIO::StreamFile::seekg( size_t pos, std::ios_base::seekdir dir )
 {
+	if( !m_stream )
+	{
+		reopenStream();
+	}
+	m_accessed = true;
 	m_stream->seekg( pos, dir );
 }
 
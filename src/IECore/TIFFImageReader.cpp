@@ -64,7 +64,19 @@ using namespace std;
 
 IE_CORE_DEFINERUNTIMETYPED( TIFFImageReader );
 
-const Reader::ReaderDescription<TIFFImageReader> TIFFImageReader::m_readerDescription("tiff tif tdl");
+static bool canReadMagic( const char *data, size_t size )
+{
+	if( size < sizeof( unsigned int ) )
+	{
+		return false;
+	}
+	unsigned int magic;
+	memcpy( &magic, data, sizeof( unsigned int ) );
+	return magic == 0x002a4949 || magic == reverseBytes<unsigned int>(0x002a4949)
+		|| magic == 0x4d4d002a || magic == reverseBytes<unsigned int>(0x4d4d002a);
+}
+
+const Reader::ReaderDescription<TIFFImageReader> TIFFImageReader::m_readerDescription( "tiff tif tdl", canReadMagic, true );
 
 TIFFImageReader::TIFFImageReader()
 		:	ImageReader( "Reads Tagged Image File Format (TIFF) files" ),
@@ -103,21 +115,9 @@ bool TIFFImageReader::canRead( const string &fileName )
 	{
 		return false;
 	}
-	unsigned int magic;
-	in.read((char *) &magic, sizeof(unsigned int));
-	if ( in.fail() )
-	{
-		return false;
-	}
-
-	in.seekg( 0, ios_base::beg );
-	if ( in.fail() )
-	{
-		return false;
-	}
-
-	return magic == 0x002a4949 || magic == reverseBytes<unsigned int>(0x002a4949)
-		|| magic == 0x4d4d002a || magic == reverseBytes<unsigned int>(0x4d4d002a) ;
+	char magic[sizeof(unsigned int)];
+	in.read( magic, sizeof(unsigned int) );
+	return canReadMagic( magic, in.gcount() );
 }
 
 void TIFFImageReader::channelNames( vector<string> &names )
@@ -180,7 +180,13 @@ bool TIFFImageReader::isComplete()
 		/// compression methods support random access to the image data.
 		ScopedTIFFErrorHandler errorHandler;
 
-		readBuffer();
+		// we decode every block directly rather than using the cache,
+		// so that we see any errors.
+		const unsigned int numBlocks = TIFFIsTiled( m_tiffImage ) ? TIFFNumberOfTiles( m_tiffImage ) : TIFFNumberOfStrips( m_tiffImage );
+		for ( unsigned int i = 0; i < numBlocks; ++i )
+		{
+			decodeBlock( i );
+		}
 
 		return !errorHandler.hasError();
 	}
@@ -310,27 +316,52 @@ DataPtr TIFFImageReader::readTypedChannel( const std::string &name, const Box2i
 	assert( area >= 0 );
 	data.resize( area );
 
-	int dataWidth = 1 + dataWindow.size().x;
-	int bufferDataWidth = 1 + m_dataWindow.size().x;
+	// \todo Currently, we only support PLANARCONFIG_CONTIG for TIFFTAG_PLANARCONFIG.
+	assert( m_planarConfig ==  PLANARCONFIG_CONTIG );
+
+	const bool tiled = TIFFIsTiled( m_tiffImage );
+	int blockWidth, blockHeight;
+	blockSize( blockWidth, blockHeight );
+
+	const size_t pixelSize = m_bitsPerSample / 8 * m_samplesPerPixel;
+
+	// Only the blocks overlapping the data window are decoded. We hold on to
+	// them for the duration of the read, in case they are evicted from the cache.
+	std::vector<ConstUCharVectorDataPtr> blocks( tiled ? TIFFNumberOfTiles( m_tiffImage ) : TIFFNumberOfStrips( m_tiffImage ) );
 
 	ScaledDataConversion<T, V> converter;
 
-	int dataY = 0;
-	for ( int y = dataWindow.min.y - m_dataWindow.min.y ; y <= dataWindow.max.y - m_dataWindow.min.y ; ++y, ++dataY )
-	{
-		int dataX = 0;
+	const int xMin = dataWindow.min.x - m_dataWindow.min.x;
+	const int xMax = dataWindow.max.x - m_dataWindow.min.x;
 
-		for ( int x = dataWindow.min.x - m_dataWindow.min.x;  x <= dataWindow.max.x - m_dataWindow.min.x ; ++x, ++dataX  )
+	typename TargetVector::ValueType::size_type dataOffset = 0;
+	for ( int y = dataWindow.min.y - m_dataWindow.min.y ; y <= dataWindow.max.y - m_dataWindow.min.y ; ++y )
+	{
+		int x = xMin;
+		while( x <= xMax )
 		{
-			const T* buf = reinterpret_cast< T* >( & m_buffer[0] );
-			assert( buf );
+			// find the block containing this pixel, and the span
+			// of pixels in the row which lie within it.
+			const unsigned int blockIndex = tiled ? TIFFComputeTile( m_tiffImage, x, y, 0, 0 ) : TIFFComputeStrip( m_tiffImage, y, 0 );
+			assert( blockIndex < blocks.size() );
+			if( !blocks[blockIndex] )
+			{
+				blocks[blockIndex] = boost::static_pointer_cast<const UCharVectorData>( block( blockIndex ) );
+			}
 
-			// \todo Currently, we only support PLANARCONFIG_CONTIG for TIFFTAG_PLANARCONFIG.
-			assert( m_planarConfig ==  PLANARCONFIG_CONTIG );
-			typename TargetVector::ValueType::size_type dataOffset = dataY * dataWidth + dataX;
-			assert( dataOffset < data.size() );
+			const int blockX = x % blockWidth;
+			const int blockY = y % blockHeight;
+			const int spanEnd = std::min( xMax, x - blockX + blockWidth - 1 );
 
-			data[dataOffset] = converter( buf[ m_samplesPerPixel * ( y * bufferDataWidth + x ) + channelOffset ] );
+			const size_t blockOffset = ( blockY * blockWidth + blockX ) * pixelSize;
+			assert( blockOffset < blocks[blockIndex]->readable().size() );
+			const T *buf = reinterpret_cast<const T *>( &(blocks[blockIndex]->readable()[0]) + blockOffset ) + channelOffset;
+
+			for( ; x <= spanEnd; ++x, ++dataOffset, buf += m_samplesPerPixel )
+			{
+				assert( dataOffset < data.size() );
+				data[dataOffset] = converter( *buf );
+			}
 		}
 	}
 
@@ -341,11 +372,6 @@ DataPtr TIFFImageReader::readChannel( const std::string &name, const Imath::Box2
 {
 	readCurrentDirectory( true );
 
-	if ( m_buffer.size() == 0 )
-	{
-		readBuffer();
-	}
-
 	if ( m_sampleFormat == SAMPLEFORMAT_IEEEFP )
 	{
 		return readTypedChannel<float, float>( name, dataWindow );
@@ -408,99 +434,59 @@ DataPtr TIFFImageReader::readChannel( const std::string &name, const Imath::Box2
 	}
 }
 
-void TIFFImageReader::readBuffer()
+void TIFFImageReader::blockSize( int &width, int &height )
 {
 	assert( m_tiffImage );
 	assert( m_haveDirectory );
 
-	int width = boxSize( m_dataWindow ).x + 1;
-	int height = boxSize( m_dataWindow ).y + 1;
-
-	// \todo Currently, we only support PLANARCONFIG_CONTIG for TIFFTAG_PLANARCONFIG.
-	assert( m_planarConfig ==  PLANARCONFIG_CONTIG );
-	std::vector<unsigned char>::size_type bufLineSize = (size_t)( (float)m_bitsPerSample / 8 * m_samplesPerPixel * width );
-	std::vector<unsigned char>::size_type bufSize = bufLineSize * height;
-	assert( bufSize );
-	m_buffer.resize( bufSize, 0 );
-
 	if ( TIFFIsTiled( m_tiffImage ) )
 	{
-		tsize_t tileSize = TIFFTileSize( m_tiffImage );
-		ttile_t numTiles = TIFFNumberOfTiles( m_tiffImage );
-
-		/// Create a buffer to hold an individual tile
-		int tileWidth = tiffField<uint32>( TIFFTAG_TILEWIDTH );
-		if ( tileWidth == 0 )
+		width = tiffField<uint32>( TIFFTAG_TILEWIDTH );
+		if ( width == 0 )
 		{
-			throw IOException( ( boost::format("TIFFImageReader: Unsupported value (%d) for TIFFTAG_TILEWIDTH while reading %s") % tileWidth % fileName() ).str() );
+			throw IOException( ( boost::format("TIFFImageReader: Unsupported value (%d) for TIFFTAG_TILEWIDTH while reading %s") % width % fileName() ).str() );
 		}
 
-		int tileLength = tiffField<uint32>( TIFFTAG_TILELENGTH );
-		if ( tileLength == 0 )
+		height = tiffField<uint32>( TIFFTAG_TILELENGTH );
+		if ( height == 0 )
 		{
-			throw IOException( ( boost::format("TIFFImageReader: Unsupported value (%d) for TIFFTAG_TILELENGTH while reading %s") % tileLength % fileName() ).str() );
+			throw IOException( ( boost::format("TIFFImageReader: Unsupported value (%d) for TIFFTAG_TILELENGTH while reading %s") % height % fileName() ).str() );
 		}
+	}
+	else
+	{
+		const uint32 imageHeight = boxSize( m_dataWindow ).y + 1;
+		width = boxSize( m_dataWindow ).x + 1;
+		height = std::min( tiffFieldDefaulted<uint32>( TIFFTAG_ROWSPERSTRIP ), imageHeight );
+	}
+}
 
-		std::vector<unsigned char>::size_type pixelSize = (size_t)( (float)m_bitsPerSample / 8 * m_samplesPerPixel );
-		std::vector<unsigned char>::size_type tileLineSize = pixelSize * tileWidth;
-		std::vector<unsigned char>::size_type tileBufSize = tileLineSize * tileLength;
-		std::vector<unsigned char> tileBuffer;
-		tileBuffer.resize( tileBufSize, 0 );
+DataPtr TIFFImageReader::decodeBlock( unsigned int blockIndex )
+{
+	assert( m_tiffImage );
+	assert( m_haveDirectory );
 
-		int x = 0;
-		int y = 0;
+	UCharVectorDataPtr result = new UCharVectorData;
+	std::vector<unsigned char> &buffer = result->writable();
 
-		/// Read each tile
-		for ( ttile_t tile = 0; tile < numTiles; tile++ )
+	if ( TIFFIsTiled( m_tiffImage ) )
+	{
+		buffer.resize( TIFFTileSize( m_tiffImage ), 0 );
+		if ( TIFFReadEncodedTile( m_tiffImage, blockIndex, &buffer[0], buffer.size() ) == -1 )
 		{
-			tsize_t imageOffset = y * bufLineSize + x * ( bufLineSize / width );
-			int result = TIFFReadEncodedTile( m_tiffImage, tile, &tileBuffer[0], tileSize );
-
-			if ( result == -1 )
-			{
-				throw IOException( (boost::format( "TIFFImageReader: Error on tile number %d while reading %s") % tile % fileName() ).str() );
-			}
-
-			/// Copy the tile into its rightful place in the image buffer.
-			/// We have to be careful here as the image might not be an exact
-			/// multiple of tiles, in which case we can't copy the tiles round the
-			/// edges in their entirety as that would give us buffer overruns.
-			int rowsToCopy = min( tileLength, height - y );
-			int columnsToCopy = min( (int)tileWidth, width - x );
-			tsize_t tileOffset = 0;
-			for ( int l = 0; l < rowsToCopy; l ++)
-			{
-				memcpy( &m_buffer[0] + imageOffset, &tileBuffer[0] + tileOffset, pixelSize * columnsToCopy );
-				imageOffset += bufLineSize;
-				tileOffset += tileLineSize;
-			}
-
-			x = x + tileWidth;
-
-			if ( x >= width )
-			{
-				x = 0;
-				y += tileLength;
-			}
+			throw IOException( (boost::format( "TIFFImageReader: Error on tile number %d while reading %s") % blockIndex % fileName() ).str() );
 		}
 	}
 	else
 	{
-		tsize_t stripSize = TIFFStripSize( m_tiffImage );
-		tsize_t imageOffset = 0;
-		tstrip_t numStrips = TIFFNumberOfStrips( m_tiffImage );
-		for ( tstrip_t strip = 0; strip < numStrips; strip++ )
+		buffer.resize( TIFFStripSize( m_tiffImage ), 0 );
+		if ( TIFFReadEncodedStrip( m_tiffImage, blockIndex, &buffer[0], buffer.size() ) == -1 )
 		{
-			tsize_t result = TIFFReadEncodedStrip( m_tiffImage, strip, &m_buffer[0] + imageOffset, stripSize );
-
-			if ( result == -1 )
-			{
-				throw IOException( (boost::format( "TIFFImageReader: Error on strip number %d while reading %s") % strip % fileName() ).str() );
-			}
-
-			imageOffset += result;
+			throw IOException( (boost::format( "TIFFImageReader: Error on strip number %d while reading %s") % blockIndex % fileName() ).str() );
 		}
 	}
+
+	return result;
 }
 
 bool TIFFImageReader::open( bool throwOnFailure )
@@ -515,7 +501,6 @@ bool TIFFImageReader::open( bool throwOnFailure )
 		{
 			TIFFClose( m_tiffImage );
 			m_tiffImage = 0;
-			m_buffer.clear();
 		}
 	}
 
@@ -566,6 +551,7 @@ bool TIFFImageReader::open( bool throwOnFailure )
 
 	assert( m_tiffImage );
 	m_tiffImageFileName = fileName();
+	m_haveDirectory = false;
 	
 	return true;
 }
@@ -602,8 +588,6 @@ bool TIFFImageReader::readCurrentDirectory( bool throwOnFailure )
 			}
 		}
 
-		m_buffer.clear();
-
 		int width = tiffField<uint32>( TIFFTAG_IMAGEWIDTH );
 		if ( width == 0 )
 		{
@@ -695,6 +679,8 @@ bool TIFFImageReader::readCurrentDirectory( bool throwOnFailure )
 		errorHandler.throwIfError();
 
 		m_haveDirectory = true;
+		// blocks are decoded from the current directory only
+		blockSourceChanged( MurmurHash().append( m_currentDirectoryIndex ) );
 	}
 	catch ( ... )
 	{
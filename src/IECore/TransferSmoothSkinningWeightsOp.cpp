@@ -35,6 +35,9 @@
 #include <algorithm>
 #include <cassert>
 
+#include "tbb/parallel_for.h"
+#include "tbb/blocked_range.h"
+
 #include "IECore/TransferSmoothSkinningWeightsOp.h"
 
 #include "IECore/CompoundObject.h"
@@ -75,6 +78,54 @@ TransferSmoothSkinningWeightsOp::~TransferSmoothSkinningWeightsOp()
 {
 }
 
+struct TransferSmoothSkinningWeightsOp::TransferWeights
+{
+	public :
+		
+		TransferWeights( const std::vector<int> &pointIndexOffsets, const std::vector<int> &pointInfluenceCounts, const std::vector<int> &pointInfluenceIndices, int targetIndex, const std::vector<bool> &isSource, std::vector<float> &pointInfluenceWeights )
+			:	m_pointIndexOffsets( pointIndexOffsets ), m_pointInfluenceCounts( pointInfluenceCounts ), m_pointInfluenceIndices( pointInfluenceIndices ), m_targetIndex( targetIndex ), m_isSource( isSource ), m_pointInfluenceWeights( pointInfluenceWeights )
+		{
+		}
+		
+		void operator()( const tbb::blocked_range<size_t> &r ) const
+		{
+			for ( size_t i=r.begin(); i!=r.end(); ++i )
+			{
+				float targetWeight = 0.0;
+				int targetCurrentIndex = 0;
+				
+				for ( int j=0; j < m_pointInfluenceCounts[i]; j++ )
+				{
+					int current = m_pointIndexOffsets[i] + j;
+					int index = m_pointInfluenceIndices[current];
+					float weight = m_pointInfluenceWeights[current];
+					
+					if( index == m_targetIndex )
+					{
+						targetWeight += weight;
+						targetCurrentIndex = current;
+					}
+					else if ( m_isSource[index] )
+					{
+						targetWeight += weight;
+						m_pointInfluenceWeights[ current ] = 0.0;
+					}
+				}
+				m_pointInfluenceWeights[ targetCurrentIndex ] = targetWeight;
+			}
+		}
+	
+	private :
+		
+		const std::vector<int> &m_pointIndexOffsets;
+		const std::vector<int> &m_pointInfluenceCounts;
+		const std::vector<int> &m_pointInfluenceIndices;
+		int m_targetIndex;
+		const std::vector<bool> &m_isSource;
+		std::vector<float> &m_pointInfluenceWeights;
+		
+};
+
 void TransferSmoothSkinningWeightsOp::modify( Object * object, const CompoundObject * operands )
 {
 	SmoothSkinningData *skinningData = static_cast<SmoothSkinningData *>( object );
@@ -126,35 +177,18 @@ void TransferSmoothSkinningWeightsOp::modify( Object * object, const CompoundObj
 	const std::vector<int> &pointInfluenceIndices = skinningData->pointInfluenceIndices()->readable();
 	std::vector<float> &pointInfluenceWeights = skinningData->pointInfluenceWeights()->writable();
 	
-	for ( unsigned i=0; i < pointIndexOffsets.size(); i++ )
+	// a per-influence lookup is faster than searching sourceIndices for every weight
+	std::vector<bool> isSource( influenceNames.size(), false );
+	for ( unsigned i=0; i < sourceIndices.size(); i++ )
 	{
-		float targetWeight = 0.0;
-		int targetCurrentIndex = 0;
-		
-		for ( int j=0; j < pointInfluenceCounts[i]; j++ )
-		{
-			int current = pointIndexOffsets[i] + j;
-			int index = pointInfluenceIndices[current];
-			float weight = pointInfluenceWeights[current];
-			
-			if( index == targetIndex )
-			{
-				targetWeight += weight;
-				targetCurrentIndex = current;
-			}
-			else
-			{
-				const std::vector<int>::const_iterator found = find( sourceIndices.begin(), sourceIndices.end(), index );
-				if ( found != sourceIndices.end() )
-				{
-					targetWeight += weight;
-					pointInfluenceWeights[ current ] = 0.0;
-				}
-			}
-		}
-		pointInfluenceWeights[ targetCurrentIndex ] = targetWeight;
+		isSource[ sourceIndices[i] ] = true;
 	}
 	
+	tbb::parallel_for(
+		tbb::blocked_range<size_t>( 0, pointIndexOffsets.size() ),
+		TransferWeights( pointIndexOffsets, pointInfluenceCounts, pointInfluenceIndices, targetIndex, isSource, pointInfluenceWeights )
+	);
+	
 	// re-compress
 	CompressSmoothSkinningDataOpPtr compressionOp = new CompressSmoothSkinningDataOp;
 	compressionOp->inputParameter()->setValidatedValue( skinningData );
@@ -32,6 +32,11 @@
 //
 //////////////////////////////////////////////////////////////////////////
 
+#include "boost/utility/enable_if.hpp"
+#include "boost/type_traits/is_same.hpp"
+
+#include "tbb/tbb.h"
+
 #include "IECore/CompoundObject.h"
 #include "IECore/MeshPrimitive.h"
 #include "IECore/TriangulateOp.h"
@@ -55,7 +60,7 @@ TriangulateOp::TriangulateOp() : MeshPrimitiveOp( "A MeshPrimitiveOp to triangul
 
 	m_throwExceptionsParameter = new BoolParameter(
 		"throwExceptions",
-		"When enabled, exceptions are thrown when invalid geometry is encountered (e.g. non-planar or concave faces).",
+		"When enabled, exceptions are thrown when invalid geometry is encountered (e.g. non-planar faces).",
 		true
 	);
 
@@ -88,216 +93,373 @@ const BoolParameter * TriangulateOp::throwExceptionsParameter() const
 	return m_throwExceptionsParameter.get();
 }
 
-/// A functor for use with despatchTypedData, which copies elements from another vector, as specified by an array of indices into that data
+/// A functor for use with despatchTypedData, which creates a new vector from the elements of another, as specified by an array of indices into that data
 struct TriangleDataRemap
 {
-	typedef size_t ReturnType;
+	typedef DataPtr ReturnType;
 
-	TriangleDataRemap( const std::vector<int> &indices ) : m_other(0), m_indices( indices )
+	TriangleDataRemap( const std::vector<int> &indices ) : m_indices( indices )
 	{
 	}
 
-	const Data * m_other;
 	const std::vector<int> &m_indices;
 
 	template<typename T>
-	size_t operator() ( T * data )
+	class Remap
+	{
+		public :
+
+			Remap( const typename T::ValueType &src, typename T::ValueType &dst, const std::vector<int> &indices )
+				:	m_src( src ), m_dst( dst ), m_indices( indices )
+			{
+			}
+
+			void operator()( const tbb::blocked_range<size_t> &r ) const
+			{
+				for( size_t i = r.begin(); i != r.end(); ++i )
+				{
+					m_dst[i] = m_src[ m_indices[i] ];
+				}
+			}
+
+		private :
+
+			const typename T::ValueType &m_src;
+			typename T::ValueType &m_dst;
+			const std::vector<int> &m_indices;
+
+	};
+
+	template<typename T>
+	DataPtr operator() ( const T * data )
 	{
 		assert( data );
-		typename T::ValueType &dataWritable = data->writable();
-		
-		const T * otherData = runTimeCast<const T, const Data>( m_other );
-		assert( otherData );
-		const typename T::ValueType &otherDataReadable = otherData->readable();
+		typename T::Ptr result = new T;
+		copyInterpretation( data, result.get() );
 
-		dataWritable.clear();
-		dataWritable.reserve( m_indices.size() );
+		typename T::ValueType &resultWritable = result->writable();
+		resultWritable.resize( m_indices.size() );
 
-		for ( std::vector<int>::const_iterator it = m_indices.begin(); it != m_indices.end(); ++it )
+		Remap<T> remap( data->readable(), resultWritable, m_indices );
+		if( boost::is_same<typename T::ValueType, std::vector<bool> >::value )
+		{
+			// elements of vector<bool> share storage, so can't be written concurrently
+			remap( tbb::blocked_range<size_t>( 0, m_indices.size() ) );
+		}
+		else
 		{
-			dataWritable.push_back( otherDataReadable[ *it ] );
+			tbb::parallel_for( tbb::blocked_range<size_t>( 0, m_indices.size() ), remap );
 		}
 
-		assert( dataWritable.size() == m_indices.size() );
+		return result;
+	}
 
-		return dataWritable.size();
+	template<typename T>
+	static void copyInterpretation( const T *src, T *dst, typename boost::enable_if<TypeTraits::IsGeometricTypedData<T> >::type *enabler = 0 )
+	{
+		dst->setInterpretation( src->getInterpretation() );
+	}
+
+	template<typename T>
+	static void copyInterpretation( const T *src, T *dst, typename boost::disable_if<TypeTraits::IsGeometricTypedData<T> >::type *enabler = 0 )
+	{
 	}
 };
 
-/// A simple class to allow TriangulateOp to operate on either V3fVectorData or V3dVectorData using
-/// despatchTypedData
-struct TriangulateOp::TriangulateFn
+/// A functor for use with tbb::parallel_for, which triangulates a range of faces, writing
+/// the triangles for each face at the offsets computed in advance by TriangulateFn.
+template<typename Vec>
+class TriangulateFaces
 {
-	typedef void ReturnType;
+	public :
+
+		typedef typename Vec::BaseType Real;
+		typedef Imath::Vec2<Real> V2;
+
+		TriangulateFaces(
+			const std::vector<Vec> &p, const std::vector<int> &vertexIds, const std::vector<int> &faceOffsets,
+			std::vector<int> &newVertexIds, std::vector<int> &faceVaryingIndices, std::vector<int> &uniformIndices,
+			float tolerance, bool checkPlanarity, tbb::atomic<int> &nonPlanar
+		)
+			:	m_p( p ), m_vertexIds( vertexIds ), m_faceOffsets( faceOffsets ),
+				m_newVertexIds( newVertexIds ), m_faceVaryingIndices( faceVaryingIndices ), m_uniformIndices( uniformIndices ),
+				m_tolerance( tolerance ), m_checkPlanarity( checkPlanarity ), m_nonPlanar( nonPlanar )
+		{
+		}
 
-	MeshPrimitive * m_mesh;
-	float m_tolerance;
-	bool m_throwExceptions;
+		void operator()( const tbb::blocked_range<size_t> &r ) const
+		{
+			// scratch space, reused for every face in the range
+			std::vector<V2> points;
+			std::vector<int> prev, next, triangles;
 
-	TriangulateFn( MeshPrimitive * mesh, float tolerance, bool throwExceptions )
-	: m_mesh( mesh ), m_tolerance( tolerance ), m_throwExceptions( throwExceptions )
-	{
-	}
+			for( size_t faceIdx = r.begin(); faceIdx != r.end(); ++faceIdx )
+			{
+				const int faceVertexIdStart = m_faceOffsets[faceIdx];
+				const int numFaceVerts = m_faceOffsets[faceIdx+1] - faceVertexIdStart;
+				// every face with n vertices produces n - 2 triangles
+				const int firstTriangle = faceVertexIdStart - 2 * (int)faceIdx;
 
-	template<typename T>
-	ReturnType operator()( T * p )
-	{
-		typedef typename T::ValueType::value_type Vec;
+				triangles.clear();
+				if( numFaceVerts == 3 )
+				{
+					triangles.push_back( 0 );
+					triangles.push_back( 1 );
+					triangles.push_back( 2 );
+				}
+				else
+				{
+					triangulate( faceVertexIdStart, numFaceVerts, points, prev, next, triangles );
+				}
 
-		const typename T::ValueType &pReadable = p->readable();
+				assert( (int)triangles.size() == ( numFaceVerts - 2 ) * 3 );
+				for( int t = 0, numTriangles = numFaceVerts - 2; t < numTriangles; ++t )
+				{
+					const int newTriangle = firstTriangle + t;
+					for( int i = 0; i < 3; ++i )
+					{
+						/// Store the indices required to rebuild the facevarying primvars
+						const int faceVertex = faceVertexIdStart + triangles[t*3+i];
+						m_faceVaryingIndices[newTriangle*3+i] = faceVertex;
+						m_newVertexIds[newTriangle*3+i] = m_vertexIds[faceVertex];
+					}
+					m_uniformIndices[newTriangle] = faceIdx;
+				}
+			}
+		}
 
-		MeshPrimitivePtr meshCopy = m_mesh->copy();
+	private :
 
-		ConstIntVectorDataPtr verticesPerFace = m_mesh->verticesPerFace();
-		const std::vector<int> &verticesPerFaceReadable = verticesPerFace->readable();
-		ConstIntVectorDataPtr vertexIds = m_mesh->vertexIds();
-		const std::vector<int> &vertexIdsReadable = vertexIds->readable();
+		const Vec &point( int faceVertex ) const
+		{
+			return m_p[ m_vertexIds[faceVertex] ];
+		}
 
-		IntVectorDataPtr newVertexIds = new IntVectorData();
-		std::vector<int> &newVertexIdsWritable = newVertexIds->writable();
-		newVertexIdsWritable.reserve( vertexIdsReadable.size() );
+		static Real cross( const V2 &a, const V2 &b, const V2 &c )
+		{
+			return ( b.x - a.x ) * ( c.y - b.y ) - ( b.y - a.y ) * ( c.x - b.x );
+		}
 
-		IntVectorDataPtr newVerticesPerFace = new IntVectorData();
-		std::vector<int> &newVerticesPerFaceWritable = newVerticesPerFace->writable();
-		newVerticesPerFaceWritable.reserve( verticesPerFaceReadable.size() );
-
-		std::vector<int> faceVaryingIndices;
-		std::vector<int> uniformIndices;
-		int faceVertexIdStart = 0;
-		int faceIdx = 0;
-		for ( IntVectorData::ValueType::const_iterator it = verticesPerFaceReadable.begin(); it != verticesPerFaceReadable.end(); ++it, ++faceIdx )
+		// returns true if p is inside or on the boundary of the anticlockwise triangle abc
+		static bool contains( const V2 &a, const V2 &b, const V2 &c, const V2 &p )
 		{
-			int numFaceVerts = *it;
+			return cross( a, b, p ) >= 0 && cross( b, c, p ) >= 0 && cross( c, a, p ) >= 0;
+		}
 
-			if ( numFaceVerts > 3 )
+		// Appends the triangles for the face to triangles, as indices relative to faceVertexIdStart.
+		void triangulate( int faceVertexIdStart, int numFaceVerts, std::vector<V2> &points, std::vector<int> &prev, std::vector<int> &next, std::vector<int> &triangles ) const
+		{
+			/// Compute the face normal using Newell's method, which is robust for concave polygons
+			Vec normal( 0 );
+			for( int i = 0; i < numFaceVerts; ++i )
 			{
-				/// For the time being, just do a simple triangle fan.
+				const Vec &a = point( faceVertexIdStart + i );
+				const Vec &b = point( faceVertexIdStart + ( i + 1 ) % numFaceVerts );
+				normal.x += ( a.y - b.y ) * ( a.z + b.z );
+				normal.y += ( a.z - b.z ) * ( a.x + b.x );
+				normal.z += ( a.x - b.x ) * ( a.y + b.y );
+			}
 
-				const int i0 = faceVertexIdStart + 0;
-				const int v0 = vertexIdsReadable[ i0 ];
+			/// Project onto the plane best aligned with the face, choosing the axes so that
+			/// the projected polygon is wound anticlockwise.
+			int axis = 2;
+			if( fabs( normal.x ) > fabs( normal.y ) && fabs( normal.x ) > fabs( normal.z ) )
+			{
+				axis = 0;
+			}
+			else if( fabs( normal.y ) > fabs( normal.z ) )
+			{
+				axis = 1;
+			}
+			int u = ( axis + 1 ) % 3;
+			int v = ( axis + 2 ) % 3;
+			if( normal[axis] < 0 )
+			{
+				std::swap( u, v );
+			}
 
-				int i1 = faceVertexIdStart + 1;
-				int i2 = faceVertexIdStart + 2;
-				int v1 = vertexIdsReadable[ i1 ];
-				int v2 = vertexIdsReadable[ i2 ];
+			points.resize( numFaceVerts );
+			bool convex = true;
+			for( int i = 0; i < numFaceVerts; ++i )
+			{
+				const Vec &p = point( faceVertexIdStart + i );
+				points[i] = V2( p[u], p[v] );
+			}
+			for( int i = 0; i < numFaceVerts && convex; ++i )
+			{
+				convex = cross( points[i], points[(i+1)%numFaceVerts], points[(i+2)%numFaceVerts] ) >= 0;
+			}
 
-				const Vec firstTriangleNormal = triangleNormal( pReadable[ v0 ], pReadable[ v1 ], pReadable[ v2 ] );
+			if( convex || normal.length() == Real( 0 ) )
+			{
+				/// A simple triangle fan will do
+				for( int i = 1; i < numFaceVerts - 1; ++i )
+				{
+					triangles.push_back( 0 );
+					triangles.push_back( i );
+					triangles.push_back( i + 1 );
+				}
+			}
+			else
+			{
+				clipEars( numFaceVerts, points, prev, next, triangles );
+			}
 
-				if (m_throwExceptions)
+			if( m_checkPlanarity )
+			{
+				const Vec unitNormal = normal.normalized();
+				for( size_t t = 0; t < triangles.size(); t += 3 )
 				{
-					/// Convexivity test - for each edge, all other vertices must be on the same "side" of it
-					for (int i = 0; i < numFaceVerts - 1; i++)
+					const Vec n = triangleNormal( point( faceVertexIdStart + triangles[t] ), point( faceVertexIdStart + triangles[t+1] ), point( faceVertexIdStart + triangles[t+2] ) );
+					if( fabs( n.dot( unitNormal ) - 1.0 ) > m_tolerance )
 					{
-						const int edgeStartIndex = faceVertexIdStart + i + 0;
-						const int edgeStart = vertexIdsReadable[ edgeStartIndex ];
-
-						const int edgeEndIndex = faceVertexIdStart + i + 1;
-						const int edgeEnd = vertexIdsReadable[ edgeEndIndex ];
+						m_nonPlanar = 1;
+						break;
+					}
+				}
+			}
+		}
 
-						const Vec edge = pReadable[ edgeEnd ] - pReadable[ edgeStart ];
-						const float edgeLength = edge.length();
+		// Ear clipping of the anticlockwise polygon held in points.
+		static void clipEars( int numFaceVerts, const std::vector<V2> &points, std::vector<int> &prev, std::vector<int> &next, std::vector<int> &triangles )
+		{
+			prev.resize( numFaceVerts );
+			next.resize( numFaceVerts );
+			for( int i = 0; i < numFaceVerts; ++i )
+			{
+				prev[i] = ( i + numFaceVerts - 1 ) % numFaceVerts;
+				next[i] = ( i + 1 ) % numFaceVerts;
+			}
 
-						if (edgeLength > m_tolerance)
+			int remaining = numFaceVerts;
+			int candidate = 0;
+			int failures = 0;
+			while( remaining > 3 )
+			{
+				const int i0 = prev[candidate];
+				const int i1 = candidate;
+				const int i2 = next[candidate];
+
+				// once we've tried every vertex without finding an ear we have to
+				// clip anyway. this only happens for self intersecting or degenerate faces.
+				bool isEar = failures >= remaining;
+				if( !isEar && cross( points[i0], points[i1], points[i2] ) > 0 )
+				{
+					isEar = true;
+					for( int j = next[i2]; j != i0; j = next[j] )
+					{
+						const V2 &p = points[j];
+						if( p != points[i0] && p != points[i1] && p != points[i2] && contains( points[i0], points[i1], points[i2], p ) )
 						{
-							const Vec edgeDirection = edge / edgeLength;
-
-							/// Construct a plane whose normal is perpendicular to both the edge and the polygon's normal
-							const Vec planeNormal = edgeDirection.cross( firstTriangleNormal );
-							const float planeConstant = planeNormal.dot( pReadable[ edgeStart ] );
-
-							int sign = 0;
-							bool first = true;
-							for (int j = 0; j < numFaceVerts; j++)
-							{
-								const int testVertexIndex = faceVertexIdStart + j;
-								const int testVertex = vertexIdsReadable[ testVertexIndex ];
-
-								if ( testVertex != edgeStart && testVertex != edgeEnd )
-								{
-									float signedDistance = planeNormal.dot( pReadable[ testVertex ] ) - planeConstant;
-
-									if ( fabs(signedDistance) > m_tolerance)
-									{
-										int thisSign = 1;
-										if ( signedDistance < 0.0 )
-										{
-											thisSign = -1;
-										}
-										if (first)
-										{
-											sign = thisSign;
-											first = false;
-										}
-										else if ( thisSign != sign )
-										{
-											assert( sign != 0 );
-											throw InvalidArgumentException("TriangulateOp cannot deal with concave polygons");
-										}
-									}
-								}
-							}
+							isEar = false;
+							break;
 						}
 					}
 				}
 
-				for (int i = 1; i < numFaceVerts - 1; i++)
+				if( isEar )
+				{
+					triangles.push_back( i0 );
+					triangles.push_back( i1 );
+					triangles.push_back( i2 );
+					next[i0] = i2;
+					prev[i2] = i0;
+					--remaining;
+					failures = 0;
+					candidate = i0;
+				}
+				else
 				{
-					i1 = faceVertexIdStart + ( (i + 0) % numFaceVerts );
-					i2 = faceVertexIdStart + ( (i + 1) % numFaceVerts );
-					v1 = vertexIdsReadable[ i1 ];
-					v2 = vertexIdsReadable[ i2 ];
+					++failures;
+					candidate = i2;
+				}
+			}
 
-					if ( m_throwExceptions && fabs( triangleNormal( pReadable[ v0 ], pReadable[ v1 ], pReadable[ v2 ] ).dot( firstTriangleNormal ) - 1.0 ) > m_tolerance )
-					{
-						throw InvalidArgumentException("TriangulateOp cannot deal with non-planar polygons");
-					}
+			triangles.push_back( prev[candidate] );
+			triangles.push_back( candidate );
+			triangles.push_back( next[candidate] );
+		}
 
-					/// Create a new triangle
-					newVerticesPerFaceWritable.push_back( 3 );
+		const std::vector<Vec> &m_p;
+		const std::vector<int> &m_vertexIds;
+		const std::vector<int> &m_faceOffsets;
+		std::vector<int> &m_newVertexIds;
+		std::vector<int> &m_faceVaryingIndices;
+		std::vector<int> &m_uniformIndices;
+		float m_tolerance;
+		bool m_checkPlanarity;
+		tbb::atomic<int> &m_nonPlanar;
 
-					/// Triangulate the vertices
-					newVertexIdsWritable.push_back( v0 );
-					newVertexIdsWritable.push_back( v1 );
-					newVertexIdsWritable.push_back( v2 );
+};
 
-					/// Store the indices required to rebuild the facevarying primvars
-					faceVaryingIndices.push_back( i0 );
-					faceVaryingIndices.push_back( i1 );
-					faceVaryingIndices.push_back( i2 );
+/// A simple class to allow TriangulateOp to operate on either V3fVectorData or V3dVectorData using
+/// despatchTypedData
+struct TriangulateOp::TriangulateFn
+{
+	typedef void ReturnType;
 
-					uniformIndices.push_back( faceIdx );
-				}
-			}
-			else
-			{
-				assert( numFaceVerts == 3 );
+	MeshPrimitive * m_mesh;
+	float m_tolerance;
+	bool m_throwExceptions;
 
-				int i0 = faceVertexIdStart + 0;
-				int i1 = faceVertexIdStart + 1;
-				int i2 = faceVertexIdStart + 2;
+	TriangulateFn( MeshPrimitive * mesh, float tolerance, bool throwExceptions )
+	: m_mesh( mesh ), m_tolerance( tolerance ), m_throwExceptions( throwExceptions )
+	{
+	}
 
-				newVerticesPerFaceWritable.push_back( 3 );
+	template<typename T>
+	ReturnType operator()( T * p )
+	{
+		typedef typename T::ValueType::value_type Vec;
 
-				/// Copy across the vertexId data
-				newVertexIdsWritable.push_back( vertexIdsReadable[ i0 ] );
-				newVertexIdsWritable.push_back( vertexIdsReadable[ i1 ] );
-				newVertexIdsWritable.push_back( vertexIdsReadable[ i2 ] );
+		const typename T::ValueType &pReadable = p->readable();
 
-				/// Store the indices required to rebuild the facevarying primvars
-				faceVaryingIndices.push_back( i0 );
-				faceVaryingIndices.push_back( i1 );
-				faceVaryingIndices.push_back( i2 );
+		ConstIntVectorDataPtr verticesPerFace = m_mesh->verticesPerFace();
+		const std::vector<int> &verticesPerFaceReadable = verticesPerFace->readable();
+		ConstIntVectorDataPtr vertexIds = m_mesh->vertexIds();
+		const std::vector<int> &vertexIdsReadable = vertexIds->readable();
 
-				uniformIndices.push_back( faceIdx );
-			}
+		/// First pass : find the offset of each face into the vertexIds. Because every face
+		/// with n vertices becomes n - 2 triangles, this also tells us where each face's
+		/// triangles go in the output, so that the faces can then be triangulated in parallel.
+		const size_t numFaces = verticesPerFaceReadable.size();
+		std::vector<int> faceOffsets( numFaces + 1 );
+		faceOffsets[0] = 0;
+		for( size_t i = 0; i < numFaces; ++i )
+		{
+			assert( verticesPerFaceReadable[i] >= 3 );
+			faceOffsets[i+1] = faceOffsets[i] + verticesPerFaceReadable[i];
+		}
+		const size_t numTriangles = faceOffsets[numFaces] - 2 * numFaces;
 
-			faceVertexIdStart += numFaceVerts;
+		IntVectorDataPtr newVerticesPerFace = new IntVectorData();
+		newVerticesPerFace->writable().resize( numTriangles, 3 );
+
+		IntVectorDataPtr newVertexIds = new IntVectorData();
+		std::vector<int> &newVertexIdsWritable = newVertexIds->writable();
+		newVertexIdsWritable.resize( numTriangles * 3 );
+
+		std::vector<int> faceVaryingIndices( numTriangles * 3 );
+		std::vector<int> uniformIndices( numTriangles );
+
+		/// Second pass : triangulate
+		tbb::atomic<int> nonPlanar;
+		nonPlanar = 0;
+		TriangulateFaces<Vec> triangulateFaces(
+			pReadable, vertexIdsReadable, faceOffsets,
+			newVertexIdsWritable, faceVaryingIndices, uniformIndices,
+			m_tolerance, m_throwExceptions, nonPlanar
+		);
+		tbb::parallel_for( tbb::blocked_range<size_t>( 0, numFaces ), triangulateFaces );
+
+		if( nonPlanar )
+		{
+			throw InvalidArgumentException( "TriangulateOp cannot deal with non-planar polygons" );
 		}
 
 		m_mesh->setTopology( newVerticesPerFace, newVertexIds, m_mesh->interpolation() );
 
-		/// Rebuild all the facevarying primvars, using the list of indices into the old data we created above.
-		assert( faceVaryingIndices.size() == newVertexIds->readable().size() );
+		/// Rebuild all the facevarying and uniform primvars, using the lists of indices into the old data we created above.
 		TriangleDataRemap varyingRemap( faceVaryingIndices );
 		TriangleDataRemap uniformRemap( uniformIndices );
 		for ( PrimitiveVariableMap::iterator it = m_mesh->variables.begin(); it != m_mesh->variables.end(); ++it )
@@ -305,26 +467,12 @@ struct TriangulateOp::TriangulateFn
 			if ( it->second.interpolation == PrimitiveVariable::FaceVarying )
 			{
  				assert( it->second.data );
-				varyingRemap.m_other = it->second.data.get();
-				DataPtr data = it->second.data->copy();
-
-				size_t primVarSize = despatchTypedData<TriangleDataRemap, TypeTraits::IsVectorTypedData>( data.get(), varyingRemap );
-				assert( primVarSize == faceVaryingIndices.size() );
-				(void)primVarSize;
-
-				it->second.data = data;
+				it->second.data = despatchTypedData<TriangleDataRemap, TypeTraits::IsVectorTypedData>( it->second.data.get(), varyingRemap );
 			}
 			else if ( it->second.interpolation == PrimitiveVariable::Uniform )
 			{
  				assert( it->second.data );
-				uniformRemap.m_other = it->second.data.get();
-				DataPtr data = it->second.data->copy();
-
-				size_t primVarSize = despatchTypedData<TriangleDataRemap, TypeTraits::IsVectorTypedData>( data.get(), uniformRemap );
-				assert( primVarSize == uniformIndices.size() );
-				(void)primVarSize;
-
-				it->second.data = data;
+				it->second.data = despatchTypedData<TriangleDataRemap, TypeTraits::IsVectorTypedData>( it->second.data.get(), uniformRemap );
 			}
 		}
 
@@ -115,6 +115,11 @@ Imath::Box3f Camera::bound() const
 	return Box3f();
 }
 
+Imath::M44f Camera::projection() const
+{
+	return M44f();
+}
+
 Imath::M44f Camera::matrix()
 {
 	Imath::M44f obj2Camera;
@@ -44,13 +44,15 @@ using namespace std;
 
 IE_CORE_DEFINERUNTIMETYPED( Group );
 
+tbb::atomic<size_t> Group::g_editCount;
+
 Group::Group()
-	:	m_state( new State( false ) ), m_transform( M44f() )
+	:	m_state( new State( false ) ), m_transform( M44f() ), m_boundEditCount( (size_t)-1 )
 {
 }
 
 Group::Group( const Group &other )
-	:	m_state( new State( *(other.m_state) ) ), m_transform( other.m_transform ), m_children( other.m_children )
+	:	m_state( new State( *(other.m_state) ) ), m_transform( other.m_transform ), m_children( other.m_children ), m_boundEditCount( (size_t)-1 )
 {
 }
 
@@ -61,6 +63,7 @@ Group::~Group()
 void Group::setTransform( const Imath::M44f &matrix )
 {
 	m_transform = matrix;
+	g_editCount++;
 }
 
 const Imath::M44f &Group::getTransform() const
@@ -81,9 +84,20 @@ const State *Group::getState() const
 void Group::setState( StatePtr state )
 {
 	m_state = state;
+	g_editCount++;
 }
 
 void Group::render( State *currentState ) const
+{
+	renderInternal( currentState, 0 );
+}
+
+void Group::render( State *currentState, const Imath::M44f &clipMatrix ) const
+{
+	renderInternal( currentState, &clipMatrix );
+}
+
+void Group::renderInternal( State *currentState, const Imath::M44f *clipMatrix ) const
 {
 	const bool haveTransform = m_transform != M44f();
 	if( haveTransform )
@@ -108,9 +122,33 @@ void Group::render( State *currentState ) const
 	
 	{
 		State::ScopedBinding scope( *m_state, *currentState );
-		for( ChildContainer::const_iterator it=m_children.begin(); it!=m_children.end(); it++ )
+		if( !clipMatrix )
+		{
+			for( ChildContainer::const_iterator it=m_children.begin(); it!=m_children.end(); it++ )
+			{
+				(*it)->render( currentState );
+			}
+		}
+		else
 		{
-			(*it)->render( currentState );
+			const M44f childClipMatrix = m_transform * *clipMatrix;
+			for( ChildContainer::const_iterator it=m_children.begin(); it!=m_children.end(); it++ )
+			{
+				const Box3f childBound = (*it)->bound();
+				if( !childBound.isEmpty() && !intersectsFrustum( childBound, childClipMatrix ) )
+				{
+					continue;
+				}
+
+				if( const Group *childGroup = IECore::runTimeCast<const Group>( it->get() ) )
+				{
+					childGroup->renderInternal( currentState, &childClipMatrix );
+				}
+				else
+				{
+					(*it)->render( currentState );
+				}
+			}
 		}
 	}
 	
@@ -122,27 +160,91 @@ void Group::render( State *currentState ) const
 
 Imath::Box3f Group::bound() const
 {
-	Box3f result;
-	for( ChildContainer::const_iterator it=children().begin(); it!=children().end(); it++ )
+	Mutex::scoped_lock lock( m_mutex );
+
+	// we read the edit count before computing the bound, so that
+	// if an edit is made while we're computing, the cache will be
+	// considered invalid next time round.
+	const size_t editCount = g_editCount;
+	if( m_boundEditCount != editCount )
 	{
-		result.extendBy( (*it)->bound() );
+		Box3f result;
+		for( ChildContainer::const_iterator it=children().begin(); it!=children().end(); it++ )
+		{
+			result.extendBy( (*it)->bound() );
+		}
+		m_bound = transform( result, m_transform );
+		m_boundEditCount = editCount;
 	}
-	return transform( result, m_transform );
+
+	return m_bound;
+}
+
+bool Group::intersectsFrustum( const Imath::Box3f &box, const Imath::M44f &clipMatrix )
+{
+	if( box.isEmpty() )
+	{
+		return false;
+	}
+
+	// Transform the corners into homogeneous clip space, and reject the
+	// box only if all of them are outside the same clipping plane. This is
+	// conservative - a box may be accepted when it is just outside a corner
+	// of the frustum - but it works for boxes which straddle the eye plane,
+	// where projecting the corners would be meaningless.
+	unsigned allOutside = 0x3f;
+	for( int i = 0; i < 8; i++ )
+	{
+		const V3f corner(
+			i & 1 ? box.max.x : box.min.x,
+			i & 2 ? box.max.y : box.min.y,
+			i & 4 ? box.max.z : box.min.z
+		);
+
+		const float x = corner.x * clipMatrix[0][0] + corner.y * clipMatrix[1][0] + corner.z * clipMatrix[2][0] + clipMatrix[3][0];
+		const float y = corner.x * clipMatrix[0][1] + corner.y * clipMatrix[1][1] + corner.z * clipMatrix[2][1] + clipMatrix[3][1];
+		const float z = corner.x * clipMatrix[0][2] + corner.y * clipMatrix[1][2] + corner.z * clipMatrix[2][2] + clipMatrix[3][2];
+		const float w = corner.x * clipMatrix[0][3] + corner.y * clipMatrix[1][3] + corner.z * clipMatrix[2][3] + clipMatrix[3][3];
+
+		unsigned outside = 0;
+		outside |= x < -w ? 1 : 0;
+		outside |= x > w ? 2 : 0;
+		outside |= y < -w ? 4 : 0;
+		outside |= y > w ? 8 : 0;
+		outside |= z < -w ? 16 : 0;
+		outside |= z > w ? 32 : 0;
+
+		allOutside &= outside;
+		if( !allOutside )
+		{
+			return true;
+		}
+	}
+
+	return false;
+}
+
+size_t Group::editCount()
+{
+	return g_editCount;
 }
 
 void Group::addChild( RenderablePtr child )
 {
 	m_children.push_back( child );
+	g_editCount++;
 }
 
 void Group::removeChild( Renderable *child )
 {
 	m_children.remove( child );
+	g_editCount++;
 }
 
 void Group::clearChildren()
 {
 	m_children.clear();
+	g_editCount++;
 }
 
 const Group::ChildContainer &Group::children() const
@@ -53,10 +53,25 @@ OrthographicCamera::OrthographicCamera(
 void OrthographicCamera::render( State *currentState ) const
 {
 	glMatrixMode( GL_PROJECTION );
-	glLoadIdentity();
-	glOrtho( m_screenWindow.min.x, m_screenWindow.max.x,
-		m_screenWindow.min.y, m_screenWindow.max.y,
-		m_clippingPlanes[0], m_clippingPlanes[1] );
+	glLoadMatrixf( projection().getValue() );
 
 	setModelViewMatrix();
 }
+
+Imath::M44f OrthographicCamera::projection() const
+{
+	// equivalent to glOrtho()
+	const Box2f &w = m_screenWindow;
+	const float nearClip = m_clippingPlanes[0];
+	const float farClip = m_clippingPlanes[1];
+
+	M44f result;
+	result[0][0] = 2.0f / ( w.max.x - w.min.x );
+	result[1][1] = 2.0f / ( w.max.y - w.min.y );
+	result[2][2] = -2.0f / ( farClip - nearClip );
+	result[3][0] = -( w.max.x + w.min.x ) / ( w.max.x - w.min.x );
+	result[3][1] = -( w.max.y + w.min.y ) / ( w.max.y - w.min.y );
+	result[3][2] = -( farClip + nearClip ) / ( farClip - nearClip );
+
+	return result;
+}
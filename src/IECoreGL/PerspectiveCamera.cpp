@@ -66,13 +66,31 @@ float PerspectiveCamera::getFOV() const
 void PerspectiveCamera::render( State *currentState ) const
 {
 	glMatrixMode( GL_PROJECTION );
-	glLoadIdentity();
+	glLoadMatrixf( projection().getValue() );
 
-	float r = m_clippingPlanes[0] * tan( M_PI * m_fov / 360.0 );
+	setModelViewMatrix();
+}
 
-	glFrustum( r * m_screenWindow.min.x, r * m_screenWindow.max.x,
-		r * m_screenWindow.min.y, r * m_screenWindow.max.y,
-		m_clippingPlanes[0], m_clippingPlanes[1] );
+Imath::M44f PerspectiveCamera::projection() const
+{
+	// equivalent to glFrustum()
+	const float r = m_clippingPlanes[0] * tan( M_PI * m_fov / 360.0 );
+	const float left = r * m_screenWindow.min.x;
+	const float right = r * m_screenWindow.max.x;
+	const float bottom = r * m_screenWindow.min.y;
+	const float top = r * m_screenWindow.max.y;
+	const float nearClip = m_clippingPlanes[0];
+	const float farClip = m_clippingPlanes[1];
 
-	setModelViewMatrix();
+	M44f result;
+	result[0][0] = 2.0f * nearClip / ( right - left );
+	result[1][1] = 2.0f * nearClip / ( top - bottom );
+	result[2][0] = ( right + left ) / ( right - left );
+	result[2][1] = ( top + bottom ) / ( top - bottom );
+	result[2][2] = -( farClip + nearClip ) / ( farClip - nearClip );
+	result[2][3] = -1.0f;
+	result[3][2] = -2.0f * farClip * nearClip / ( farClip - nearClip );
+	result[3][3] = 0.0f;
+
+	return result;
 }
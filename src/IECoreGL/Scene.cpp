@@ -32,21 +32,206 @@
 //
 //////////////////////////////////////////////////////////////////////////
 
+#include <cassert>
+#include <map>
+#include <algorithm>
+
+#include "OpenEXR/ImathBoxAlgo.h"
+
+#include "IECore/BoundedKDTree.h"
+#include "IECore/Exception.h"
+
 #include "IECoreGL/Scene.h"
 #include "IECoreGL/Group.h"
 #include "IECoreGL/State.h"
 #include "IECoreGL/Camera.h"
 #include "IECoreGL/Selector.h"
 #include "IECoreGL/ShaderStateComponent.h"
+#include "IECoreGL/NameStateComponent.h"
+#include "IECoreGL/Primitive.h"
 
 using namespace IECoreGL;
 using namespace Imath;
 using namespace std;
 
+//////////////////////////////////////////////////////////////////////////
+// Scene::SelectionIndex
+//////////////////////////////////////////////////////////////////////////
+
+namespace
+{
+
+// A frustum specified by a clip matrix, for querying the
+// BoundedKDTree used by the SelectionIndex.
+struct ClipFrustum
+{
+	ClipFrustum( const M44f &clipMatrix )
+		:	clipMatrix( clipMatrix )
+	{
+	}
+
+	M44f clipMatrix;
+};
+
+// Found by argument dependent lookup from within BoundedKDTree.
+bool boxIntersects( const Box3f &box, const ClipFrustum &frustum )
+{
+	return Group::intersectsFrustum( box, frustum.clipMatrix );
+}
+
+} // namespace
+
+/// A flattened list of the selectable primitives in a scene, with
+/// a tree of their world space bounds for fast region queries.
+class Scene::SelectionIndex : public IECore::RefCounted
+{
+
+	public :
+
+		SelectionIndex( const Group *root )
+			:	m_editCount( Group::editCount() )
+		{
+			const State *defaultState = State::defaultState();
+			addRenderable(
+				root, M44f(),
+				defaultState->get<NameStateComponent>()->glName(),
+				defaultState->get<Primitive::Selectable>()->value()
+			);
+			m_tree.init( m_worldBounds.begin(), m_worldBounds.end() );
+		}
+
+		size_t editCount() const
+		{
+			return m_editCount;
+		}
+
+		void select( const M44f &worldToClip, const M44f &worldToRegion, std::vector<HitRecord> &hits ) const
+		{
+			std::vector<BoundIterator> candidates;
+			m_tree.intersectingBounds( ClipFrustum( worldToRegion ), candidates );
+
+			typedef std::map<GLuint, HitRecord> HitMap;
+			HitMap hitMap;
+			for( std::vector<BoundIterator>::const_iterator it = candidates.begin(); it != candidates.end(); ++it )
+			{
+				const Entry &entry = m_entries[*it - m_worldBounds.begin()];
+				// the world bound is a loose fit after transformation, so we
+				// refine the test using the object space bound.
+				if( !Group::intersectsFrustum( entry.bound, entry.transform * worldToRegion ) )
+				{
+					continue;
+				}
+
+				const Box2f depthRange = depths( entry.bound, entry.transform * worldToClip );
+				HitMap::iterator hIt = hitMap.find( entry.name );
+				if( hIt == hitMap.end() )
+				{
+					hitMap.insert( HitMap::value_type( entry.name, HitRecord( depthRange.min.x, depthRange.max.x, entry.name ) ) );
+				}
+				else
+				{
+					hIt->second.depthMin = std::min( hIt->second.depthMin, depthRange.min.x );
+					hIt->second.depthMax = std::max( hIt->second.depthMax, depthRange.max.x );
+				}
+			}
+
+			const size_t firstHit = hits.size();
+			for( HitMap::const_iterator it = hitMap.begin(); it != hitMap.end(); ++it )
+			{
+				hits.push_back( it->second );
+			}
+			std::sort( hits.begin() + firstHit, hits.end() );
+		}
+
+	private :
+
+		typedef std::vector<Box3f>::const_iterator BoundIterator;
+
+		struct Entry
+		{
+			Box3f bound;
+			M44f transform;
+			GLuint name;
+		};
+
+		void addRenderable( const Renderable *renderable, const M44f &transform, GLuint name, bool selectable )
+		{
+			if( const Group *group = IECore::runTimeCast<const Group>( renderable ) )
+			{
+				const State *state = group->getState();
+				if( const NameStateComponent *n = state->get<NameStateComponent>() )
+				{
+					name = n->glName();
+				}
+				if( const Primitive::Selectable *s = state->get<Primitive::Selectable>() )
+				{
+					selectable = s->value();
+				}
+
+				const M44f groupTransform = group->getTransform() * transform;
+				Group::Mutex::scoped_lock lock( group->mutex() );
+				for( Group::ChildContainer::const_iterator it = group->children().begin(); it != group->children().end(); ++it )
+				{
+					addRenderable( it->get(), groupTransform, name, selectable );
+				}
+				return;
+			}
+
+			if( !selectable || !IECore::runTimeCast<const Primitive>( renderable ) )
+			{
+				return;
+			}
+
+			Entry entry;
+			entry.bound = renderable->bound();
+			if( entry.bound.isEmpty() )
+			{
+				return;
+			}
+			entry.transform = transform;
+			entry.name = name;
+
+			m_entries.push_back( entry );
+			m_worldBounds.push_back( Imath::transform( entry.bound, transform ) );
+		}
+
+		// Returns the range of window space depths covered by the box,
+		// in the same 0-1 range as provided by the GL select buffer.
+		static Box2f depths( const Box3f &box, const M44f &clipMatrix )
+		{
+			Box2f result;
+			for( int i = 0; i < 8; i++ )
+			{
+				const V3f corner(
+					i & 1 ? box.max.x : box.min.x,
+					i & 2 ? box.max.y : box.min.y,
+					i & 4 ? box.max.z : box.min.z
+				);
+
+				const float z = corner.x * clipMatrix[0][2] + corner.y * clipMatrix[1][2] + corner.z * clipMatrix[2][2] + clipMatrix[3][2];
+				const float w = corner.x * clipMatrix[0][3] + corner.y * clipMatrix[1][3] + corner.z * clipMatrix[2][3] + clipMatrix[3][3];
+				// corners behind the eye are clipped to the near plane
+				const float depth = w > 0.0f ? Imath::clamp( z / w * 0.5f + 0.5f, 0.0f, 1.0f ) : 0.0f;
+				result.extendBy( V2f( depth ) );
+			}
+			return result;
+		}
+
+		size_t m_editCount;
+		std::vector<Entry> m_entries;
+		std::vector<Box3f> m_worldBounds;
+		IECore::BoundedKDTree<BoundIterator> m_tree;
+
+};
+
+//////////////////////////////////////////////////////////////////////////
+// Scene
+//////////////////////////////////////////////////////////////////////////
+
 IE_CORE_DEFINERUNTIMETYPED( Scene );
 
 Scene::Scene()
-	:	m_root( new Group ), m_camera( 0 )
+	:	m_root( new Group ), m_camera( 0 ), m_frustumCulling( true )
 {
 }
 
@@ -67,7 +252,7 @@ void Scene::render( State *state ) const
 
 		State::bindBaseState();
 		state->bind();
-		root()->render( state );
+		renderRoot( state );
 
 	glPopAttrib();
 	glUseProgram( prevProgram );
@@ -95,11 +280,67 @@ size_t Scene::select( Selector::Mode mode, const Imath::Box2f &region, std::vect
 	
 	State::bindBaseState();
 	selector.baseState()->bind();
-	root()->render( selector.baseState() );
+	renderRoot( selector.baseState() );
 
 	return hits.size();
 }
 
+size_t Scene::select( const Imath::Box2f &region, std::vector<HitRecord> &hits ) const
+{
+	if( !m_camera )
+	{
+		throw IECore::Exception( "Scene::select : CPU selection requires a camera" );
+	}
+
+	SelectionIndexPtr selectionIndex;
+	{
+		tbb::mutex::scoped_lock lock( m_selectionIndexMutex );
+		if( !m_selectionIndex || m_selectionIndex->editCount() != Group::editCount() )
+		{
+			m_selectionIndex = new SelectionIndex( m_root.get() );
+		}
+		selectionIndex = m_selectionIndex;
+	}
+
+	const M44f worldToClip = m_camera->getTransform().inverse() * m_camera->projection();
+
+	// Make the equivalent of the pick matrix used by the Selector, mapping
+	// the region (0,0 at top left of NDC) to the whole of clip space.
+	const V2f center( region.center().x * 2.0f - 1.0f, 1.0f - region.center().y * 2.0f );
+	const V2f halfSize = region.size();
+	M44f pickMatrix;
+	pickMatrix[0][0] = 1.0f / halfSize.x;
+	pickMatrix[1][1] = 1.0f / halfSize.y;
+	pickMatrix[3][0] = -center.x / halfSize.x;
+	pickMatrix[3][1] = -center.y / halfSize.y;
+
+	const size_t numHitsBefore = hits.size();
+	selectionIndex->select( worldToClip, worldToClip * pickMatrix, hits );
+	return hits.size() - numHitsBefore;
+}
+
+void Scene::setFrustumCulling( bool frustumCulling )
+{
+	m_frustumCulling = frustumCulling;
+}
+
+bool Scene::getFrustumCulling() const
+{
+	return m_frustumCulling;
+}
+
+void Scene::renderRoot( State *state ) const
+{
+	if( m_frustumCulling )
+	{
+		root()->render( state, Camera::matrix() * Camera::projectionMatrix() );
+	}
+	else
+	{
+		root()->render( state );
+	}
+}
+
 void Scene::setCamera( CameraPtr camera )
 {
 	m_camera = camera;
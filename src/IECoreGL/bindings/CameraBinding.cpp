@@ -55,6 +55,7 @@ void bindCamera()
 		.def( "getScreenWindow", &Camera::getScreenWindow, return_value_policy<copy_const_reference>() )
 		.def( "setClippingPlanes", &Camera::setClippingPlanes )
 		.def( "getClippingPlanes", &Camera::getClippingPlanes, return_value_policy<copy_const_reference>() )
+		.def( "projection", &Camera::projection )
 		.def( "matrix", &Camera::matrix ).staticmethod( "matrix" )
 		.def( "projectionMatrix", &Camera::projectionMatrix ).staticmethod( "projectionMatrix" )
 		.def( "perspectiveProjection", &Camera::perspectiveProjection ).staticmethod( "perspectiveProjection" )
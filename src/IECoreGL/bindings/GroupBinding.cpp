@@ -93,6 +93,8 @@ void bindGroup()
 		.def( "removeChild", &removeChild )
 		.def( "clearChildren", &clearChildren )
 		.def( "bound", &bound )
+		.def( "intersectsFrustum", &Group::intersectsFrustum ).staticmethod( "intersectsFrustum" )
+		.def( "editCount", &Group::editCount ).staticmethod( "editCount" )
 		.def( "children", &children, "Returns a list referencing the children of the group - modifying the list has no effect on the Group." )
 	;
 }
@@ -59,6 +59,18 @@ static list select( Scene &s, Selector::Mode mode, const Imath::Box2f &b )
 	return result;
 }
 
+static list cpuSelect( Scene &s, const Imath::Box2f &b )
+{
+	std::vector<HitRecord> hits;
+	s.select( b, hits );
+	list result;
+	for( std::vector<HitRecord>::const_iterator it=hits.begin(); it!=hits.end(); it++ )
+	{
+		result.append( *it );
+	}
+	return result;
+}
+
 void bindScene()
 {
 	IECorePython::RunTimeTypedClass<Scene>()
@@ -67,6 +79,9 @@ void bindScene()
 		.def( "render", (void (Scene::*)() const )&Scene::render )
 		.def( "render", (void (Scene::*)( State * ) const )&Scene::render )
 		.def( "select", &select )
+		.def( "select", &cpuSelect )
+		.def( "setFrustumCulling", &Scene::setFrustumCulling )
+		.def( "getFrustumCulling", &Scene::getFrustumCulling )
 		.def( "setCamera", &Scene::setCamera )
 		.def( "getCamera", (CameraPtr (Scene::*)())&Scene::getCamera )
 	;
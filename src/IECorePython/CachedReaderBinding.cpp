@@ -42,6 +42,7 @@
 #include "IECorePython/CachedReaderBinding.h"
 #include "IECorePython/RefCountedBinding.h"
 #include "IECorePython/ScopedGILRelease.h"
+#include "IECorePython/IECoreBinding.h"
 
 using namespace boost::python;
 using namespace IECore;
@@ -63,12 +64,77 @@ static ObjectPtr read( CachedReader &r, const std::string &f )
 	}
 }
 
+static CachedReader::Future readAsync( CachedReader &r, const std::string &f )
+{
+	ScopedGILRelease gilRelease;
+	return r.readAsync( f );
+}
+
+static void prefetch( CachedReader &r, list files )
+{
+	std::vector<std::string> f;
+	for( long i = 0; i < IECorePython::len( files ); i++ )
+	{
+		extract<std::string> ex( files[i] );
+		if( !ex.check() )
+		{
+			throw InvalidArgumentException( "CachedReader.prefetch: List element is not a string" );
+		}
+		f.push_back( ex() );
+	}
+
+	ScopedGILRelease gilRelease;
+	r.prefetch( f );
+}
+
+static void waitForPendingReads( CachedReader &r )
+{
+	ScopedGILRelease gilRelease;
+	r.waitForPendingReads();
+}
+
+static ObjectPtr futureGet( CachedReader::Future &f )
+{
+	ConstObjectPtr o;
+	{
+		ScopedGILRelease gilRelease;
+		o = f.get();
+	}
+	if( o )
+	{
+		return o->copy();
+	}
+	else
+	{
+		return 0;
+	}
+}
+
+static bool futureIsReady( const CachedReader::Future &f )
+{
+	return f.is_ready();
+}
+
 void bindCachedReader()
 {
-	RefCountedClass<CachedReader, RefCounted>( "CachedReader" )
+	RefCountedClass<CachedReader, RefCounted> cachedReaderClass( "CachedReader" );
+
+	{
+		scope s( cachedReaderClass );
+
+		class_<CachedReader::Future>( "Future", no_init )
+			.def( "get", &futureGet )
+			.def( "isReady", &futureIsReady )
+		;
+	}
+
+	cachedReaderClass
 		.def( init<const SearchPath &, optional<ObjectPoolPtr> >() )
 		.def( init<const SearchPath &, ConstModifyOpPtr, optional<ObjectPoolPtr> >() )
 		.def( "read", &read )
+		.def( "readAsync", &readAsync )
+		.def( "prefetch", &prefetch )
+		.def( "waitForPendingReads", &waitForPendingReads )
 		.def( "clear", (void (CachedReader::*)( const std::string &) )&CachedReader::clear )
 		.def( "clear", (void (CachedReader::*)( void ) )&CachedReader::clear )
 		.def( "insert", &CachedReader::insert )
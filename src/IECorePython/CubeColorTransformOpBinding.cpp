@@ -38,6 +38,7 @@
 #include "IECore/CompoundObject.h"
 #include "IECorePython/CubeColorTransformOpBinding.h"
 #include "IECorePython/RunTimeTypedBinding.h"
+#include "IECorePython/ScopedGILRelease.h"
 
 using namespace boost;
 using namespace boost::python;
@@ -46,10 +47,34 @@ using namespace IECore;
 namespace IECorePython
 {
 
+static CubeColorLookupfDataPtr bake( list ops, const Imath::V3i &dimension, const Imath::Box3f &domain, float tolerance )
+{
+	std::vector<ModifyOpPtr> o;
+	for( long i = 0; i < len( ops ); i++ )
+	{
+		o.push_back( extract<ModifyOpPtr>( ops[i] ) );
+	}
+
+	ScopedGILRelease gilRelease;
+	return CubeColorTransformOp::bake( o, dimension, domain, tolerance );
+}
+
 void bindCubeColorTransformOp()
 {
+	using boost::python::arg;
+
 	RunTimeTypedClass<CubeColorTransformOp>()
 		.def( init<>() )
+		.def(
+			"bake", &bake,
+			(
+				arg( "ops" ),
+				arg( "dimension" ) = Imath::V3i( 33 ),
+				arg( "domain" ) = Imath::Box3f( Imath::V3f( 0 ), Imath::V3f( 1 ) ),
+				arg( "tolerance" ) = -1.0f
+			)
+		)
+		.staticmethod( "bake" )
 	;
 }
 
@@ -51,7 +51,7 @@ void bindDisplayDriverServer()
 	using boost::python::arg;
 
 	RunTimeTypedClass<DisplayDriverServer>()
-		.def( init< int >( ( arg( "portNumber" ) ) ) )
+		.def( init< int, int >( ( arg( "portNumber" ), arg( "numThreads" ) = 0 ) ) )
 	;
 
 }
@@ -51,6 +51,8 @@ void bindEXRImageWriter()
 	RunTimeTypedClass<EXRImageWriter>()
 		.def( init<>() )
 		.def( init<ObjectPtr, const std::string &>() )
+		.def( "setGlobalThreadCount", &EXRImageWriter::setGlobalThreadCount ).staticmethod( "setGlobalThreadCount" )
+		.def( "getGlobalThreadCount", &EXRImageWriter::getGlobalThreadCount ).staticmethod( "getGlobalThreadCount" )
 	;
 }
 
@@ -64,6 +64,9 @@ void bindImageReader()
 		.def( "displayWindow", &ImageReader::displayWindow )
 		.def( "readChannel", (DataPtr (ImageReader::*)( const std::string &, bool ))&ImageReader::readChannel, ( arg_("name"), arg_( "raw" ) = false ) )
 		.def( "sourceColorSpace", &ImageReader::sourceColorSpace )
+		.def( "setBlockCacheMemoryLimit", &ImageReader::setBlockCacheMemoryLimit ).staticmethod( "setBlockCacheMemoryLimit" )
+		.def( "getBlockCacheMemoryLimit", &ImageReader::getBlockCacheMemoryLimit ).staticmethod( "getBlockCacheMemoryLimit" )
+		.def( "clearBlockCache", &ImageReader::clearBlockCache ).staticmethod( "clearBlockCache" )
 	;
 
 }
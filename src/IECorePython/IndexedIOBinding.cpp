@@ -42,6 +42,7 @@
 #include "IECore/IndexedIO.h"
 #include "IECore/FileIndexedIO.h"
 #include "IECore/MemoryIndexedIO.h"
+#include "IECore/PackedIndexedIO.h"
 #include "IECore/VectorTypedData.h"
 #include "IECore/SimpleTypedData.h"
 
@@ -56,6 +57,7 @@ void bindIndexedIOBase();
 void bindStreamIndexedIO();
 void bindFileIndexedIO();
 void bindMemoryIndexedIO();
+void bindPackedIndexedIO();
 
 void bindIndexedIO()
 {
@@ -63,6 +65,7 @@ void bindIndexedIO()
 	bindStreamIndexedIO();
 	bindFileIndexedIO();
 	bindMemoryIndexedIO();
+	bindPackedIndexedIO();
 }
 
 struct IndexedIOHelper
@@ -417,6 +420,10 @@ void bindFileIndexedIO()
 		.def("__init__", make_constructor( &IndexedIOHelper::constructorAtRoot<FileIndexedIO, const std::string &> ) )
 		.def("__init__", make_constructor( &IndexedIOHelper::constructor<FileIndexedIO, const std::string &> ) )
 		.def( "fileName", make_function( &FileIndexedIO::fileName, return_value_policy<copy_const_reference>() ) )
+		.def( "setMaxOpenFiles", &FileIndexedIO::setMaxOpenFiles ).staticmethod( "setMaxOpenFiles" )
+		.def( "getMaxOpenFiles", &FileIndexedIO::getMaxOpenFiles ).staticmethod( "getMaxOpenFiles" )
+		.def( "numOpenFiles", &FileIndexedIO::numOpenFiles ).staticmethod( "numOpenFiles" )
+		.def( "numReopens", &FileIndexedIO::numReopens ).staticmethod( "numReopens" )
 	;
 }
 
@@ -434,3 +441,12 @@ void bindMemoryIndexedIO()
 		.def( "buffer", memoryIndexedIOBufferWrapper )
 	;
 }
+
+void bindPackedIndexedIO()
+{
+	IECorePython::RunTimeTypedClass<PackedIndexedIO>()
+		.def("__init__", make_constructor( &IndexedIOHelper::constructorAtRoot<PackedIndexedIO, ConstCharVectorDataPtr> ) )
+		.def("__init__", make_constructor( &IndexedIOHelper::constructor<PackedIndexedIO, ConstCharVectorDataPtr> ) )
+		.def( "buffer", &PackedIndexedIO::buffer )
+	;
+}
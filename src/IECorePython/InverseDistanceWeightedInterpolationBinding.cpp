@@ -45,6 +45,7 @@
 #include "IECore/VectorTypedData.h"
 
 #include "IECorePython/InverseDistanceWeightedInterpolationBinding.h"
+#include "IECorePython/ScopedGILRelease.h"
 
 using namespace boost::python;
 using namespace IECore;
@@ -113,18 +114,10 @@ struct InverseDistanceWeightedInterpolationWrapper
 		assert(m_idw);
 		
 		ValueDataPtr resultData = new ValueData;
-		std::vector<typename T::Value> &v = resultData->writable();
-		
-		const std::vector<typename T::Point> &p = pData->readable();
-		
-		v.resize( p.size() );
-		
-		typename T::NeighbourVector neighbours;
-		for( unsigned i=0; i<p.size(); i++ )
-		{
-			v[i] = (*m_idw)( p[i], neighbours );
-		}
-		
+
+		ScopedGILRelease gilRelease;
+		(*m_idw)( pData->readable(), resultData->writable() );
+
 		return resultData;
 	}
 	
@@ -91,6 +91,7 @@ void bindObject()
 		.def( "load", (ObjectPtr (*)( ConstIndexedIOPtr, const IndexedIO::EntryID & ) )&Object::load )
 		.staticmethod( "load" )
 		.def( "save", (void (Object::*)( IndexedIOPtr, const IndexedIO::EntryID & )const )&Object::save )
+		.def( "save", (void (Object::*)( IndexedIOPtr, const IndexedIO::EntryID &, bool )const )&Object::save )
 		.def( "memoryUsage", (size_t (Object::*)()const )&Object::memoryUsage, "Returns the number of bytes this instance occupies in memory" )
 		.def( "hash", (MurmurHash (Object::*)() const)&Object::hash )
 		.def( "hash", (void (Object::*)( MurmurHash & ) const)&Object::hash )
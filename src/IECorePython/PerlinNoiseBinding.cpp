@@ -38,6 +38,7 @@
 #include "IECore/VectorTypedData.h"
 
 #include "IECorePython/PerlinNoiseBinding.h"
+#include "IECorePython/ScopedGILRelease.h"
 
 using namespace boost;
 using namespace boost::python;
@@ -54,13 +55,8 @@ static typename TypedData<vector<typename T::Value> >::Ptr noiseVector( const T
 	{
 		v = new TypedData<vector<typename T::Value> >;
 	}
-	vector<typename T::Value> &vv = v->writable();
-	const vector<typename T::Point> &pp = p->readable();
-	vv.resize( pp.size() );
-	for( typename vector<typename T::Point>::size_type i=0; i<pp.size(); i++ )
-	{
-		vv[i] = n.noise( pp[i] );
-	}
+	ScopedGILRelease gilRelease;
+	n.noise( p->readable(), v->writable() );
 	return v;
 }
 
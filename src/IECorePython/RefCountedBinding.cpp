@@ -79,6 +79,9 @@ void bindRefCounted()
 		.def( "__hash__", hash )
 		.def( "isSame", &is )
 		.def( "refCount", &RefCounted::refCount )
+		.def( "pooledAllocation", &RefCounted::pooledAllocation ).staticmethod( "pooledAllocation" )
+		.def( "numAllocations", &RefCounted::numAllocations ).staticmethod( "numAllocations" )
+		.def( "numSystemAllocations", &RefCounted::numSystemAllocations ).staticmethod( "numSystemAllocations" )
 		.def( "numWrappedInstances", &WrapperGarbageCollector::numWrappedInstances ).staticmethod( "numWrappedInstances" )
 		.add_static_property( "garbageCollectionThreshold", &WrapperGarbageCollector::getCollectThreshold, &WrapperGarbageCollector::setCollectThreshold )
 		.def( "collectGarbage", &WrapperGarbageCollector::collect ).staticmethod( "collectGarbage" )
@@ -35,15 +35,36 @@
 #include "boost/python.hpp"
 
 #include "IECore/Turbulence.h"
+#include "IECore/VectorTypedData.h"
 #include "IECorePython/TurbulenceBinding.h"
+#include "IECorePython/ScopedGILRelease.h"
 
 using namespace boost;
 using namespace boost::python;
+using namespace std;
 using namespace IECore;
 
 namespace IECorePython
 {
 
+template<typename T>
+static typename TypedData<vector<typename T::Value> >::Ptr turbulenceVector( const T &t, typename TypedData<vector<typename T::Point> >::Ptr p, typename TypedData<vector<typename T::Value> >::Ptr v = 0 )
+{
+	if( !v )
+	{
+		v = new TypedData<vector<typename T::Value> >;
+	}
+	ScopedGILRelease gilRelease;
+	t.turbulence( p->readable(), v->writable() );
+	return v;
+}
+
+template<typename T>
+static typename TypedData<vector<typename T::Value> >::Ptr turbulenceVector2( const T &t, typename TypedData<vector<typename T::Point> >::Ptr p )
+{
+	return turbulenceVector<T>( t, p );
+}
+
 template<typename T>
 void bindTurb( const char *name )
 {
@@ -57,6 +78,8 @@ void bindTurb( const char *name )
 			) )
 		.def( "turbulence", (typename T::Value (T::*)( const typename T::Point & ) const )&T::turbulence )
 		.def( "turbulence", (typename T::Value (T::*)( const typename T::Point &, typename T::PointBaseType ) const )&T::turbulence )
+		.def( "turbulenceVector", &turbulenceVector<T>, "Returns an array of turbulence values when given an array of points. Optionally the values array to be filled may be passed as the last argument - if not specified then a new array is created." )
+		.def( "turbulenceVector", &turbulenceVector2<T> )
 		.add_property( "octaves", &T::getOctaves, &T::setOctaves )
 		.add_property( "gain", make_function( &T::getGain, return_value_policy<copy_const_reference>() ), &T::setGain )
 		.add_property( "lacunarity", &T::getLacunarity, &T::setLacunarity )
@@ -296,6 +296,7 @@
 #include "IECorePython/StandardRadialLensModelBinding.h"
 #include "IECorePython/LensDistortOpBinding.h"
 #include "IECorePython/ObjectPoolBinding.h"
+#include "IECorePython/DiskObjectCacheBinding.h"
 #include "IECorePython/EXRDeepImageReaderBinding.h"
 #include "IECorePython/EXRDeepImageWriterBinding.h"
 #include "IECorePython/ExternalProceduralBinding.h"
@@ -592,6 +593,7 @@ BOOST_PYTHON_MODULE(_IECore)
 	bindStandardRadialLensModel();
 	bindLensDistortOp();
 	bindObjectPool();
+	bindDiskObjectCache();
 	bindExternalProcedural();
 	bindClippingPlane();
 
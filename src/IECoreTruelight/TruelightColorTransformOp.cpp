@@ -190,6 +190,12 @@ void TruelightColorTransformOp::transform( Imath::Color3f &color ) const
 	}
 }
 
+void TruelightColorTransformOp::transformSpan( float *r, float *g, float *b, size_t n ) const
+{
+	tbb::mutex::scoped_lock lock( m_instanceMutex );
+	ColorTransformOp::transformSpan( r, g, b, n );
+}
+
 void TruelightColorTransformOp::maybeWarn() const
 {
 	assert( m_instance );
@@ -0,0 +1,156 @@
+//////////////////////////////////////////////////////////////////////////
+//
+//  Copyright (c) 2013, Image Engine Design Inc. All rights reserved.
+//
+//  Redistribution and use in source and binary forms, with or without
+//  modification, are permitted provided that the following conditions are
+//  met:
+//
+//     * Redistributions of source code must retain the above copyright
+//       notice, this list of conditions and the following disclaimer.
+//
+//     * Redistributions in binary form must reproduce the above copyright
+//       notice, this list of conditions and the following disclaimer in the
+//       documentation and/or other materials provided with the distribution.
+//
+//     * Neither the name of Image Engine Design nor the names of any
+//       other contributors to this software may be used to endorse or
+//       promote products derived from this software without specific prior
+//       written permission.
+//
+//  THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS
+//  IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO,
+//  THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR
+//  PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER OR
+//  CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+//  EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+//  PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR
+//  PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF
+//  LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING
+//  NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+//  SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+//
+//////////////////////////////////////////////////////////////////////////
+
+#include <stdint.h>
+
+#include "IECore/AlignedAllocator.h"
+
+#include "AlignedAllocatorTest.h"
+
+using namespace boost;
+using namespace boost::unit_test;
+
+namespace IECore
+{
+
+struct AlignedAllocatorTest
+{
+
+	template<typename T, size_t Alignment>
+	static bool aligned( const typename AlignedVector<T, Alignment>::Type &v )
+	{
+		return ( reinterpret_cast<uintptr_t>( &v[0] ) % Alignment ) == 0;
+	}
+
+	void testAlignment()
+	{
+		AlignedVector<float>::Type v;
+		for( int i = 0; i < 1000; i++ )
+		{
+			v.push_back( i );
+			BOOST_CHECK( ( aligned<float, 64>( v ) ) );
+		}
+
+		v.resize( 100000 );
+		BOOST_CHECK( ( aligned<float, 64>( v ) ) );
+		for( int i = 0; i < 1000; i++ )
+		{
+			BOOST_CHECK_EQUAL( v[i], i );
+		}
+
+		AlignedVector<double, 32>::Type d( 10, 1.0 );
+		BOOST_CHECK( ( aligned<double, 32>( d ) ) );
+
+		AlignedVector<char>::Type c( 1 );
+		BOOST_CHECK( ( aligned<char, 64>( c ) ) );
+	}
+
+	void testCopy()
+	{
+		AlignedVector<int>::Type v;
+		for( int i = 0; i < 100; i++ )
+		{
+			v.push_back( i * 2 );
+		}
+
+		AlignedVector<int>::Type c( v );
+		BOOST_CHECK( c == v );
+		BOOST_CHECK( &c[0] != &v[0] );
+		BOOST_CHECK( ( aligned<int, 64>( c ) ) );
+
+		AlignedVector<int>::Type s;
+		s.swap( c );
+		BOOST_CHECK( s == v );
+		BOOST_CHECK( c.empty() );
+	}
+
+	void testAdoption()
+	{
+		AlignedAllocator<int> allocator;
+		int *buffer = allocator.allocate( 50 );
+		for( int i = 0; i < 50; i++ )
+		{
+			buffer[i] = i * 3;
+		}
+
+		// the vector takes ownership of the buffer without
+		// copying or initialising it.
+		AlignedVector<int>::Type v( 50, AlignedAllocator<int>( buffer, 50 ) );
+		BOOST_CHECK( &v[0] == buffer );
+		for( int i = 0; i < 50; i++ )
+		{
+			BOOST_CHECK_EQUAL( v[i], i * 3 );
+		}
+
+		// the buffer is only adopted once, so copies
+		// get their own storage.
+		AlignedVector<int>::Type c( v );
+		BOOST_CHECK( &c[0] != buffer );
+		BOOST_CHECK( c == v );
+
+		v.resize( 200 );
+		BOOST_CHECK( &v[0] != buffer );
+		for( int i = 0; i < 50; i++ )
+		{
+			BOOST_CHECK_EQUAL( v[i], i * 3 );
+		}
+
+		// a buffer which is never allocated is freed
+		// along with the last copy of the allocator.
+		AlignedAllocator<int> a( allocator.allocate( 10 ), 10 );
+		AlignedAllocator<char> b( a );
+		AlignedVector<char>::Type unused( 5, b );
+		BOOST_CHECK( ( aligned<char, 64>( unused ) ) );
+	}
+
+};
+
+struct AlignedAllocatorTestSuite : public boost::unit_test::test_suite
+{
+
+	AlignedAllocatorTestSuite() : boost::unit_test::test_suite( "AlignedAllocatorTestSuite" )
+	{
+		boost::shared_ptr<AlignedAllocatorTest> instance( new AlignedAllocatorTest() );
+		add( BOOST_CLASS_TEST_CASE( &AlignedAllocatorTest::testAlignment, instance ) );
+		add( BOOST_CLASS_TEST_CASE( &AlignedAllocatorTest::testCopy, instance ) );
+		add( BOOST_CLASS_TEST_CASE( &AlignedAllocatorTest::testAdoption, instance ) );
+	}
+};
+
+void addAlignedAllocatorTest( boost::unit_test::test_suite *test )
+{
+	test->add( new AlignedAllocatorTestSuite() );
+}
+
+} // namespace IECore
@@ -133,6 +133,7 @@ from LineSegmentTest import *
 from CubicBasisTest import *
 from CurvesPrimitiveTest import *
 from ImageDiffOp import *
+from HdrMergeOpTest import *
 from TriangulatorTest import *
 from BezierAlgoTest import *
 from MeshNormalsOpTest import *
@@ -250,6 +251,7 @@ from LinkedSceneTest import LinkedSceneTest
 from StandardRadialLensModelTest import StandardRadialLensModelTest
 from LensDistortOpTest import LensDistortOpTest
 from ObjectPoolTest import ObjectPoolTest
+from DiskObjectCacheTest import DiskObjectCacheTest
 from RefCountedTest import RefCountedTest
 from ExternalProceduralTest import ExternalProceduralTest
 from ClippingPlaneTest import ClippingPlaneTest
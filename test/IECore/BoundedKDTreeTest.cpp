@@ -0,0 +1,158 @@
+//////////////////////////////////////////////////////////////////////////
+//
+//  Copyright (c) 2013, Image Engine Design Inc. All rights reserved.
+//
+//  Redistribution and use in source and binary forms, with or without
+//  modification, are permitted provided that the following conditions are
+//  met:
+//
+//     * Redistributions of source code must retain the above copyright
+//       notice, this list of conditions and the following disclaimer.
+//
+//     * Redistributions in binary form must reproduce the above copyright
+//       notice, this list of conditions and the following disclaimer in the
+//       documentation and/or other materials provided with the distribution.
+//
+//     * Neither the name of Image Engine Design nor the names of any
+//       other contributors to this software may be used to endorse or
+//       promote products derived from this software without specific prior
+//       written permission.
+//
+//  THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS
+//  IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO,
+//  THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR
+//  PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER OR
+//  CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+//  EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+//  PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR
+//  PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF
+//  LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING
+//  NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+//  SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+//
+//////////////////////////////////////////////////////////////////////////
+
+#include <vector>
+#include <algorithm>
+
+#include "OpenEXR/ImathRandom.h"
+
+#include "BoundedKDTreeTest.h"
+
+#include "IECore/BoundedKDTree.h"
+#include "IECore/VectorTraits.h"
+
+using namespace boost;
+using namespace boost::unit_test;
+using namespace Imath;
+
+namespace IECore
+{
+
+template<typename T>
+struct BoundedKDTreeTest
+{
+
+	typedef typename T::Bound Bound;
+	typedef typename T::BaseType Vec;
+	typedef typename VectorTraits<Vec>::BaseType Real;
+	typedef std::vector<Bound> BoundVector;
+
+	// Moves the bounds in place and checks that after update() the tree gives
+	// the same results as a tree built from scratch for the new bounds.
+	void testUpdate()
+	{
+		Rand32 r( 10 );
+
+		BoundVector bounds;
+		for( unsigned i = 0; i < 2000; ++i )
+		{
+			bounds.push_back( randomBound( r, 0.05 ) );
+		}
+
+		T tree( bounds.begin(), bounds.end() );
+
+		for( unsigned iteration = 0; iteration < 3; ++iteration )
+		{
+			for( typename BoundVector::iterator it = bounds.begin(); it != bounds.end(); ++it )
+			{
+				const Vec offset = randomVec( r ) * Real( 0.2 ) - Vec( Real( 0.1 ) );
+				const Real growth = r.nextf( 0, 0.02 );
+				it->min += offset - Vec( growth );
+				it->max += offset + Vec( growth );
+			}
+
+			tree.update();
+			T freshTree( bounds.begin(), bounds.end() );
+
+			for( unsigned i = 0; i < 200; ++i )
+			{
+				const Bound query = randomBound( r, 0.2 );
+
+				std::vector<typename T::Iterator> updated;
+				tree.intersectingBounds( query, updated );
+				std::sort( updated.begin(), updated.end() );
+
+				std::vector<typename T::Iterator> fresh;
+				freshTree.intersectingBounds( query, fresh );
+				std::sort( fresh.begin(), fresh.end() );
+
+				BOOST_CHECK( updated == fresh );
+
+				std::vector<typename T::Iterator> expected;
+				for( typename BoundVector::const_iterator it = bounds.begin(); it != bounds.end(); ++it )
+				{
+					if( it->intersects( query ) )
+					{
+						expected.push_back( it );
+					}
+				}
+
+				BOOST_CHECK( updated == expected );
+			}
+		}
+	}
+
+	Vec randomVec( Rand32 &r )
+	{
+		Vec v;
+		for( unsigned i = 0; i < VectorTraits<Vec>::dimensions(); ++i )
+		{
+			v[i] = r.nextf();
+		}
+		return v;
+	}
+
+	Bound randomBound( Rand32 &r, Real maxSize )
+	{
+		const Vec min = randomVec( r );
+		return Bound( min, min + randomVec( r ) * maxSize );
+	}
+
+};
+
+struct BoundedKDTreeTestSuite : public boost::unit_test::test_suite
+{
+
+	BoundedKDTreeTestSuite() : boost::unit_test::test_suite( "BoundedKDTreeTestSuite" )
+	{
+		addTest<Box3fTree>();
+		addTest<Box3dTree>();
+		addTest<Box2fTree>();
+		addTest<Box2dTree>();
+	}
+
+	template<typename T>
+	void addTest()
+	{
+		boost::shared_ptr<BoundedKDTreeTest<T> > instance( new BoundedKDTreeTest<T>() );
+		add( BOOST_CLASS_TEST_CASE( &BoundedKDTreeTest<T>::testUpdate, instance ) );
+	}
+};
+
+void addBoundedKDTreeTest( boost::unit_test::test_suite *test )
+{
+	test->add( new BoundedKDTreeTestSuite() );
+}
+
+} // namespace IECore
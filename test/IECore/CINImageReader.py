@@ -126,6 +126,22 @@ class TestCINReader(unittest.TestCase):
 
 		self.assert_( ( color - expectedColor).length() < 1.e-3 )
 
+	def testDataWindowReadMatchesCrop( self ) :
+
+		# the windows span the boundaries between the blocks
+		# of scanlines which are read from the file.
+		r = CINImageReader( "test/IECore/data/cinFiles/uvMap.512x256.cin" )
+		full = r.read()
+		for window in (
+			Box2i( V2i( 100, 20 ), V2i( 300, 250 ) ),
+			Box2i( V2i( 0, 255 ), V2i( 511, 255 ) ),
+			Box2i( V2i( 0, 63 ), V2i( 511, 64 ) ),
+		) :
+			r["dataWindow"].setValue( Box2iData( window ) )
+			expected = ImageCropOp()( input = full, cropBox = window, matchDataWindow = False, resetOrigin = False )
+			expected.displayWindow = full.displayWindow
+			self.assertEqual( r.read(), expected )
+
 	def testChannelRead(self):
 
 		# create a reader, constrain to a sub-image, R and G channels
@@ -34,6 +34,7 @@
 
 import unittest
 import threading
+import shutil
 
 from IECore import *
 import os
@@ -262,5 +263,107 @@ class CachedReaderTest( unittest.TestCase ) :
 		t2.join()
 		t3.join()
 		
+	__syntheticDirectory = "test/IECore/cachedReaderSynthetic"
+
+	def __writeSyntheticFiles( self, numFiles, size ) :
+
+		if not os.path.exists( self.__syntheticDirectory ) :
+			os.makedirs( self.__syntheticDirectory )
+
+		files = []
+		for i in range( 0, numFiles ) :
+			f = os.path.join( self.__syntheticDirectory, "file%d.cob" % i )
+			ObjectWriter( IntVectorData( [ i ] * size ), f ).write()
+			files.append( f )
+
+		return files
+
+	def __countingPostProcessor( self ) :
+
+		class PostProcessor( ModifyOp ) :
+
+			def __init__( self ) :
+
+				ModifyOp.__init__( self, "", Parameter( "result", "", NullObject() ), Parameter( "input", "", NullObject() ) )
+				self.count = 0
+
+			def modify( self, obj, args ) :
+
+				self.count += 1
+
+		return PostProcessor()
+
+	def testReadAsync( self ) :
+
+		files = self.__writeSyntheticFiles( 20, 1000 )
+
+		p = self.__countingPostProcessor()
+		r = CachedReader( SearchPath( "./", ":" ), p, ObjectPool( 100 * 1024 * 1024 ) )
+
+		futures = [ r.readAsync( f ) for f in files ]
+		# duplicate requests are coalesced with the ones in flight
+		futures += [ r.readAsync( f ) for f in files ]
+
+		for i, f in enumerate( futures ) :
+			self.assertEqual( f.get(), IntVectorData( [ i % len( files ) ] * 1000 ) )
+			self.assertTrue( f.isReady() )
+
+		r.waitForPendingReads()
+		self.assertEqual( p.count, len( files ) )
+		for f in files :
+			self.assertTrue( r.cached( f ) )
+
+		# cached files are returned without loading
+		self.assertEqual( r.readAsync( files[0] ).get(), IntVectorData( [ 0 ] * 1000 ) )
+		self.assertEqual( p.count, len( files ) )
+
+		# errors are reported by get()
+		f = r.readAsync( "doesNotExist" )
+		self.assertRaises( RuntimeError, f.get )
+		self.assertRaises( RuntimeError, r.read, "doesNotExist" )
+
+	def testPrefetch( self ) :
+
+		files = self.__writeSyntheticFiles( 20, 1000 )
+
+		p = self.__countingPostProcessor()
+		r = CachedReader( SearchPath( "./", ":" ), p, ObjectPool( 100 * 1024 * 1024 ) )
+
+		r.prefetch( files + [ "doesNotExist" ] )
+		for i, f in enumerate( files ) :
+			self.assertEqual( r.read( f ), IntVectorData( [ i ] * 1000 ) )
+
+		r.waitForPendingReads()
+		self.assertEqual( p.count, len( files ) )
+		for f in files :
+			self.assertTrue( r.cached( f ) )
+		self.assertRaises( RuntimeError, r.read, "doesNotExist" )
+
+	def testPrefetchRespectsMemoryLimit( self ) :
+
+		files = self.__writeSyntheticFiles( 100, 10000 )
+		fileSize = IntVectorData( [ 0 ] * 10000 ).memoryUsage()
+
+		p = self.__countingPostProcessor()
+		pool = ObjectPool( fileSize * 2 )
+		r = CachedReader( SearchPath( "./", ":" ), p, pool )
+
+		r.prefetch( files )
+		r.waitForPendingReads()
+
+		# a few loads may already be in flight when the pool fills up, but
+		# most of the files shouldn't have been loaded at all.
+		self.assertTrue( p.count >= 2 )
+		self.assertTrue( p.count < len( files ) / 2 )
+		self.assertTrue( pool.memoryUsage() <= fileSize * 2 )
+
+		# files which weren't prefetched can still be read
+		self.assertEqual( r.read( files[-1] ), IntVectorData( [ 99 ] * 10000 ) )
+
+	def tearDown( self ) :
+
+		if os.path.exists( self.__syntheticDirectory ) :
+			shutil.rmtree( self.__syntheticDirectory )
+
 if __name__ == "__main__":
     unittest.main()
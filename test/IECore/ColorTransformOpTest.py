@@ -195,6 +195,32 @@ class TestPythonColorTransformOp( unittest.TestCase ) :
 		self.assertEqual( o.numTransforms, 1 )
 		self.assertEqual( o.numEnds, 1 )
 
+	def testManySpans( self ) :
+
+		# enough elements to be split into many spans and processed
+		# in parallel, with a partial span at the end.
+		n = 100003
+		r = Rand32()
+		p = PointsPrimitive( n )
+		for c in "RGBA" :
+			p[c] = PrimitiveVariable( PrimitiveVariable.Interpolation.Vertex, FloatVectorData( [ r.nextf() for i in range( 0, n ) ] ) )
+
+		cs = Color3fVectorData( [ Color3f( p["R"].data[i], p["G"].data[i], p["B"].data[i] ) for i in range( 0, n ) ] )
+		p["Cs"] = PrimitiveVariable( PrimitiveVariable.Interpolation.Vertex, cs )
+
+		o = Grade()
+		o["gain"] = Color3f( 2, 0.5, 1 )
+		o["gamma"] = Color3f( 0.5, 1, 2 )
+
+		separate = o( input = p, colorPrimVar = "" )
+		interleaved = o( input = p, redPrimVar = "", greenPrimVar = "", bluePrimVar = "" )
+
+		for i in range( 0, n, 97 ) + [ n - 1 ] :
+			self.assertAlmostEqual( separate["R"].data[i], interleaved["Cs"].data[i][0], 5 )
+			self.assertAlmostEqual( separate["G"].data[i], interleaved["Cs"].data[i][1], 5 )
+			self.assertAlmostEqual( separate["B"].data[i], interleaved["Cs"].data[i][2], 5 )
+
+
 if __name__ == "__main__":
 	unittest.main()
 
@@ -222,7 +222,27 @@ class testCompoundObject( unittest.TestCase ) :
 			else :
 				self.assertEqual( h, o.hash() )
 			h = o.hash()
-	
+
+	def testManyMembers( self ) :
+
+		o = IECore.CompoundObject()
+		for i in range( 0, 2000 ) :
+			c = IECore.CompoundObject()
+			for j in range( 0, 10 ) :
+				c["member%d" % j] = IECore.IntData( j )
+			o["child%d" % i] = c
+
+		self.assertEqual( len( o ), 2000 )
+		self.assertEqual( o.copy(), o )
+		self.assertEqual( o.copy().hash(), o.hash() )
+
+		m = IECore.MemoryIndexedIO( IECore.CharVectorData(), [], IECore.IndexedIO.OpenMode.Write )
+		o.save( m, "o" )
+		o2 = IECore.Object.load( m, "o" )
+		self.assertEqual( o2, o )
+		self.assertEqual( o2.hash(), o.hash() )
+		self.assertEqual( o2["child1999"]["member9"], IECore.IntData( 9 ) )
+
 if __name__ == "__main__":
         unittest.main()
 
@@ -222,5 +222,22 @@ class CompressAndDecompressSmoothSkinningDataOpsTest( unittest.TestCase ) :
 		self.assertEqual( result.pointInfluenceWeights(), ssd.pointInfluenceWeights() )
 		self.assertEqual( result, ssd )
 
+	def testDecompressingReordered( self ) :
+		""" Test DeompressSmoothSkinningDataOp with data of the decompressed size but in a different order"""
+		
+		names = StringVectorData( [ 'jointA', 'jointB', 'jointC' ] )
+		poses = M44fVectorData( [M44f(),M44f(),M44f()] )
+		offsets = IntVectorData( [0, 3, 6] )
+		counts = IntVectorData( [3, 3, 3] )
+		indices = IntVectorData( [2, 1, 0, 0, 1, 2, 1, 0, 2] )
+		weights = FloatVectorData( [0.0, 0.5, 0.5, 0.2, 0.8, 0.0, 1.0, 0.0, 0.0] )
+		ssd = SmoothSkinningData( names, poses, offsets, counts, indices, weights )
+		
+		op = DecompressSmoothSkinningDataOp()
+		op.parameters()['input'].setValue( ssd )
+		result = op.operate()
+		
+		self.assertEqual( result, self.decompressed() )
+
 if __name__ == "__main__":
     unittest.main()
@@ -34,6 +34,8 @@
 
 #include <iostream>
 
+#include "boost/filesystem/operations.hpp"
+
 #include "tbb/tbb.h"
 
 #include "IECore/ComputationCache.h"
@@ -209,6 +211,81 @@ struct ComputationCacheTest
 		BOOST_CHECK_EQUAL( size_t(500), cache.cachedComputations() );
 	}
 
+	void testDiskCache()
+	{
+		const std::string directory = "test/IECore/computationCacheDiskCache";
+		boost::filesystem::remove_all( directory );
+
+		DiskObjectCachePtr disk = new DiskObjectCache( directory, 1024 * 1024 );
+		BOOST_CHECK_EQUAL( directory, disk->directory() );
+		BOOST_CHECK_EQUAL( size_t(1024 * 1024), disk->getMaxDiskUsage() );
+		BOOST_CHECK_EQUAL( size_t(0), disk->diskUsage() );
+
+		Cache cache( get, hash, 1000, new ObjectPool( 10000 ), disk );
+		BOOST_CHECK_EQUAL( disk.get(), cache.diskCache() );
+
+		/// computing a value writes it through to disk
+		int c0 = ComputationCacheTest::getCount;
+		ConstObjectPtr v0 = cache.get( ComputationParams(7) );
+		BOOST_CHECK_EQUAL( c0 + 1, ComputationCacheTest::getCount );
+		BOOST_CHECK( disk->contains( hash( ComputationParams(7) ) ) );
+		BOOST_CHECK( disk->diskUsage() > 0 );
+
+		/// a separate cache sharing the directory, as another process would, gets
+		/// the result from disk without recomputing it.
+		Cache otherCache( get, hash, 1000, new ObjectPool( 10000 ), new DiskObjectCache( directory, 1024 * 1024 ) );
+		ConstObjectPtr v1 = otherCache.get( ComputationParams(7), Cache::NullIfMissing );
+		BOOST_CHECK( v1 );
+		BOOST_CHECK( *v0 == *v1 );
+		BOOST_CHECK_EQUAL( size_t(1), otherCache.cachedComputations() );
+		v1 = otherCache.get( ComputationParams(7) );
+		BOOST_CHECK( *v0 == *v1 );
+		BOOST_CHECK_EQUAL( c0 + 1, ComputationCacheTest::getCount );
+
+		/// and still finds it after the pool forgets about it
+		otherCache.objectPool()->clear();
+		BOOST_CHECK( otherCache.get( ComputationParams(7), Cache::ThrowIfMissing ) );
+		BOOST_CHECK_EQUAL( c0 + 1, ComputationCacheTest::getCount );
+
+		/// clearing the in-memory cache leaves the disk intact
+		cache.clear();
+		BOOST_CHECK( disk->contains( hash( ComputationParams(7) ) ) );
+
+		/// but erasing a computation removes it from disk too
+		cache.erase( ComputationParams(7) );
+		BOOST_CHECK( !disk->contains( hash( ComputationParams(7) ) ) );
+		BOOST_CHECK_EQUAL( size_t(0), disk->diskUsage() );
+
+		/// explicitly set values are written to disk as well
+		IntDataPtr v = new IntData( 42 );
+		cache.set( ComputationParams(8), v.get(), ObjectPool::StoreCopy );
+		ObjectPtr stored = disk->retrieve( hash( ComputationParams(8) ) );
+		BOOST_CHECK( stored );
+		BOOST_CHECK( *stored == *v );
+
+		/// limit the disk usage to a few entries, and check that pruning keeps us within it
+		const size_t entrySize = disk->diskUsage();
+		for( int i = 0; i < 20; i++ )
+		{
+			cache.get( ComputationParams( 100 + i ) );
+		}
+		BOOST_CHECK( disk->diskUsage() > 5 * entrySize );
+		disk->setMaxDiskUsage( 5 * entrySize );
+		BOOST_CHECK( disk->diskUsage() <= 5 * entrySize );
+		for( int i = 0; i < 20; i++ )
+		{
+			cache.get( ComputationParams( 200 + i ) );
+			BOOST_CHECK( disk->diskUsage() <= 5 * entrySize );
+		}
+		BOOST_CHECK( disk->diskUsage() > 0 );
+
+		disk->clear();
+		BOOST_CHECK_EQUAL( size_t(0), disk->diskUsage() );
+		BOOST_CHECK( !disk->retrieve( hash( ComputationParams(8) ) ) );
+
+		boost::filesystem::remove_all( directory );
+	}
+
 };
 
 int ComputationCacheTest::getCount(0);
@@ -222,6 +299,7 @@ struct ComputationCacheTestSuite : public boost::unit_test::test_suite
 
 		add( BOOST_CLASS_TEST_CASE( &ComputationCacheTest::test, instance ) );
 		add( BOOST_CLASS_TEST_CASE( &ComputationCacheTest::testThreadedGet, instance ) );
+		add( BOOST_CLASS_TEST_CASE( &ComputationCacheTest::testDiskCache, instance ) );
 	}
 };
 
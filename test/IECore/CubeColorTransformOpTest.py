@@ -303,6 +303,62 @@ class CubeColorTransformOpTest( unittest.TestCase ) :
                 self.failIf( res.value )
 
 
+	def testBake( self ) :
+
+		grade = Grade()
+		grade['gain'] = Color3f( 0.5, 0.75, 1 )
+		grade['offset'] = Color3f( 0.1, 0, 0.2 )
+
+		invert = CubeColorTransformOp()
+		invert['cube'] = CubeColorLookupfData(
+			CubeColorLookupf(
+				V3i( 2, 2, 2 ),
+				Color3fVectorData( [
+					Color3f( 1, 1, 1 ), Color3f( 1, 1, 0 ), Color3f( 1, 0, 1 ), Color3f( 1, 0, 0 ),
+					Color3f( 0, 1, 1 ), Color3f( 0, 1, 0 ), Color3f( 0, 0, 1 ), Color3f( 0, 0, 0 ),
+				] )
+			)
+		)
+
+		gradeInput = grade["input"].getValue()
+		invertInput = invert["input"].getValue()
+
+		# both ops are linear, so the baked lookup should be exact
+		cube = CubeColorTransformOp.bake( [ grade, invert ], V3i( 5 ), tolerance = 0.0001 )
+
+		# the chain should be left untouched
+		self.failUnless( grade["input"].getValue().isSame( gradeInput ) )
+		self.failUnless( invert["input"].getValue().isSame( invertInput ) )
+		self.assertEqual( grade["copy"].getTypedValue(), True )
+		self.assertEqual( invert["copy"].getTypedValue(), True )
+		self.assert_( isinstance( cube, CubeColorLookupfData ) )
+		self.assertEqual( cube.value.dimension(), V3i( 5 ) )
+
+		window = Box2i( V2i( 0 ), V2i( 63, 31 ) )
+		img = ImagePrimitive( window, window )
+		n = img.variableSize( PrimitiveVariable.Interpolation.Vertex )
+		r = Rand32()
+		for c in "RGB" :
+			img[c] = PrimitiveVariable( PrimitiveVariable.Interpolation.Vertex, FloatVectorData( [ r.nextf() for i in range( 0, n ) ] ) )
+
+		expected = invert( input = grade( input = img ) )
+		baked = CubeColorTransformOp()( input = img, cube = cube )
+
+		for c in "RGB" :
+			for i in range( 0, n ) :
+				self.assertAlmostEqual( baked[c].data[i], expected[c].data[i], 4 )
+
+	def testBakeTolerance( self ) :
+
+		grade = Grade()
+		grade['gamma'] = Color3f( 3 )
+
+		self.assertRaises( RuntimeError, CubeColorTransformOp.bake, [ grade ], V3i( 2 ), tolerance = 0.001 )
+		self.assertRaises( RuntimeError, CubeColorTransformOp.bake, [ grade ], V3i( 1 ) )
+
+		cube = CubeColorTransformOp.bake( [ grade ], V3i( 2 ) )
+		self.assertEqual( cube.value.dimension(), V3i( 2 ) )
+
 
 if __name__ == "__main__":
 	unittest.main()
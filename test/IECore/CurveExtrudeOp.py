@@ -58,6 +58,47 @@ class CurveExtrudeOpTest( unittest.TestCase ) :
 
 			self.assert_( child.arePrimitiveVariablesValid() )
 
+	def curvesWithPOnly( self, curves, curveIndices ) :
+
+		p = curves["P"].data
+		verticesPerCurve = curves.verticesPerCurve()
+		offsets = [ 0 ]
+		for n in verticesPerCurve :
+			offsets.append( offsets[-1] + n )
+
+		newVerticesPerCurve = IECore.IntVectorData()
+		newP = IECore.V3fVectorData()
+		for i in curveIndices :
+			newVerticesPerCurve.append( verticesPerCurve[i] )
+			newP.extend( p[offsets[i]:offsets[i+1]] )
+
+		return IECore.CurvesPrimitive( newVerticesPerCurve, curves.basis(), curves.periodic(), newP )
+
+	def testParallelResultsMatchIndividualCurves( self ) :
+
+		c = IECore.Reader.create( "test/IECore/data/cobFiles/torusCurves.cob" ).read()
+		c = self.curvesWithPOnly( c, range( 0, c.numCurves() ) )
+
+		patchGroup = IECore.CurveExtrudeOp()( curves = c, resolution = IECore.V2i( 6, 30 ) )
+		self.assertEqual( len( patchGroup.children() ), c.numCurves() )
+
+		for i in range( 0, c.numCurves(), 16 ) :
+
+			individual = IECore.CurveExtrudeOp()( curves = self.curvesWithPOnly( c, [ i ] ), resolution = IECore.V2i( 6, 30 ) )
+			self.assertEqual( len( individual.children() ), 1 )
+			self.assertEqual( individual.children()[0], patchGroup.children()[i] )
+
+	def testPeriodicCurvesRaise( self ) :
+
+		c = IECore.CurvesPrimitive(
+			IECore.IntVectorData( [ 4, 4 ] ),
+			IECore.CubicBasisf.bSpline(),
+			True,
+			IECore.V3fVectorData( [ IECore.V3f( i, i % 2, 0 ) for i in range( 0, 8 ) ] )
+		)
+
+		self.assertRaises( RuntimeError, IECore.CurveExtrudeOp(), curves = c )
+
 if __name__ == "__main__":
     unittest.main()
 
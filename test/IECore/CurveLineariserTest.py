@@ -325,6 +325,51 @@ class CurveLineariserTest( unittest.TestCase ) :
 		
 		self.runTest( c )
 			
+	def manyCurves( self, numCurves ) :
+
+		r = IECore.Rand32( 10 )
+		verticesPerCurve = IECore.IntVectorData()
+		p = IECore.V3fVectorData()
+		for i in range( 0, numCurves ) :
+			n = 4 + int( r.nextf( 0, 6 ) )
+			verticesPerCurve.append( n )
+			for j in range( 0, n ) :
+				p.append( r.nextV3f() + IECore.V3f( j, 0, 0 ) )
+
+		c = IECore.CurvesPrimitive( verticesPerCurve, IECore.CubicBasisf.catmullRom(), False, p )
+		c["Cs"] = IECore.PrimitiveVariable( IECore.PrimitiveVariable.Interpolation.Vertex, IECore.Color3fVectorData( [ IECore.Color3f( x.x, x.y, x.z ) for x in p ] ) )
+		c["width"] = IECore.PrimitiveVariable( IECore.PrimitiveVariable.Interpolation.Varying, IECore.FloatVectorData( [ r.nextf() for x in range( 0, c.variableSize( IECore.PrimitiveVariable.Interpolation.Varying ) ) ] ) )
+
+		return c
+
+	def testParallelResultsMatchIndividualCurves( self ) :
+
+		c = self.manyCurves( 500 )
+		c2 = IECore.CurveLineariser()( input=c, verticesPerSegment=7.5 )
+		self.assert_( c2.arePrimitiveVariablesValid() )
+
+		vertexOffset = 0
+		varyingOffset = 0
+		pOffset = 0
+		for i in range( 0, c.numCurves() ) :
+
+			n = c.verticesPerCurve()[i]
+			nVarying = c.variableSize( IECore.PrimitiveVariable.Interpolation.Varying, i )
+
+			single = IECore.CurvesPrimitive( IECore.IntVectorData( [ n ] ), c.basis(), False, c["P"].data[vertexOffset:vertexOffset+n] )
+			single["Cs"] = IECore.PrimitiveVariable( IECore.PrimitiveVariable.Interpolation.Vertex, c["Cs"].data[vertexOffset:vertexOffset+n] )
+			single["width"] = IECore.PrimitiveVariable( IECore.PrimitiveVariable.Interpolation.Varying, c["width"].data[varyingOffset:varyingOffset+nVarying] )
+			single = IECore.CurveLineariser()( input=single, verticesPerSegment=7.5 )
+
+			n2 = c2.verticesPerCurve()[i]
+			self.assertEqual( single.verticesPerCurve()[0], n2 )
+			for k in ( "P", "Cs", "width" ) :
+				self.assertEqual( single[k].data, c2[k].data[pOffset:pOffset+n2] )
+
+			vertexOffset += n
+			varyingOffset += nVarying
+			pOffset += n2
+
 if __name__ == "__main__":
 	unittest.main()
 
@@ -78,6 +78,20 @@ class TestDPXReader(unittest.TestCase):
 		self.assertEqual( h['displayWindow'], Box2iData( Box2i( V2i(0,0), V2i(511,255) ) ) )
 		self.assertEqual( h['dataWindow'], Box2iData( Box2i( V2i(0,0), V2i(511,255) ) ) )
 
+	def testDataWindowRead( self ) :
+
+		r = DPXImageReader( "test/IECore/data/dpx/uvMap.512x256.dpx" )
+		full = r.read()
+		for window in (
+			Box2i( V2i( 100, 20 ), V2i( 300, 250 ) ),
+			Box2i( V2i( 0, 255 ), V2i( 511, 255 ) ),
+			Box2i( V2i( 0, 63 ), V2i( 511, 64 ) ),
+		) :
+			r["dataWindow"].setValue( Box2iData( window ) )
+			expected = ImageCropOp()( input = full, cropBox = window, matchDataWindow = False, resetOrigin = False )
+			expected.displayWindow = full.displayWindow
+			self.assertEqual( r.read(), expected )
+
 	def testOrientation( self ) :
 		""" Test orientation of DPX files """
 
@@ -37,9 +37,15 @@
 
 #include <cassert>
 #include <limits.h>
+#include <vector>
+#include <cmath>
+#include <algorithm>
+#include <limits>
 
 #include "boost/test/unit_test.hpp"
 #include "boost/test/floating_point_comparison.hpp"
+#include "boost/type_traits/is_same.hpp"
+#include "boost/math/special_functions/fpclassify.hpp"
 #include "boost/random.hpp"
 
 #include "IECore/HalfTypeTraits.h"
@@ -51,6 +57,10 @@
 #include "IECore/LinearToSRGBDataConversion.h"
 #include "IECore/Rec709ToLinearDataConversion.h"
 #include "IECore/LinearToRec709DataConversion.h"
+#include "IECore/AlexaLogcToLinearDataConversion.h"
+#include "IECore/LinearToAlexaLogcDataConversion.h"
+#include "IECore/PanalogToLinearDataConversion.h"
+#include "IECore/LinearToPanalogDataConversion.h"
 #include "IECore/CompoundDataConversion.h"
 
 using namespace Imath;
@@ -107,6 +117,69 @@ struct DataConversionTest
 		}
 	}
 
+	template<typename Func>
+	void testArrayConversion()
+	{
+		typedef typename Func::FromType F;
+		typedef typename Func::ToType T;
+
+		/// Cover the linear segments, the transition points and a generous
+		/// range of over-bright values, with enough values to span several
+		/// of the chunks the approximation is applied in.
+		std::vector<F> values;
+		for( int i = -200; i < 900; i++ )
+		{
+			values.push_back( F( i * 0.005f ) );
+		}
+
+		/// And values which are outside the domain of the approximations,
+		/// and must be converted exactly.
+		values.push_back( F( -1e20 ) );
+		values.push_back( F( 1e20 ) );
+		values.push_back( std::numeric_limits<F>::infinity() );
+		values.push_back( -std::numeric_limits<F>::infinity() );
+		values.push_back( std::numeric_limits<F>::quiet_NaN() );
+
+		std::vector<T> results( values.size() );
+		Func f;
+		f( &values[0], &results[0], values.size() );
+
+		for( size_t i = 0; i < values.size(); i++ )
+		{
+			const double expected = f( values[i] );
+			if( !boost::is_same<F, float>::value || !boost::math::isfinite( expected ) )
+			{
+				/// Only float values are approximated
+				checkIdentical( results[i], T( expected ) );
+			}
+			else
+			{
+				BOOST_CHECK_SMALL( double( results[i] ) - expected, std::max( fabs( expected ) * 1.e-5, 1.e-6 ) );
+			}
+		}
+
+		/// Converting in place should give the same results
+		std::vector<F> inPlace( values );
+		f( &inPlace[0], &inPlace[0], inPlace.size() );
+		for( size_t i = 0; i < values.size(); i++ )
+		{
+			checkIdentical( inPlace[i], F( results[i] ) );
+		}
+	}
+
+	template<typename T>
+	void checkIdentical( T a, T b )
+	{
+		if( boost::math::isnan( double( a ) ) || boost::math::isnan( double( b ) ) )
+		{
+			BOOST_CHECK( boost::math::isnan( double( a ) ) && boost::math::isnan( double( b ) ) );
+		}
+		else
+		{
+			BOOST_CHECK_EQUAL( double( a ), double( b ) );
+		}
+	}
+
 	template<typename F, typename T>
 	void testSignedScaled()
 	{
@@ -144,6 +217,35 @@ struct DataConversionTestSuite : public boost::unit_test::test_suite
 		testSRGBLinear( instance );
 		testRec709Linear( instance );
 		testSignedScaled( instance );
+		testArrayConversion( instance );
+	}
+
+	void testArrayConversion( boost::shared_ptr<DataConversionTest> instance )
+	{
+		void (DataConversionTest::*fn)() = 0;
+
+		fn = &DataConversionTest::testArrayConversion< SRGBToLinearDataConversion<float, float> >;
+		add( BOOST_CLASS_TEST_CASE( fn, instance ) );
+		fn = &DataConversionTest::testArrayConversion< LinearToSRGBDataConversion<float, float> >;
+		add( BOOST_CLASS_TEST_CASE( fn, instance ) );
+		fn = &DataConversionTest::testArrayConversion< Rec709ToLinearDataConversion<float, float> >;
+		add( BOOST_CLASS_TEST_CASE( fn, instance ) );
+		fn = &DataConversionTest::testArrayConversion< LinearToRec709DataConversion<float, float> >;
+		add( BOOST_CLASS_TEST_CASE( fn, instance ) );
+		fn = &DataConversionTest::testArrayConversion< AlexaLogcToLinearDataConversion<float, float> >;
+		add( BOOST_CLASS_TEST_CASE( fn, instance ) );
+		fn = &DataConversionTest::testArrayConversion< LinearToAlexaLogcDataConversion<float, float> >;
+		add( BOOST_CLASS_TEST_CASE( fn, instance ) );
+		fn = &DataConversionTest::testArrayConversion< PanalogToLinearDataConversion<float, float> >;
+		add( BOOST_CLASS_TEST_CASE( fn, instance ) );
+		fn = &DataConversionTest::testArrayConversion< LinearToPanalogDataConversion<float, float> >;
+		add( BOOST_CLASS_TEST_CASE( fn, instance ) );
+		fn = &DataConversionTest::testArrayConversion< SRGBToLinearDataConversion<double, double> >;
+		add( BOOST_CLASS_TEST_CASE( fn, instance ) );
+		fn = &DataConversionTest::testArrayConversion< LinearToAlexaLogcDataConversion<double, double> >;
+		add( BOOST_CLASS_TEST_CASE( fn, instance ) );
+		fn = &DataConversionTest::testArrayConversion< LinearToPanalogDataConversion<double, double> >;
+		add( BOOST_CLASS_TEST_CASE( fn, instance ) );
 	}
 
 	void testCineonLinear( boost::shared_ptr<DataConversionTest> instance )
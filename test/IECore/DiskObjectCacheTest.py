@@ -0,0 +1,149 @@
+##########################################################################
+#
+#  Copyright (c) 2014, Image Engine Design Inc. All rights reserved.
+#
+#  Redistribution and use in source and binary forms, with or without
+#  modification, are permitted provided that the following conditions are
+#  met:
+#
+#     * Redistributions of source code must retain the above copyright
+#       notice, this list of conditions and the following disclaimer.
+#
+#     * Redistributions in binary form must reproduce the above copyright
+#       notice, this list of conditions and the following disclaimer in the
+#       documentation and/or other materials provided with the distribution.
+#
+#     * Neither the name of Image Engine Design nor the names of any
+#       other contributors to this software may be used to endorse or
+#       promote products derived from this software without specific prior
+#       written permission.
+#
+#  THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS
+#  IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO,
+#  THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR
+#  PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER OR
+#  CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+#  EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+#  PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR
+#  PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF
+#  LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING
+#  NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+#  SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+#
+##########################################################################
+
+
+import os
+import shutil
+import unittest
+import threading
+
+from IECore import *
+
+class DiskObjectCacheTest( unittest.TestCase ) :
+
+	__directory = "test/IECore/diskObjectCache"
+
+	def setUp( self ) :
+
+		if os.path.exists( self.__directory ) :
+			shutil.rmtree( self.__directory )
+
+	def testConstructor( self ) :
+
+		c = DiskObjectCache( self.__directory, 1000 )
+		self.assertTrue( isinstance( c, DiskObjectCache ) )
+		self.assertTrue( os.path.isdir( self.__directory ) )
+		self.assertEqual( c.directory(), self.__directory )
+		self.assertEqual( c.diskUsage(), 0 )
+		self.assertEqual( c.getMaxDiskUsage(), 1000 )
+
+	def testStoreAndRetrieve( self ) :
+
+		c = DiskObjectCache( self.__directory, 1024 * 1024 )
+
+		k = MurmurHash()
+		k.append( "key" )
+		self.assertFalse( c.contains( k ) )
+		self.assertEqual( c.retrieve( k ), None )
+
+		d = CompoundObject( { "a" : IntVectorData( range( 0, 100 ) ), "b" : StringData( "b" ) } )
+		c.store( k, d )
+		self.assertTrue( c.contains( k ) )
+		self.assertEqual( c.retrieve( k ), d )
+		self.assertTrue( c.diskUsage() > 0 )
+
+		# another instance sees the same entries
+		c2 = DiskObjectCache( self.__directory, 1024 * 1024 )
+		self.assertEqual( c2.retrieve( k ), d )
+
+		# storing again replaces the entry
+		c.store( k, IntData( 10 ) )
+		self.assertEqual( c2.retrieve( k ), IntData( 10 ) )
+
+		self.assertTrue( c.erase( k ) )
+		self.assertFalse( c.erase( k ) )
+		self.assertFalse( c2.contains( k ) )
+		self.assertEqual( c.diskUsage(), 0 )
+
+	def testPruning( self ) :
+
+		c = DiskObjectCache( self.__directory, 1024 * 1024 )
+
+		keys = []
+		for i in range( 0, 20 ) :
+			k = MurmurHash()
+			k.append( i )
+			keys.append( k )
+			c.store( k, IntVectorData( range( 0, 1000 ) ) )
+
+		entrySize = c.diskUsage() / 20
+		c.setMaxDiskUsage( entrySize * 5 )
+		self.assertTrue( c.diskUsage() <= entrySize * 5 )
+		self.assertTrue( c.diskUsage() > 0 )
+
+		for k in keys :
+			c.store( k, IntVectorData( range( 0, 1000 ) ) )
+			self.assertTrue( c.diskUsage() <= entrySize * 5 )
+
+		c.clear()
+		self.assertEqual( c.diskUsage(), 0 )
+		for k in keys :
+			self.assertFalse( c.contains( k ) )
+
+	def testThreading( self ) :
+
+		c = DiskObjectCache( self.__directory, 1024 * 1024 )
+		errors = []
+
+		def f() :
+			try :
+				for i in range( 0, 50 ) :
+					k = MurmurHash()
+					k.append( i % 10 )
+					c.store( k, IntData( i % 10 ) )
+					r = c.retrieve( k )
+					if r is not None and r != IntData( i % 10 ) :
+						errors.append( r )
+			except Exception, e :
+				errors.append( e )
+
+		threads = [ threading.Thread( target = f ) for i in range( 0, 8 ) ]
+		for t in threads :
+			t.start()
+		for t in threads :
+			t.join()
+
+		self.assertEqual( errors, [] )
+		for i in range( 0, 10 ) :
+			k = MurmurHash()
+			k.append( i )
+			self.assertEqual( c.retrieve( k ), IntData( i ) )
+
+	def tearDown( self ) :
+
+		if os.path.exists( self.__directory ) :
+			shutil.rmtree( self.__directory )
+
+if __name__ == "__main__":
+	unittest.main()
@@ -39,6 +39,7 @@ import gc
 import glob
 import sys
 import time
+import threading
 from IECore import *
 
 class TestImageDisplayDriver(unittest.TestCase):
@@ -255,6 +256,59 @@ class TestClientServerDisplayDriver(unittest.TestCase):
 		i = ImageDisplayDriver.removeStoredImage( "myHandle" )
 		self.assertEqual( i["Y"].data, y )
 
+	def testConcurrentClients( self ) :
+
+		# streams buckets from several concurrent clients into a server running
+		# in this same process, checking the results.
+
+		window = Box2i( V2i( 0 ), V2i( 511 ) )
+		channels = [ "R", "G", "B", "A" ]
+		bucketSize = 32
+		numClients = 4
+
+		bucket = FloatVectorData( [ 0.25, 0.5, 0.75, 1 ] * bucketSize * bucketSize )
+
+		def render( port, handle ) :
+
+			dd = ClientDisplayDriver(
+				window, window,
+				channels,
+				CompoundData( {
+					"displayHost" : "localhost",
+					"displayPort" : str( port ),
+					"remoteDisplayType" : "ImageDisplayDriver",
+					"handle" : handle,
+				} )
+			)
+
+			for y in range( window.min.y, window.max.y + 1, bucketSize ) :
+				for x in range( window.min.x, window.max.x + 1, bucketSize ) :
+					dd.imageData( Box2i( V2i( x, y ), V2i( x + bucketSize - 1, y + bucketSize - 1 ) ), bucket )
+
+			dd.imageClose()
+
+		for numThreads in ( 1, 4 ) :
+
+			port = 1561 + numThreads
+			server = DisplayDriverServer( port, numThreads )
+
+			threads = []
+			for i in range( 0, numClients ) :
+				threads.append( threading.Thread( target = render, args = ( port, "loopback%d" % i ) ) )
+
+			for thread in threads :
+				thread.start()
+			for thread in threads :
+				thread.join()
+
+			for i in range( 0, numClients ) :
+				image = ImageDisplayDriver.removeStoredImage( "loopback%d" % i )
+				self.assertEqual( image.dataWindow, window )
+				for c, v in zip( channels, [ 0.25, 0.5, 0.75, 1 ] ) :
+					self.assertEqual( image[c].data, FloatVectorData( [ v ] * 512 * 512 ) )
+
+			del server
+
 	def tearDown( self ):
 		
 		self.server = None
@@ -229,6 +229,109 @@ class TestEXRWriter(unittest.TestCase):
 		w = EXRImageWriter()
 		w['compression'].setValue( w['compression'].getPresets()['zip'] )
 
+	def testTiled( self ) :
+
+		displayWindow = Box2i( V2i( 0, 0 ), V2i( 99, 79 ) )
+		dataWindow = Box2i( V2i( 10, 5 ), V2i( 90, 70 ) )
+
+		for dataType in ( FloatVectorData, HalfVectorData ) :
+
+			imgOrig = self.__makeFloatImage( dataWindow, displayWindow, withAlpha = True, dataType = dataType )
+
+			for levelMode in ( "oneLevel", "mipMap", "ripMap" ) :
+
+				w = EXRImageWriter( imgOrig, "test/IECore/data/exrFiles/output.exr" )
+				w["tiled"].setTypedValue( True )
+				w["tileSize"].setTypedValue( V2i( 16, 32 ) )
+				w["levelMode"].setValue( w["levelMode"].getPresets()[levelMode] )
+				w.write()
+
+				imgNew = Reader.create( "test/IECore/data/exrFiles/output.exr" ).read()
+				self.assertEqual( imgNew.dataWindow, dataWindow )
+				self.assertEqual( imgNew.displayWindow, displayWindow )
+				self.__verifyImageRGB( imgNew, imgOrig )
+
+	def testLevelsIncreaseFileSize( self ) :
+
+		imgOrig = self.__makeFloatImage( Box2i( V2i( 0 ), V2i( 127 ) ), Box2i( V2i( 0 ), V2i( 127 ) ) )
+
+		sizes = {}
+		for levelMode in ( "oneLevel", "mipMap", "ripMap" ) :
+
+			w = EXRImageWriter( imgOrig, "test/IECore/data/exrFiles/output.exr" )
+			w["compression"].setValue( w["compression"].getPresets()["none"] )
+			w["tiled"].setTypedValue( True )
+			w["levelMode"].setValue( w["levelMode"].getPresets()[levelMode] )
+			w.write()
+
+			sizes[levelMode] = os.path.getsize( "test/IECore/data/exrFiles/output.exr" )
+
+		# without compression, each mip level adds a quarter of the size of the
+		# level above, and the rip levels add up to nearly four times the original.
+		# the contents of the levels are checked by EXRImageWriterTest.cpp, because
+		# the reader only gives us access to the full resolution image.
+		self.failUnless( sizes["mipMap"] > sizes["oneLevel"] * 1.3 )
+		self.failUnless( sizes["ripMap"] > sizes["oneLevel"] * 3.5 )
+
+	def testInvalidTileSize( self ) :
+
+		imgOrig = self.__makeFloatImage( Box2i( V2i( 0 ), V2i( 15 ) ), Box2i( V2i( 0 ), V2i( 15 ) ) )
+
+		w = EXRImageWriter( imgOrig, "test/IECore/data/exrFiles/output.exr" )
+		w["tiled"].setTypedValue( True )
+		w["tileSize"].setTypedValue( V2i( 0, 16 ) )
+		self.assertRaises( RuntimeError, w.write )
+
+	def testNumThreads( self ) :
+
+		displayWindow = Box2i( V2i( 0 ), V2i( 511 ) )
+		imgOrig = self.__makeFloatImage( displayWindow, displayWindow, withAlpha = True, dataType = HalfVectorData )
+
+		for numThreads in ( 0, 1, 4 ) :
+
+			w = EXRImageWriter( imgOrig, "test/IECore/data/exrFiles/output.exr" )
+			w["numThreads"].setNumericValue( numThreads )
+			w.write()
+
+			imgNew = Reader.create( "test/IECore/data/exrFiles/output.exr" ).read()
+			self.__verifyImageRGB( imgNew, imgOrig )
+
+	def testGlobalThreadCount( self ) :
+
+		displayWindow = Box2i( V2i( 0 ), V2i( 511 ) )
+		imgOrig = self.__makeFloatImage( displayWindow, displayWindow, withAlpha = True, dataType = HalfVectorData )
+
+		originalCount = EXRImageWriter.getGlobalThreadCount()
+		try :
+
+			EXRImageWriter.setGlobalThreadCount( 0 )
+			self.assertEqual( EXRImageWriter.getGlobalThreadCount(), 0 )
+			self.assertRaises( RuntimeError, EXRImageWriter.setGlobalThreadCount, -1 )
+
+			threadsBefore = len( os.listdir( "/proc/self/task" ) ) if sys.platform.startswith( "linux" ) else None
+
+			EXRImageWriter.setGlobalThreadCount( 4 )
+			self.assertEqual( EXRImageWriter.getGlobalThreadCount(), 4 )
+
+			# the pool's threads must actually exist for numThreads = 0
+			# to compress in parallel.
+			if threadsBefore is not None :
+				self.failUnless( len( os.listdir( "/proc/self/task" ) ) >= threadsBefore + 4 )
+
+			for tiled in ( False, True ) :
+
+				w = EXRImageWriter( imgOrig, "test/IECore/data/exrFiles/output.exr" )
+				w["tiled"].setTypedValue( tiled )
+				w["numThreads"].setNumericValue( 0 )
+				w.write()
+
+				imgNew = Reader.create( "test/IECore/data/exrFiles/output.exr" ).read()
+				self.__verifyImageRGB( imgNew, imgOrig )
+
+		finally :
+
+			EXRImageWriter.setGlobalThreadCount( originalCount )
+
 	def testBlindDataToHeader( self ) :
 
 		displayWindow = Box2i(
@@ -0,0 +1,172 @@
+//////////////////////////////////////////////////////////////////////////
+//
+//  Copyright (c) 2013, Image Engine Design Inc. All rights reserved.
+//
+//  Redistribution and use in source and binary forms, with or without
+//  modification, are permitted provided that the following conditions are
+//  met:
+//
+//     * Redistributions of source code must retain the above copyright
+//       notice, this list of conditions and the following disclaimer.
+//
+//     * Redistributions in binary form must reproduce the above copyright
+//       notice, this list of conditions and the following disclaimer in the
+//       documentation and/or other materials provided with the distribution.
+//
+//     * Neither the name of Image Engine Design nor the names of any
+//       other contributors to this software may be used to endorse or
+//       promote products derived from this software without specific prior
+//       written permission.
+//
+//  THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS
+//  IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO,
+//  THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR
+//  PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER OR
+//  CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+//  EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+//  PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR
+//  PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF
+//  LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING
+//  NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+//  SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+//
+//////////////////////////////////////////////////////////////////////////
+
+#include <cstdio>
+#include <vector>
+#include <algorithm>
+
+#include "OpenEXR/ImfTiledInputFile.h"
+#include "OpenEXR/ImfFrameBuffer.h"
+
+#include "EXRImageWriterTest.h"
+
+#include "IECore/EXRImageWriter.h"
+#include "IECore/ImagePrimitive.h"
+#include "IECore/VectorTypedData.h"
+#include "IECore/SimpleTypedParameter.h"
+#include "IECore/NumericParameter.h"
+
+using namespace boost;
+using namespace boost::unit_test;
+using namespace Imath;
+
+namespace IECore
+{
+
+/// The python bindings only give access to the full resolution image in
+/// a tiled file, so the reduced resolution levels are tested here by
+/// reading them directly with OpenEXR.
+struct EXRImageWriterTest
+{
+
+	EXRImageWriterTest()
+		:	m_fileName( "test/IECore/data/exrFiles/levelsTest.exr" )
+	{
+	}
+
+	~EXRImageWriterTest()
+	{
+		std::remove( m_fileName.c_str() );
+	}
+
+	void testMipMapLevels()
+	{
+		testLevels( Imf::MIPMAP_LEVELS );
+	}
+
+	void testRipMapLevels()
+	{
+		testLevels( Imf::RIPMAP_LEVELS );
+	}
+
+	void testLevels( Imf::LevelMode levelMode )
+	{
+		const int width = 64;
+		const int height = 32;
+
+		// a linear ramp, so that the box filtered value of any
+		// power of two block is the value at its centre.
+		const Box2i window( V2i( 0 ), V2i( width - 1, height - 1 ) );
+		ImagePrimitivePtr image = new ImagePrimitive( window, window );
+		std::vector<float> &r = image->createChannel<float>( "R" )->writable();
+		std::vector<unsigned int> &id = image->createChannel<unsigned int>( "id" )->writable();
+		for( int y = 0; y < height; ++y )
+		{
+			for( int x = 0; x < width; ++x )
+			{
+				r[y * width + x] = x + width * y;
+				id[y * width + x] = x + width * y;
+			}
+		}
+
+		EXRImageWriterPtr writer = new EXRImageWriter( image, m_fileName );
+		writer->tiledParameter()->setTypedValue( true );
+		writer->tileSizeParameter()->setTypedValue( V2i( 16 ) );
+		writer->levelModeParameter()->setNumericValue( levelMode );
+		writer->write();
+
+		Imf::TiledInputFile file( m_fileName.c_str() );
+		BOOST_REQUIRE( file.levelMode() == levelMode );
+		BOOST_CHECK_EQUAL( file.numXLevels(), 7 );
+		BOOST_CHECK_EQUAL( file.numYLevels(), levelMode == Imf::MIPMAP_LEVELS ? 7 : 6 );
+
+		for( int ly = 0; ly < file.numYLevels(); ++ly )
+		{
+			for( int lx = 0; lx < file.numXLevels(); ++lx )
+			{
+				if( levelMode == Imf::MIPMAP_LEVELS && lx != ly )
+				{
+					continue;
+				}
+
+				const int levelWidth = file.levelWidth( lx );
+				const int levelHeight = file.levelHeight( ly );
+				BOOST_CHECK_EQUAL( levelWidth, std::max( width >> lx, 1 ) );
+				BOOST_CHECK_EQUAL( levelHeight, std::max( height >> ly, 1 ) );
+
+				std::vector<float> levelR( levelWidth * levelHeight );
+				std::vector<unsigned int> levelId( levelWidth * levelHeight );
+				Imf::FrameBuffer frameBuffer;
+				frameBuffer.insert( "R", Imf::Slice( Imf::FLOAT, (char *)&levelR[0], sizeof( float ), sizeof( float ) * levelWidth ) );
+				frameBuffer.insert( "id", Imf::Slice( Imf::UINT, (char *)&levelId[0], sizeof( unsigned int ), sizeof( unsigned int ) * levelWidth ) );
+				file.setFrameBuffer( frameBuffer );
+				file.readTiles( 0, file.numXTiles( lx ) - 1, 0, file.numYTiles( ly ) - 1, lx, ly );
+
+				const int blockWidth = width / levelWidth;
+				const int blockHeight = height / levelHeight;
+				for( int y = 0; y < levelHeight; ++y )
+				{
+					for( int x = 0; x < levelWidth; ++x )
+					{
+						const float expected = ( x * blockWidth + ( blockWidth - 1 ) * 0.5f ) + width * ( y * blockHeight + ( blockHeight - 1 ) * 0.5f );
+						BOOST_CHECK_SMALL( levelR[y * levelWidth + x] - expected, 1e-3f );
+						// integer channels are point sampled rather than averaged
+						BOOST_CHECK_EQUAL( levelId[y * levelWidth + x], (unsigned int)( x * blockWidth + width * y * blockHeight ) );
+					}
+				}
+			}
+		}
+	}
+
+	std::string m_fileName;
+
+};
+
+struct EXRImageWriterTestSuite : public boost::unit_test::test_suite
+{
+
+	EXRImageWriterTestSuite() : boost::unit_test::test_suite( "EXRImageWriterTestSuite" )
+	{
+		boost::shared_ptr<EXRImageWriterTest> instance( new EXRImageWriterTest() );
+		add( BOOST_CLASS_TEST_CASE( &EXRImageWriterTest::testMipMapLevels, instance ) );
+		add( BOOST_CLASS_TEST_CASE( &EXRImageWriterTest::testRipMapLevels, instance ) );
+	}
+};
+
+void addEXRImageWriterTest( boost::unit_test::test_suite *test )
+{
+	test->add( new EXRImageWriterTestSuite() );
+}
+
+} // namespace IECore
@@ -458,6 +458,43 @@ class testLs( unittest.TestCase ) :
 		l = ls( "test/sequences/lsTest/a.###.tif" )
 		self.assertFalse( l )
 
+	def testLargeDirectories( self ) :
+
+		# many entries, in the sort of layer and AOV
+		# structure found in typical render output directories.
+
+		sequences = []
+		for layer in range( 0, 20 ) :
+			for aov in ( "beauty", "diffuse", "specular", "N", "P" ) :
+				sequences.append( FileSequence( "shot010_layer%d_%s.####.exr" % ( layer, aov ), FrameRange( 1001, 1100 ) ) )
+
+		names = []
+		for sequence in sequences :
+			names.extend( sequence.fileNames() )
+		names.extend( [ "notASequence.exr", "notes.txt", "test100.#.tif.tmp" ] )
+		self.assertEqual( len( names ), 10003 )
+
+		l = findSequences( names )
+
+		sequences.sort( key = lambda s : s.fileName )
+		self.assertEqual( l, sequences )
+
+		# and a smaller directory on disk to exercise ls() as well
+
+		self.tearDown()
+		os.system( "mkdir -p test/sequences/lsTest" )
+
+		sequences = sequences[:5]
+		for sequence in sequences :
+			for f in sequence.fileNames() :
+				open( "test/sequences/lsTest/" + f, "w" ).close()
+
+		l = ls( "test/sequences/lsTest" )
+		self.assertEqual( l, sequences )
+
+		l = ls( "test/sequences/lsTest/shot010_layer0_N.####.exr" )
+		self.assertEqual( l, FileSequence( "test/sequences/lsTest/" + sequences[0].fileName, sequences[0].frameList ) )
+
 	def tearDown( self ) :
 
 		if os.path.exists( "test/sequences" ) :
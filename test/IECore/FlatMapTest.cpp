@@ -0,0 +1,231 @@
+//////////////////////////////////////////////////////////////////////////
+//
+//  Copyright (c) 2013, Image Engine Design Inc. All rights reserved.
+//
+//  Redistribution and use in source and binary forms, with or without
+//  modification, are permitted provided that the following conditions are
+//  met:
+//
+//     * Redistributions of source code must retain the above copyright
+//       notice, this list of conditions and the following disclaimer.
+//
+//     * Redistributions in binary form must reproduce the above copyright
+//       notice, this list of conditions and the following disclaimer in the
+//       documentation and/or other materials provided with the distribution.
+//
+//     * Neither the name of Image Engine Design nor the names of any
+//       other contributors to this software may be used to endorse or
+//       promote products derived from this software without specific prior
+//       written permission.
+//
+//  THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS
+//  IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO,
+//  THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR
+//  PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER OR
+//  CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+//  EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+//  PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR
+//  PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF
+//  LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING
+//  NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+//  SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+//
+//////////////////////////////////////////////////////////////////////////
+
+
+#include <map>
+#include <vector>
+
+#include "boost/random.hpp"
+
+#include "FlatMapTest.h"
+
+#include "IECore/FlatMap.h"
+#include "IECore/InternedString.h"
+
+using namespace boost;
+using namespace boost::unit_test;
+
+namespace IECore
+{
+
+struct FlatMapTest
+{
+
+	typedef FlatMap<int, int> IntMap;
+
+	template<typename A, typename B>
+	static bool equal( const A &a, const B &b )
+	{
+		if( a.size() != b.size() )
+		{
+			return false;
+		}
+		typename A::const_iterator aIt = a.begin();
+		typename B::const_iterator bIt = b.begin();
+		for( ; aIt != a.end(); ++aIt, ++bIt )
+		{
+			if( aIt->first != bIt->first || aIt->second != bIt->second )
+			{
+				return false;
+			}
+		}
+		return true;
+	}
+
+	void testMatchesStdMap()
+	{
+		boost::mt19937 generator( 42 );
+		boost::uniform_int<> keyDist( 0, 100 );
+		boost::variate_generator<boost::mt19937&, boost::uniform_int<> > key( generator, keyDist );
+
+		std::map<int, int> m;
+		IntMap f;
+
+		for( int i = 0; i < 10000; i++ )
+		{
+			int k = key();
+			switch( i % 5 )
+			{
+				case 0 :
+					m[k] = i;
+					f[k] = i;
+					break;
+				case 1 :
+				{
+					std::pair<std::map<int, int>::iterator, bool> mr = m.insert( std::map<int, int>::value_type( k, i ) );
+					std::pair<IntMap::iterator, bool> fr = f.insert( IntMap::value_type( k, i ) );
+					BOOST_CHECK_EQUAL( mr.second, fr.second );
+					BOOST_CHECK_EQUAL( fr.first->first, k );
+					BOOST_CHECK_EQUAL( fr.first->second, mr.first->second );
+					break;
+				}
+				case 2 :
+					BOOST_CHECK_EQUAL( m.erase( k ), f.erase( k ) );
+					break;
+				case 3 :
+				{
+					IntMap::const_iterator it = f.find( k );
+					BOOST_CHECK_EQUAL( m.count( k ), f.count( k ) );
+					BOOST_CHECK( ( it == f.end() ) == ( m.find( k ) == m.end() ) );
+					BOOST_CHECK( f.lower_bound( k ) - f.begin() == std::distance( m.begin(), m.lower_bound( k ) ) );
+					BOOST_CHECK( f.upper_bound( k ) - f.begin() == std::distance( m.begin(), m.upper_bound( k ) ) );
+					std::pair<IntMap::iterator, IntMap::iterator> r = f.equal_range( k );
+					BOOST_CHECK_EQUAL( (size_t)( r.second - r.first ), m.count( k ) );
+					break;
+				}
+				case 4 :
+					f.insert( f.begin() + f.size() / 2, IntMap::value_type( k, i ) );
+					m.insert( std::map<int, int>::value_type( k, i ) );
+					break;
+			}
+			BOOST_CHECK( equal( f, m ) );
+		}
+
+		IntMap f2( m.begin(), m.end() );
+		BOOST_CHECK( f2 == f );
+		f2.begin()->second += 1;
+		BOOST_CHECK( f2 != f );
+
+		f2.swap( f );
+		BOOST_CHECK( !equal( f, m ) );
+		BOOST_CHECK( equal( f2, m ) );
+
+		f.clear();
+		BOOST_CHECK( f.empty() );
+	}
+
+	void testInternedStringKeys()
+	{
+		FlatMap<InternedString, int> f;
+		f["b"] = 2;
+		f["a"] = 1;
+		f["c"] = 3;
+
+		BOOST_CHECK_EQUAL( f.size(), 3u );
+		BOOST_CHECK_EQUAL( f["a"], 1 );
+		BOOST_CHECK_EQUAL( f["b"], 2 );
+		BOOST_CHECK_EQUAL( f["c"], 3 );
+		BOOST_CHECK( f.find( "d" ) == f.end() );
+
+		f.erase( f.find( "b" ) );
+		BOOST_CHECK_EQUAL( f.size(), 2u );
+		BOOST_CHECK( f.find( "b" ) == f.end() );
+		BOOST_CHECK_EQUAL( f["c"], 3 );
+	}
+
+	void testSortedInsertion()
+	{
+		IntMap f;
+		f.reserve( 1000 );
+		for( int i = 0; i < 1000; i++ )
+		{
+			IntMap::iterator it = f.insert( f.end(), IntMap::value_type( i, i ) );
+			BOOST_CHECK_EQUAL( it->first, i );
+		}
+		BOOST_CHECK_EQUAL( f.size(), 1000u );
+		BOOST_CHECK( f.capacity() >= 1000u );
+
+		// a wrong hint must still insert in the right place
+		f.erase( 500 );
+		IntMap::iterator it = f.insert( f.begin(), IntMap::value_type( 500, -1 ) );
+		BOOST_CHECK_EQUAL( it - f.begin(), 500 );
+		BOOST_CHECK_EQUAL( f[500], -1 );
+
+		// and an existing key must not be replaced
+		it = f.insert( f.end(), IntMap::value_type( 10, -1 ) );
+		BOOST_CHECK_EQUAL( it->first, 10 );
+		BOOST_CHECK_EQUAL( it->second, 10 );
+		BOOST_CHECK_EQUAL( f.size(), 1000u );
+	}
+
+	void testRangeInsertion()
+	{
+		boost::mt19937 generator( 42 );
+		boost::uniform_int<> keyDist( 0, 1000 );
+		boost::variate_generator<boost::mt19937&, boost::uniform_int<> > key( generator, keyDist );
+
+		std::map<int, int> m;
+		IntMap f;
+		for( int i = 0; i < 10; i++ )
+		{
+			// unsorted values, with duplicates both within the
+			// range and of keys already in the map.
+			std::vector<IntMap::value_type> values;
+			for( int j = 0; j < 200; j++ )
+			{
+				values.push_back( IntMap::value_type( key(), i * 200 + j ) );
+			}
+
+			m.insert( values.begin(), values.end() );
+			f.insert( values.begin(), values.end() );
+			BOOST_CHECK( equal( f, m ) );
+		}
+
+		// inserting an empty range is a no-op
+		std::vector<IntMap::value_type> empty;
+		f.insert( empty.begin(), empty.end() );
+		BOOST_CHECK( equal( f, m ) );
+	}
+
+};
+
+struct FlatMapTestSuite : public boost::unit_test::test_suite
+{
+
+	FlatMapTestSuite() : boost::unit_test::test_suite( "FlatMapTestSuite" )
+	{
+		boost::shared_ptr<FlatMapTest> instance( new FlatMapTest() );
+		add( BOOST_CLASS_TEST_CASE( &FlatMapTest::testMatchesStdMap, instance ) );
+		add( BOOST_CLASS_TEST_CASE( &FlatMapTest::testInternedStringKeys, instance ) );
+		add( BOOST_CLASS_TEST_CASE( &FlatMapTest::testSortedInsertion, instance ) );
+		add( BOOST_CLASS_TEST_CASE( &FlatMapTest::testRangeInsertion, instance ) );
+	}
+};
+
+void addFlatMapTest( boost::unit_test::test_suite *test )
+{
+	test->add( new FlatMapTestSuite() );
+}
+
+} // namespace IECore
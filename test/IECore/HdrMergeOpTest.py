@@ -0,0 +1,149 @@
+##########################################################################
+#
+#  Copyright (c) 2013, Image Engine Design Inc. All rights reserved.
+#
+#  Redistribution and use in source and binary forms, with or without
+#  modification, are permitted provided that the following conditions are
+#  met:
+#
+#     * Redistributions of source code must retain the above copyright
+#       notice, this list of conditions and the following disclaimer.
+#
+#     * Redistributions in binary form must reproduce the above copyright
+#       notice, this list of conditions and the following disclaimer in the
+#       documentation and/or other materials provided with the distribution.
+#
+#     * Neither the name of Image Engine Design nor the names of any
+#       other contributors to this software may be used to endorse or
+#       promote products derived from this software without specific prior
+#       written permission.
+#
+#  THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS
+#  IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO,
+#  THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR
+#  PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER OR
+#  CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+#  EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+#  PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR
+#  PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF
+#  LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING
+#  NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+#  SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+#
+##########################################################################
+
+import unittest
+import IECore
+
+class HdrMergeOpTest( unittest.TestCase ) :
+
+	fileNames = [
+		"test/IECore/data/exrFiles/checkerAnimated.0001.exr",
+		"test/IECore/data/exrFiles/checkerAnimated.0002.exr",
+		"test/IECore/data/exrFiles/checkerAnimated.0003.exr",
+	]
+
+	def testMergeGroup( self ) :
+
+		g = IECore.Group()
+		for f in self.fileNames :
+			g.addChild( IECore.Reader.create( f ).read() )
+
+		result = IECore.HdrMergeOp()( inputGroup = g )
+
+		self.assertEqual( result.dataWindow, g.children()[0].dataWindow )
+		self.assertEqual( result.displayWindow, g.children()[0].displayWindow )
+		self.assertEqual( set( result.keys() ), set( [ "R", "G", "B", "A" ] ) )
+		self.failUnless( result.arePrimitiveVariablesValid() )
+
+	@staticmethod
+	def __constantImage( value, channelSize = 4 ) :
+
+		window = IECore.Box2i( IECore.V2i( 0 ), IECore.V2i( 1 ) )
+		image = IECore.ImagePrimitive( window, window )
+		for c in ( "R", "G", "B" ) :
+			image[c] = IECore.PrimitiveVariable( IECore.PrimitiveVariable.Interpolation.Vertex, IECore.FloatVectorData( [ value ] * channelSize ) )
+
+		return image
+
+	def testMergedValues( self ) :
+
+		def smoothstep( v0, v1, v ) :
+			x = ( v - v0 ) / ( v1 - v0 )
+			x = min( max( x, 0.0 ), 1.0 )
+			return ( 3.0 - 2.0 * x ) * x * x
+
+		# the first value falls in the lower transition zone, the
+		# last in the upper one, and the middle one is fully weighted.
+		values = [ 0.02, 0.4, 0.95 ]
+		g = IECore.Group()
+		for v in values :
+			g.addChild( self.__constantImage( v ) )
+
+		exposureStep = 1.5
+		exposureAdjustment = 0.5
+		windowing = IECore.Box2f( IECore.V2f( 0.0, 0.05 ), IECore.V2f( 0.9, 1.0 ) )
+
+		result = IECore.HdrMergeOp()(
+			inputGroup = g,
+			exposureStep = exposureStep,
+			exposureAdjustment = exposureAdjustment,
+			windowing = windowing,
+		)
+
+		colour = 0.0
+		alpha = 0.0
+		exposure = exposureStep * ( len( values ) - 1 ) / 2.0
+		for i, v in enumerate( values ) :
+			weight = smoothstep( windowing.min[0], windowing.min[1], v )
+			if i :
+				weight *= 1.0 - smoothstep( windowing.max[0], windowing.max[1], v )
+			colour += v * weight * 2.0 ** exposure
+			alpha += weight
+			exposure -= exposureStep
+
+		colour /= alpha * 2.0 ** -exposureAdjustment
+
+		for c in ( "R", "G", "B" ) :
+			self.assertEqual( len( result[c].data ), 4 )
+			for x in result[c].data :
+				self.assertAlmostEqual( x, colour, 5 )
+
+		for x in result["A"].data :
+			self.assertAlmostEqual( x, alpha, 5 )
+
+	def testMergeFilesMatchesGroup( self ) :
+
+		g = IECore.Group()
+		for f in self.fileNames :
+			g.addChild( IECore.Reader.create( f ).read() )
+
+		expected = IECore.HdrMergeOp()( inputGroup = g )
+
+		for scanlinesPerBlock in ( 1, 7, 64, 10000 ) :
+
+			result = IECore.HdrMergeOp()(
+				inputFileNames = IECore.StringVectorData( self.fileNames ),
+				scanlinesPerBlock = scanlinesPerBlock,
+			)
+
+			self.assertEqual( result, expected )
+
+	def testErrors( self ) :
+
+		self.assertRaises( RuntimeError, IECore.HdrMergeOp(), inputGroup = IECore.Group() )
+
+		self.assertRaises(
+			RuntimeError,
+			IECore.HdrMergeOp(),
+			inputFileNames = IECore.StringVectorData( [ "test/IECore/data/exrFiles/checkerAnimated.0001.exr", "test/IECore/data/exrFiles/carPark.exr" ] )
+		)
+
+		# channels which are longer than the data window would overrun the output
+		g = IECore.Group()
+		g.addChild( self.__constantImage( 0.5, channelSize = 8 ) )
+		g.addChild( self.__constantImage( 0.5, channelSize = 8 ) )
+		self.assertRaises( RuntimeError, IECore.HdrMergeOp(), inputGroup = g )
+
+if __name__ == "__main__":
+	unittest.main()
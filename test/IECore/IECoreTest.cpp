@@ -45,6 +45,7 @@
 #include "boost/test/detail/unit_test_parameters.hpp"
 
 #include "KDTreeTest.h"
+#include "BoundedKDTreeTest.h"
 #include "TypedDataTest.h"
 #include "InterpolatorTest.h"
 #include "IndexedIOTest.h"
@@ -76,6 +77,12 @@
 #include "CompoundObjectTest.h"
 #include "ComputationCacheTest.h"
 #include "SceneCacheThreadingTest.h"
+#include "RunTimeTypedThreadingTest.h"
+#include "FlatMapTest.h"
+#include "EXRImageWriterTest.h"
+#include "PointRepulsionOpTest.h"
+#include "RefCountedAllocationTest.h"
+#include "AlignedAllocatorTest.h"
 
 using namespace boost::unit_test;
 using boost::test_tools::output_test_stream;
@@ -90,6 +97,7 @@ test_suite* init_unit_test_suite( int argc, char* argv[] )
 	{
 		addBoostUnitTestTest(test);
 		addKDTreeTest(test);
+		addBoundedKDTreeTest(test);
 		addTypedDataTest(test);
 		addInterpolatorTest(test);
 		addIndexedIOTest(test);
@@ -119,6 +127,12 @@ test_suite* init_unit_test_suite( int argc, char* argv[] )
 		addCompoundObjectTest(test);
 		addComputationCacheTest(test);
 		addSceneCacheThreadingTest(test);
+		addRunTimeTypedThreadingTest(test);
+		addFlatMapTest(test);
+		addEXRImageWriterTest(test);
+		addPointRepulsionOpTest(test);
+		addRefCountedAllocationTest(test);
+		addAlignedAllocatorTest(test);
 	}
 	catch (std::exception &ex)
 	{
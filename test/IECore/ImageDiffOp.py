@@ -171,6 +171,25 @@ class TestImageDiffOp(unittest.TestCase):
 
 		self.failIf( res.value )
 
+	def testLargeImage( self ) :
+
+		w = Box2i( V2i( 0, 0 ), V2i( 1999, 999 ) )
+
+		f = FloatVectorData()
+		f.resize( 2000 * 1000, 0.5 )
+		imageA = ImagePrimitive( w, w )
+		imageA["R"] = PrimitiveVariable( PrimitiveVariable.Interpolation.Vertex, f )
+
+		f = f.copy()
+		f[1999999] = 1.5
+		imageB = ImagePrimitive( w, w )
+		imageB["R"] = PrimitiveVariable( PrimitiveVariable.Interpolation.Vertex, f )
+
+		# the rms error is 1 / sqrt( 2000 * 1000 ), which is about 0.0007
+		op = ImageDiffOp()
+		self.failIf( op( imageA = imageA, imageB = imageB, maxError = 0.0008 ).value )
+		self.failUnless( op( imageA = imageA, imageB = imageB, maxError = 0.0006 ).value )
+
 
 if __name__ == "__main__":
 	unittest.main()
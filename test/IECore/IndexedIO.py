@@ -158,6 +158,84 @@ class TestMemoryIndexedIO(unittest.TestCase):
 
 			self.assertEqual( len(entryNames), len(dataPresent) )
 
+class TestPackedIndexedIO(unittest.TestCase):
+
+	def testReadWrite(self):
+		"""Test PackedIndexedIO read/write operations."""
+		f = PackedIndexedIO( CharVectorData(), [], IndexedIO.OpenMode.Write)
+		self.assertEqual( f.path() , [] )
+		self.assertEqual( f.currentEntryId() , "/" )
+
+		g = f.subdirectory( "sub", IndexedIO.MissingBehaviour.CreateIfMissing )
+		g.write( "f", FloatVectorData( [ 1, 2, 3 ] ) )
+		g.write( "s", "hello" )
+		g.write( "i", 10 )
+		g.write( "i", 11 )
+		g.write( "removed", 1 )
+		g.remove( "removed" )
+
+		f2 = PackedIndexedIO( f.buffer(), [], IndexedIO.OpenMode.Read )
+		self.assertEqual( f2.entryIds(), [ "sub" ] )
+		g2 = f2.subdirectory( "sub" )
+		self.assertEqual( g2.path(), [ "sub" ] )
+		self.assertEqual( set( g2.entryIds() ), set( [ "f", "s", "i" ] ) )
+		self.assertEqual( g2.read( "f" ), FloatVectorData( [ 1, 2, 3 ] ) )
+		self.assertEqual( g2.read( "s" ), StringData( "hello" ) )
+		self.assertEqual( g2.read( "i" ), IntData( 11 ) )
+		self.assertEqual( g2.parentDirectory().path(), [] )
+
+		self.assertRaises( RuntimeError, g2.write, "x", 1 )
+		self.assertRaises( RuntimeError, f2.subdirectory, "missing" )
+		self.assertEqual( f2.subdirectory( "missing", IndexedIO.MissingBehaviour.NullIfMissing ), None )
+
+	def testSaveWriteObjects(self):
+		"""Test PackedIndexedIO with saved objects."""
+		f = PackedIndexedIO( CharVectorData(), [], IndexedIO.OpenMode.Write)
+		o = CompoundObject( { "a" : IntData( 1 ), "b" : CompoundData( { "c" : StringVectorData( [ "d", "e" ] ) } ) } )
+		o["shared"] = o["a"]
+		o.save( f, "obj" )
+
+		f2 = PackedIndexedIO( f.buffer(), [], IndexedIO.OpenMode.Read )
+		o2 = Object.load( f2, "obj" )
+		self.assertEqual( o, o2 )
+		self.failUnless( o2["a"].isSame( o2["shared"] ) )
+
+	def testAppend(self):
+		"""Test PackedIndexedIO append mode."""
+		f = PackedIndexedIO( CharVectorData(), [], IndexedIO.OpenMode.Write)
+		f.write( "a", 1 )
+
+		f2 = PackedIndexedIO( f.buffer(), [ "sub" ], IndexedIO.OpenMode.Append )
+		f2.write( "b", 2 )
+
+		f3 = PackedIndexedIO( f2.buffer(), [], IndexedIO.OpenMode.Read )
+		self.assertEqual( f3.read( "a" ), IntData( 1 ) )
+		self.assertEqual( f3.subdirectory( "sub" ).read( "b" ), IntData( 2 ) )
+
+	def testInvalidBlock(self):
+		"""Test PackedIndexedIO with invalid blocks."""
+		self.assertRaises( RuntimeError, PackedIndexedIO, CharVectorData(), [], IndexedIO.OpenMode.Read )
+
+		m = MemoryIndexedIO( CharVectorData(), [], IndexedIO.OpenMode.Write )
+		m.write( "a", 1 )
+		self.assertRaises( RuntimeError, PackedIndexedIO, m.buffer(), [], IndexedIO.OpenMode.Read )
+
+	def testPackedObjects(self):
+		"""Test saving packed objects into another IndexedIO."""
+		o = CompoundObject( { "a" : IntData( 1 ), "b" : V3fVectorData( [ V3f( 1, 2, 3 ) ] * 10 ) } )
+
+		f = MemoryIndexedIO( CharVectorData(), [], IndexedIO.OpenMode.Write)
+		o.save( f, "packed", True )
+		o.save( f, "regular", False )
+
+		self.assertEqual( f.entry( "packed" ).entryType(), IndexedIO.EntryType.File )
+		self.assertEqual( f.entry( "packed" ).dataType(), IndexedIO.DataType.CharArray )
+		self.assertEqual( f.entry( "regular" ).entryType(), IndexedIO.EntryType.Directory )
+
+		f2 = MemoryIndexedIO( f.buffer(), [], IndexedIO.OpenMode.Read )
+		self.assertEqual( Object.load( f2, "packed" ), o )
+		self.assertEqual( Object.load( f2, "regular" ), o )
+
 class TestFileIndexedIO(unittest.TestCase):
 
 	badNames = ['*', '!', '&', '^', '@', '#', '$', '(', ')', '<', '+',
@@ -573,6 +651,66 @@ class TestFileIndexedIO(unittest.TestCase):
 		self.failIf(fv is gv)
 		self.assertEqual(fv, gv)
 
+	def testOpenFileBudget( self ) :
+
+		f = FileIndexedIO( "./test/FileIndexedIO.fio", [], IndexedIO.OpenMode.Write )
+		f.write( "i", IntVectorData( range( 0, 100 ) ) )
+		del f
+
+		maxOpenFiles = FileIndexedIO.getMaxOpenFiles()
+		try :
+
+			FileIndexedIO.setMaxOpenFiles( 2 )
+			self.assertEqual( FileIndexedIO.getMaxOpenFiles(), 2 )
+
+			files = [ FileIndexedIO( "./test/FileIndexedIO.fio", [], IndexedIO.OpenMode.Read ) for i in range( 0, 10 ) ]
+			self.failUnless( FileIndexedIO.numOpenFiles() <= 2 )
+
+			# reading from closed files reopens them transparently
+			reopens = FileIndexedIO.numReopens()
+			for i in range( 0, 3 ) :
+				for f in files :
+					self.assertEqual( f.read( "i" ), IntVectorData( range( 0, 100 ) ) )
+			self.failUnless( FileIndexedIO.numReopens() > reopens )
+			self.failUnless( FileIndexedIO.numOpenFiles() <= 2 )
+
+		finally :
+
+			FileIndexedIO.setMaxOpenFiles( maxOpenFiles )
+
+	def testReopenModifiedFile( self ) :
+
+		for fileName in [ "./test/FileIndexedIO.fio", "./test/FileIndexedIO2.fio" ] :
+			f = FileIndexedIO( fileName, [], IndexedIO.OpenMode.Write )
+			f.write( "i", IntVectorData( range( 0, 100 ) ) )
+			del f
+
+		maxOpenFiles = FileIndexedIO.getMaxOpenFiles()
+		try :
+
+			FileIndexedIO.setMaxOpenFiles( 1 )
+
+			f1 = FileIndexedIO( "./test/FileIndexedIO.fio", [], IndexedIO.OpenMode.Read )
+			f2 = FileIndexedIO( "./test/FileIndexedIO2.fio", [], IndexedIO.OpenMode.Read )
+			self.assertEqual( f2.read( "i" ), IntVectorData( range( 0, 100 ) ) )
+			self.assertEqual( FileIndexedIO.numOpenFiles(), 1 )
+
+			# f1 has been closed to make room for f2. rewriting it on disk
+			# must make the next read fail rather than use the stale index.
+			f = FileIndexedIO( "./test/FileIndexedIO.fio", [], IndexedIO.OpenMode.Write )
+			f.write( "j", IntVectorData( range( 0, 1000 ) ) )
+			f.write( "i", IntVectorData( range( 0, 10 ) ) )
+			del f
+
+			self.assertRaises( RuntimeError, f1.read, "i" )
+
+			# reopening unmodified files is still fine
+			self.assertEqual( f2.read( "i" ), IntVectorData( range( 0, 100 ) ) )
+
+		finally :
+
+			FileIndexedIO.setMaxOpenFiles( maxOpenFiles )
+
 	def setUp( self ):
 
 		if os.path.isfile("./test/FileIndexedIO.fio") :
@@ -581,8 +719,9 @@ class TestFileIndexedIO(unittest.TestCase):
 	def tearDown(self):
 
 		# cleanup
-		if os.path.isfile("./test/FileIndexedIO.fio") :
-			os.remove("./test/FileIndexedIO.fio")
+		for f in [ "./test/FileIndexedIO.fio", "./test/FileIndexedIO2.fio" ] :
+			if os.path.isfile( f ) :
+				os.remove( f )
 
 
 if __name__ == "__main__":
@@ -146,6 +146,29 @@ class TestInverseDistanceWeightedInterpolation(unittest.TestCase):
 		)
 
 		self.failIf( res.value )
-		
+
+	def testVectorQueriesMatchSingleQueries( self ):
+
+		random.seed( 2 )
+
+		p = V3fVectorData()
+		v = V3fVectorData()
+		for i in range( 0, 1000 ):
+			p.append( V3f( random.uniform( 0, 100 ), random.uniform( 0, 100 ), random.uniform( 0, 100 ) ) )
+			v.append( V3f( random.uniform( 0, 1 ), random.uniform( 0, 1 ), random.uniform( 0, 1 ) ) )
+
+		idw = InverseDistanceWeightedInterpolationV3fV3f( p, v, 8 )
+
+		queryPoints = V3fVectorData()
+		for i in range( 0, 5000 ):
+			queryPoints.append( V3f( random.uniform( -10, 110 ), random.uniform( -10, 110 ), random.uniform( -10, 110 ) ) )
+
+		f = idw( queryPoints )
+		self.assertEqual( len( f ), len( queryPoints ) )
+		for i in range( 0, len( queryPoints ) ):
+			self.assertEqual( f[i], idw( queryPoints[i] ) )
+
+		self.assertEqual( len( idw( V3fVectorData() ) ), 0 )
+
 if __name__ == "__main__":
 	unittest.main()
@@ -261,6 +261,33 @@ class TestObjectIO( unittest.TestCase ) :
 		self.assert_( dd['c']['d'].isSame( dd['links']['v3'] ) )
 		self.assert_( dd['c/d'].isSame( dd['links']['v3'] ) )
 
+	def testParallelLoadOfSharedMembers( self ) :
+
+		# enough members that they're loaded in parallel, with every
+		# one of them referring to the same data in several places.
+
+		shared = FloatVectorData( range( 0, 1000 ) )
+
+		o = CompoundObject()
+		for i in range( 0, 50 ) :
+			c = CompoundData()
+			c["a"] = shared
+			c["b"] = IntVectorData( [ i ] * 100 )
+			c["c"] = shared
+			o["member%d" % i] = c
+		o["shared"] = shared
+
+		iface = IndexedIO.create( "test/o.fio", [], IndexedIO.OpenMode.Write )
+		o.save( iface, "test" )
+
+		for i in range( 0, 10 ) :
+
+			oo = Object.load( iface, "test" )
+			self.assertEqual( o, oo )
+			for j in range( 0, 50 ) :
+				self.assertTrue( oo["member%d" % j]["a"].isSame( oo["shared"] ) )
+				self.assertTrue( oo["member%d" % j]["c"].isSame( oo["shared"] ) )
+
 	def tearDown( self ) :
 
 		for f in [ "test/o.fio", "test/FileIndexedIOSlashes.fio" ] :
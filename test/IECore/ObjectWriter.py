@@ -80,6 +80,22 @@ class TestObjectWriter( unittest.TestCase ) :
 
 		self.assertEqual( h["bound"].value, o.bound() )
 
+	def testPacked( self ) :
+
+		o = IECore.Reader.create( "test/IECore/data/cobFiles/compoundData.cob" ).read()
+
+		w = IECore.Writer.create( o, "test/compoundData.cob" )
+		self.assertEqual( w["packed"].getTypedValue(), False )
+		w["packed"].setTypedValue( True )
+		w.write()
+
+		r = IECore.Reader.create( "test/compoundData.cob" )
+		self.assertEqual( r.read(), o )
+		self.assertEqual( r.readHeader()["typeName"].value, o.typeName() )
+
+		io = IECore.FileIndexedIO( "test/compoundData.cob", [], IECore.IndexedIO.OpenMode.Read )
+		self.assertEqual( io.entry( "object" ).entryType(), IECore.IndexedIO.EntryType.File )
+
 	def tearDown( self ) :
 		
 		for f in ( "test/compoundData.cob", "test/intData.cob", "test/spherePrimitive.cob" ) :
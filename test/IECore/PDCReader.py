@@ -211,6 +211,48 @@ class TestPDCReader( unittest.TestCase ) :
 		self.assert_( len( a ) < 15 )
 		self.assert_( len( a ) > 8 )
 
+	def testFilteredAttributesMatchUnfiltered( self ) :
+
+		r = IECore.Reader.create( "test/IECore/data/pdcFiles/particleShape1.250.pdc" )
+		r["realType"].setValue( "native" )
+
+		allIds = list( r.readAttribute( "particleId" ) )
+		allPositions = r.readAttribute( "position" )
+
+		r.parameters()["percentage"].setValue( IECore.FloatData( 30 ) )
+		ids = r.readAttribute( "particleId" )
+		positions = r.readAttribute( "position" )
+
+		self.assertEqual( len( ids ), len( positions ) )
+		self.assert_( len( ids ) < len( allIds ) )
+		for i in range( 0, len( ids ) ) :
+			self.assertEqual( positions[i], allPositions[allIds.index( ids[i] )] )
+
+	def testSparselyFilteredAttributesMatchUnfiltered( self ) :
+
+		r = IECore.Reader.create( "test/IECore/data/pdcFiles/particleMesh.pdc" )
+		r["realType"].setValue( "native" )
+
+		allIds = list( r.readAttribute( "particleId" ) )
+		allPositions = r.readAttribute( "position" )
+		allMasses = r.readAttribute( "mass" )
+
+		for percentage in ( 0.5, 5, 50 ) :
+
+			r.parameters()["percentage"].setValue( IECore.FloatData( percentage ) )
+			ids = r.readAttribute( "particleId" )
+			positions = r.readAttribute( "position" )
+			masses = r.readAttribute( "mass" )
+
+			self.assertEqual( len( ids ), len( positions ) )
+			self.assertEqual( len( ids ), len( masses ) )
+			self.assert_( len( ids ) > 0 )
+			self.assert_( len( ids ) < len( allIds ) )
+			for i in range( 0, len( ids ) ) :
+				index = allIds.index( ids[i] )
+				self.assertEqual( positions[i], allPositions[index] )
+				self.assertEqual( masses[i], allMasses[index] )
+
 
 	def testConversion( self ) :
 
@@ -175,6 +175,38 @@ class TestPerlinNoise( unittest.TestCase ) :
 
 		self.failIf( res.value ) # Tested against OpenEXR 1.6.1
 
+	def __randomPoints( self, vectorType, pointType, numPoints ) :
+
+		random.seed( 0 )
+		result = vectorType()
+		for i in range( 0, numPoints ) :
+			if pointType is float :
+				result.append( random.uniform( -100, 100 ) )
+			else :
+				result.append( pointType( *[ random.uniform( -100, 100 ) for d in range( 0, pointType.dimensions() ) ] ) )
+
+		return result
+
+	def testNoiseVector( self ) :
+
+		for noiseType, vectorType, pointType in [
+			( IECore.PerlinNoiseff, IECore.FloatVectorData, float ),
+			( IECore.PerlinNoiseV2ff, IECore.V2fVectorData, IECore.V2f ),
+			( IECore.PerlinNoiseV3ff, IECore.V3fVectorData, IECore.V3f ),
+			( IECore.PerlinNoiseV3fColor3f, IECore.V3fVectorData, IECore.V3f ),
+		] :
+
+			n = noiseType( 5 )
+			p = self.__randomPoints( vectorType, pointType, 5000 )
+
+			v = n.noiseVector( p )
+			self.assertEqual( len( v ), len( p ) )
+			for i in range( 0, len( p ) ) :
+				self.assertEqual( v[i], n.noise( p[i] ) )
+
+			v2 = n.noiseVector( p, v )
+			self.failUnless( v2.isSame( v ) )
+
 #	def testSpeed( self ) :
 #
 #		numPoints = 100000
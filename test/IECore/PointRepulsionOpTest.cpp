@@ -0,0 +1,126 @@
+//////////////////////////////////////////////////////////////////////////
+//
+//  Copyright (c) 2013, Image Engine Design Inc. All rights reserved.
+//
+//  Redistribution and use in source and binary forms, with or without
+//  modification, are permitted provided that the following conditions are
+//  met:
+//
+//     * Redistributions of source code must retain the above copyright
+//       notice, this list of conditions and the following disclaimer.
+//
+//     * Redistributions in binary form must reproduce the above copyright
+//       notice, this list of conditions and the following disclaimer in the
+//       documentation and/or other materials provided with the distribution.
+//
+//     * Neither the name of Image Engine Design nor the names of any
+//       other contributors to this software may be used to endorse or
+//       promote products derived from this software without specific prior
+//       written permission.
+//
+//  THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS
+//  IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO,
+//  THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR
+//  PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER OR
+//  CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+//  EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+//  PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR
+//  PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF
+//  LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING
+//  NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+//  SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+//
+//////////////////////////////////////////////////////////////////////////
+
+#include "tbb/task_scheduler_init.h"
+
+#include "OpenEXR/ImathRandom.h"
+
+#include "PointRepulsionOpTest.h"
+
+#include "IECore/PointRepulsionOp.h"
+#include "IECore/PointsPrimitive.h"
+#include "IECore/MeshPrimitive.h"
+#include "IECore/ImagePrimitive.h"
+#include "IECore/VectorTypedData.h"
+
+using namespace boost;
+using namespace boost::unit_test;
+using namespace Imath;
+
+namespace IECore
+{
+
+/// The number of threads can't be controlled from python, so the
+/// independence of the results from it is tested here.
+struct PointRepulsionOpTest
+{
+
+	void testThreadCountIndependence()
+	{
+		Rand32 r( 1 );
+
+		MeshPrimitivePtr mesh = MeshPrimitive::createPlane( Box2f( V2f( 0 ), V2f( 1 ) ), V2i( 10 ) );
+
+		const Box2i window( V2i( 0 ), V2i( 15 ) );
+		ImagePrimitivePtr image = new ImagePrimitive( window, window );
+		std::vector<float> &density = image->createChannel<float>( "Y" )->writable();
+		for( std::vector<float>::iterator it = density.begin(); it != density.end(); ++it )
+		{
+			*it = r.nextf( 0.25, 1 );
+		}
+
+		// some points are coincident, so that they are pushed apart
+		// in random directions.
+		V3fVectorDataPtr p = new V3fVectorData;
+		for( unsigned i = 0; i < 500; ++i )
+		{
+			const V3f v( r.nextf(), r.nextf(), 0 );
+			p->writable().push_back( v );
+			if( i % 10 == 0 )
+			{
+				p->writable().push_back( v );
+			}
+		}
+		PointsPrimitivePtr points = new PointsPrimitive( p );
+
+		ConstV3fVectorDataPtr serial = repel( points.get(), mesh.get(), image.get(), 1 );
+		ConstV3fVectorDataPtr parallel = repel( points.get(), mesh.get(), image.get(), 8 );
+
+		BOOST_CHECK( serial->readable() != p->readable() );
+		BOOST_CHECK( serial->readable() == parallel->readable() );
+	}
+
+	ConstV3fVectorDataPtr repel( PointsPrimitive *points, MeshPrimitive *mesh, ImagePrimitive *image, int numThreads )
+	{
+		tbb::task_scheduler_init scheduler( numThreads );
+
+		PointRepulsionOpPtr op = new PointRepulsionOp;
+		op->inputParameter()->setValue( points );
+		op->meshParameter()->setValue( mesh );
+		op->imageParameter()->setValue( image );
+		op->numIterationsParameter()->setNumericValue( 50 );
+
+		PointsPrimitivePtr result = runTimeCast<PointsPrimitive>( op->operate() );
+		BOOST_REQUIRE( result );
+		return result->variableData<V3fVectorData>( "P" );
+	}
+
+};
+
+struct PointRepulsionOpTestSuite : public boost::unit_test::test_suite
+{
+
+	PointRepulsionOpTestSuite() : boost::unit_test::test_suite( "PointRepulsionOpTestSuite" )
+	{
+		boost::shared_ptr<PointRepulsionOpTest> instance( new PointRepulsionOpTest() );
+		add( BOOST_CLASS_TEST_CASE( &PointRepulsionOpTest::testThreadCountIndependence, instance ) );
+	}
+};
+
+void addPointRepulsionOpTest( boost::unit_test::test_suite *test )
+{
+	test->add( new PointRepulsionOpTestSuite() );
+}
+
+} // namespace IECore
@@ -32,6 +32,8 @@
 #
 ##########################################################################
 
+import os
+import shutil
 import unittest
 import IECore
 
@@ -84,6 +86,25 @@ class TestReader(unittest.TestCase):
 		self.assertRaises( RuntimeError, IECore.Reader.create, 'test/IECore/data/null' )
 		self.assertRaises( RuntimeError, IECore.Reader.create, 'test/IECore/data/null.cin' )
 		
+	def testCreateFromMagicNumber( self ) :
+
+		# files with misleading or missing extensions should still find
+		# the right reader from their magic numbers.
+
+		for source, readerType in [
+			( "test/IECore/data/dpx/ramp.dpx", IECore.DPXImageReader ),
+			( "test/IECore/data/sgiFiles/uvMap.512x256.8bit.sgi", IECore.SGIImageReader ),
+			( "test/IECore/data/pdcFiles/10Particles.pdc", IECore.PDCParticleReader ),
+		] :
+
+			for fileName in ( "test/IECore/data/magicTest", "test/IECore/data/magicTest.cin" ) :
+
+				shutil.copy( source, fileName )
+				r = IECore.Reader.create( fileName )
+				self.failUnless( isinstance( r, readerType ) )
+				self.assertEqual( r.read(), readerType( source ).read() )
+				os.remove( fileName )
+
 	def testCanRead( self ) :
 	
 		# every reader subclass should have a canRead() static method, unless it's an abstract base class
@@ -103,6 +124,12 @@ class TestReader(unittest.TestCase):
 		for reader in allReaders :
 			self.failUnless( hasattr( reader, "canRead" ) )
 
+	def tearDown( self ) :
+
+		for f in ( "test/IECore/data/magicTest", "test/IECore/data/magicTest.cin" ) :
+			if os.path.exists( f ) :
+				os.remove( f )
+
 if __name__ == "__main__":
 	unittest.main()
 
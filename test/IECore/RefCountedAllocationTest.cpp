@@ -0,0 +1,242 @@
+//////////////////////////////////////////////////////////////////////////
+//
+//  Copyright (c) 2013, Image Engine Design Inc. All rights reserved.
+//
+//  Redistribution and use in source and binary forms, with or without
+//  modification, are permitted provided that the following conditions are
+//  met:
+//
+//     * Redistributions of source code must retain the above copyright
+//       notice, this list of conditions and the following disclaimer.
+//
+//     * Redistributions in binary form must reproduce the above copyright
+//       notice, this list of conditions and the following disclaimer in the
+//       documentation and/or other materials provided with the distribution.
+//
+//     * Neither the name of Image Engine Design nor the names of any
+//       other contributors to this software may be used to endorse or
+//       promote products derived from this software without specific prior
+//       written permission.
+//
+//  THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS
+//  IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO,
+//  THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR
+//  PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER OR
+//  CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+//  EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+//  PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR
+//  PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF
+//  LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING
+//  NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+//  SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+//
+//////////////////////////////////////////////////////////////////////////
+
+#include <cstring>
+#include <vector>
+
+#include "boost/thread.hpp"
+#include "boost/bind.hpp"
+
+#include "tbb/parallel_for.h"
+#include "tbb/blocked_range.h"
+
+#include "IECore/RefCounted.h"
+#include "IECore/SimpleTypedData.h"
+#include "IECore/CompoundData.h"
+
+#include "RefCountedAllocationTest.h"
+
+using namespace boost;
+using namespace boost::unit_test;
+
+namespace IECore
+{
+
+/// These tests are valid whether or not pooled allocation is in use,
+/// but only test the pool itself when IECORE_POOLED_ALLOCATION=1
+/// is set in the environment. The test suite is run in both modes.
+struct RefCountedAllocationTest
+{
+
+	void testSizeClassBoundaries()
+	{
+		const size_t sizes[] = { 1, 15, 16, 17, 255, 256, 257, 1024 };
+		for( size_t i = 0; i < sizeof( sizes ) / sizeof( size_t ); ++i )
+		{
+			// the whole of each block must be usable
+			char *p = static_cast<char *>( RefCounted::operator new( sizes[i] ) );
+			memset( p, (int)i, sizes[i] );
+			BOOST_CHECK_EQUAL( p[0], (char)i );
+			BOOST_CHECK_EQUAL( p[sizes[i]-1], (char)i );
+			RefCounted::operator delete( p, sizes[i] );
+		}
+
+		if( !RefCounted::pooledAllocation() )
+		{
+			BOOST_CHECK_EQUAL( RefCounted::numAllocations(), 0u );
+			BOOST_CHECK_EQUAL( RefCounted::numSystemAllocations(), 0u );
+			return;
+		}
+
+		// 256 bytes is the largest pooled size, so a block freed at that
+		// size is reused for the next allocation in the same size class.
+		void *p = RefCounted::operator new( 256 );
+		RefCounted::operator delete( p, 256 );
+
+		const size_t numAllocations = RefCounted::numAllocations();
+		const size_t numSystemAllocations = RefCounted::numSystemAllocations();
+
+		void *p2 = RefCounted::operator new( 241 );
+		BOOST_CHECK( p2 == p );
+		RefCounted::operator delete( p2, 241 );
+		BOOST_CHECK_EQUAL( RefCounted::numAllocations(), numAllocations + 1 );
+		BOOST_CHECK_EQUAL( RefCounted::numSystemAllocations(), numSystemAllocations );
+
+		// 257 bytes is too large to be pooled, so always goes to
+		// the system allocator.
+		for( int i = 0; i < 10; ++i )
+		{
+			char *q = static_cast<char *>( RefCounted::operator new( 257 ) );
+			memset( q, 0, 257 );
+			RefCounted::operator delete( q, 257 );
+		}
+		BOOST_CHECK_EQUAL( RefCounted::numAllocations(), numAllocations + 11 );
+		BOOST_CHECK_EQUAL( RefCounted::numSystemAllocations(), numSystemAllocations + 10 );
+	}
+
+	static void allocate( std::vector<DataPtr> &objects, int offset )
+	{
+		for( size_t i = 0; i < objects.size(); ++i )
+		{
+			if( i % 2 )
+			{
+				objects[i] = new IntData( offset + i );
+			}
+			else
+			{
+				CompoundDataPtr c = new CompoundData;
+				c->writable()["i"] = new IntData( offset + i );
+				objects[i] = c;
+			}
+		}
+	}
+
+	static void deallocate( std::vector<DataPtr> &objects )
+	{
+		for( std::vector<DataPtr>::iterator it = objects.begin(); it != objects.end(); ++it )
+		{
+			*it = 0;
+		}
+	}
+
+	static void check( const std::vector<DataPtr> &objects, int offset )
+	{
+		for( size_t i = 0; i < objects.size(); ++i )
+		{
+			const IntData *d = 0;
+			if( i % 2 )
+			{
+				d = runTimeCast<const IntData>( objects[i].get() );
+			}
+			else
+			{
+				const CompoundData *c = runTimeCast<const CompoundData>( objects[i].get() );
+				BOOST_REQUIRE( c );
+				d = c->member<IntData>( "i" );
+			}
+			BOOST_REQUIRE( d );
+			BOOST_CHECK_EQUAL( d->readable(), (int)( offset + i ) );
+		}
+	}
+
+	// Objects allocated on one thread and freed on another are put on
+	// the free lists of the freeing thread, and reused from there.
+	void testCrossThreadDeallocation()
+	{
+		const size_t numObjects = 10000;
+		const size_t numAllocations = RefCounted::numAllocations();
+
+		std::vector<DataPtr> objects( numObjects );
+		boost::thread allocator( boost::bind( &allocate, boost::ref( objects ), 0 ) );
+		allocator.join();
+		check( objects, 0 );
+
+		// the blocks of objects from the thread above, which has now exited,
+		// are freed and then reused by this one.
+		deallocate( objects );
+		allocate( objects, 1 );
+		check( objects, 1 );
+
+		// and these are freed by another thread while this
+		// one allocates some more.
+		std::vector<DataPtr> moreObjects( numObjects );
+		boost::thread deallocator( boost::bind( &deallocate, boost::ref( objects ) ) );
+		allocate( moreObjects, 2 );
+		deallocator.join();
+		check( moreObjects, 2 );
+
+		if( RefCounted::pooledAllocation() )
+		{
+			// each call to allocate() makes at least one allocation per object
+			BOOST_CHECK( RefCounted::numAllocations() >= numAllocations + numObjects * 3 );
+		}
+	}
+
+	struct Exchange
+	{
+
+		Exchange( std::vector<DataPtr> &objects, int offset )
+			:	m_objects( objects ), m_offset( offset )
+		{
+		}
+
+		// replaces each object with a new one, so objects are freed on
+		// whichever thread happens to process their index.
+		void operator()( const tbb::blocked_range<size_t> &r ) const
+		{
+			for( size_t i = r.begin(); i != r.end(); ++i )
+			{
+				m_objects[i] = new IntData( m_offset + i );
+			}
+		}
+
+		std::vector<DataPtr> &m_objects;
+		int m_offset;
+
+	};
+
+	void testConcurrentCrossThreadDeallocation()
+	{
+		std::vector<DataPtr> objects( 100000 );
+		for( int i = 0; i < 20; ++i )
+		{
+			// small grains so that indices move between threads from pass to pass
+			tbb::parallel_for( tbb::blocked_range<size_t>( 0, objects.size(), 10 + i * 7 ), Exchange( objects, i ) );
+			for( size_t j = 0; j < objects.size(); j += 997 )
+			{
+				BOOST_CHECK_EQUAL( runTimeCast<IntData>( objects[j].get() )->readable(), (int)( i + j ) );
+			}
+		}
+	}
+
+};
+
+struct RefCountedAllocationTestSuite : public boost::unit_test::test_suite
+{
+
+	RefCountedAllocationTestSuite() : boost::unit_test::test_suite( "RefCountedAllocationTestSuite" )
+	{
+		boost::shared_ptr<RefCountedAllocationTest> instance( new RefCountedAllocationTest() );
+		add( BOOST_CLASS_TEST_CASE( &RefCountedAllocationTest::testSizeClassBoundaries, instance ) );
+		add( BOOST_CLASS_TEST_CASE( &RefCountedAllocationTest::testCrossThreadDeallocation, instance ) );
+		add( BOOST_CLASS_TEST_CASE( &RefCountedAllocationTest::testConcurrentCrossThreadDeallocation, instance ) );
+	}
+};
+
+void addRefCountedAllocationTest( boost::unit_test::test_suite *test )
+{
+	test->add( new RefCountedAllocationTestSuite() );
+}
+
+} // namespace IECore
@@ -32,7 +32,10 @@
 #
 ##########################################################################
 
+import os
+import sys
 import unittest
+import subprocess
 
 import IECore
 
@@ -164,5 +167,52 @@ class RefCountedTest( unittest.TestCase ) :
 		del c["i"]
 		self.assertEqual( i.refCount(), r )
 
+	def testPooledAllocation( self ) :
+
+		# pooled allocation can only be chosen at startup, so
+		# we exercise each mode in a separate process.
+
+		script = "\n".join( [
+			"import sys, threading, IECore",
+			"n = IECore.RefCounted.numAllocations()",
+			"s = IECore.RefCounted.numSystemAllocations()",
+			"for i in range( 0, 2000 ) :",
+			"	c = IECore.CompoundData()",
+			"	for j in range( 0, 10 ) :",
+			"		c['f%d' % j] = IECore.FloatData( j )",
+			"	c['m'] = IECore.M44fData()",
+			"	c['v'] = IECore.V3fVectorData( [ IECore.V3f( 0 ) ] * 3 )",
+			"	c2 = c.copy()",
+			"	assert( c2 == c )",
+			# objects allocated on one thread and freed on another
+			"l = []",
+			"t = threading.Thread( target = lambda : l.extend( [ IECore.IntData( i ) for i in range( 0, 10000 ) ] ) )",
+			"t.start()",
+			"t.join()",
+			"assert( [ d.value for d in l ] == range( 0, 10000 ) )",
+			"del l[:]",
+			"l2 = [ IECore.IntData( i ) for i in range( 0, 10000 ) ]",
+			"assert( [ d.value for d in l2 ] == range( 0, 10000 ) )",
+			"sys.stdout.write( '%d %d %d' % ( IECore.RefCounted.pooledAllocation(), IECore.RefCounted.numAllocations() - n, IECore.RefCounted.numSystemAllocations() - s ) )",
+		] )
+
+		for pooled in ( "0", "1" ) :
+
+			env = os.environ.copy()
+			env["IECORE_POOLED_ALLOCATION"] = pooled
+			p = subprocess.Popen( [ sys.executable, "-c", script ], stdout=subprocess.PIPE, env=env )
+			output, nothing = p.communicate()
+			self.assertEqual( p.returncode, 0 )
+
+			result, numAllocations, numSystemAllocations = output.split()
+			self.assertEqual( result, pooled )
+			if pooled == "1" :
+				self.failUnless( int( numAllocations ) > 2000 * 13 + 20000 )
+				# most allocations should be served from the free lists
+				self.failUnless( int( numSystemAllocations ) < int( numAllocations ) / 2 )
+			else :
+				self.assertEqual( int( numAllocations ), 0 )
+				self.assertEqual( int( numSystemAllocations ), 0 )
+
 if __name__ == "__main__":
     unittest.main()
@@ -0,0 +1,151 @@
+//////////////////////////////////////////////////////////////////////////
+//
+//  Copyright (c) 2013, Image Engine Design Inc. All rights reserved.
+//
+//  Redistribution and use in source and binary forms, with or without
+//  modification, are permitted provided that the following conditions are
+//  met:
+//
+//     * Redistributions of source code must retain the above copyright
+//       notice, this list of conditions and the following disclaimer.
+//
+//     * Redistributions in binary form must reproduce the above copyright
+//       notice, this list of conditions and the following disclaimer in the
+//       documentation and/or other materials provided with the distribution.
+//
+//     * Neither the name of Image Engine Design nor the names of any
+//       other contributors to this software may be used to endorse or
+//       promote products derived from this software without specific prior
+//       written permission.
+//
+//  THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS
+//  IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO,
+//  THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR
+//  PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER OR
+//  CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+//  EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+//  PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR
+//  PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF
+//  LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING
+//  NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+//  SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+//
+//////////////////////////////////////////////////////////////////////////
+
+
+#include "boost/lexical_cast.hpp"
+
+#include "tbb/tbb.h"
+
+#include "IECore/RunTimeTyped.h"
+#include "IECore/SimpleTypedData.h"
+#include "IECore/Parameter.h"
+
+#include "RunTimeTypedThreadingTest.h"
+
+using namespace boost;
+using namespace boost::unit_test;
+using namespace tbb;
+
+namespace IECore
+{
+
+struct RunTimeTypedThreadingTest
+{
+
+	// The first of the ids used for types registered by the tests. These
+	// are well outside any range allocated in TypeIds.h.
+	static const int g_firstTestTypeId = 900000;
+
+	struct QueryHierarchy
+	{
+		public :
+
+			QueryHierarchy( tbb::atomic<int> &errors, bool registerTypes )
+				:	m_errors( errors ), m_registerTypes( registerTypes )
+			{
+			}
+
+			void operator()( const blocked_range<size_t> &r ) const
+			{
+				for( size_t i=r.begin(); i!=r.end(); ++i )
+				{
+					if(
+						!RunTimeTyped::inheritsFrom( IntDataTypeId, DataTypeId ) ||
+						!RunTimeTyped::inheritsFrom( IntDataTypeId, RunTimeTypedTypeId ) ||
+						RunTimeTyped::inheritsFrom( IntDataTypeId, ParameterTypeId ) ||
+						RunTimeTyped::inheritsFrom( DataTypeId, IntDataTypeId ) ||
+						RunTimeTyped::baseTypeIds( IntDataTypeId ).front() != DataTypeId ||
+						!RunTimeTyped::derivedTypeIds( DataTypeId ).count( IntDataTypeId ) ||
+						RunTimeTyped::typeIdFromTypeName( "IntData" ) != IntDataTypeId
+					)
+					{
+						m_errors++;
+					}
+
+					// Register a late type every so often, as a plugin might.
+					if( m_registerTypes && i % 1000 == 0 )
+					{
+						const TypeId typeId = TypeId( g_firstTestTypeId + i / 1000 );
+						const std::string typeName = "RunTimeTypedThreadingTest" + boost::lexical_cast<std::string>( typeId );
+						RunTimeTyped::registerType( typeId, typeName.c_str(), DataTypeId );
+						if(
+							!RunTimeTyped::inheritsFrom( typeId, ObjectTypeId ) ||
+							RunTimeTyped::typeIdFromTypeName( typeName.c_str() ) != typeId ||
+							RunTimeTyped::baseTypeIds( typeId ).size() != RunTimeTyped::baseTypeIds( DataTypeId ).size() + 1
+						)
+						{
+							m_errors++;
+						}
+					}
+				}
+			}
+
+		private :
+
+			tbb::atomic<int> &m_errors;
+			bool m_registerTypes;
+
+	};
+
+	void testQueries()
+	{
+		tbb::atomic<int> errors;
+		errors = 0;
+		parallel_for( blocked_range<size_t>( 0, 1000000 ), QueryHierarchy( errors, false ) );
+		BOOST_CHECK( errors == 0 );
+	}
+
+	void testLateRegistration()
+	{
+		tbb::atomic<int> errors;
+		errors = 0;
+		parallel_for( blocked_range<size_t>( 0, 100000 ), QueryHierarchy( errors, true ) );
+		BOOST_CHECK( errors == 0 );
+
+		for( int i = 0; i < 100; ++i )
+		{
+			BOOST_CHECK( RunTimeTyped::derivedTypeIds( DataTypeId ).count( TypeId( g_firstTestTypeId + i ) ) );
+		}
+	}
+
+};
+
+struct RunTimeTypedThreadingTestSuite : public boost::unit_test::test_suite
+{
+
+	RunTimeTypedThreadingTestSuite() : boost::unit_test::test_suite( "RunTimeTypedThreadingTestSuite" )
+	{
+		boost::shared_ptr<RunTimeTypedThreadingTest> instance( new RunTimeTypedThreadingTest() );
+
+		add( BOOST_CLASS_TEST_CASE( &RunTimeTypedThreadingTest::testQueries, instance ) );
+		add( BOOST_CLASS_TEST_CASE( &RunTimeTypedThreadingTest::testLateRegistration, instance ) );
+	}
+};
+
+void addRunTimeTypedThreadingTest(boost::unit_test::test_suite* test)
+{
+	test->add( new RunTimeTypedThreadingTestSuite( ) );
+}
+
+} // namespace IECore
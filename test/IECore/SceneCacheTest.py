@@ -667,6 +667,40 @@ class SceneCacheTest( unittest.TestCase ) :
 		self.assertEqual( b.readObject(1)['P'], b.readObjectPrimitiveVariables(['P','Cs'], 1)['P'] )
 		self.assertEqual( b.readObject(1)['Cs'], b.readObjectPrimitiveVariables(['P','Cs'], 1)['Cs'] )
 
+	def testPackedObjects( self ) :
+
+		box = IECore.MeshPrimitive.createBox( IECore.Box3f( IECore.V3f( 0 ), IECore.V3f( 1 ) ) )
+		box["Cs"] = IECore.PrimitiveVariable( IECore.PrimitiveVariable.Interpolation.Uniform, IECore.Color3fVectorData( [ IECore.Color3f( 1, 0, 0 ) ] * box.variableSize( IECore.PrimitiveVariable.Interpolation.Uniform ) ) )
+		attribute = IECore.CompoundObject( { "a" : IECore.IntData( 1 ), "b" : IECore.CompoundData( { "c" : IECore.StringData( "d" ) } ) } )
+		transform = IECore.M44dData( IECore.M44d.createTranslated( IECore.V3d( 1, 2, 3 ) ) )
+
+		s = IECore.SceneCache( "/tmp/test.scc", IECore.IndexedIO.OpenMode.Write )
+		self.assertEqual( s.getPackedObjects(), False )
+		s.setPackedObjects( True )
+
+		b = s.createChild( "b" )
+		self.assertEqual( b.getPackedObjects(), True )
+		b.writeObject( box, 0 )
+		b.writeAttribute( "attr", attribute, 0 )
+		b.writeTransform( transform, 0 )
+
+		# packed and regular samples can be mixed
+		s.setPackedObjects( False )
+		b.writeObject( box, 1 )
+
+		del s, b
+
+		s = IECore.SceneCache( "/tmp/test.scc", IECore.IndexedIO.OpenMode.Read )
+		self.assertEqual( s.getPackedObjects(), False )
+		b = s.child( "b" )
+
+		self.assertEqual( b.readObject( 0 ), box )
+		self.assertEqual( b.readObject( 1 ), box )
+		self.assertEqual( b.readAttribute( "attr", 0 ), attribute )
+		self.assertEqual( b.readTransform( 0 ), transform )
+		self.assertEqual( b.readObjectPrimitiveVariables( [ "P", "Cs" ], 0 )["Cs"], box["Cs"] )
+		self.assertEqual( b.readObjectPrimitiveVariables( [ "P", "Cs" ], 0.5 )["P"], box["P"] )
+
 	def testTags( self ) :
 
 		sphere = IECore.SpherePrimitive( 1 )
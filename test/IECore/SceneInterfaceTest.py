@@ -106,6 +106,46 @@ class SceneInterfaceTest( unittest.TestCase ) :
 		self.assertFalse( instance4.isSame( instance1 ) )
 		self.assertTrue( instance4.isSame( instance3 ) )
 	
+	def testMaxScenes( self ) :
+
+		self.writeSCC()
+		fileNames = [
+			SceneInterfaceTest.__testFile,
+			"test/IECore/data/sccFiles/animatedSpheres.scc",
+			"test/IECore/data/sccFiles/attributeAtRoot.scc",
+		]
+
+		IECore.SharedSceneInterfaces.clear()
+		maxScenes = IECore.SharedSceneInterfaces.getMaxScenes()
+		try :
+
+			IECore.SharedSceneInterfaces.setMaxScenes( 2 )
+			self.assertEqual( IECore.SharedSceneInterfaces.getMaxScenes(), 2 )
+
+			numLoads = IECore.SharedSceneInterfaces.numLoads()
+			scene0 = IECore.SharedSceneInterfaces.get( fileNames[0] )
+			scene1 = IECore.SharedSceneInterfaces.get( fileNames[1] )
+			self.assertEqual( IECore.SharedSceneInterfaces.numLoads(), numLoads + 2 )
+
+			# cache hits don't load anything, but do make scene0 the most recently used
+			self.assertTrue( IECore.SharedSceneInterfaces.get( fileNames[0] ).isSame( scene0 ) )
+			self.assertEqual( IECore.SharedSceneInterfaces.numLoads(), numLoads + 2 )
+
+			# so loading a third scene evicts scene1
+			IECore.SharedSceneInterfaces.get( fileNames[2] )
+			self.assertEqual( IECore.SharedSceneInterfaces.numLoads(), numLoads + 3 )
+
+			self.assertTrue( IECore.SharedSceneInterfaces.get( fileNames[0] ).isSame( scene0 ) )
+			self.assertEqual( IECore.SharedSceneInterfaces.numLoads(), numLoads + 3 )
+
+			self.assertFalse( IECore.SharedSceneInterfaces.get( fileNames[1] ).isSame( scene1 ) )
+			self.assertEqual( IECore.SharedSceneInterfaces.numLoads(), numLoads + 4 )
+
+		finally :
+
+			IECore.SharedSceneInterfaces.setMaxScenes( maxScenes )
+			IECore.SharedSceneInterfaces.clear()
+
 	def testVisibilityName( self ) :
 		self.assertEqual( IECore.SceneInterface.visibilityName, "scene:visible" )
 	
@@ -401,6 +401,50 @@ class SmoothSmoothSkinningWeightsOpTest( unittest.TestCase ) :
 				current = resultOffsets[i] + j
 				self.assertAlmostEqual( resultWeights[current], origWeights[current], 6 )
 
+	def testLargeMesh( self ) :
+		""" Test SmoothSmoothSkinningWeightsOp on a dense mesh, checking the results stay normalized"""
+		
+		divisions = 200
+		mesh = MeshPrimitive.createPlane( Box2f( V2f( -1 ), V2f( 1 ) ), V2i( divisions ) )
+		numPoints = mesh.variableSize( PrimitiveVariable.Interpolation.Vertex )
+		self.assertEqual( numPoints, ( divisions + 1 ) * ( divisions + 1 ) )
+		
+		# each row of points is fully weighted to one of the three influences
+		offsets = IntVectorData( range( 0, numPoints ) )
+		counts = IntVectorData( [ 1 ] * numPoints )
+		indices = IntVectorData( [ ( i / ( divisions + 1 ) ) % 3 for i in range( 0, numPoints ) ] )
+		weights = FloatVectorData( [ 1 ] * numPoints )
+		ssd = self.createSSD( offsets, counts, indices, weights )
+		
+		op = SmoothSmoothSkinningWeightsOp()
+		op.parameters()['input'].setValue( ssd )
+		op.parameters()['mesh'].setValue( mesh )
+		op.parameters()['smoothingRatio'].setValue( 0.5 )
+		op.parameters()['iterations'].setValue( 10 )
+		op.parameters()['applyLocks'].setValue( False )
+		
+		result = op.operate()
+		
+		resultOffsets = result.pointIndexOffsets()
+		resultCounts = result.pointInfluenceCounts()
+		resultWeights = result.pointInfluenceWeights()
+		self.assertEqual( resultOffsets.size(), numPoints )
+		for i in range( 0, numPoints, 997 ) :
+			self.assertTrue( resultCounts[i] > 1 )
+			total = sum( [ resultWeights[resultOffsets[i] + j] for j in range( 0, resultCounts[i] ) ] )
+			self.assertAlmostEqual( total, 1.0, 5 )
+		
+		# normalizing, compressing and decompressing should all be consistent on the smoothed data
+		
+		normalizeOp = NormalizeSmoothSkinningWeightsOp()
+		normalized = normalizeOp( input = result )
+		for i in range( 0, resultWeights.size(), 997 ) :
+			self.assertAlmostEqual( normalized.pointInfluenceWeights()[i], resultWeights[i], 6 )
+		
+		decompressed = DecompressSmoothSkinningDataOp()( input = result )
+		self.assertEqual( decompressed.pointInfluenceWeights().size(), numPoints * 3 )
+		self.assertEqual( CompressSmoothSkinningDataOp()( input = decompressed ), result )
+
 	def testErrorStates( self ) :
 		""" Test SmoothSmoothSkinningWeightsOp with various error states"""
 		
@@ -427,5 +471,15 @@ class SmoothSmoothSkinningWeightsOpTest( unittest.TestCase ) :
 		op.parameters()['vertexIndices'].setFrameListValue( FrameList.parse( "10-18" ) )
 		self.assertRaises( RuntimeError, op.operate )
 
+		numVerts = len( ssd.pointIndexOffsets() )
+		op.parameters()['vertexIndices'].setFrameListValue( FrameList.parse( str( numVerts ) ) )
+		self.assertRaises( RuntimeError, op.operate )
+
+		op.parameters()['vertexIndices'].setFrameListValue( FrameList.parse( "-1" ) )
+		self.assertRaises( RuntimeError, op.operate )
+
+		op.parameters()['vertexIndices'].setFrameListValue( FrameList.parse( str( numVerts - 1 ) ) )
+		op.operate()
+
 if __name__ == "__main__":
 	unittest.main()
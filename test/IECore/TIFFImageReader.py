@@ -406,6 +406,104 @@ class TestTIFFReader(unittest.TestCase):
 
 		self.failIf( res.value )
 		
+	def testTiledDataWindowRead( self ) :
+
+		r = TIFFImageReader( "test/IECore/data/tiff/tilesWithLeftovers.tif" )
+		full = r.read()
+		dataWindow = full.dataWindow
+		for window in (
+			dataWindow,
+			Box2i( dataWindow.min + V2i( 3 ), dataWindow.max - V2i( 5 ) ),
+			Box2i( dataWindow.max, dataWindow.max ),
+		) :
+			r["dataWindow"].setValue( Box2iData( window ) )
+			expected = ImageCropOp()( input = full, cropBox = window, matchDataWindow = False, resetOrigin = False )
+			expected.displayWindow = full.displayWindow
+			self.assertEqual( r.read(), expected )
+
+	def testStrippedDataWindowRead( self ) :
+
+		r = TIFFImageReader( "test/IECore/data/tiff/uvMap.512x256.16bit.tif" )
+		full = r.read()
+		for window in (
+			Box2i( V2i( 100, 20 ), V2i( 300, 250 ) ),
+			Box2i( V2i( 0, 255 ), V2i( 511, 255 ) ),
+		) :
+			r["dataWindow"].setValue( Box2iData( window ) )
+			expected = ImageCropOp()( input = full, cropBox = window, matchDataWindow = False, resetOrigin = False )
+			expected.displayWindow = full.displayWindow
+			self.assertEqual( r.read(), expected )
+
+	def testBlockCache( self ) :
+
+		limit = ImageReader.getBlockCacheMemoryLimit()
+		try :
+
+			for l in ( 0, limit ) :
+
+				ImageReader.setBlockCacheMemoryLimit( l )
+				self.assertEqual( ImageReader.getBlockCacheMemoryLimit(), l )
+				ImageReader.clearBlockCache()
+
+				# reading twice must give the same results, whether
+				# or not the second read is from the cache.
+				r = TIFFImageReader( "test/IECore/data/tiff/uvMap.512x256.8bit.tif" )
+				r["rawChannels"].setTypedValue( True )
+				i1 = r.read()
+				i2 = r.read()
+				self.assertEqual( i1, i2 )
+
+		finally :
+
+			ImageReader.setBlockCacheMemoryLimit( limit )
+
+	def testBlockCacheSharedBetweenReaders( self ) :
+
+		fileName = "test/IECore/data/tiff/uvMap.multiRes.32bit.tif"
+
+		limit = ImageReader.getBlockCacheMemoryLimit()
+		try :
+
+			# read each directory without the cache, to give the expected results
+			ImageReader.setBlockCacheMemoryLimit( 0 )
+			expected = []
+			for i in range( 0, 3 ) :
+				r = TIFFImageReader( fileName )
+				r.setDirectory( i )
+				expected.append( r.read() )
+
+			# directories 0 and 2 have the same resolution, so would have
+			# the same blocks if the directory didn't form part of their
+			# identity in the cache.
+			ImageReader.setBlockCacheMemoryLimit( limit )
+			ImageReader.clearBlockCache()
+			for i in ( 0, 2, 1, 0, 2 ) :
+				r = TIFFImageReader( fileName )
+				r.setDirectory( i )
+				self.assertEqual( r.read(), expected[i] )
+
+		finally :
+
+			ImageReader.setBlockCacheMemoryLimit( limit )
+
+	def testBlockCacheWithRewrittenFile( self ) :
+
+		# files may be rewritten with a different layout within the resolution
+		# of the file modification time, but blocks cached for the old file must
+		# never be returned for the new one.
+		for size in ( 64, 48, 96 ) :
+
+			image = ImagePrimitive.createRGBFloat( Color3f( size / 100.0 ), Box2i( V2i( 0 ), V2i( size - 1 ) ), Box2i( V2i( 0 ), V2i( size - 1 ) ) )
+			Writer.create( image, "test/IECore/data/tiff/rewritten.tif" ).write()
+
+			r = TIFFImageReader( "test/IECore/data/tiff/rewritten.tif" )
+			self.assertEqual( r.dataWindow(), image.dataWindow )
+			result = r.read()
+			self.assertEqual( result.dataWindow, image.dataWindow )
+			self.assertEqual( len( result["R"].data ), size * size )
+			for v in result["R"].data :
+				self.assertAlmostEqual( v, size / 100.0, 1 )
+
 	def testReadWithIncorrectExtension( self ) :
 	
 		shutil.copyfile( "test/IECore/data/tiff/uvMap.512x256.8bit.tif", "test/IECore/data/tiff/uvMap.512x256.8bit.dpx" )
@@ -456,6 +554,7 @@ class TestTIFFReader(unittest.TestCase):
 	
 		for f in [
 			 "test/IECore/data/tiff/uvMap.512x256.8bit.dpx",
+			 "test/IECore/data/tiff/rewritten.tif",
 		] :
 			if os.path.exists( f ) :
 				os.remove( f )
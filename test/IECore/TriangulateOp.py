@@ -186,6 +186,22 @@ class TestTriangulateOp( unittest.TestCase ) :
 		result = op()
 
 
+	def __triangleArea( self, mesh ) :
+
+		P = mesh["P"].data
+		ids = mesh.vertexIds
+		normal = None
+		area = 0
+		for i in range( 0, len( ids ), 3 ) :
+			n = ( P[ids[i+1]] - P[ids[i]] ).cross( P[ids[i+2]] - P[ids[i]] )
+			if normal is None :
+				normal = n.normalized()
+			# all the triangles must have the same winding
+			self.failUnless( n.dot( normal ) >= 0 )
+			area += n.length() / 2
+
+		return area
+
 	def testConcave( self ) :
 		""" Test TriangulateOp with a concave polygon"""
 
@@ -211,11 +227,53 @@ class TestTriangulateOp( unittest.TestCase ) :
 
 		op["input"] = m
 
-		# Concave faces not supported by default
-		self.assertRaises( RuntimeError, op )
+		# Concave faces are supported
+		result = op()
+		self.assert_( result.arePrimitiveVariablesValid() )
+		self.assertEqual( result.verticesPerFace, IntVectorData( [ 3, 3 ] ) )
+		self.assertAlmostEqual( self.__triangleArea( result ), 2, 6 )
 
 		op.parameters()["throwExceptions"] = False
 		result = op()
+		self.assertEqual( result.verticesPerFace, IntVectorData( [ 3, 3 ] ) )
+
+	def testConcaveNGons( self ) :
+
+		# an L shape and a comb shape, in the xy and yz planes respectively,
+		# with a quad in between to check the offsets are computed correctly.
+		P = V3fVectorData( [
+			V3f( 0, 0, 0 ), V3f( 2, 0, 0 ), V3f( 2, 1, 0 ), V3f( 1, 1, 0 ), V3f( 1, 2, 0 ), V3f( 0, 2, 0 ),
+			V3f( 5, 0, 0 ), V3f( 6, 0, 0 ), V3f( 6, 1, 0 ), V3f( 5, 1, 0 ),
+			V3f( 10, 0, 0 ), V3f( 10, 3, 0 ), V3f( 10, 3, 2 ), V3f( 10, 2, 2 ), V3f( 10, 2, 1 ), V3f( 10, 1, 1 ), V3f( 10, 1, 2 ), V3f( 10, 0, 2 ),
+		] )
+
+		m = MeshPrimitive( IntVectorData( [ 6, 4, 8 ] ), IntVectorData( range( 0, 18 ) ) )
+		m["P"] = PrimitiveVariable( PrimitiveVariable.Interpolation.Vertex, P )
+		m["uniform"] = PrimitiveVariable( PrimitiveVariable.Interpolation.Uniform, IntVectorData( [ 0, 1, 2 ] ) )
+		m["faceVarying"] = PrimitiveVariable( PrimitiveVariable.Interpolation.FaceVarying, IntVectorData( range( 0, 18 ) ) )
+
+		result = TriangulateOp()( input = m )
+		self.assert_( result.arePrimitiveVariablesValid() )
+		self.assertEqual( result.verticesPerFace, IntVectorData( [ 3 ] * 12 ) )
+		self.assertEqual( result["uniform"].data, IntVectorData( [ 0 ] * 4 + [ 1 ] * 2 + [ 2 ] * 6 ) )
+		self.assertEqual( result["faceVarying"].data, result.vertexIds )
+
+		for face, area in enumerate( [ 3, 1, 5 ] ) :
+			faceMesh = MeshPrimitive( IntVectorData( [ 3 ] * ( [ 4, 2, 6 ][face] ) ), IntVectorData( [ result.vertexIds[i] for i in range( 0, 36 ) if result["uniform"].data[i/3] == face ] ) )
+			faceMesh["P"] = PrimitiveVariable( PrimitiveVariable.Interpolation.Vertex, P )
+			self.assertAlmostEqual( self.__triangleArea( faceMesh ), area, 5 )
+
+	def testLargeMesh( self ) :
+
+		m = MeshPrimitive.createPlane( Box2f( V2f( -1 ), V2f( 1 ) ), V2i( 200 ) )
+		m["uniform"] = PrimitiveVariable( PrimitiveVariable.Interpolation.Uniform, IntVectorData( range( 0, m.numFaces() ) ) )
+		m["faceVarying"] = PrimitiveVariable( PrimitiveVariable.Interpolation.FaceVarying, V2fVectorData( [ V2f( 0 ) ] * len( m.vertexIds ) ) )
+
+		result = TriangulateOp()( input = m )
+
+		self.assert_( result.arePrimitiveVariablesValid() )
+		self.assertEqual( result.numFaces(), m.numFaces() * 2 )
+		self.assertEqual( result["uniform"].data, IntVectorData( [ i / 2 for i in range( 0, result.numFaces() ) ] ) )
 
 	def testErrors( self ):
 		""" Test TriangulateOp with invalid P data """
@@ -34,6 +34,7 @@
 
 import os
 import unittest
+import random
 import IECore
 
 class TestTurbulence( unittest.TestCase ) :
@@ -113,6 +114,41 @@ class TestTurbulence( unittest.TestCase ) :
 		f = t.turbulence( IECore.V2f( 21.3, 51.2 ) )
 		self.assert_( f == f )
 
+	def testTurbulenceVector( self ) :
+
+		random.seed( 0 )
+		p = IECore.V3fVectorData()
+		for i in range( 0, 5000 ) :
+			p.append( IECore.V3f( random.uniform( -100, 100 ), random.uniform( -100, 100 ), random.uniform( -100, 100 ) ) )
+
+		for turbulent in ( True, False ) :
+
+			t = IECore.TurbulenceV3ff(
+				octaves = 5,
+				gain = 0.6,
+				lacunarity = 2.1,
+				turbulent = turbulent
+			)
+
+			v = t.turbulenceVector( p )
+			self.assertEqual( len( v ), len( p ) )
+			for i in range( 0, len( p ) ) :
+				self.assertEqual( v[i], t.turbulence( p[i] ) )
+
+	def testTurbulenceVectorInPlace( self ) :
+
+		random.seed( 0 )
+		p = IECore.V3fVectorData()
+		for i in range( 0, 5000 ) :
+			p.append( IECore.V3f( random.uniform( -100, 100 ), random.uniform( -100, 100 ), random.uniform( -100, 100 ) ) )
+
+		t = IECore.TurbulenceV3fV3f()
+		expected = t.turbulenceVector( p )
+
+		v = t.turbulenceVector( p, p )
+		self.failUnless( v.isSame( p ) )
+		self.assertEqual( v, expected )
+
 if __name__ == "__main__":
 	unittest.main()
 
@@ -67,6 +67,43 @@ class TestGroup( unittest.TestCase ) :
 		g.clearChildren()
 		self.assertEqual( g.children(), [] )
 
+	def testBoundCaching( self ) :
+
+		g = Group()
+		self.failUnless( g.bound().isEmpty() )
+
+		g2 = Group()
+		g2.addChild( SpherePrimitive() )
+		g.addChild( g2 )
+		self.assertEqual( g.bound(), Box3f( V3f( -1 ), V3f( 1 ) ) )
+
+		# editing a grandchild must invalidate the cached bound
+		# of the parent too.
+		c = g.editCount()
+		g2.setTransform( M44f.createTranslated( V3f( 1, 0, 0 ) ) )
+		self.failUnless( g.editCount() > c )
+		self.assertEqual( g.bound(), Box3f( V3f( 0, -1, -1 ), V3f( 2, 1, 1 ) ) )
+
+		g.setTransform( M44f.createScaled( V3f( 2 ) ) )
+		self.assertEqual( g.bound(), Box3f( V3f( 0, -2, -2 ), V3f( 4, 2, 2 ) ) )
+
+		g2.clearChildren()
+		self.failUnless( g.bound().isEmpty() )
+
+	def testIntersectsFrustum( self ) :
+
+		m = M44f()
+		self.failUnless( Group.intersectsFrustum( Box3f( V3f( -0.5 ), V3f( 0.5 ) ), m ) )
+		self.failUnless( Group.intersectsFrustum( Box3f( V3f( 0.5 ), V3f( 2 ) ), m ) )
+		self.failUnless( Group.intersectsFrustum( Box3f( V3f( -10 ), V3f( 10 ) ), m ) )
+		self.failIf( Group.intersectsFrustum( Box3f( V3f( 1.5 ), V3f( 2 ) ), m ) )
+		self.failIf( Group.intersectsFrustum( Box3f( V3f( -2, -0.5, -0.5 ), V3f( -1.5, 0.5, 0.5 ) ), m ) )
+		self.failIf( Group.intersectsFrustum( Box3f(), m ) )
+
+		m = M44f.createTranslated( V3f( 3, 0, 0 ) )
+		self.failUnless( Group.intersectsFrustum( Box3f( V3f( -3.5, -0.5, -0.5 ), V3f( -2.5, 0.5, 0.5 ) ), m ) )
+		self.failIf( Group.intersectsFrustum( Box3f( V3f( -0.5 ), V3f( 0.5 ) ), m ) )
+
 		
 if __name__ == "__main__":
     unittest.main()
@@ -123,6 +123,54 @@ class TestSelection( unittest.TestCase ) :
 		self.assertEqual( len( ss ), 1 )
 		self.assertEqual( IECoreGL.NameStateComponent.nameFromGLName( ss[0].name ), "white" )
 
+	def testCPURegionSelect( self ) :
+
+		r = IECoreGL.Renderer()
+		r.setOption( "gl:mode", IECore.StringData( "deferred" ) )
+
+		with IECore.WorldBlock( r ) :
+
+			r.concatTransform( IECore.M44f.createTranslated( IECore.V3f( 0, 0, -5 ) ) )
+
+			for name, offset in [
+				( "red", IECore.V3f( -2, -2, 0 ) ),
+				( "green", IECore.V3f( 0, 4, 0 ) ),
+				( "blue", IECore.V3f( 4, 0, 0 ) ),
+				( "white", IECore.V3f( 0, -4, 0 ) ),
+			] :
+				r.concatTransform( IECore.M44f.createTranslated( offset ) )
+				r.setAttribute( "name", IECore.StringData( name ) )
+				r.geometry( "sphere", {}, {} )
+
+		s = r.scene()
+		s.setCamera( IECoreGL.PerspectiveCamera() )
+
+		for region, name in [
+			( IECore.Box2f( IECore.V2f( 0, 0.5 ), IECore.V2f( 0.5, 1 ) ), "red" ),
+			( IECore.Box2f( IECore.V2f( 0 ), IECore.V2f( 0.5 ) ), "green" ),
+			( IECore.Box2f( IECore.V2f( 0.5, 0 ), IECore.V2f( 1, 0.5 ) ), "blue" ),
+			( IECore.Box2f( IECore.V2f( 0.5 ), IECore.V2f( 1 ) ), "white" ),
+		] :
+
+			cpu = s.select( region )
+			self.assertEqual( len( cpu ), 1 )
+			self.assertEqual( IECoreGL.NameStateComponent.nameFromGLName( cpu[0].name ), name )
+			self.failUnless( 0 <= cpu[0].depthMin <= cpu[0].depthMax <= 1 )
+
+			gl = s.select( IECoreGL.Selector.Mode.GLSelect, region )
+			self.assertEqual( [ x.name for x in cpu ], [ x.name for x in gl ] )
+
+		ss = s.select( IECore.Box2f( IECore.V2f( 0 ), IECore.V2f( 1 ) ) )
+		names = set( [ IECoreGL.NameStateComponent.nameFromGLName( x.name ) for x in ss ] )
+		self.assertEqual( names, set( [ "red", "green", "blue", "white" ] ) )
+
+		# the selection index must be rebuilt when the scene is edited
+		s.root().clearChildren()
+		self.assertEqual( s.select( IECore.Box2f( IECore.V2f( 0 ), IECore.V2f( 1 ) ) ), [] )
+
+		s.setCamera( None )
+		self.assertRaises( RuntimeError, s.select, IECore.Box2f( IECore.V2f( 0 ), IECore.V2f( 1 ) ) )
+
 	def testIDSelect( self ) :
 	
 		r = IECoreGL.Renderer()
@@ -447,6 +495,10 @@ class TestSelection( unittest.TestCase ) :
 			ss = s.select( mode, IECore.Box2f( IECore.V2f( 0 ), IECore.V2f( 1 ) ) )
 			names = [ IECoreGL.NameStateComponent.nameFromGLName( x.name ) for x in ss ]
 			self.assertEqual( names, [ "selectableObj" ] )
+
+		ss = s.select( IECore.Box2f( IECore.V2f( 0 ), IECore.V2f( 1 ) ) )
+		names = [ IECoreGL.NameStateComponent.nameFromGLName( x.name ) for x in ss ]
+		self.assertEqual( names, [ "selectableObj" ] )
 				
 if __name__ == "__main__":
     unittest.main()